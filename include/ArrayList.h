@@ -2,6 +2,7 @@
 #define _ARRAY_LIST_H_
 
 #include <cstdlib>          // For size_t
+#include <iosfwd>           // For std::ostream, std::istream
 #include "ScopedArray.h"
 
 // Forward declarations
@@ -11,6 +12,12 @@ class ArrayListIterator;
 template <typename T>
 class ArrayListConstIterator;
 
+template <typename T>
+class ArrayListSubList;
+
+class ListWriter;
+class ListReader;
+
 namespace std {
     class out_of_range;
 }
@@ -54,16 +61,26 @@ public:
      * Initializes the ArrayList with size elements all set to value. If size is
      * not supplied, an empty ArrayList is created. If value is not supplied,
      * the default value for the parametrized type will be used.
+     * The optional storage selects where this ArrayList obtains its memory
+     * for the rest of its lifetime (see ArrayStorage), e.g. huge page backed
+     * mappings for very large lists or 64-byte aligned heap memory for SIMD.
+     * If storage is the default HEAP, the parametrized type is trivial and
+     * value is all zero bytes, the storage is requested zero-filled from the
+     * system instead of being filled element by element. Large lists then
+     * only commit memory for the pages that are actually written.
      * This operation provides strong exception safety.
      *
      * @param size size of the ArrayList to create
      * @param value value used to fill the ArrayList
+     * @param storage where to allocate the elements from
      */
-    explicit ArrayList(size_t size = 0, const_reference value = value_type());
+    explicit ArrayList(size_t size = 0, const_reference value = value_type(),
+                       const ArrayStorage& storage = ArrayStorage());
 
     /**
      * Initializes the ArrayList to be a copy of src. Only the logical values of
      * src are copied. This means that any excess capacity of src is ignored.
+     * The copy uses the same kind of storage as src.
      * This operation provides strong exception safety.
      *
      * @param src ArrayList to copy
@@ -84,7 +101,8 @@ public:
     /**
      * Adds value to the end of this ArrayList. If we have excess capacity,
      * the insertion is performed in constant time. Otherwise, time proportional
-     * to the size of this ArrayList is needed.
+     * to the size of this ArrayList is needed, unless the storage can be
+     * remapped in place (see ArrayStorage::MAPPED).
      * This operation provides strong exception safety.
      *
      * @param value value to append to this ArrayList
@@ -106,9 +124,23 @@ public:
      */
     void add(size_t index, const_reference value);
 
+    /**
+     * Adds the elements of the range [first, last) to the end of this
+     * ArrayList. The range is measured first, so at most one reallocation
+     * happens however long it is. InputIterator must be a forward iterator,
+     * and the range must not lie within this ArrayList.
+     * This operation provides strong exception safety.
+     *
+     * @param first iterator to the first element to append
+     * @param last iterator one past the last element to append
+     */
+    template <typename InputIterator>
+    void addAll(InputIterator first, InputIterator last);
+
     /**
      * Empties this ArrayList releasing all of its resources (i.e., returning
-     * this ArrayList to the same state as the default constructor).
+     * this ArrayList to the same state as the default constructor). The kind
+     * of storage is retained.
      * This operation is no-throw under the assumption that the parametrizing
      * type's destructor is no-throw.
      */
@@ -156,6 +188,42 @@ public:
      */
     reference operator[](size_t index) throw ();
 
+    /**
+     * Returns a constant reference to the first element. If this ArrayList is
+     * empty, an std::out_of_range exception is thrown with 0 as its message.
+     * This operation provides strong exception safety.
+     *
+     * @return constant reference to the first element.
+     */
+    const_reference front() const throw (std::out_of_range);
+
+    /**
+     * Returns a reference to the first element. If this ArrayList is empty, an
+     * std::out_of_range exception is thrown with 0 as its message.
+     * This operation provides strong exception safety.
+     *
+     * @return reference to the first element.
+     */
+    reference front() throw (std::out_of_range);
+
+    /**
+     * Returns a constant reference to the last element. If this ArrayList is
+     * empty, an std::out_of_range exception is thrown with 0 as its message.
+     * This operation provides strong exception safety.
+     *
+     * @return constant reference to the last element.
+     */
+    const_reference back() const throw (std::out_of_range);
+
+    /**
+     * Returns a reference to the last element. If this ArrayList is empty, an
+     * std::out_of_range exception is thrown with 0 as its message.
+     * This operation provides strong exception safety.
+     *
+     * @return reference to the last element.
+     */
+    reference back() throw (std::out_of_range);
+
     /**
      * Returns true if this ArrayList is equal to rhs and false otherwise
      * This operation provides strong exception safety.
@@ -228,6 +296,39 @@ public:
      */
     value_type remove(size_t index);
 
+    /**
+     * Removes and returns the last element in constant time, without ever
+     * reallocating. If this ArrayList is empty, an std::out_of_range exception
+     * is thrown with 0 as its message.
+     * This operation provides strong exception safety.
+     *
+     * @return copy of the just removed object.
+     */
+    value_type removeLast();
+
+    /**
+     * Removes the elements in the range [from, to), shifting the elements
+     * after it down once. If to is past the end or from is past to, an
+     * std::out_of_range exception is thrown with the offending index as its
+     * message. Types whose copy assignment cannot throw are shifted in place;
+     * others are copied to a new array of the same capacity.
+     * This operation provides strong exception safety.
+     *
+     * @param from index of the first element to remove
+     * @param to index one past the last element to remove
+     */
+    void removeRange(size_t from, size_t to);
+
+    /**
+     * Makes sure that at least capacity elements fit without reallocation, so
+     * that a known number of add(const_reference) calls runs in constant time
+     * each. Does nothing if the capacity is already large enough.
+     * This operation provides strong exception safety.
+     *
+     * @param capacity number of elements to make room for
+     */
+    void reserve(size_t capacity);
+
     /**
      * Sets the element at the specified index to the provided value. If index
      * is out of bounds, an std::out_of_range exception is thrown with the index
@@ -245,8 +346,86 @@ public:
      */
     size_t size() const throw ();
 
+    /**
+     * Returns a view of the elements of this ArrayList in the range
+     * [from, to). The view costs constant time to create and shares the
+     * elements of this ArrayList. If to is past the end or from is past to,
+     * an std::out_of_range exception is thrown with the offending index as
+     * its message.
+     * This operation provides strong exception safety.
+     *
+     * @param from index of the first element of the view
+     * @param to index one past the last element of the view
+     * @return
+     */
+    ArrayListSubList<T> subList(size_t from, size_t to) throw (std::out_of_range);
+
+    /**
+     * Returns a constant view of the elements of this ArrayList in the range
+     * [from, to). If to is past the end or from is past to, an
+     * std::out_of_range exception is thrown with the offending index as its
+     * message.
+     * This operation provides strong exception safety.
+     *
+     * @param from index of the first element of the view
+     * @param to index one past the last element of the view
+     * @return
+     */
+    ArrayListSubList<const T> subList(size_t from, size_t to) const throw (std::out_of_range);
+
+    /**
+     * Writes this ArrayList to the file descriptor fd in the versioned binary
+     * format described by ListFileHeader. Trivially copyable elements are
+     * written in a single block. Throws std::system_error if writing fails.
+     *
+     * @param fd file descriptor to write to
+     */
+    void writeTo(int fd) const;
+
+    /**
+     * Writes this ArrayList to os in the versioned binary format described by
+     * ListFileHeader. Throws std::ios_base::failure if writing fails.
+     *
+     * @param os stream to write to
+     */
+    void writeTo(std::ostream& os) const;
+
+    /**
+     * Replaces the contents of this ArrayList with a list read from the file
+     * descriptor fd, as written by writeTo. Trivially copyable elements are
+     * read in a single block. Throws std::runtime_error if the data is
+     * truncated or was written for another element type.
+     * This operation provides strong exception safety.
+     *
+     * @param fd file descriptor to read from
+     */
+    void readFrom(int fd);
+
+    /**
+     * Replaces the contents of this ArrayList with a list read from is, as
+     * written by writeTo. Throws std::runtime_error if the data is truncated
+     * or was written for another element type.
+     * This operation provides strong exception safety.
+     *
+     * @param is stream to read from
+     */
+    void readFrom(std::istream& is);
+
 private:
 
+    // Bytes of elements deserialize() reads before growing the storage again
+    enum { kReadChunk = 1 << 16 };
+
+    /**
+     * Returns true if value is of a trivial type and consists of zero bytes
+     * only, meaning zero-filled memory is indistinguishable from a fill.
+     * This operation is a no-throw.
+     *
+     * @param value
+     * @return
+     */
+    static bool isZeroFill(const_reference value) throw ();
+
     /**
      * Given an index, this method throws an std::out_of_range with the index as
      * its message if index is out of bounds or is a no-op otherwise.
@@ -256,6 +435,31 @@ private:
      */
     void rangeCheck(size_t index) const throw (std::out_of_range);
 
+    /**
+     * Throws an std::out_of_range with the offending index as its message if
+     * [from, to) is not a range of this ArrayList.
+     * This operation provides strong exception safety.
+     *
+     * @param from
+     * @param to
+     */
+    void sliceCheck(size_t from, size_t to) const throw (std::out_of_range);
+
+    /**
+     * Writes the header and elements to out.
+     *
+     * @param out
+     */
+    void serialize(ListWriter& out) const;
+
+    /**
+     * Replaces the contents with the header and elements read from in.
+     * This operation provides strong exception safety.
+     *
+     * @param in
+     */
+    void deserialize(ListReader& in);
+
     /**
      * Swaps the contents of this ArrayList with that of other in constant time.
      * This operation is a no-throw.
@@ -270,5 +474,6 @@ private:
 };
 
 #include "../src/ArrayList.cpp"
+#include "ArrayListBool.h"       // Bit-packed ArrayList<bool>
 
 #endif
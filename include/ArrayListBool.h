@@ -0,0 +1,378 @@
+#ifndef _ARRAY_LIST_BOOL_H_
+#define _ARRAY_LIST_BOOL_H_
+
+#include <cstdlib>          // For size_t
+#include <stdint.h>         // For uint64_t
+#include "ArrayList.h"
+#include "ScopedArray.h"
+
+// Forward declarations
+template <>
+class ArrayListIterator<bool>;
+
+template <>
+class ArrayListConstIterator<bool>;
+
+/**
+ * A bit-packed specialization of the ArrayList for bool. Flags are stored 64 to
+ * a word, so the list occupies one bit per element instead of one byte. Since
+ * individual bits are not addressable, the mutable accessors return a proxy
+ * (ArrayList<bool>::reference) that behaves like a bool& for reads, writes and
+ * flip(). The const accessors return plain bool values.
+ *
+ * Implementation note: every bit at or beyond size() is kept cleared. This lets
+ * count(), operator== and the find methods operate on whole words without
+ * masking the tail.
+ *
+ * In addition to the ArrayList interface, this class offers count(),
+ * findFirst() and findNext(size_t) which scan a word at a time using the
+ * compiler's popcount and count-trailing-zeros builtins.
+ *
+ * The constructor allocates exactly the words needed for size elements. Methods
+ * that grow the list request twice the memory that is needed, as ArrayList
+ * does.
+ */
+template <>
+class ArrayList<bool> {
+public:
+
+    /**
+     * A proxy standing in for a bool& to a single bit of an ArrayList<bool>.
+     * It remains valid for as long as iterators of the list would.
+     */
+    class reference {
+    public:
+
+        /**
+         * Reads the referenced bit.
+         *
+         * @return
+         */
+        operator bool() const throw () {
+            return (*mWord & mMask) != 0;
+        }
+
+        /**
+         * Writes value into the referenced bit.
+         *
+         * @param value
+         * @return
+         */
+        reference& operator=(bool value) throw () {
+            if (value)
+                *mWord |= mMask;
+            else
+                *mWord &= ~mMask;
+            return *this;
+        }
+
+        /**
+         * Writes the bit referenced by rhs into the bit referenced by this.
+         *
+         * @param rhs
+         * @return
+         */
+        reference& operator=(const reference& rhs) throw () {
+            return *this = static_cast<bool>(rhs);
+        }
+
+        /**
+         * Inverts the referenced bit.
+         */
+        void flip() throw () {
+            *mWord ^= mMask;
+        }
+
+    private:
+
+        friend class ArrayList<bool>;
+        friend class ArrayListIterator<bool>;
+
+        reference(uint64_t* word, size_t bit) : mWord(word), mMask(uint64_t(1) << bit) {}
+
+        uint64_t* mWord;
+        uint64_t mMask;
+    };
+
+    typedef bool value_type;
+    typedef bool const_reference;
+    typedef ArrayListIterator<bool> iterator;
+    typedef ArrayListConstIterator<bool> const_iterator;
+
+    /**
+     * Initializes the ArrayList with size elements all set to value. If size is
+     * not supplied, an empty ArrayList is created. If value is not supplied,
+     * false is used.
+     * This operation provides strong exception safety.
+     *
+     * @param size size of the ArrayList to create
+     * @param value value used to fill the ArrayList
+     */
+    explicit ArrayList(size_t size = 0, bool value = false);
+
+    /**
+     * Initializes the ArrayList to be a copy of src. Only the logical values of
+     * src are copied. This means that any excess capacity of src is ignored.
+     * This operation provides strong exception safety.
+     *
+     * @param src ArrayList to copy
+     */
+    ArrayList(const ArrayList<bool>& src);
+
+    /**
+     * Makes this object a copy of rhs using the same guidelines as the copy
+     * constructor. Note that calling this method on yourself (a = a;) is
+     * equivalent to a no-op.
+     * This operation provides strong exception safety.
+     *
+     * @param src ArrayList to copy
+     * @return *this, used for chaining.
+     */
+    const ArrayList<bool>& operator=(const ArrayList<bool>& rhs);
+
+    /**
+     * Adds value to the end of this ArrayList. If we have excess capacity,
+     * the insertion is performed in constant time. Otherwise, time proportional
+     * to the size of this ArrayList is needed.
+     * This operation provides strong exception safety.
+     *
+     * @param value value to append to this ArrayList
+     */
+    void add(bool value);
+
+    /**
+     * Inserts value at the specified index. All elements at or to the right of
+     * index are shifted down by one spot, a word at a time. If this ArrayList
+     * needs to be enlarged, false is used to fill the gaps.
+     * This operation provides strong exception safety.
+     *
+     * @param index index at which to insert value
+     * @param value the element to insert
+     */
+    void add(size_t index, bool value);
+
+    /**
+     * Empties this ArrayList releasing all of its resources (i.e., returning
+     * this ArrayList to the same state as the default constructor).
+     * This operation is no-throw.
+     */
+    void clear() throw ();
+
+    /**
+     * Returns the value of the element stored at the provided index. If index
+     * is out of bounds, an std::out_of_range exception is thrown with the index
+     * as its message.
+     * This operation provides strong exception safety.
+     *
+     * @param index index of the element to return
+     * @return value of the element at the index.
+     */
+    const_reference get(size_t index) const throw (std::out_of_range);
+
+    /**
+     * Returns a proxy reference to the element stored at the provided index. If
+     * index is out of bounds, an std::out_of_range exception is thrown with the
+     * index as its message.
+     * This operation provides strong exception safety.
+     *
+     * @param index index of the element to return
+     * @return proxy reference to the element at the index.
+     */
+    reference get(size_t index) throw (std::out_of_range);
+
+    /**
+     * Returns the value of the element stored at the provided index. No range
+     * checking is performed on the index.
+     * This operation is no-throw.
+     *
+     * @param index index of the element to return
+     * @return value of the element at the index.
+     */
+    const_reference operator[](size_t index) const throw ();
+
+    /**
+     * Returns a proxy reference to the element stored at the provided index.
+     * No range checking is performed on the index.
+     * This operation is no-throw.
+     *
+     * @param index index of the element to return
+     * @return proxy reference to the element at the index.
+     */
+    reference operator[](size_t index) throw ();
+
+    /**
+     * Returns true if this ArrayList is equal to rhs and false otherwise. The
+     * comparison is performed a word at a time.
+     * This operation is no-throw.
+     *
+     * @param rhs
+     * @return
+     */
+    bool operator==(const ArrayList<bool>& rhs) const throw ();
+
+    /**
+     * Returns false if this ArrayList is equal to rhs and true otherwise
+     * This operation is no-throw.
+     *
+     * @param rhs
+     * @return
+     */
+    bool operator!=(const ArrayList<bool>& rhs) const throw ();
+
+    /**
+     * Returns a constant iterator to the beginning.
+     * This operation is a no-throw.
+     *
+     * @return
+     */
+    const_iterator begin() const throw ();
+
+    /**
+     * Returns an iterator to the beginning.
+     * This operation is a no-throw.
+     *
+     * @return
+     */
+    iterator begin() throw ();
+
+    /**
+     * Returns a constant iterator to the end.
+     * This operation is a no-throw.
+     *
+     * @return
+     */
+    const_iterator end() const throw ();
+
+    /**
+     * Returns an iterator to the end.
+     * This operation is a no-throw.
+     *
+     * @return
+     */
+    iterator end() throw ();
+
+    /**
+     * Returns true if this ArrayList is empty and false otherwise.
+     * This operation is a no-throw.
+     *
+     * @return
+     */
+    bool isEmpty() const throw ();
+
+    /**
+     * Removes and returns the element at the specified index. If index is out
+     * of bounds, an std::out_of_range exception is thrown with index as its
+     * message. The elements to the right of index are shifted in place a word
+     * at a time, so no reallocation ever takes place.
+     * This operation provides strong exception safety.
+     *
+     * @param index index of the object to remove.
+     * @return value of the just removed object.
+     */
+    value_type remove(size_t index);
+
+    /**
+     * Sets the element at the specified index to the provided value. If index
+     * is out of bounds, an std::out_of_range exception is thrown with the index
+     * as its message. This method completes in constant time.
+     * This operation provides strong exception safety.
+     */
+    void set(size_t index, bool value);
+
+    /**
+     * Return the size of this ArrayList.
+     * This operation is a no-throw.
+     *
+     * @return
+     */
+    size_t size() const throw ();
+
+    /**
+     * Returns the number of elements set to true.
+     * This operation is a no-throw.
+     *
+     * @return
+     */
+    size_t count() const throw ();
+
+    /**
+     * Returns the index of the first element set to true, or size() if there
+     * is none.
+     * This operation is a no-throw.
+     *
+     * @return
+     */
+    size_t findFirst() const throw ();
+
+    /**
+     * Returns the index of the first element after index that is set to true,
+     * or size() if there is none.
+     * This operation is a no-throw.
+     *
+     * @param index index to start searching after
+     * @return
+     */
+    size_t findNext(size_t index) const throw ();
+
+private:
+
+    static const size_t kWordBits = 64;
+
+    /**
+     * Returns the number of words needed to hold bits bits.
+     *
+     * @param bits
+     * @return
+     */
+    static size_t wordsFor(size_t bits) throw ();
+
+    /**
+     * Returns a word with the low bits bits set.
+     *
+     * @param bits
+     * @return
+     */
+    static uint64_t lowMask(size_t bits) throw ();
+
+    /**
+     * Returns the index of the first set bit at or after index, or size().
+     *
+     * @param index
+     * @return
+     */
+    size_t scanFrom(size_t index) const throw ();
+
+    /**
+     * Grows the storage so that at least minSize bits fit, requesting twice
+     * minSize if a reallocation is necessary.
+     * This operation provides strong exception safety.
+     *
+     * @param minSize
+     */
+    void ensureCapacity(size_t minSize);
+
+    /**
+     * Given an index, this method throws an std::out_of_range with the index as
+     * its message if index is out of bounds or is a no-op otherwise.
+     * This operation provides strong exception safety.
+     *
+     * @param index index to check
+     */
+    void rangeCheck(size_t index) const throw (std::out_of_range);
+
+    /**
+     * Swaps the contents of this ArrayList with that of other in constant time.
+     * This operation is a no-throw.
+     *
+     * @param other the ArrayList to swap with
+     */
+    void swap(ArrayList<bool>& other) throw ();
+
+    size_t mSize;
+    size_t mCapacity;       // In bits, always a multiple of kWordBits
+    ScopedArray<uint64_t> mArray;
+};
+
+#include "../src/ArrayListBool.cpp"
+
+#endif
@@ -0,0 +1,163 @@
+#ifndef _ARRAY_LIST_BOOL_ITERATORS_H_
+#define _ARRAY_LIST_BOOL_ITERATORS_H_
+
+#include <iterator>
+#include <cstddef>          // For ptrdiff_t
+#include <stdint.h>         // For uint64_t
+#include "ArrayListBool.h"
+
+/**
+ * A random access iterator for the bit-packed ArrayList<bool>. Dereferencing
+ * yields an ArrayList<bool>::reference proxy rather than a bool&. All of the
+ * methods are guaranteed no-throws and complete in constant-time.
+ */
+template <>
+class ArrayListIterator<bool>
+        : public std::iterator<std::random_access_iterator_tag, bool, std::ptrdiff_t, void,
+                               ArrayList<bool>::reference> {
+private:
+
+    friend class ArrayList<bool>;
+    friend class ArrayListConstIterator<bool>;
+    uint64_t* mWords;
+    size_t mIndex;
+
+    /**
+     * A private explicit constructor used in ArrayList's begin() and end().
+     *
+     * @param
+     * @param
+     */
+    ArrayListIterator(uint64_t* words, size_t index) : mWords(words), mIndex(index) {}
+
+public:
+
+    /**
+     * Default constructor. Equivalent to a null pointer.
+     */
+    ArrayListIterator() : mWords(0), mIndex(0) {}
+
+    bool operator==(const ArrayListIterator<bool>& rhs) const {
+        return mWords == rhs.mWords && mIndex == rhs.mIndex;
+    }
+
+    bool operator!=(const ArrayListIterator<bool>& rhs) const {
+        return !(*this == rhs);
+    }
+
+    /**
+     * Dereference as an lvalue proxy.
+     *
+     * @return
+     */
+    ArrayList<bool>::reference operator*() {
+        return ArrayList<bool>::reference(mWords + mIndex / 64, mIndex % 64);
+    }
+
+    /**
+     * Dereference as an rvalue.
+     *
+     * @return
+     */
+    bool operator*() const {
+        return (mWords[mIndex / 64] >> (mIndex % 64)) & 1;
+    }
+
+    ArrayListIterator<bool>& operator++() {
+        ++mIndex;
+        return *this;
+    }
+
+    ArrayListIterator<bool> operator++(int) {
+        return ArrayListIterator<bool>(mWords, mIndex++);
+    }
+
+    ArrayListIterator<bool> operator+(int offset) const {
+        return ArrayListIterator<bool>(mWords, mIndex + offset);
+    }
+
+    ArrayListIterator<bool> operator-(int offset) const {
+        return ArrayListIterator<bool>(mWords, mIndex - offset);
+    }
+
+    int operator-(const ArrayListIterator<bool>& rhs) const {
+        return mIndex - rhs.mIndex;
+    }
+};
+
+/**
+ * A random access iterator for the bit-packed ArrayList<bool> incapable of
+ * changing its content. All of the methods are guaranteed no-throws and
+ * complete in constant-time.
+ */
+template <>
+class ArrayListConstIterator<bool>
+        : public std::iterator<std::random_access_iterator_tag, bool, std::ptrdiff_t, void, bool> {
+private:
+
+    friend class ArrayList<bool>;
+    const uint64_t* mWords;
+    size_t mIndex;
+
+    /**
+     * A private explicit constructor used in ArrayList's begin() and end().
+     *
+     * @param
+     * @param
+     */
+    ArrayListConstIterator(const uint64_t* words, size_t index) : mWords(words), mIndex(index) {}
+
+public:
+
+    /**
+     * Default constructor. Equivalent to a null pointer.
+     */
+    ArrayListConstIterator() : mWords(0), mIndex(0) {}
+
+    /**
+     * Conversion from a mutable iterator.
+     *
+     * @param
+     */
+    ArrayListConstIterator(const ArrayListIterator<bool>& iter) : mWords(iter.mWords), mIndex(iter.mIndex) {}
+
+    bool operator==(const ArrayListConstIterator<bool>& rhs) const {
+        return mWords == rhs.mWords && mIndex == rhs.mIndex;
+    }
+
+    bool operator!=(const ArrayListConstIterator<bool>& rhs) const {
+        return !(*this == rhs);
+    }
+
+    /**
+     * Dereference as an rvalue.
+     *
+     * @return
+     */
+    bool operator*() const {
+        return (mWords[mIndex / 64] >> (mIndex % 64)) & 1;
+    }
+
+    ArrayListConstIterator<bool>& operator++() {
+        ++mIndex;
+        return *this;
+    }
+
+    ArrayListConstIterator<bool> operator++(int) {
+        return ArrayListConstIterator<bool>(mWords, mIndex++);
+    }
+
+    ArrayListConstIterator<bool> operator+(int offset) const {
+        return ArrayListConstIterator<bool>(mWords, mIndex + offset);
+    }
+
+    ArrayListConstIterator<bool> operator-(int offset) const {
+        return ArrayListConstIterator<bool>(mWords, mIndex - offset);
+    }
+
+    int operator-(const ArrayListConstIterator<bool>& rhs) const {
+        return mIndex - rhs.mIndex;
+    }
+};
+
+#endif
@@ -1,14 +1,26 @@
 #ifndef _ARRAY_LIST_ITERATORS_H_
 #define _ARRAY_LIST_ITERATORS_H_
 
+#include <cstddef>          // For std::ptrdiff_t
 #include <iterator>
 
+// Forward declarations
+template <typename T>
+class ArrayList;
+
+template <typename T>
+class MappedArrayList;
+
+template <typename T>
+class ArrayListView;
+
+template <typename T>
+class ArrayListSubList;
+
 /**
  * A random access iterator implementation for the ArrayList capable of changing
  * the content it is pointing to. By the virtue of this class's design, all of
  * the methods are guaranteed no-throws and complete in constant-time.
- * Note that this implementation leaves out some less commonly used random
- * iterator methods like the subsript operator and comparison operators.
  *
  * @author Krzysztof Zienkiewicz
  * @date October 1, 2011
@@ -18,6 +30,8 @@ class ArrayListIterator : public std::iterator<std::random_access_iterator_tag,
 private:
 
     friend class ArrayList<T>;
+    friend class MappedArrayList<T>;
+    friend class ArrayListSubList<T>;
     T* mPtr;
 
     /**
@@ -81,6 +95,16 @@ public:
         return mPtr;
     }
 
+    /**
+     * Subscript as an lvalue.
+     *
+     * @param
+     * @return
+     */
+    T& operator[](std::ptrdiff_t offset) const {
+        return mPtr[offset];
+    }
+
     /**
      * Pointer-style dereference as an rvalue.
      *
@@ -115,7 +139,7 @@ public:
      * @param
      * @return
      */
-    ArrayListIterator<T> operator+(int offset) {
+    ArrayListIterator<T> operator+(std::ptrdiff_t offset) const {
         return ArrayListIterator<T>(mPtr + offset);
     }
 
@@ -125,7 +149,7 @@ public:
      * @param
      * @return
      */
-    ArrayListIterator<T> operator-(int offset) {
+    ArrayListIterator<T> operator-(std::ptrdiff_t offset) const {
         return ArrayListIterator<T>(mPtr - offset);
     }
 
@@ -135,9 +159,90 @@ public:
      * @param
      * @return
      */
-    int operator-(const ArrayListIterator<T>& rhs) {
+    std::ptrdiff_t operator-(const ArrayListIterator<T>& rhs) const {
         return mPtr - rhs.mPtr;
     }
+
+    /**
+     * Compound arithmetic addition.
+     *
+     * @param
+     * @return
+     */
+    ArrayListIterator<T>& operator+=(std::ptrdiff_t offset) {
+        mPtr += offset;
+        return *this;
+    }
+
+    /**
+     * Compound arithmetic subtraction.
+     *
+     * @param
+     * @return
+     */
+    ArrayListIterator<T>& operator-=(std::ptrdiff_t offset) {
+        mPtr -= offset;
+        return *this;
+    }
+
+    /**
+     * Predecrement operator.
+     *
+     * @return
+     */
+    ArrayListIterator<T>& operator--() {
+        --mPtr;
+        return *this;
+    }
+
+    /**
+     * Postdecrement operator.
+     *
+     * @return
+     */
+    ArrayListIterator<T> operator--(int) {
+        return ArrayListIterator<T>(mPtr--);
+    }
+
+    /**
+     * Less than comparison (equivalent to pointer comparison).
+     *
+     * @param
+     * @return
+     */
+    bool operator<(const ArrayListIterator<T>& rhs) const {
+        return mPtr < rhs.mPtr;
+    }
+
+    /**
+     * Greater than comparison (equivalent to pointer comparison).
+     *
+     * @param
+     * @return
+     */
+    bool operator>(const ArrayListIterator<T>& rhs) const {
+        return rhs < *this;
+    }
+
+    /**
+     * Less than or equal comparison (equivalent to pointer comparison).
+     *
+     * @param
+     * @return
+     */
+    bool operator<=(const ArrayListIterator<T>& rhs) const {
+        return !(rhs < *this);
+    }
+
+    /**
+     * Greater than or equal comparison (equivalent to pointer comparison).
+     *
+     * @param
+     * @return
+     */
+    bool operator>=(const ArrayListIterator<T>& rhs) const {
+        return !(*this < rhs);
+    }
 };
 
 /**
@@ -148,7 +253,7 @@ public:
  * @return
  */
 template <typename T>
-ArrayListIterator<T> operator+(int offset, const ArrayListIterator<T>& iter) {
+ArrayListIterator<T> operator+(std::ptrdiff_t offset, const ArrayListIterator<T>& iter) {
     return iter + offset;
 }
 
@@ -160,7 +265,7 @@ ArrayListIterator<T> operator+(int offset, const ArrayListIterator<T>& iter) {
  * @return
  */
 template <typename T>
-ArrayListIterator<T> operator-(int offset, const ArrayListIterator<T>& iter) {
+ArrayListIterator<T> operator-(std::ptrdiff_t offset, const ArrayListIterator<T>& iter) {
     return iter - offset;
 }
 
@@ -169,8 +274,6 @@ ArrayListIterator<T> operator-(int offset, const ArrayListIterator<T>& iter) {
  * A random access iterator implementation for the ArrayList incapable of
  * changing its content. By the virtue of this class's design, all of
  * the methods are guaranteed no-throws and complete in constant-time.
- * Note that this implementation leaves out some less commonly used random
- * iterator methods like the subsript operator and comparison operators.
  *
  * @author Krzysztof Zienkiewicz
  * @date October 1, 2011
@@ -180,6 +283,10 @@ class ArrayListConstIterator : public std::iterator<std::random_access_iterator_
 private:
 
     friend class ArrayList<T>;
+    friend class MappedArrayList<T>;
+    friend class ArrayListView<T>;
+    friend class ArrayListSubList<T>;
+    friend class ArrayListSubList<const T>;
     T* mPtr;
 
     /**
@@ -234,6 +341,16 @@ public:
         return mPtr;
     }
 
+    /**
+     * Subscript as an rvalue.
+     *
+     * @param
+     * @return
+     */
+    const T& operator[](std::ptrdiff_t offset) const {
+        return mPtr[offset];
+    }
+
     /**
      * Preincrement operator.
      *
@@ -250,7 +367,7 @@ public:
      * @return
      */
     ArrayListConstIterator<T> operator++(int) {
-        return ArrayListIterator<T>(mPtr++);
+        return ArrayListConstIterator<T>(mPtr++);
     }
 
     /**
@@ -259,7 +376,7 @@ public:
      * @param
      * @return
      */
-    ArrayListConstIterator<T> operator+(int offset) {
+    ArrayListConstIterator<T> operator+(std::ptrdiff_t offset) const {
         return ArrayListConstIterator<T>(mPtr + offset);
     }
 
@@ -269,7 +386,7 @@ public:
      * @param
      * @return
      */
-    ArrayListConstIterator<T> operator-(int offset) {
+    ArrayListConstIterator<T> operator-(std::ptrdiff_t offset) const {
         return ArrayListConstIterator<T>(mPtr - offset);
     }
 
@@ -279,9 +396,90 @@ public:
      * @param
      * @return
      */
-    int operator-(const ArrayListConstIterator<T>& rhs) {
+    std::ptrdiff_t operator-(const ArrayListConstIterator<T>& rhs) const {
         return mPtr - rhs.mPtr;
     }
+
+    /**
+     * Compound arithmetic addition.
+     *
+     * @param
+     * @return
+     */
+    ArrayListConstIterator<T>& operator+=(std::ptrdiff_t offset) {
+        mPtr += offset;
+        return *this;
+    }
+
+    /**
+     * Compound arithmetic subtraction.
+     *
+     * @param
+     * @return
+     */
+    ArrayListConstIterator<T>& operator-=(std::ptrdiff_t offset) {
+        mPtr -= offset;
+        return *this;
+    }
+
+    /**
+     * Predecrement operator.
+     *
+     * @return
+     */
+    ArrayListConstIterator<T>& operator--() {
+        --mPtr;
+        return *this;
+    }
+
+    /**
+     * Postdecrement operator.
+     *
+     * @return
+     */
+    ArrayListConstIterator<T> operator--(int) {
+        return ArrayListConstIterator<T>(mPtr--);
+    }
+
+    /**
+     * Less than comparison (equivalent to pointer comparison).
+     *
+     * @param
+     * @return
+     */
+    bool operator<(const ArrayListConstIterator<T>& rhs) const {
+        return mPtr < rhs.mPtr;
+    }
+
+    /**
+     * Greater than comparison (equivalent to pointer comparison).
+     *
+     * @param
+     * @return
+     */
+    bool operator>(const ArrayListConstIterator<T>& rhs) const {
+        return rhs < *this;
+    }
+
+    /**
+     * Less than or equal comparison (equivalent to pointer comparison).
+     *
+     * @param
+     * @return
+     */
+    bool operator<=(const ArrayListConstIterator<T>& rhs) const {
+        return !(rhs < *this);
+    }
+
+    /**
+     * Greater than or equal comparison (equivalent to pointer comparison).
+     *
+     * @param
+     * @return
+     */
+    bool operator>=(const ArrayListConstIterator<T>& rhs) const {
+        return !(*this < rhs);
+    }
 };
 
 /**
@@ -292,7 +490,7 @@ public:
  * @return
  */
 template <typename T>
-ArrayListConstIterator<T> operator+(int offset, const ArrayListConstIterator<T>& iter) {
+ArrayListConstIterator<T> operator+(std::ptrdiff_t offset, const ArrayListConstIterator<T>& iter) {
     return iter + offset;
 }
 
@@ -304,7 +502,7 @@ ArrayListConstIterator<T> operator+(int offset, const ArrayListConstIterator<T>&
  * @return
  */
 template <typename T>
-ArrayListConstIterator<T> operator-(int offset, const ArrayListConstIterator<T>& iter) {
+ArrayListConstIterator<T> operator-(std::ptrdiff_t offset, const ArrayListConstIterator<T>& iter) {
     return iter - offset;
 }
 
@@ -0,0 +1,229 @@
+#ifndef _ARRAY_LIST_SUB_LIST_H_
+#define _ARRAY_LIST_SUB_LIST_H_
+
+#include <cstdlib>          // For size_t
+#include <type_traits>      // For std::remove_const, std::conditional
+
+// Forward declarations
+template <typename T>
+class ArrayList;
+
+template <typename T>
+class ArrayListIterator;
+
+template <typename T>
+class ArrayListConstIterator;
+
+namespace std {
+    class out_of_range;
+}
+
+/**
+ * A non-owning view of a contiguous range of an ArrayList, as returned by
+ * ArrayList::subList. The view is a pointer and a length: creating and
+ * copying it costs constant time and nothing is allocated. Reads and writes
+ * through the view go straight to the underlying ArrayList. The view has a
+ * fixed size since it cannot add or remove elements of the list it views.
+ *
+ * A view of a constant ArrayList is parametrized by a const type, in which
+ * case only the constant interface is available.
+ *
+ * The view is invalidated by anything that invalidates the iterators of the
+ * underlying ArrayList. It provides the same STL-style random access
+ * iterators as ArrayList, so standard algorithms like std::sort and
+ * std::lower_bound can be run on any slice of a list without copying it.
+ */
+template <typename T>
+class ArrayListSubList {
+public:
+
+    typedef typename std::remove_const<T>::type value_type;
+    typedef T& reference;
+    typedef const value_type& const_reference;
+    typedef typename std::conditional<std::is_const<T>::value,
+                                      ArrayListConstIterator<value_type>,
+                                      ArrayListIterator<value_type> >::type iterator;
+    typedef ArrayListConstIterator<value_type> const_iterator;
+
+    /**
+     * Returns a constant reference to the element stored at the provided index.
+     * If index is out of bounds, an std::out_of_range exception is thrown with
+     * the index as its message.
+     * This operation provides strong exception safety.
+     *
+     * @param index index of the element to return
+     * @return constant reference to the element at the index.
+     */
+    const_reference get(size_t index) const throw (std::out_of_range);
+
+    /**
+     * Returns a reference to the element stored at the provided index.
+     * If index is out of bounds, an std::out_of_range exception is thrown with
+     * the index as its message.
+     * This operation provides strong exception safety.
+     *
+     * @param index index of the element to return
+     * @return reference to the element at the index.
+     */
+    reference get(size_t index) throw (std::out_of_range);
+
+    /**
+     * Returns a constant reference to the element stored at the provided index.
+     * No bounds checking is performed.
+     * This operation is a no-throw.
+     *
+     * @param index index of the element to return
+     * @return constant reference to the element at the index.
+     */
+    const_reference operator[](size_t index) const throw ();
+
+    /**
+     * Returns a reference to the element stored at the provided index.
+     * No bounds checking is performed.
+     * This operation is a no-throw.
+     *
+     * @param index index of the element to return
+     * @return reference to the element at the index.
+     */
+    reference operator[](size_t index) throw ();
+
+    /**
+     * Returns true if this ArrayListSubList is logically equal to rhs.
+     *
+     * @param rhs
+     * @return
+     */
+    bool operator==(const ArrayListSubList<T>& rhs) const;
+
+    /**
+     * Returns false if this ArrayListSubList is logically equal to rhs.
+     *
+     * @param rhs
+     * @return
+     */
+    bool operator!=(const ArrayListSubList<T>& rhs) const;
+
+    /**
+     * Returns a constant iterator to the first element.
+     * This operation is a no-throw.
+     *
+     * @return
+     */
+    const_iterator begin() const throw ();
+
+    /**
+     * Returns an iterator to the first element.
+     * This operation is a no-throw.
+     *
+     * @return
+     */
+    iterator begin() throw ();
+
+    /**
+     * Returns a constant iterator one past the last element.
+     * This operation is a no-throw.
+     *
+     * @return
+     */
+    const_iterator end() const throw ();
+
+    /**
+     * Returns an iterator one past the last element.
+     * This operation is a no-throw.
+     *
+     * @return
+     */
+    iterator end() throw ();
+
+    /**
+     * Returns true if this ArrayListSubList is empty and false otherwise.
+     * This operation is a no-throw.
+     *
+     * @return
+     */
+    bool isEmpty() const throw ();
+
+    /**
+     * Sets the element at the specified index to the provided value. If index
+     * is out of bounds, an std::out_of_range exception is thrown with the index
+     * as its message. This method completes in constant time.
+     * This operation provides no exception safety.
+     *
+     * @param index index of the object to set
+     * @param value the new value
+     */
+    void set(size_t index, const_reference value);
+
+    /**
+     * Return the size of this ArrayListSubList.
+     * This operation is a no-throw.
+     *
+     * @return
+     */
+    size_t size() const throw ();
+
+    /**
+     * Returns a view of the elements of this ArrayListSubList in the range
+     * [from, to). If to is past the end or from is past to, an
+     * std::out_of_range exception is thrown with the offending index as its
+     * message.
+     * This operation provides strong exception safety.
+     *
+     * @param from index of the first element of the view
+     * @param to index one past the last element of the view
+     * @return
+     */
+    ArrayListSubList<T> subList(size_t from, size_t to) throw (std::out_of_range);
+
+    /**
+     * Returns a constant view of the elements of this ArrayListSubList in the
+     * range [from, to). If to is past the end or from is past to, an
+     * std::out_of_range exception is thrown with the offending index as its
+     * message.
+     * This operation provides strong exception safety.
+     *
+     * @param from index of the first element of the view
+     * @param to index one past the last element of the view
+     * @return
+     */
+    ArrayListSubList<const T> subList(size_t from, size_t to) const throw (std::out_of_range);
+
+private:
+
+    friend class ArrayList<value_type>;
+    friend class ArrayListSubList<value_type>;
+
+    /**
+     * A private constructor used by ArrayList::subList and nested views.
+     *
+     * @param data first element of the view
+     * @param size number of elements in the view
+     */
+    ArrayListSubList(T* data, size_t size) throw ();
+
+    /**
+     * Given an index, this method throws an std::out_of_range with the index as
+     * its message if index is out of bounds or is a no-op otherwise.
+     * This operation provides strong exception safety.
+     *
+     * @param index index to check
+     */
+    void rangeCheck(size_t index) const throw (std::out_of_range);
+
+    /**
+     * Throws an std::out_of_range with the offending index as its message if
+     * [from, to) is not a range of this ArrayListSubList.
+     * This operation provides strong exception safety.
+     *
+     * @param from
+     * @param to
+     */
+    void sliceCheck(size_t from, size_t to) const throw (std::out_of_range);
+
+    T* mData;
+    size_t mSize;
+};
+
+#include "../src/ArrayListSubList.cpp"
+
+#endif
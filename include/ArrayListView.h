@@ -0,0 +1,132 @@
+#ifndef _ARRAY_LIST_VIEW_H_
+#define _ARRAY_LIST_VIEW_H_
+
+#include <cstdlib>          // For size_t
+
+// Forward declarations
+template <typename T>
+class ArrayListConstIterator;
+
+namespace std {
+    class out_of_range;
+}
+
+/**
+ * A read-only list over a buffer holding a list in the RAW encoding of
+ * ListFileHeader, as produced by ArrayList::writeTo for trivially copyable
+ * types or kept by a MappedArrayList. Typically the buffer is a memory-mapped
+ * file, in which case the elements are used in place: constructing a view
+ * costs constant time and nothing is copied.
+ *
+ * The view does not own the buffer, which must outlive it and stay unchanged
+ * while it is in use. It offers the constant interface of ArrayList along
+ * with the same STL-style constant random access iterators.
+ */
+template <typename T>
+class ArrayListView {
+public:
+
+    typedef T value_type;
+    typedef const T& reference;
+    typedef const T& const_reference;
+    typedef ArrayListConstIterator<T> iterator;
+    typedef ArrayListConstIterator<T> const_iterator;
+
+    /**
+     * Initializes the view over the list serialized in the length bytes at
+     * buffer. Throws std::runtime_error if the buffer does not hold a RAW
+     * list of this element type, is truncated, or is not suitably aligned.
+     * This operation provides strong exception safety.
+     *
+     * @param buffer start of the serialized list
+     * @param length number of bytes available at buffer
+     */
+    ArrayListView(const void* buffer, size_t length);
+
+    /**
+     * Returns a constant reference to the element stored at the provided index.
+     * If index is out of bounds, an std::out_of_range exception is thrown with
+     * the index as its message.
+     * This operation provides strong exception safety.
+     *
+     * @param index index of the element to return
+     * @return constant reference to the element at the index.
+     */
+    const_reference get(size_t index) const throw (std::out_of_range);
+
+    /**
+     * Returns a constant reference to the element stored at the provided index.
+     * No bounds checking is performed.
+     * This operation is a no-throw.
+     *
+     * @param index index of the element to return
+     * @return constant reference to the element at the index.
+     */
+    const_reference operator[](size_t index) const throw ();
+
+    /**
+     * Returns true if this ArrayListView is logically equal to rhs.
+     *
+     * @param rhs
+     * @return
+     */
+    bool operator==(const ArrayListView<T>& rhs) const;
+
+    /**
+     * Returns false if this ArrayListView is logically equal to rhs.
+     *
+     * @param rhs
+     * @return
+     */
+    bool operator!=(const ArrayListView<T>& rhs) const;
+
+    /**
+     * Returns a constant iterator to the first element.
+     * This operation is a no-throw.
+     *
+     * @return
+     */
+    const_iterator begin() const throw ();
+
+    /**
+     * Returns a constant iterator one past the last element.
+     * This operation is a no-throw.
+     *
+     * @return
+     */
+    const_iterator end() const throw ();
+
+    /**
+     * Returns true if this ArrayListView is empty and false otherwise.
+     * This operation is a no-throw.
+     *
+     * @return
+     */
+    bool isEmpty() const throw ();
+
+    /**
+     * Return the size of this ArrayListView.
+     * This operation is a no-throw.
+     *
+     * @return
+     */
+    size_t size() const throw ();
+
+private:
+
+    /**
+     * Given an index, this method throws an std::out_of_range with the index as
+     * its message if index is out of bounds or is a no-op otherwise.
+     * This operation provides strong exception safety.
+     *
+     * @param index index to check
+     */
+    void rangeCheck(size_t index) const throw (std::out_of_range);
+
+    const T* mData;
+    size_t mSize;
+};
+
+#include "../src/ArrayListView.cpp"
+
+#endif
@@ -0,0 +1,172 @@
+#ifndef _ARRAY_STORAGE_H_
+#define _ARRAY_STORAGE_H_
+
+#include <cstdlib>          // For size_t
+
+/**
+ * Describes where a ScopedArray (and therefore an ArrayList) obtains its
+ * memory from. An ArrayList keeps the storage it was constructed with for all
+ * of its subsequent reallocations.
+ *   - HEAP: the array is allocated with new T[] and released with delete[].
+ *     This is the historical behavior and works for every type.
+ *   - ZEROED: raw zero-filled memory is requested from the system. Small
+ *     blocks come from calloc, while blocks of at least kMapThreshold bytes
+ *     are mapped anonymously so that pages are only committed when first
+ *     written. This backing is only suitable for trivial types whose all-zero
+ *     byte pattern is a valid value.
+ *   - ALIGNED: heap memory aligned to a caller supplied power of two (64 bytes
+ *     for cache lines and SIMD loads by default, or the page size).
+ *   - MAPPED: an anonymous memory mapping, always page aligned and zero
+ *     filled. With HUGE_PAGES the mapping is aligned and sized to huge page
+ *     boundaries and the kernel is advised to back it with transparent huge
+ *     pages, which greatly reduces TLB misses for very large arrays. With
+ *     POPULATE every page is faulted in up front. Growing a mapped array of a
+ *     trivially copyable type remaps it in place instead of copying.
+ *
+ * The MAPPED extras degrade gracefully: if transparent huge pages, prefaulting
+ * or remapping are unavailable on the running system they are skipped and an
+ * ordinary mapping (or an allocate-and-copy growth) is used instead.
+ *
+ * This class only deals in raw bytes; ScopedArray takes care of constructing
+ * and destroying elements for non-HEAP backings.
+ */
+class ArrayStorage {
+public:
+
+    enum Backing {
+        HEAP,
+        ZEROED,
+        ALIGNED,
+        MAPPED
+    };
+
+    /**
+     * Flags for the MAPPED backing.
+     */
+    enum MapFlags {
+        HUGE_PAGES = 1,
+        POPULATE = 2
+    };
+
+    /**
+     * Blocks at least this large are mapped rather than calloc'ed by the
+     * ZEROED backing.
+     */
+    enum { kMapThreshold = 1 << 20 };
+
+    /**
+     * The transparent huge page size assumed for alignment.
+     */
+    enum { kHugePageSize = 2 << 20 };
+
+    /**
+     * Initializes a storage descriptor with the provided backing. Use
+     * aligned() and mapped() to configure the ALIGNED and MAPPED backings.
+     *
+     * @param backing
+     */
+    explicit ArrayStorage(Backing backing = HEAP) : mBacking(backing), mFlags(0), mAlignment(0) {}
+
+    /**
+     * Returns a descriptor for heap memory aligned to alignment bytes, which
+     * must be a power of two.
+     *
+     * @param alignment
+     * @return
+     */
+    static ArrayStorage aligned(size_t alignment = 64);
+
+    /**
+     * Returns a descriptor for anonymous mappings using the provided
+     * combination of MapFlags.
+     *
+     * @param flags
+     * @return
+     */
+    static ArrayStorage mapped(unsigned flags = HUGE_PAGES);
+
+    /**
+     * Returns the backing of this storage.
+     *
+     * @return
+     */
+    Backing backing() const throw () {
+        return mBacking;
+    }
+
+    /**
+     * Returns true if freshly allocated memory is guaranteed to be zero.
+     *
+     * @return
+     */
+    bool zeroFilled() const throw () {
+        return mBacking == ZEROED || mBacking == MAPPED;
+    }
+
+    /**
+     * Allocates bytes bytes of raw memory. A request for zero bytes returns a
+     * null pointer. Throws std::bad_alloc if the memory cannot be obtained.
+     * Must not be called for the HEAP backing.
+     *
+     * @param bytes
+     * @return
+     */
+    void* allocate(size_t bytes) const;
+
+    /**
+     * Attempts to resize a block obtained from allocate(oldBytes) to newBytes
+     * without copying through user space, preserving its contents. Returns
+     * the (possibly moved) block, or a null pointer if this storage cannot
+     * resize in place, in which case the original block is left untouched.
+     * This operation is a no-throw.
+     *
+     * @param ptr
+     * @param oldBytes
+     * @param newBytes
+     * @return
+     */
+    void* reallocate(void* ptr, size_t oldBytes, size_t newBytes) const throw ();
+
+    /**
+     * Releases memory obtained from allocate(bytes) of an equivalent storage.
+     * This operation is a no-throw.
+     *
+     * @param ptr
+     * @param bytes
+     */
+    void deallocate(void* ptr, size_t bytes) const throw ();
+
+private:
+
+    /**
+     * Returns bytes rounded up to the granularity of this MAPPED storage.
+     *
+     * @param bytes
+     * @return
+     */
+    size_t mappedLength(size_t bytes) const throw ();
+
+    /**
+     * Applies the huge page advice to a freshly mapped region.
+     *
+     * @param ptr
+     * @param length
+     */
+    void advise(void* ptr, size_t length) const throw ();
+
+    /**
+     * Faults in every page of a mapped region by writing to it.
+     *
+     * @param ptr
+     * @param length
+     */
+    static void prefault(void* ptr, size_t length) throw ();
+
+    Backing mBacking;
+    unsigned mFlags;
+    size_t mAlignment;
+};
+
+#include "../src/ArrayStorage.cpp"
+
+#endif
@@ -0,0 +1,249 @@
+#ifndef _BLOCKING_QUEUE_H_
+#define _BLOCKING_QUEUE_H_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>          // For size_t
+#include <mutex>
+#include "QueueBase.h"
+#include "StaticQueue.h"
+
+/**
+ * A thread-safe queue on top of any container that QueueAdapter accepts,
+ * whose consumers wait for elements instead of polling for them. A capacity
+ * may be given at construction, in which case producers wait for room as
+ * well.
+ *
+ * The container is guarded by a mutex. A waiting thread first spins for a
+ * short while on an atomic copy of the size, which is enough when the other
+ * side answers quickly, and then parks on a condition variable. Wake-ups are
+ * only signalled when some thread is actually parked, so a queue whose
+ * consumers keep up never pays for a notification.
+ *
+ * close() ends the queue: it wakes every waiting thread, makes further
+ * enqueues throw Closed, and lets consumers drain what is left, after which
+ * the blocking dequeues throw Underflow (or return false or 0) instead of
+ * waiting.
+ *
+ * front() returns a reference into the container, which any later
+ * modification of the queue may invalidate; use tryDequeue() to read the
+ * front element safely while other threads are running.
+ */
+template <typename Container>
+class BlockingQueue final : public QueueBase<typename Container::value_type> {
+public:
+
+    typedef typename Container::value_type value_type;
+
+    /**
+     * An exception class used when an element is added to a closed queue.
+     */
+    class Closed {};
+
+    /**
+     * Initializes an empty, open queue. A capacity of 0 makes the queue
+     * unbounded.
+     *
+     * @param capacity maximum number of elements, or 0 for no limit
+     */
+    explicit BlockingQueue(size_t capacity = 0);
+
+    /**
+     * Removes the front element from this queue, waiting for one if the queue
+     * is empty. Throws Underflow if the queue is closed and empty.
+     */
+    virtual void dequeue();
+
+    /**
+     * Removes the front element and returns it, moved out rather than copied,
+     * waiting for one if the queue is empty. Throws Underflow if the queue is
+     * closed and empty.
+     *
+     * @return
+     */
+    virtual value_type dequeueValue();
+
+    /**
+     * Adds value to the end of this queue, waiting for room if the queue is
+     * full. Throws Closed if the queue is closed.
+     *
+     * @param
+     */
+    virtual void enqueue(const value_type& value);
+
+    /**
+     * Returns a reference to the front of this queue. Throws Underflow if this
+     * queue is empty. The reference is invalidated by any later modification.
+     *
+     * @return
+     */
+    virtual const value_type& front() const;
+
+    /**
+     * Returns the size of this queue.
+     *
+     * @return
+     */
+    virtual size_t size() const;
+
+    /**
+     * Moves the front element into out, removes it and returns true, or
+     * returns false at once if this queue is empty.
+     *
+     * @param out receives the front element
+     * @return
+     */
+    virtual bool tryDequeue(value_type& out);
+
+    /**
+     * Adds the count elements of values to the end of this queue, in order,
+     * waiting for room as needed. Throws Closed if the queue is closed before
+     * all of them are added; the ones added so far stay in the queue.
+     *
+     * @param values elements to enqueue
+     * @param count number of elements to enqueue
+     */
+    virtual void enqueueBulk(const value_type* values, size_t count);
+
+    /**
+     * Moves up to count elements from the front of this queue into out, in
+     * dequeue order, and removes them, without waiting. Returns the number of
+     * elements moved.
+     *
+     * @param out receives the dequeued elements
+     * @param count maximum number of elements to dequeue
+     * @return
+     */
+    virtual size_t dequeueBulk(value_type* out, size_t count);
+
+    /**
+     * Moves the front element into out and removes it, waiting at most
+     * timeout for one to arrive. Returns false if none arrived in time or the
+     * queue is closed and empty.
+     *
+     * @param out receives the front element
+     * @param timeout longest time to wait
+     * @return
+     */
+    template <typename Rep, typename Period>
+    bool dequeueFor(value_type& out, const std::chrono::duration<Rep, Period>& timeout);
+
+    /**
+     * Moves up to max elements from the front of this queue into out, in
+     * dequeue order, and removes them, waiting at most timeout for the first
+     * one. Returns the number of elements moved, which is 0 only if none
+     * arrived in time or the queue is closed and empty.
+     *
+     * @param out receives the dequeued elements
+     * @param max maximum number of elements to dequeue
+     * @param timeout longest time to wait
+     * @return
+     */
+    template <typename Rep, typename Period>
+    size_t dequeueBatch(value_type* out, size_t max, const std::chrono::duration<Rep, Period>& timeout);
+
+    /**
+     * Adds value to the end of this queue and returns true, or returns false
+     * at once if the queue is full. Throws Closed if the queue is closed.
+     *
+     * @param value value to enqueue
+     * @return
+     */
+    bool tryEnqueue(const value_type& value);
+
+    /**
+     * Closes this queue and wakes every waiting thread. Elements already in
+     * the queue can still be dequeued. Closing a closed queue does nothing.
+     */
+    void close();
+
+    /**
+     * Returns true if close() has been called.
+     * This operation is a no-throw.
+     *
+     * @return
+     */
+    bool isClosed() const throw ();
+
+    /**
+     * Returns the maximum number of elements, or 0 if the queue is unbounded.
+     * This operation is a no-throw.
+     *
+     * @return
+     */
+    size_t capacity() const throw ();
+
+private:
+
+    typedef std::chrono::steady_clock Clock;
+
+    BlockingQueue(const BlockingQueue&);
+    void operator=(const BlockingQueue&);
+
+    enum {
+        kSpinCount = 128
+    };
+
+    /**
+     * Spins for a short while until an element is available or the queue is
+     * closed, then takes the lock and parks until then or until deadline, if
+     * one is given. Returns true with the lock held if an element is
+     * available.
+     *
+     * @param lock unlocked lock on mMutex
+     * @param deadline latest time to wait until, or null to wait forever
+     * @return
+     */
+    bool awaitElement(std::unique_lock<std::mutex>& lock, const Clock::time_point* deadline);
+
+    /**
+     * Spins for a short while until there is room or the queue is closed,
+     * then takes the lock and parks until then. Throws Closed if the queue is
+     * closed. Returns with the lock held and room for at least one element.
+     *
+     * @param lock unlocked lock on mMutex
+     */
+    void awaitRoom(std::unique_lock<std::mutex>& lock);
+
+    /**
+     * Publishes the new size after elements were added and wakes a parked
+     * consumer, if any. The lock is released.
+     *
+     * @param lock locked lock on mMutex
+     * @param count number of elements added
+     */
+    void added(std::unique_lock<std::mutex>& lock, size_t count);
+
+    /**
+     * Publishes the new size after elements were removed and wakes parked
+     * producers, if any. The lock is released.
+     *
+     * @param lock locked lock on mMutex
+     * @param count number of elements removed
+     */
+    void removed(std::unique_lock<std::mutex>& lock, size_t count);
+
+    /**
+     * Returns true if no more elements fit. The lock must be held.
+     *
+     * @return
+     */
+    bool isFull() const;
+
+    StaticQueue<Container> mQueue;
+    const size_t mCapacity;
+    mutable std::mutex mMutex;
+    std::condition_variable mNotEmpty;
+    std::condition_variable mNotFull;
+    size_t mConsumersParked;
+    size_t mProducersParked;
+
+    // Written under the lock, read without it while spinning
+    std::atomic<size_t> mSize;
+    std::atomic<bool> mClosed;
+};
+
+#include "../src/BlockingQueue.cpp"
+
+#endif
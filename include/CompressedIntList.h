@@ -0,0 +1,208 @@
+#ifndef _COMPRESSED_INT_LIST_H_
+#define _COMPRESSED_INT_LIST_H_
+
+#include <cstdlib>          // For size_t
+#include <stdint.h>         // For uint64_t, uint8_t
+#include "ArrayList.h"
+
+// Forward declarations
+class CompressedIntListIterator;
+
+namespace std {
+    class out_of_range;
+}
+
+/**
+ * An append-only list of 64-bit unsigned integers stored in compressed form.
+ * Values are appended into an uncompressed tail of kBlockSize elements. A full
+ * tail is sealed, when the next value arrives, into a block using whichever
+ * of the following encodings is smaller:
+ *   - delta: the difference to the previous value, zigzag-mapped and stored as
+ *     a little-endian base 128 varint. Best for monotone-ish sequences.
+ *   - frame of reference: the block minimum is kept in the block header and
+ *     every value is stored as (value - minimum) using just enough bits to
+ *     represent the largest such offset. Best for clustered values and
+ *     permits constant time random access.
+ *
+ * Each sealed block has an entry in a skip index holding its first value,
+ * minimum, encoding, bit width and offset into the shared byte buffer. Since
+ * every block holds exactly kBlockSize values, locating the block of an index
+ * is a constant time division and get(size_t) never decodes more than one
+ * block.
+ *
+ * This class provides a set of STL-style constant forward iterators which
+ * decode a whole block at a time, so sequential scans cost one block decode
+ * per kBlockSize elements. As with the other lists, modifying the list while
+ * iterating over it invalidates all current iterators.
+ */
+class CompressedIntList {
+public:
+
+    typedef uint64_t value_type;
+    typedef CompressedIntListIterator iterator;
+    typedef CompressedIntListIterator const_iterator;
+
+    /**
+     * The number of values sealed together into a single block.
+     */
+    enum { kBlockSize = 128 };
+
+    /**
+     * Initializes an empty CompressedIntList.
+     * This operation provides strong exception safety.
+     */
+    CompressedIntList();
+
+    /**
+     * Adds value to the end of this list. This is a constant time operation
+     * unless the tail block is full, in which case time proportional to
+     * kBlockSize is needed to seal it first.
+     * This operation provides strong exception safety.
+     *
+     * @param value value to append to this list
+     */
+    void add(value_type value);
+
+    /**
+     * Empties this list releasing all of its resources.
+     * This operation is a no-throw.
+     */
+    void clear() throw ();
+
+    /**
+     * Returns the value stored at the provided index. If index is out of
+     * bounds, an std::out_of_range exception is thrown with the index as its
+     * message. Time proportional to kBlockSize is needed in the worst case.
+     * This operation provides strong exception safety.
+     *
+     * @param index index of the element to return
+     * @return the element at the index.
+     */
+    value_type get(size_t index) const throw (std::out_of_range);
+
+    /**
+     * Returns the value stored at the provided index. No range checking is
+     * performed on the index.
+     *
+     * @param index index of the element to return
+     * @return the element at the index.
+     */
+    value_type operator[](size_t index) const throw ();
+
+    /**
+     * Returns true if this list holds the same values as rhs.
+     *
+     * @param rhs
+     * @return
+     */
+    bool operator==(const CompressedIntList& rhs) const;
+
+    /**
+     * Returns false if this list holds the same values as rhs.
+     *
+     * @param rhs
+     * @return
+     */
+    bool operator!=(const CompressedIntList& rhs) const;
+
+    /**
+     * Returns a constant iterator to the beginning.
+     *
+     * @return
+     */
+    const_iterator begin() const;
+
+    /**
+     * Returns a constant iterator to the end.
+     *
+     * @return
+     */
+    const_iterator end() const;
+
+    /**
+     * Returns true if this list is empty and false otherwise.
+     * This operation is a no-throw.
+     *
+     * @return
+     */
+    bool isEmpty() const throw ();
+
+    /**
+     * Return the size of this list.
+     * This operation is a no-throw.
+     *
+     * @return
+     */
+    size_t size() const throw ();
+
+    /**
+     * Returns the number of bytes of encoded payload and skip index currently
+     * in use, excluding the fixed-size tail buffer.
+     * This operation is a no-throw.
+     *
+     * @return
+     */
+    size_t compressedBytes() const throw ();
+
+private:
+
+    friend class CompressedIntListIterator;
+
+    enum Encoding {
+        DELTA_VARINT,
+        FRAME_OF_REFERENCE
+    };
+
+    /**
+     * Skip index entry describing one sealed block.
+     */
+    struct Block {
+        uint64_t mFirst;        // First value of the block
+        uint64_t mMin;          // Frame of reference base
+        size_t mOffset;         // Offset of the payload in mData
+        uint8_t mEncoding;
+        uint8_t mWidth;         // Bits per value for FRAME_OF_REFERENCE
+    };
+
+    /**
+     * Decodes the block with the provided number (the tail being number
+     * mBlocks.size()) into out and returns the number of values written.
+     *
+     * @param blockNum
+     * @param out array of at least kBlockSize elements
+     * @return
+     */
+    size_t decodeBlock(size_t blockNum, value_type* out) const throw ();
+
+    /**
+     * Encodes the full tail buffer into a new block and empties the tail. If
+     * an allocation fails, the bytes already written are dropped again.
+     * This operation provides strong exception safety.
+     */
+    void sealTail();
+
+    /**
+     * Given an index, this method throws an std::out_of_range with the index as
+     * its message if index is out of bounds or is a no-op otherwise.
+     * This operation provides strong exception safety.
+     *
+     * @param index index to check
+     */
+    void rangeCheck(size_t index) const throw (std::out_of_range);
+
+    static uint64_t zigzag(uint64_t delta) throw ();
+    static uint64_t unzigzag(uint64_t code) throw ();
+    static size_t varintLength(uint64_t value) throw ();
+    static uint64_t readVarint(const uint8_t*& ptr) throw ();
+    static uint64_t readBits(const uint8_t* data, size_t bitPos, unsigned width) throw ();
+
+    size_t mSize;
+    ArrayList<Block> mBlocks;
+    ArrayList<uint8_t> mData;
+    size_t mTailSize;
+    value_type mTail[kBlockSize];
+};
+
+#include "../src/CompressedIntList.cpp"
+
+#endif
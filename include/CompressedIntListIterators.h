@@ -0,0 +1,70 @@
+#ifndef _COMPRESSED_INT_LIST_ITERATORS_H_
+#define _COMPRESSED_INT_LIST_ITERATORS_H_
+
+#include <iterator>
+#include "CompressedIntList.h"
+
+/**
+ * A constant forward iterator for the CompressedIntList. The iterator keeps a
+ * decoded copy of the block it is positioned in, so advancing only decodes
+ * when a block boundary is crossed.
+ */
+class CompressedIntListIterator : public std::iterator<std::forward_iterator_tag, uint64_t> {
+private:
+
+    friend class CompressedIntList;
+
+    const CompressedIntList* mList;
+    size_t mIndex;
+    size_t mBlockStart;
+    uint64_t mBuffer[CompressedIntList::kBlockSize];
+
+    /**
+     * A private constructor used in CompressedIntList's begin() and end().
+     *
+     * @param
+     * @param
+     */
+    CompressedIntListIterator(const CompressedIntList* list, size_t index)
+            : mList(list), mIndex(index), mBlockStart(index) {
+        if (mIndex < mList->size())
+            mList->decodeBlock(mIndex / CompressedIntList::kBlockSize, mBuffer);
+    }
+
+public:
+
+    CompressedIntListIterator() : mList(0), mIndex(0), mBlockStart(0) {}
+
+    bool operator==(const CompressedIntListIterator& rhs) const {
+        return mList == rhs.mList && mIndex == rhs.mIndex;
+    }
+
+    bool operator!=(const CompressedIntListIterator& rhs) const {
+        return !(*this == rhs);
+    }
+
+    const uint64_t& operator*() const {
+        return mBuffer[mIndex - mBlockStart];
+    }
+
+    const uint64_t* operator->() const {
+        return &mBuffer[mIndex - mBlockStart];
+    }
+
+    CompressedIntListIterator& operator++() {
+        if (++mIndex - mBlockStart == CompressedIntList::kBlockSize) {
+            mBlockStart = mIndex;
+            if (mIndex < mList->size())
+                mList->decodeBlock(mIndex / CompressedIntList::kBlockSize, mBuffer);
+        }
+        return *this;
+    }
+
+    CompressedIntListIterator operator++(int) {
+        CompressedIntListIterator copy(*this);
+        ++*this;
+        return copy;
+    }
+};
+
+#endif
@@ -0,0 +1,225 @@
+#ifndef _CONCURRENT_STACK_H_
+#define _CONCURRENT_STACK_H_
+
+#include <atomic>
+#include <cstdlib>          // For size_t
+#include <stdint.h>         // For uint32_t, uint64_t
+#include "StackBase.h"
+
+// Forward declarations
+template <typename T>
+class EliminationStack;
+
+/**
+ * A lock-free stack for any number of threads, after R. K. Treiber. push()
+ * and pop() each come down to one compare-and-swap on the head.
+ *
+ * Nodes are never handed back to the allocator while the stack exists.
+ * Popped nodes go to a free list inside the stack, itself a Treiber stack,
+ * and the next push takes its node from there. Fresh nodes are carved from
+ * chunks that double in size. A node is named by a 32-bit index rather than
+ * a pointer, so that the head and the free list can pair it with a 32-bit
+ * tag in a single 64-bit word. Every successful compare-and-swap bumps the
+ * tag, so a thread whose head snapshot went stale because the same node was
+ * popped and pushed back in between (the ABA problem) fails and retries.
+ * Since node memory stays valid and typed, a thread reading the link of a
+ * node that was just popped by another thread reads a stale but harmless
+ * value, which is what hazard pointers or epochs would otherwise have to
+ * guarantee. The price is that the stack keeps its peak number of nodes
+ * until it is destroyed.
+ *
+ * top() returns a reference into the top node, which is only stable while no
+ * other thread pops; concurrent users should call tryPop() or popValue(),
+ * which move the element out. size() and isEmpty() are snapshots. Since the
+ * class is final, calls made through a ConcurrentStack rather than a
+ * StackBase are not virtual.
+ */
+template <typename T>
+class ConcurrentStack final : public StackBase<T> {
+public:
+
+    /**
+     * Initializes an empty stack.
+     */
+    ConcurrentStack();
+
+    /**
+     * Destroys the stack and all of its nodes. No thread may use the stack
+     * any more.
+     */
+    virtual ~ConcurrentStack();
+
+    /**
+     * Removes the top element from this stack. Throws Underflow if this stack
+     * is empty.
+     */
+    virtual void pop();
+
+    /**
+     * Removes the top element and returns it, moved out rather than copied.
+     * Throws Underflow if this stack is empty.
+     *
+     * @return
+     */
+    virtual T popValue();
+
+    /**
+     * Pushes value onto this stack.
+     * This operation provides strong exception safety.
+     *
+     * @param
+     */
+    virtual void push(const T& value);
+
+    /**
+     * Returns the number of elements in this stack.
+     *
+     * @return
+     */
+    virtual size_t size() const;
+
+    /**
+     * Moves the top element into out, removes it and returns true, or returns
+     * false if this stack is empty.
+     *
+     * @param out receives the top element
+     * @return
+     */
+    virtual bool tryPop(T& out);
+
+    /**
+     * Pushes the count elements of values in order, so that the last one ends
+     * on top, with a single compare-and-swap. No other thread's element ends
+     * up in between.
+     * This operation provides strong exception safety.
+     *
+     * @param values elements to push
+     * @param count number of elements to push
+     */
+    virtual void pushBulk(const T* values, size_t count);
+
+    /**
+     * Returns a reference to the top of this stack. Throws Underflow if this
+     * stack is empty. The reference is only stable while no other thread
+     * pops.
+     *
+     * @return
+     */
+    virtual const T& top() const;
+
+private:
+
+    friend class EliminationStack<T>;
+
+    ConcurrentStack(const ConcurrentStack&);
+    void operator=(const ConcurrentStack&);
+
+    enum {
+        kCacheLine = 64,
+        kFirstChunkBits = 6,
+        kFirstChunk = 1 << kFirstChunkBits,
+        kMaxChunks = 32 - kFirstChunkBits
+    };
+
+    struct Node {
+        Node() : mNext(0), mItem() {}
+
+        std::atomic<uint32_t> mNext;
+        T mItem;
+    };
+
+    /**
+     * Returns the node with the given non-zero index.
+     * This operation is a no-throw.
+     *
+     * @param index
+     * @return
+     */
+    Node& node(uint32_t index) const throw ();
+
+    /**
+     * Returns the index of a node holding value, taken from the free list or
+     * carved from a chunk.
+     * This operation provides strong exception safety.
+     *
+     * @param value
+     * @return
+     */
+    uint32_t acquire(const T& value);
+
+    /**
+     * Links the chain first..last, whose last node's link is rewritten, on top
+     * of list with one compare-and-swap.
+     * This operation is a no-throw.
+     *
+     * @param list
+     * @param first
+     * @param last
+     */
+    void pushChain(std::atomic<uint64_t>& list, uint32_t first, uint32_t last) throw ();
+
+    /**
+     * Unlinks and returns the top node index of list, or 0 if list is empty.
+     * This operation is a no-throw.
+     *
+     * @param list
+     * @return
+     */
+    uint32_t popIndex(std::atomic<uint64_t>& list) throw ();
+
+    /**
+     * Makes one attempt at linking the chain first..last on top of list, whose
+     * head was last seen as old. Returns false, with old refreshed, if another
+     * thread changed list in between.
+     * This operation is a no-throw.
+     *
+     * @param list
+     * @param first
+     * @param last
+     * @param old
+     * @return
+     */
+    bool casPush(std::atomic<uint64_t>& list, uint32_t first, uint32_t last, uint64_t& old) throw ();
+
+    /**
+     * Makes one attempt at unlinking the top node of list, whose head was last
+     * seen as old. Returns true with the node's index in index, or 0 if list
+     * is empty, or false, with old refreshed, if another thread changed list
+     * in between.
+     * This operation is a no-throw.
+     *
+     * @param list
+     * @param old
+     * @param index
+     * @return
+     */
+    bool casPop(std::atomic<uint64_t>& list, uint64_t& old, uint32_t& index) throw ();
+
+    /**
+     * Returns a tagged list head holding index, with the tag of old bumped.
+     * This operation is a no-throw.
+     *
+     * @param index
+     * @param old
+     * @return
+     */
+    static uint64_t tagged(uint32_t index, uint64_t old) throw ();
+
+    // Read-mostly: chunk k holds kFirstChunk << k nodes
+    std::atomic<Node*> mChunks[kMaxChunks];
+    char mPad0[kCacheLine];
+
+    std::atomic<uint64_t> mHead;
+    char mPad1[kCacheLine - sizeof(std::atomic<uint64_t>)];
+
+    std::atomic<uint64_t> mFree;
+    std::atomic<uint64_t> mNextIndex;
+    char mPad2[kCacheLine - 2 * sizeof(std::atomic<uint64_t>)];
+
+    std::atomic<size_t> mSize;
+    char mPad3[kCacheLine - sizeof(std::atomic<size_t>)];
+};
+
+#include "../src/ConcurrentStack.cpp"
+
+#endif
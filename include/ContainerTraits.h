@@ -0,0 +1,98 @@
+#ifndef _CONTAINER_TRAITS_H_
+#define _CONTAINER_TRAITS_H_
+
+#include <cstdlib>          // For size_t
+#include <type_traits>      // For std::true_type, std::false_type
+#include <utility>          // For std::declval
+
+/**
+ * Compile-time detection of the optional operations a container may offer on
+ * top of the minimal add/get/remove/size contract. The type member of each
+ * trait is std::true_type if Container has a callable member of that name and
+ * std::false_type otherwise, so the adapters can overload on it and only the
+ * chosen branch is ever instantiated.
+ */
+
+template <typename Container>
+class HasRemoveFirst {
+    template <typename C>
+    static auto check(int) -> decltype(std::declval<C&>().removeFirst(), std::true_type());
+    template <typename C>
+    static std::false_type check(...);
+public:
+    typedef decltype(check<Container>(0)) type;
+};
+
+template <typename Container>
+class HasRemoveLast {
+    template <typename C>
+    static auto check(int) -> decltype(std::declval<C&>().removeLast(), std::true_type());
+    template <typename C>
+    static std::false_type check(...);
+public:
+    typedef decltype(check<Container>(0)) type;
+};
+
+template <typename Container>
+class HasFront {
+    template <typename C>
+    static auto check(int) -> decltype(std::declval<const C&>().front(), std::true_type());
+    template <typename C>
+    static std::false_type check(...);
+public:
+    typedef decltype(check<Container>(0)) type;
+};
+
+template <typename Container>
+class HasBack {
+    template <typename C>
+    static auto check(int) -> decltype(std::declval<const C&>().back(), std::true_type());
+    template <typename C>
+    static std::false_type check(...);
+public:
+    typedef decltype(check<Container>(0)) type;
+};
+
+template <typename Container>
+class HasReserve {
+    template <typename C>
+    static auto check(int) -> decltype(std::declval<C&>().reserve(size_t()), std::true_type());
+    template <typename C>
+    static std::false_type check(...);
+public:
+    typedef decltype(check<Container>(0)) type;
+};
+
+template <typename Container, typename... Args>
+class HasEmplace {
+    template <typename C>
+    static auto check(int) -> decltype(std::declval<C&>().emplace(std::declval<Args>()...), std::true_type());
+    template <typename C>
+    static std::false_type check(...);
+public:
+    typedef decltype(check<Container>(0)) type;
+};
+
+template <typename Container>
+class HasAddAll {
+    template <typename C>
+    static auto check(int) -> decltype(std::declval<C&>().addAll(std::declval<const typename C::value_type*>(),
+                                                                  std::declval<const typename C::value_type*>()),
+                                       std::true_type());
+    template <typename C>
+    static std::false_type check(...);
+public:
+    typedef decltype(check<Container>(0)) type;
+};
+
+template <typename Container>
+class HasRemoveRange {
+    template <typename C>
+    static auto check(int) -> decltype(std::declval<C&>().removeRange(size_t(), size_t()), std::true_type());
+    template <typename C>
+    static std::false_type check(...);
+public:
+    typedef decltype(check<Container>(0)) type;
+};
+
+#endif
@@ -0,0 +1,241 @@
+#ifndef _COW_ARRAY_LIST_H_
+#define _COW_ARRAY_LIST_H_
+
+#include <atomic>
+#include <cstdlib>          // For size_t
+#include "ArrayList.h"
+
+namespace std {
+    class out_of_range;
+}
+
+/**
+ * A copy-on-write list backed by an ArrayList. Copies share a reference
+ * counted buffer, so copy construction and assignment take constant time no
+ * matter how large the list is. The first modification made through a copy
+ * whose buffer is shared clones the buffer; later modifications then run at
+ * ArrayList speed until the list is copied again. unique() tells whether the
+ * next modification will clone.
+ *
+ * The reference count is atomic, so copies of one CowArrayList may be handed
+ * to and used by different threads without further synchronization, exactly
+ * like copies of an std::shared_ptr. A single CowArrayList object is not safe
+ * to modify from several threads at once.
+ *
+ * Only constant access is offered to the elements, so that no reference can
+ * observe a later clone; use set() to modify an element. This class provides
+ * the same STL-style constant random access iterators as ArrayList, which
+ * are invalidated by any modification of the list they were obtained from.
+ */
+template <typename T>
+class CowArrayList {
+public:
+
+    typedef T value_type;
+    typedef const T& reference;
+    typedef const T& const_reference;
+    typedef typename ArrayList<T>::const_iterator iterator;
+    typedef typename ArrayList<T>::const_iterator const_iterator;
+
+    /**
+     * Initializes the CowArrayList with size elements all set to value. If size
+     * is not supplied, an empty CowArrayList is created. If value is not
+     * supplied, the default value for the parametrized type will be used.
+     * This operation provides strong exception safety.
+     *
+     * @param size size of the CowArrayList to create
+     * @param value value used to fill the CowArrayList
+     */
+    explicit CowArrayList(size_t size = 0, const_reference value = value_type());
+
+    /**
+     * Initializes the CowArrayList to share the buffer of src in constant time.
+     * This operation is a no-throw.
+     *
+     * @param src CowArrayList to copy
+     */
+    CowArrayList(const CowArrayList<T>& src) throw ();
+
+    /**
+     * Releases this CowArrayList's share of its buffer, destroying the buffer
+     * if this was the last share.
+     * This operation is a no-throw.
+     */
+    ~CowArrayList() throw ();
+
+    /**
+     * Makes this object share the buffer of rhs in constant time. Note that
+     * calling this method on yourself (a = a;) is equivalent to a no-op.
+     * This operation is a no-throw.
+     *
+     * @param rhs CowArrayList to copy
+     * @return *this, used for chaining.
+     */
+    const CowArrayList<T>& operator=(const CowArrayList<T>& rhs) throw ();
+
+    /**
+     * Adds value to the end of this CowArrayList, cloning a shared buffer
+     * first.
+     * This operation provides strong exception safety.
+     *
+     * @param value value to append to this CowArrayList
+     */
+    void add(const_reference value);
+
+    /**
+     * Inserts value at the specified index, cloning a shared buffer first. All
+     * elements at or to the right of index are shifted down by one spot. If
+     * this CowArrayList needs to be enlarged, default values are used to fill
+     * the gaps.
+     * This operation provides strong exception safety.
+     *
+     * @param index index at which to insert value
+     * @param value the element to insert
+     */
+    void add(size_t index, const_reference value);
+
+    /**
+     * Empties this CowArrayList. A shared buffer is released rather than
+     * cleared.
+     * This operation provides strong exception safety.
+     */
+    void clear();
+
+    /**
+     * Returns a constant reference to the element stored at the provided index.
+     * If index is out of bounds, an std::out_of_range exception is thrown with
+     * the index as its message.
+     * This operation provides strong exception safety.
+     *
+     * @param index index of the element to return
+     * @return constant reference to the element at the index.
+     */
+    const_reference get(size_t index) const throw (std::out_of_range);
+
+    /**
+     * Returns a constant reference to the element stored at the provided index.
+     * No bounds checking is performed.
+     * This operation is a no-throw.
+     *
+     * @param index index of the element to return
+     * @return constant reference to the element at the index.
+     */
+    const_reference operator[](size_t index) const throw ();
+
+    /**
+     * Returns true if this CowArrayList is logically equal to rhs. Lists
+     * sharing a buffer compare equal in constant time.
+     *
+     * @param rhs
+     * @return
+     */
+    bool operator==(const CowArrayList<T>& rhs) const;
+
+    /**
+     * Returns false if this CowArrayList is logically equal to rhs.
+     *
+     * @param rhs
+     * @return
+     */
+    bool operator!=(const CowArrayList<T>& rhs) const;
+
+    /**
+     * Returns a constant iterator to the first element.
+     * This operation is a no-throw.
+     *
+     * @return
+     */
+    const_iterator begin() const throw ();
+
+    /**
+     * Returns a constant iterator one past the last element.
+     * This operation is a no-throw.
+     *
+     * @return
+     */
+    const_iterator end() const throw ();
+
+    /**
+     * Returns true if this CowArrayList is empty and false otherwise.
+     * This operation is a no-throw.
+     *
+     * @return
+     */
+    bool isEmpty() const throw ();
+
+    /**
+     * Removes and returns the element at the specified index, cloning a shared
+     * buffer first. If index is out of bounds, an std::out_of_range exception
+     * is thrown with index as its message.
+     * This operation provides strong exception safety.
+     *
+     * @param index index of the object to remove.
+     * @return copy of the just removed object.
+     */
+    value_type remove(size_t index);
+
+    /**
+     * Sets the element at the specified index to the provided value, cloning a
+     * shared buffer first. If index is out of bounds, an std::out_of_range
+     * exception is thrown with the index as its message.
+     * This operation provides strong exception safety if the buffer had to be
+     * cloned and no exception safety otherwise.
+     *
+     * @param index index of the object to set
+     * @param value the new value
+     */
+    void set(size_t index, const_reference value);
+
+    /**
+     * Return the size of this CowArrayList.
+     * This operation is a no-throw.
+     *
+     * @return
+     */
+    size_t size() const throw ();
+
+    /**
+     * Returns true if no other CowArrayList shares this one's buffer, meaning
+     * the next modification will not clone it.
+     * This operation is a no-throw.
+     *
+     * @return
+     */
+    bool unique() const throw ();
+
+private:
+
+    /**
+     * The shared, reference counted buffer.
+     */
+    struct Buffer {
+        Buffer(const ArrayList<T>& list) : mRefs(1), mList(list) {}
+        Buffer(size_t size, const_reference value) : mRefs(1), mList(size, value) {}
+
+        std::atomic<size_t> mRefs;
+        ArrayList<T> mList;
+    };
+
+    /**
+     * Gives this CowArrayList a buffer of its own, cloning the shared one if
+     * needed, and returns its list.
+     * This operation provides strong exception safety.
+     *
+     * @return
+     */
+    ArrayList<T>& detach();
+
+    /**
+     * Drops one share of buffer, destroying it if that was the last one.
+     * This operation is a no-throw.
+     *
+     * @param buffer
+     */
+    static void release(Buffer* buffer) throw ();
+
+    Buffer* mBuffer;
+};
+
+#include "../src/CowArrayList.cpp"
+
+#endif
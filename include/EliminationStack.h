@@ -0,0 +1,200 @@
+#ifndef _ELIMINATION_STACK_H_
+#define _ELIMINATION_STACK_H_
+
+#include <atomic>
+#include <cstdlib>          // For size_t
+#include <stdint.h>         // For uint32_t, uint64_t
+#include "StackBase.h"
+#include "ConcurrentStack.h"
+#include "ScopedArray.h"
+
+/**
+ * A lock-free stack that stays fast when many threads push and pop at once,
+ * after Hendler, Shavit and Yerushalmi's elimination-backoff stack. It is a
+ * ConcurrentStack with an elimination array in front of it.
+ *
+ * A push followed at once by a pop leaves the stack as it was, so the two
+ * need not touch the shared head at all. Each thread first tries the central
+ * stack once. If its compare-and-swap loses against another thread, it backs
+ * off to a random slot of the elimination array instead of retrying at once.
+ * There a pusher offers its node and waits for a while, and a popper waits
+ * for an offer to appear. A popper that takes an offer owns the node and the
+ * pusher is done. Threads that meet nobody go back to the central stack.
+ *
+ * The array adapts to the contention it sees. A thread that finds its slot
+ * taken by another pusher widens the part of the array in use, and a pusher
+ * that waits in vain narrows it again, so that the remaining threads meet
+ * more often. Successful exchanges lengthen the time threads wait in a slot
+ * and fruitless waits shorten it. Without contention the array is never
+ * touched and the stack costs no more than a ConcurrentStack.
+ *
+ * Elements only travel through the array between a push and a pop that
+ * overlap in time, so the stack stays linearizable. top() has the same
+ * caveats as ConcurrentStack::top().
+ */
+template <typename T>
+class EliminationStack final : public StackBase<T> {
+public:
+
+    /**
+     * Initializes an empty stack whose elimination array has slots slots. If
+     * slots is 0, half the number of hardware threads is used.
+     *
+     * @param slots maximum number of elimination slots
+     */
+    explicit EliminationStack(size_t slots = 0);
+
+    /**
+     * Removes the top element from this stack. Throws Underflow if this stack
+     * is empty.
+     */
+    virtual void pop();
+
+    /**
+     * Removes the top element and returns it, moved out rather than copied.
+     * Throws Underflow if this stack is empty.
+     *
+     * @return
+     */
+    virtual T popValue();
+
+    /**
+     * Pushes value onto this stack.
+     * This operation provides strong exception safety.
+     *
+     * @param
+     */
+    virtual void push(const T& value);
+
+    /**
+     * Returns the number of elements in this stack.
+     *
+     * @return
+     */
+    virtual size_t size() const;
+
+    /**
+     * Moves the top element into out, removes it and returns true, or returns
+     * false if this stack is empty.
+     *
+     * @param out receives the top element
+     * @return
+     */
+    virtual bool tryPop(T& out);
+
+    /**
+     * Pushes the count elements of values in order, so that the last one ends
+     * on top. The batch goes to the central stack with a single
+     * compare-and-swap and is never eliminated.
+     * This operation provides strong exception safety.
+     *
+     * @param values elements to push
+     * @param count number of elements to push
+     */
+    virtual void pushBulk(const T* values, size_t count);
+
+    /**
+     * Returns a reference to the top of this stack. Throws Underflow if this
+     * stack is empty. The reference is only stable while no other thread
+     * pops.
+     *
+     * @return
+     */
+    virtual const T& top() const;
+
+private:
+
+    EliminationStack(const EliminationStack&);
+    void operator=(const EliminationStack&);
+
+    enum {
+        kCacheLine = 64,
+        kMaxSlots = 64,
+        kMinWait = 16,
+        kMaxWait = 4096
+    };
+
+    // Slot states; an offer is the offered node index shifted left by one
+    enum {
+        kEmpty = 0,
+        kTaken = 1
+    };
+
+    struct Slot {
+        Slot() : mState(kEmpty) {}
+
+        std::atomic<uint64_t> mState;
+        char mPad[kCacheLine - sizeof(std::atomic<uint64_t>)];
+    };
+
+    /**
+     * Unlinks the top node, from the central stack or from a pusher met in
+     * the elimination array, and returns its index, or 0 if the stack is
+     * empty.
+     * This operation is a no-throw.
+     *
+     * @return
+     */
+    uint32_t popNode() throw ();
+
+    /**
+     * Offers node index in a random slot of the elimination array and waits
+     * for a popper to take it. Returns true if one did.
+     * This operation is a no-throw.
+     *
+     * @param index
+     * @return
+     */
+    bool offer(uint32_t index) throw ();
+
+    /**
+     * Waits in a random slot of the elimination array for a pusher's offer.
+     * Returns the offered node index, or 0 if none came.
+     * This operation is a no-throw.
+     *
+     * @return
+     */
+    uint32_t take() throw ();
+
+    /**
+     * Returns a slot picked at random among the ones in use.
+     * This operation is a no-throw.
+     *
+     * @return
+     */
+    Slot& randomSlot() throw ();
+
+    /**
+     * Records the outcome of a visit to the elimination array, adapting the
+     * slot range and the waiting time to it.
+     * This operation is a no-throw.
+     *
+     * @param exchanged true if the visit met a partner
+     * @param crowded true if the slot was held by another thread of the same kind
+     */
+    void adapt(bool exchanged, bool crowded) throw ();
+
+    /**
+     * Returns the number of slots to use when slots were asked for: at least
+     * 1 and at most kMaxSlots, with 0 meaning half the hardware threads.
+     * This operation is a no-throw.
+     *
+     * @param slots
+     * @return
+     */
+    static size_t slotCount(size_t slots) throw ();
+
+    ConcurrentStack<T> mStack;
+    ScopedArray<Slot> mSlots;
+    size_t mSlotCount;
+    char mPad0[kCacheLine];
+
+    // Contention estimates, updated racily
+    std::atomic<size_t> mRange;
+    std::atomic<unsigned> mWait;
+    char mPad1[kCacheLine - sizeof(std::atomic<size_t>) - sizeof(std::atomic<unsigned>)];
+};
+
+#include "../src/EliminationStack.cpp"
+
+#endif
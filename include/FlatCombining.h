@@ -0,0 +1,233 @@
+#ifndef _FLAT_COMBINING_H_
+#define _FLAT_COMBINING_H_
+
+#include <atomic>
+#include <cstdlib>          // For size_t
+#include <exception>        // For std::exception_ptr
+#include <type_traits>      // For std::true_type, std::false_type
+#include "ScopedArray.h"
+#include "StackBase.h"
+#include "QueueBase.h"
+
+/**
+ * Makes a sequential StackAdapter or QueueAdapter safe to share between
+ * threads by flat combining, after Hendler, Incze, Shavit and Tzafrir.
+ *
+ * A thread does not lock the adapter itself. It writes its request into a
+ * slot of a publication array and then either waits for the request to be
+ * marked done, or takes the combiner lock if it is free. The combiner
+ * applies every pending request in one pass over the array, with the
+ * adapter's data hot in its own cache, and hands each requester its result.
+ * Under contention one lock acquisition thus serves many operations, and
+ * the combiner can batch them: the room needed by all pending additions is
+ * reserved once before any of them is applied.
+ *
+ * add() and tryRemove() map to push()/tryPop() for stacks and to
+ * enqueue()/tryDequeue() for queues. apply() runs any function on the
+ * adapter as one request, which gives access to the rest of its interface.
+ * An exception thrown while applying a request is rethrown in the thread
+ * that made it.
+ *
+ * Slots are claimed per request rather than per thread, so any number of
+ * threads may use the wrapper; when there are more threads than slots they
+ * wait for a free slot.
+ */
+template <typename Adapter>
+class FlatCombining {
+public:
+
+    typedef typename Adapter::value_type value_type;
+
+    /**
+     * Initializes a wrapper around a default constructed adapter with slots
+     * publication slots. If slots is 0, two per hardware thread are used.
+     *
+     * @param slots number of publication slots
+     */
+    explicit FlatCombining(size_t slots = 0);
+
+    /**
+     * Adds value to the adapter: pushes it onto a stack or enqueues it at the
+     * end of a queue.
+     * This operation provides strong exception safety.
+     *
+     * @param value value to add
+     */
+    void add(const value_type& value);
+
+    /**
+     * Moves the next element out of the adapter, the top of a stack or the
+     * front of a queue, into out and returns true, or returns false if the
+     * adapter is empty.
+     *
+     * @param out receives the element
+     * @return
+     */
+    bool tryRemove(value_type& out);
+
+    /**
+     * Calls function(adapter) as one request, with no other request applied
+     * at the same time. References into the adapter must not escape
+     * function.
+     *
+     * @param function function object taking an Adapter&
+     */
+    template <typename Function>
+    void apply(Function function);
+
+    /**
+     * Returns the number of elements in the adapter.
+     *
+     * @return
+     */
+    size_t size();
+
+    /**
+     * Returns the number of publication slots.
+     * This operation is a no-throw.
+     *
+     * @return
+     */
+    size_t slotCount() const throw ();
+
+private:
+
+    FlatCombining(const FlatCombining&);
+    void operator=(const FlatCombining&);
+
+    enum {
+        kCacheLine = 64,
+        kMaxSlots = 256,
+        kSpinCount = 64
+    };
+
+    // Slot states
+    enum {
+        kFree,
+        kClaimed,
+        kPending,
+        kDone
+    };
+
+    // Requests
+    enum Operation {
+        kAdd,
+        kRemove,
+        kApply
+    };
+
+    struct Slot {
+        Slot() : mState(kFree), mOperation(kAdd), mValue(0), mOut(0), mApply(0), mContext(0), mResult(false) {}
+
+        std::atomic<unsigned> mState;
+        Operation mOperation;
+        const value_type* mValue;
+        value_type* mOut;
+        void (*mApply)(void*, Adapter&);
+        void* mContext;
+        bool mResult;
+        std::exception_ptr mError;
+        char mPad[kCacheLine];
+    };
+
+    typedef typename std::is_base_of<StackBase<value_type>, Adapter>::type IsStack;
+
+    /**
+     * Claims a free slot for the calling thread, waiting for one if needed.
+     *
+     * @return
+     */
+    Slot& claim();
+
+    /**
+     * Publishes the request written into slot, waits until it is done,
+     * combining if the lock is free, and releases the slot. Rethrows the
+     * exception the request threw, if any; otherwise returns its result.
+     *
+     * @param slot
+     * @return
+     */
+    bool perform(Slot& slot);
+
+    /**
+     * Applies every pending request. The combiner lock must be held.
+     */
+    void combine();
+
+    /**
+     * Applies the request in slot, recording its result or exception.
+     *
+     * @param slot
+     */
+    void execute(Slot& slot);
+
+    /**
+     * Adds value to a stack.
+     *
+     * @param value
+     */
+    void doAdd(const value_type& value, std::true_type);
+
+    /**
+     * Adds value to a queue.
+     *
+     * @param value
+     */
+    void doAdd(const value_type& value, std::false_type);
+
+    /**
+     * Removes the top of a stack into out.
+     *
+     * @param out
+     * @return
+     */
+    bool doRemove(value_type& out, std::true_type);
+
+    /**
+     * Removes the front of a queue into out.
+     *
+     * @param out
+     * @return
+     */
+    bool doRemove(value_type& out, std::false_type);
+
+    /**
+     * Calls the function object of type Function at context on adapter.
+     *
+     * @param context
+     * @param adapter
+     */
+    template <typename Function>
+    static void invoke(void* context, Adapter& adapter);
+
+    /**
+     * Returns the number of slots to use when slots were asked for.
+     * This operation is a no-throw.
+     *
+     * @param slots
+     * @return
+     */
+    static size_t slotsFor(size_t slots) throw ();
+
+    /**
+     * Returns the slot the calling thread starts looking from.
+     * This operation is a no-throw.
+     *
+     * @return
+     */
+    size_t homeSlot() const throw ();
+
+    ScopedArray<Slot> mSlots;
+    size_t mSlotCount;
+    char mPad0[kCacheLine];
+
+    std::atomic<bool> mLocked;
+    char mPad1[kCacheLine - sizeof(std::atomic<bool>)];
+
+    // Only touched by the combiner
+    Adapter mAdapter;
+};
+
+#include "../src/FlatCombining.cpp"
+
+#endif
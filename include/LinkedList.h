@@ -2,6 +2,7 @@
 #define _LINKED_LIST_H_
 
 #include <cstdlib>          // For size_t
+#include <iosfwd>           // For std::ostream, std::istream
 #include <memory>
 
 // Forward declarations
@@ -14,6 +15,12 @@ class LinkedListConstIterator;
 template <typename T>
 class LinkedListNode;
 
+template <typename T>
+class LinkedListSubList;
+
+class ListWriter;
+class ListReader;
+
 namespace std {
     class out_of_range;
 }
@@ -114,6 +121,17 @@ public:
      */
     void add(size_t index, const_reference value);
 
+    /**
+     * Adds the elements of the range [first, last) to the end of this
+     * LinkedList. The nodes are built on the side and spliced in at once.
+     * This operation provides strong exception safety.
+     *
+     * @param first iterator to the first element to append
+     * @param last iterator one past the last element to append
+     */
+    template <typename InputIterator>
+    void addAll(InputIterator first, InputIterator last);
+
     /**
      * Empties this LinkedList returning it to the same state as the default
      * constructor.
@@ -144,6 +162,46 @@ public:
      */
     reference get(size_t index) throw (std::out_of_range);
 
+    /**
+     * Returns a constant reference to the first element in constant time. If
+     * this LinkedList is empty, an std::out_of_range exception is thrown with 0
+     * as its message.
+     * This operation provides strong exception safety.
+     *
+     * @return constant reference to the first element.
+     */
+    const_reference front() const throw (std::out_of_range);
+
+    /**
+     * Returns a reference to the first element in constant time. If this
+     * LinkedList is empty, an std::out_of_range exception is thrown with 0 as
+     * its message.
+     * This operation provides strong exception safety.
+     *
+     * @return reference to the first element.
+     */
+    reference front() throw (std::out_of_range);
+
+    /**
+     * Returns a constant reference to the last element in constant time. If
+     * this LinkedList is empty, an std::out_of_range exception is thrown with 0
+     * as its message.
+     * This operation provides strong exception safety.
+     *
+     * @return constant reference to the last element.
+     */
+    const_reference back() const throw (std::out_of_range);
+
+    /**
+     * Returns a reference to the last element in constant time. If this
+     * LinkedList is empty, an std::out_of_range exception is thrown with 0 as
+     * its message.
+     * This operation provides strong exception safety.
+     *
+     * @return reference to the last element.
+     */
+    reference back() throw (std::out_of_range);
+
     /**
      * Returns true if this LinkedList is equal to rhs and false otherwise.
      * This operation provides strong exception safety.
@@ -214,6 +272,22 @@ public:
      */
     void remove(size_t index) throw (std::out_of_range);
 
+    /**
+     * Removes the first element in constant time. If this LinkedList is empty,
+     * an std::out_of_range exception is thrown with 0 as its message.
+     * This operation is no-throw under the assumption that the parametrizing
+     * type's destructor is no-throw.
+     */
+    void removeFirst() throw (std::out_of_range);
+
+    /**
+     * Removes the last element in constant time. If this LinkedList is empty,
+     * an std::out_of_range exception is thrown with 0 as its message.
+     * This operation is no-throw under the assumption that the parametrizing
+     * type's destructor is no-throw.
+     */
+    void removeLast() throw (std::out_of_range);
+
     /**
      * Sets the element at the specified index to the provided value. If index
      * is out of bounds, an std::out_of_range exception is thrown with the index
@@ -234,6 +308,70 @@ public:
      */
     size_t size() const throw ();
 
+    /**
+     * Returns a view of the elements of this LinkedList in the range
+     * [from, to). Creating the view takes time proportional to to, after
+     * which it shares the nodes of this LinkedList. If to is past the end or
+     * from is past to, an std::out_of_range exception is thrown with the
+     * offending index as its message.
+     * This operation provides strong exception safety.
+     *
+     * @param from index of the first element of the view
+     * @param to index one past the last element of the view
+     * @return
+     */
+    LinkedListSubList<T> subList(size_t from, size_t to) throw (std::out_of_range);
+
+    /**
+     * Returns a constant view of the elements of this LinkedList in the range
+     * [from, to). If to is past the end or from is past to, an
+     * std::out_of_range exception is thrown with the offending index as its
+     * message.
+     * This operation provides strong exception safety.
+     *
+     * @param from index of the first element of the view
+     * @param to index one past the last element of the view
+     * @return
+     */
+    LinkedListSubList<const T> subList(size_t from, size_t to) const throw (std::out_of_range);
+
+    /**
+     * Writes this LinkedList to the file descriptor fd in the versioned binary
+     * format described by ListFileHeader. The elements are streamed one by one
+     * through their Serializer. Throws std::system_error if writing fails.
+     *
+     * @param fd file descriptor to write to
+     */
+    void writeTo(int fd) const;
+
+    /**
+     * Writes this LinkedList to os in the versioned binary format described by
+     * ListFileHeader. Throws std::ios_base::failure if writing fails.
+     *
+     * @param os stream to write to
+     */
+    void writeTo(std::ostream& os) const;
+
+    /**
+     * Replaces the contents of this LinkedList with a list read from the file
+     * descriptor fd, as written by writeTo. Throws std::runtime_error if the
+     * data is truncated or was written for another element type.
+     * This operation provides strong exception safety.
+     *
+     * @param fd file descriptor to read from
+     */
+    void readFrom(int fd);
+
+    /**
+     * Replaces the contents of this LinkedList with a list read from is, as
+     * written by writeTo. Throws std::runtime_error if the data is truncated
+     * or was written for another element type.
+     * This operation provides strong exception safety.
+     *
+     * @param is stream to read from
+     */
+    void readFrom(std::istream& is);
+
 private:
 
     /**
@@ -254,6 +392,31 @@ private:
      */
     void removeNode(iterator iter) throw ();
 
+    /**
+     * Throws an std::out_of_range with the offending index as its message if
+     * [from, to) is not a range of this LinkedList.
+     * This operation provides strong exception safety.
+     *
+     * @param from
+     * @param to
+     */
+    void sliceCheck(size_t from, size_t to) const throw (std::out_of_range);
+
+    /**
+     * Writes the header and elements to out.
+     *
+     * @param out
+     */
+    void serialize(ListWriter& out) const;
+
+    /**
+     * Replaces the contents with the header and elements read from in.
+     * This operation provides strong exception safety.
+     *
+     * @param in
+     */
+    void deserialize(ListReader& in);
+
     /**
      * Swaps the contents of this LinkedList with that of other in constant time.
      * This operation is a no-throw.
@@ -315,6 +478,8 @@ private:
     friend class LinkedList<T>;
     friend class LinkedListIterator<T>;
     friend class LinkedListConstIterator<T>;
+    friend class LinkedListSubList<T>;
+    friend class LinkedListSubList<const T>;
 
     /**
      * Initializes this node with the provided values. The nodes pointed to
@@ -9,6 +9,7 @@ class LinkedListIterator : public std::iterator<std::forward_iterator_tag, T> {
 private:
 
     friend class LinkedList<T>;
+    friend class LinkedListSubList<T>;
     LinkedListNode<T>* mPtr;
 
     explicit LinkedListIterator(LinkedListNode<T>* ptr) : mPtr(ptr) {}
@@ -58,6 +59,8 @@ class LinkedListConstIterator : public std::iterator<std::forward_iterator_tag,
 private:
 
     friend class LinkedList<T>;
+    friend class LinkedListSubList<T>;
+    friend class LinkedListSubList<const T>;
     LinkedListNode<T>* mPtr;
 
     explicit LinkedListConstIterator(LinkedListNode<T>* ptr) : mPtr(ptr) {}
@@ -0,0 +1,228 @@
+#ifndef _LINKED_LIST_SUB_LIST_H_
+#define _LINKED_LIST_SUB_LIST_H_
+
+#include <cstdlib>          // For size_t
+#include <type_traits>      // For std::remove_const, std::conditional, std::enable_if
+
+// Forward declarations
+template <typename T>
+class LinkedList;
+
+template <typename T>
+class LinkedListNode;
+
+template <typename T>
+class LinkedListIterator;
+
+template <typename T>
+class LinkedListConstIterator;
+
+namespace std {
+    class out_of_range;
+}
+
+/**
+ * A non-owning view of a range of a LinkedList, as returned by
+ * LinkedList::subList. The view holds the first node of the range, the node
+ * one past its end and the size of the range, so copying it costs constant
+ * time and nothing is allocated. Reads and writes through the view go
+ * straight to the nodes of the underlying LinkedList. The view has a fixed
+ * size since it cannot add or remove elements of the list it views.
+ *
+ * A view of a constant LinkedList is parametrized by a const type, in which
+ * case only the constant interface is available.
+ *
+ * The view is invalidated by removing any node of the range or its end
+ * node from the underlying LinkedList, and inserting into the range makes
+ * the cached size stale. It provides the same STL-style forward iterators as
+ * LinkedList.
+ */
+template <typename T>
+class LinkedListSubList {
+public:
+
+    typedef typename std::remove_const<T>::type value_type;
+    typedef T& reference;
+    typedef const value_type& const_reference;
+    typedef typename std::conditional<std::is_const<T>::value,
+                                      LinkedListConstIterator<value_type>,
+                                      LinkedListIterator<value_type> >::type iterator;
+    typedef LinkedListConstIterator<value_type> const_iterator;
+
+    /**
+     * Returns a constant reference to the element stored at the provided index.
+     * If index is out of bounds, an std::out_of_range exception is thrown with
+     * the index as its message. Time proportional to index is needed.
+     * This operation provides strong exception safety.
+     *
+     * @param index index of the element to return
+     * @return constant reference to the element at the index.
+     */
+    const_reference get(size_t index) const throw (std::out_of_range);
+
+    /**
+     * Returns a reference to the element stored at the provided index.
+     * If index is out of bounds, an std::out_of_range exception is thrown with
+     * the index as its message. Time proportional to index is needed.
+     * This operation provides strong exception safety.
+     *
+     * @param index index of the element to return
+     * @return reference to the element at the index.
+     */
+    reference get(size_t index) throw (std::out_of_range);
+
+    /**
+     * Returns true if this LinkedListSubList is logically equal to rhs.
+     *
+     * @param rhs
+     * @return
+     */
+    bool operator==(const LinkedListSubList<T>& rhs) const;
+
+    /**
+     * Returns false if this LinkedListSubList is logically equal to rhs.
+     *
+     * @param rhs
+     * @return
+     */
+    bool operator!=(const LinkedListSubList<T>& rhs) const;
+
+    /**
+     * Returns a constant iterator to the first element.
+     * This operation is a no-throw.
+     *
+     * @return
+     */
+    const_iterator begin() const throw ();
+
+    /**
+     * Returns an iterator to the first element.
+     * This operation is a no-throw.
+     *
+     * @return
+     */
+    iterator begin() throw ();
+
+    /**
+     * Returns a constant iterator one past the last element.
+     * This operation is a no-throw.
+     *
+     * @return
+     */
+    const_iterator end() const throw ();
+
+    /**
+     * Returns an iterator one past the last element.
+     * This operation is a no-throw.
+     *
+     * @return
+     */
+    iterator end() throw ();
+
+    /**
+     * Returns true if this LinkedListSubList is empty and false otherwise.
+     * This operation is a no-throw.
+     *
+     * @return
+     */
+    bool isEmpty() const throw ();
+
+    /**
+     * Sets the element at the specified index to the provided value. If index
+     * is out of bounds, an std::out_of_range exception is thrown with the index
+     * as its message. Time proportional to index is needed. Views of a
+     * constant LinkedList do not have this method.
+     * This operation provides no exception safety.
+     *
+     * @param index index of the object to set
+     * @param value the new value
+     */
+    template <typename U = T>
+    typename std::enable_if<!std::is_const<U>::value>::type set(size_t index, const_reference value);
+
+    /**
+     * Return the size of this LinkedListSubList.
+     * This operation is a no-throw.
+     *
+     * @return
+     */
+    size_t size() const throw ();
+
+    /**
+     * Returns a view of the elements of this LinkedListSubList in the range
+     * [from, to). Creating the view takes time proportional to to. If to is
+     * past the end or from is past to, an std::out_of_range exception is
+     * thrown with the offending index as its message.
+     * This operation provides strong exception safety.
+     *
+     * @param from index of the first element of the view
+     * @param to index one past the last element of the view
+     * @return
+     */
+    LinkedListSubList<T> subList(size_t from, size_t to) throw (std::out_of_range);
+
+    /**
+     * Returns a constant view of the elements of this LinkedListSubList in
+     * the range [from, to). If to is past the end or from is past to, an
+     * std::out_of_range exception is thrown with the offending index as its
+     * message.
+     * This operation provides strong exception safety.
+     *
+     * @param from index of the first element of the view
+     * @param to index one past the last element of the view
+     * @return
+     */
+    LinkedListSubList<const T> subList(size_t from, size_t to) const throw (std::out_of_range);
+
+private:
+
+    typedef LinkedListNode<value_type> Node;
+
+    friend class LinkedList<value_type>;
+    friend class LinkedListSubList<value_type>;
+
+    /**
+     * A private constructor used by LinkedList::subList and nested views.
+     *
+     * @param first first node of the view
+     * @param end node one past the last node of the view
+     * @param size number of nodes in the view
+     */
+    LinkedListSubList(Node* first, Node* end, size_t size) throw ();
+
+    /**
+     * Returns the node index positions after the first one of this view.
+     * This operation is a no-throw.
+     *
+     * @param index
+     * @return
+     */
+    Node* nodeAt(size_t index) const throw ();
+
+    /**
+     * Given an index, this method throws an std::out_of_range with the index as
+     * its message if index is out of bounds or is a no-op otherwise.
+     * This operation provides strong exception safety.
+     *
+     * @param index index to check
+     */
+    void rangeCheck(size_t index) const throw (std::out_of_range);
+
+    /**
+     * Throws an std::out_of_range with the offending index as its message if
+     * [from, to) is not a range of this LinkedListSubList.
+     * This operation provides strong exception safety.
+     *
+     * @param from
+     * @param to
+     */
+    void sliceCheck(size_t from, size_t to) const throw (std::out_of_range);
+
+    Node* mFirst;
+    Node* mEnd;
+    size_t mSize;
+};
+
+#include "../src/LinkedListSubList.cpp"
+
+#endif
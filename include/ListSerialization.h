@@ -0,0 +1,231 @@
+#ifndef _LIST_SERIALIZATION_H_
+#define _LIST_SERIALIZATION_H_
+
+#include <cstdlib>          // For size_t
+#include <iosfwd>           // For std::ostream, std::istream
+#include <stdint.h>         // For uint32_t, uint64_t
+#include <string>
+
+/**
+ * The fixed-size record that starts every serialized list, whether it was
+ * written by ArrayList::writeTo, LinkedList::writeTo or lives in the file of
+ * a MappedArrayList. Its 64 bytes keep the elements that follow aligned for
+ * any fundamental type. Everything is stored in native layout and byte order.
+ *
+ * With the RAW encoding the elements are stored back to back as their object
+ * representation, so the data can be used in place (see ArrayListView). The
+ * STREAM encoding is used for types that are not trivially copyable; each
+ * element is then written by its Serializer.
+ */
+struct ListFileHeader {
+
+    enum Encoding {
+        RAW = 0,
+        STREAM = 1
+    };
+
+    enum { kVersion = 1 };
+
+    /**
+     * Fills in the header for size elements of elementSize bytes each, with
+     * room for capacity elements after it.
+     * This operation is a no-throw.
+     *
+     * @param elementSize
+     * @param size
+     * @param capacity
+     * @param encoding
+     */
+    void init(size_t elementSize, size_t size, size_t capacity, Encoding encoding) throw ();
+
+    /**
+     * Returns true if this header was written by a compatible version for
+     * elements of elementSize bytes with the provided encoding, and its
+     * capacity in bytes fits in a size_t.
+     * This operation is a no-throw.
+     *
+     * @param elementSize
+     * @param encoding
+     * @return
+     */
+    bool valid(size_t elementSize, Encoding encoding) const throw ();
+
+    char mMagic[8];
+    uint32_t mVersion;
+    uint32_t mElementSize;
+    uint64_t mSize;
+    uint64_t mCapacity;
+    uint32_t mEncoding;
+    char mReserved[28];
+};
+
+/**
+ * Buffered output to either a file descriptor or an std::ostream. Errors on
+ * a file descriptor are reported through std::system_error and errors on a
+ * stream through std::ios_base::failure. Nothing is guaranteed to have been
+ * written until flush() returns.
+ */
+class ListWriter {
+public:
+
+    /**
+     * Initializes a writer appending to the file descriptor fd.
+     *
+     * @param fd
+     */
+    explicit ListWriter(int fd);
+
+    /**
+     * Initializes a writer appending to the stream os.
+     *
+     * @param os
+     */
+    explicit ListWriter(std::ostream& os);
+
+    /**
+     * Writes count bytes. Large blocks bypass the buffer.
+     *
+     * @param bytes
+     * @param count
+     */
+    void write(const void* bytes, size_t count);
+
+    /**
+     * Writes out everything buffered so far.
+     */
+    void flush();
+
+private:
+
+    enum { kBufferSize = 1 << 16 };
+
+    ListWriter(const ListWriter&);
+    void operator=(const ListWriter&);
+
+    /**
+     * Writes count bytes straight to the destination.
+     *
+     * @param bytes
+     * @param count
+     */
+    void writeOut(const char* bytes, size_t count);
+
+    int mFd;
+    std::ostream* mStream;
+    size_t mUsed;
+    char mBuffer[kBufferSize];
+};
+
+/**
+ * Buffered input from either a file descriptor or an std::istream. Running
+ * out of data before a read is satisfied throws std::runtime_error; other
+ * errors are reported like for ListWriter. A file descriptor is read ahead
+ * in blocks; finish() seeks back over whatever was read ahead, which only
+ * works for seekable descriptors.
+ */
+class ListReader {
+public:
+
+    /**
+     * Initializes a reader consuming the file descriptor fd.
+     *
+     * @param fd
+     */
+    explicit ListReader(int fd);
+
+    /**
+     * Initializes a reader consuming the stream is.
+     *
+     * @param is
+     */
+    explicit ListReader(std::istream& is);
+
+    /**
+     * Reads exactly count bytes into bytes. Large blocks bypass the buffer.
+     *
+     * @param bytes
+     * @param count
+     */
+    void read(void* bytes, size_t count);
+
+    /**
+     * Returns the unconsumed read ahead to the file descriptor.
+     * This operation is a no-throw.
+     */
+    void finish() throw ();
+
+private:
+
+    enum { kBufferSize = 1 << 16 };
+
+    ListReader(const ListReader&);
+    void operator=(const ListReader&);
+
+    /**
+     * Reads up to count bytes straight from the source, returning how many
+     * were read. Zero means the end of the data.
+     *
+     * @param bytes
+     * @param count
+     * @return
+     */
+    size_t readIn(char* bytes, size_t count);
+
+    int mFd;
+    std::istream* mStream;
+    size_t mStart;
+    size_t mEnd;
+    char mBuffer[kBufferSize];
+};
+
+/**
+ * Encodes single elements for the STREAM encoding and for LinkedList. The
+ * default writes the object representation and thus only supports trivially
+ * copyable types; specialize it to serialize other types.
+ */
+template <typename T>
+struct Serializer {
+
+    /**
+     * Writes value to out.
+     *
+     * @param out
+     * @param value
+     */
+    static void write(ListWriter& out, const T& value);
+
+    /**
+     * Reads value back from in.
+     *
+     * @param in
+     * @param value
+     */
+    static void read(ListReader& in, T& value);
+};
+
+/**
+ * Strings are written as a 64-bit length followed by their characters.
+ */
+template <>
+struct Serializer<std::string> {
+
+    /**
+     * Writes value to out.
+     *
+     * @param out
+     * @param value
+     */
+    static void write(ListWriter& out, const std::string& value);
+
+    /**
+     * Reads value back from in.
+     *
+     * @param in
+     * @param value
+     */
+    static void read(ListReader& in, std::string& value);
+};
+
+#include "../src/ListSerialization.cpp"
+
+#endif
@@ -0,0 +1,297 @@
+#ifndef _MAPPED_ARRAY_LIST_H_
+#define _MAPPED_ARRAY_LIST_H_
+
+#include <cstdlib>          // For size_t
+#include <string>
+#include "ListSerialization.h"
+
+// Forward declarations
+template <typename T>
+class ArrayListIterator;
+
+template <typename T>
+class ArrayListConstIterator;
+
+namespace std {
+    class out_of_range;
+}
+
+/**
+ * An array-backed list whose storage is a memory-mapped file. The file starts
+ * with a ListFileHeader holding the size and capacity of the list, followed by
+ * the elements in native layout and byte order (the RAW encoding, which an
+ * ArrayListView can also read). Since the list lives directly
+ * in the mapping, opening an existing file attaches to it instantly without
+ * any deserialization, and several processes mapping the same file share a
+ * single copy of it in the page cache.
+ *
+ * Only trivially copyable types may be stored, as elements are moved around
+ * with memmove and reinterpreted straight from the file. Such a type never
+ * throws while being copied, so the exception guarantees below only concern
+ * failures of the underlying system calls, which are reported through
+ * std::system_error. A file written by a different element type or file
+ * format version is rejected with std::runtime_error.
+ *
+ * Modifications reach the file through the shared mapping, but the kernel
+ * writes them back at its own pace; call sync() to make them durable. Growing
+ * the list enlarges the file with ftruncate and remaps it, in place where
+ * possible (mremap on Linux), using the same doubling policy as ArrayList.
+ * Concurrent modification from several processes is not synchronized.
+ *
+ * This class provides the same STL-style random access iterators as
+ * ArrayList. Growing the list may move the mapping and thus invalidates all
+ * current iterators and references.
+ */
+template <typename T>
+class MappedArrayList {
+public:
+
+    typedef T value_type;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef ArrayListIterator<T> iterator;
+    typedef ArrayListConstIterator<T> const_iterator;
+
+    /**
+     * Opens the list stored in the file at path, creating an empty one if the
+     * file does not exist or is empty. Throws std::system_error if the file
+     * cannot be opened or mapped and std::runtime_error if it does not hold a
+     * list of this element type.
+     *
+     * @param path the file backing this MappedArrayList
+     */
+    explicit MappedArrayList(const std::string& path);
+
+    /**
+     * Unmaps and closes the file. Pending modifications are written back by
+     * the kernel eventually; call sync() beforehand to wait for them.
+     * This operation is a no-throw.
+     */
+    ~MappedArrayList() throw ();
+
+    /**
+     * Adds value to the end of this MappedArrayList. If we have excess
+     * capacity, the insertion is performed in constant time. Otherwise the
+     * file is enlarged to twice the size first.
+     * This operation provides strong exception safety.
+     *
+     * @param value value to append to this MappedArrayList
+     */
+    void add(const_reference value);
+
+    /**
+     * Inserts value at the specified index. All elements at or to the right of
+     * index are shifted down by one spot. If this MappedArrayList needs to be
+     * enlarged, default values are used to fill the gaps.
+     * This operation provides strong exception safety.
+     *
+     * @param index index at which to insert value
+     * @param value the element to insert
+     */
+    void add(size_t index, const_reference value);
+
+    /**
+     * Empties this MappedArrayList. The file keeps its capacity.
+     * This operation is a no-throw.
+     */
+    void clear() throw ();
+
+    /**
+     * Returns a constant reference to the element stored at the provided index.
+     * If index is out of bounds, an std::out_of_range exception is thrown with
+     * the index as its message.
+     * This operation provides strong exception safety.
+     *
+     * @param index index of the element to return
+     * @return constant reference to the element at the index.
+     */
+    const_reference get(size_t index) const throw (std::out_of_range);
+
+    /**
+     * Returns a reference to the element stored at the provided index.
+     * If index is out of bounds, an std::out_of_range exception is thrown with
+     * the index as its message.
+     * This operation provides strong exception safety.
+     *
+     * @param index index of the element to return
+     * @return reference to the element at the index.
+     */
+    reference get(size_t index) throw (std::out_of_range);
+
+    /**
+     * Returns a constant reference to the element stored at the provided index.
+     * No bounds checking is performed.
+     * This operation is a no-throw.
+     *
+     * @param index index of the element to return
+     * @return constant reference to the element at the index.
+     */
+    const_reference operator[](size_t index) const throw ();
+
+    /**
+     * Returns a reference to the element stored at the provided index.
+     * No bounds checking is performed.
+     * This operation is a no-throw.
+     *
+     * @param index index of the element to return
+     * @return reference to the element at the index.
+     */
+    reference operator[](size_t index) throw ();
+
+    /**
+     * Returns true if this MappedArrayList is logically equal to rhs.
+     *
+     * @param rhs
+     * @return
+     */
+    bool operator==(const MappedArrayList<T>& rhs) const;
+
+    /**
+     * Returns false if this MappedArrayList is logically equal to rhs.
+     *
+     * @param rhs
+     * @return
+     */
+    bool operator!=(const MappedArrayList<T>& rhs) const;
+
+    /**
+     * Returns a constant iterator to the first element.
+     * This operation is a no-throw.
+     *
+     * @return
+     */
+    const_iterator begin() const throw ();
+
+    /**
+     * Returns an iterator to the first element.
+     * This operation is a no-throw.
+     *
+     * @return
+     */
+    iterator begin() throw ();
+
+    /**
+     * Returns a constant iterator one past the last element.
+     * This operation is a no-throw.
+     *
+     * @return
+     */
+    const_iterator end() const throw ();
+
+    /**
+     * Returns an iterator one past the last element.
+     * This operation is a no-throw.
+     *
+     * @return
+     */
+    iterator end() throw ();
+
+    /**
+     * Returns true if this MappedArrayList is empty and false otherwise.
+     * This operation is a no-throw.
+     *
+     * @return
+     */
+    bool isEmpty() const throw ();
+
+    /**
+     * Removes and returns the element at the specified index. If index is out
+     * of bounds, an std::out_of_range exception is thrown with index as its
+     * message. The elements to the right of index are shifted in place.
+     * This operation provides strong exception safety.
+     *
+     * @param index index of the object to remove.
+     * @return copy of the just removed object.
+     */
+    value_type remove(size_t index);
+
+    /**
+     * Sets the element at the specified index to the provided value. If index
+     * is out of bounds, an std::out_of_range exception is thrown with the index
+     * as its message. This method completes in constant time.
+     * This operation provides strong exception safety.
+     *
+     * @param index index of the object to set
+     * @param value the new value
+     */
+    void set(size_t index, const_reference value);
+
+    /**
+     * Return the size of this MappedArrayList.
+     * This operation is a no-throw.
+     *
+     * @return
+     */
+    size_t size() const throw ();
+
+    /**
+     * Return the number of elements the file can hold before it needs to be
+     * enlarged.
+     * This operation is a no-throw.
+     *
+     * @return
+     */
+    size_t capacity() const throw ();
+
+    /**
+     * Blocks until every modification made so far has been written to the
+     * file. Throws std::system_error if the write back fails.
+     */
+    void sync() const;
+
+private:
+
+    typedef ListFileHeader Header;
+
+    MappedArrayList(const MappedArrayList<T>&);
+    void operator=(const MappedArrayList<T>&);
+
+    /**
+     * Returns the file length needed for capacity elements.
+     *
+     * @param capacity
+     * @return
+     */
+    static size_t bytesFor(size_t capacity) throw ();
+
+    /**
+     * Returns the first element of the mapping.
+     *
+     * @return
+     */
+    T* data() const throw ();
+
+    /**
+     * Enlarges the file and the mapping so that at least capacity elements
+     * fit. On failure the list is left as it was.
+     * This operation provides strong exception safety.
+     *
+     * @param capacity
+     */
+    void grow(size_t capacity);
+
+    /**
+     * Given an index, this method throws an std::out_of_range with the index as
+     * its message if index is out of bounds or is a no-op otherwise.
+     * This operation provides strong exception safety.
+     *
+     * @param index index to check
+     */
+    void rangeCheck(size_t index) const throw (std::out_of_range);
+
+    /**
+     * Throws an std::system_error for the current errno, naming the failed
+     * call in its message.
+     *
+     * @param call
+     */
+    static void throwSystemError(const char* call);
+
+    int mFd;
+    size_t mLength;
+    Header* mHeader;
+};
+
+#include "../src/MappedArrayList.cpp"
+
+#endif
@@ -0,0 +1,196 @@
+#ifndef _MPMC_BOUNDED_QUEUE_H_
+#define _MPMC_BOUNDED_QUEUE_H_
+
+#include <atomic>
+#include <cstdlib>          // For size_t
+#include "QueueBase.h"
+#include "ScopedArray.h"
+
+/**
+ * A bounded, lock-free queue for any number of producer and consumer threads,
+ * after Dmitry Vyukov's design. The capacity is fixed at construction and
+ * rounded up to a power of two.
+ *
+ * Every slot carries a sequence number that says whose turn it is. A
+ * producer that finds the slot at the enqueue position with a sequence
+ * equal to that position claims the position with a compare-and-swap,
+ * writes the element and releases the slot to consumers by storing
+ * position + 1. A consumer claims the slot whose sequence is position + 1
+ * in the same way and hands it back to producers for the next lap by
+ * storing position + capacity. Producers only contend with producers and
+ * consumers with consumers, on counters that sit on cache lines of their
+ * own.
+ *
+ * tryEnqueue() and tryDequeue() never block. enqueue() yields the processor
+ * while the queue is full, since QueueBase offers no way to report it.
+ * front() returns a reference into the ring, so it is only meaningful when
+ * no other consumer runs at the same time. size() and isEmpty() are
+ * snapshots. Since the class is final, calls made through an
+ * MpmcBoundedQueue rather than a QueueBase are not virtual.
+ *
+ * Copying or moving an element may throw once its slot has been claimed.
+ * The exception then propagates, but the slot is still published so the
+ * ring keeps moving: a slot whose enqueue threw is marked for consumers to
+ * pass over, and a slot whose element could not be moved out is handed back
+ * to producers, losing that element. size() counts a marked slot until a
+ * consumer has passed over it.
+ */
+template <typename T>
+class MpmcBoundedQueue final : public QueueBase<T> {
+public:
+
+    /**
+     * Initializes an empty queue that holds up to capacity elements. The
+     * capacity is rounded up to a power of two, and is at least 2.
+     *
+     * @param capacity minimum number of elements the queue can hold
+     */
+    explicit MpmcBoundedQueue(size_t capacity);
+
+    /**
+     * Removes the front element from this queue. Throws Underflow if this queue
+     * is empty.
+     */
+    virtual void dequeue();
+
+    /**
+     * Removes the front element and returns it, moved out rather than copied.
+     * Throws Underflow if this queue is empty.
+     *
+     * @return
+     */
+    virtual T dequeueValue();
+
+    /**
+     * Adds value to the end of this queue, yielding the processor while the
+     * queue is full.
+     *
+     * @param
+     */
+    virtual void enqueue(const T& value);
+
+    /**
+     * Returns a reference to the front of this queue, looking past slots whose
+     * enqueue failed. Throws Underflow if this queue is empty. The reference is
+     * only stable while no other consumer runs.
+     *
+     * @return
+     */
+    virtual const T& front() const;
+
+    /**
+     * Returns the number of elements in this queue.
+     *
+     * @return
+     */
+    virtual size_t size() const;
+
+    /**
+     * Moves the front element into out, removes it and returns true, or
+     * returns false if this queue is empty.
+     *
+     * @param out receives the front element
+     * @return
+     */
+    virtual bool tryDequeue(T& out);
+
+    /**
+     * Adds value to the end of this queue and returns true, or returns false
+     * if the queue is full.
+     *
+     * @param value value to enqueue
+     * @return
+     */
+    bool tryEnqueue(const T& value);
+
+    /**
+     * Returns the number of elements this queue can hold.
+     * This operation is a no-throw.
+     *
+     * @return
+     */
+    size_t capacity() const throw ();
+
+private:
+
+    MpmcBoundedQueue(const MpmcBoundedQueue&);
+    void operator=(const MpmcBoundedQueue&);
+
+    enum {
+        kCacheLine = 64
+    };
+
+    // Set in the sequence of a slot whose enqueue threw
+    static const size_t kSkipped = ~(~static_cast<size_t>(0) >> 1);
+
+    struct Cell {
+        std::atomic<size_t> mSequence;
+        T mValue;
+    };
+
+    /**
+     * Hands a claimed slot back to producers when it goes out of scope, so
+     * that the slot is released even if moving its element out throws.
+     */
+    class Release {
+    public:
+        Release(MpmcBoundedQueue* queue, size_t pos) : mQueue(queue), mPos(pos) {}
+        ~Release() { mQueue->releaseFront(mPos); }
+    private:
+        Release(const Release&);
+        void operator=(const Release&);
+        MpmcBoundedQueue* mQueue;
+        size_t mPos;
+    };
+
+    /**
+     * Claims the slot at the dequeue position, passing over slots whose enqueue
+     * failed, or returns null if the queue is empty. On success pos holds the
+     * claimed position.
+     *
+     * @param pos
+     * @return
+     */
+    Cell* claimFront(size_t& pos);
+
+    /**
+     * Hands the claimed slot at pos back to producers for the next lap.
+     * This operation is a no-throw.
+     *
+     * @param pos
+     */
+    void releaseFront(size_t pos) throw ();
+
+    /**
+     * Returns the sequence number marking a slot that consumers pass over
+     * instead of sequence.
+     * This operation is a no-throw.
+     *
+     * @param sequence
+     * @return
+     */
+    static size_t skipped(size_t sequence) throw ();
+
+    /**
+     * Returns the smallest power of two that is at least capacity and 2.
+     *
+     * @param capacity
+     * @return
+     */
+    static size_t roundCapacity(size_t capacity);
+
+    // Read-only after construction
+    ScopedArray<Cell> mCells;
+    size_t mMask;
+    char mPad0[kCacheLine];
+
+    std::atomic<size_t> mEnqueuePos;
+    char mPad1[kCacheLine - sizeof(std::atomic<size_t>)];
+
+    std::atomic<size_t> mDequeuePos;
+    char mPad2[kCacheLine - sizeof(std::atomic<size_t>)];
+};
+
+#include "../src/MpmcBoundedQueue.cpp"
+
+#endif
@@ -0,0 +1,211 @@
+#ifndef _MPSC_QUEUE_H_
+#define _MPSC_QUEUE_H_
+
+#include <atomic>
+#include <cstdlib>          // For size_t
+#include "QueueBase.h"
+#include "MpmcBoundedQueue.h"
+
+/**
+ * An unbounded queue for any number of producer threads and exactly one
+ * consumer thread, after Dmitry Vyukov's intrusive MPSC queue. It suits
+ * mailboxes, where many threads post to one owner that drains them.
+ *
+ * The elements live in singly linked nodes that carry their own link. The
+ * queue always holds one node whose element has already been consumed, so
+ * that producers and the consumer never touch the same pointer. A producer
+ * swings the tail to its node with a single atomic exchange and then links
+ * the previous tail to it, so enqueue() is wait-free apart from obtaining a
+ * node. The consumer follows the links from the head without any atomic
+ * read-modify-write. enqueueBulk() links a whole chain with one exchange and
+ * dequeueBulk() and drain() take a batch in one pass.
+ *
+ * Nodes freed by the consumer go to a bounded pool that producers draw from
+ * before allocating, so in the steady state no memory is allocated. The pool
+ * is an MpmcBoundedQueue, so it has no ABA problem.
+ *
+ * Between a producer's exchange and its link the new element is not yet
+ * reachable, and the queue may briefly look empty to the consumer.
+ * dequeue(), dequeueValue(), front(), size(), tryDequeue(), dequeueBulk()
+ * and drain() may only be called from the consumer thread. size() takes
+ * linear time.
+ */
+template <typename T>
+class MpscQueue final : public QueueBase<T> {
+public:
+
+    /**
+     * Initializes an empty queue whose node pool holds up to poolCapacity
+     * nodes, rounded up to a power of two.
+     *
+     * @param poolCapacity number of freed nodes kept for reuse
+     */
+    explicit MpscQueue(size_t poolCapacity = 256);
+
+    /**
+     * Destroys the queue and all the nodes it holds. No thread may use the
+     * queue any more.
+     */
+    virtual ~MpscQueue();
+
+    /**
+     * Removes the front element from this queue. Throws Underflow if this queue
+     * is empty. Consumer only.
+     */
+    virtual void dequeue();
+
+    /**
+     * Removes the front element and returns it, moved out rather than copied.
+     * Throws Underflow if this queue is empty. Consumer only.
+     *
+     * @return
+     */
+    virtual T dequeueValue();
+
+    /**
+     * Adds value to the end of this queue.
+     * This operation provides strong exception safety.
+     *
+     * @param
+     */
+    virtual void enqueue(const T& value);
+
+    /**
+     * Returns a reference to the front of this queue. Throws Underflow if this
+     * queue is empty. Consumer only.
+     *
+     * @return
+     */
+    virtual const T& front() const;
+
+    /**
+     * Returns the number of elements in this queue, walking the nodes.
+     * Consumer only.
+     *
+     * @return
+     */
+    virtual size_t size() const;
+
+    /**
+     * Moves the front element into out, removes it and returns true, or
+     * returns false if this queue is empty. Consumer only.
+     *
+     * @param out receives the front element
+     * @return
+     */
+    virtual bool tryDequeue(T& out);
+
+    /**
+     * Adds count elements from values to the end of this queue, in order and
+     * with no element of another producer in between.
+     * This operation provides strong exception safety.
+     *
+     * @param values elements to enqueue
+     * @param count number of elements
+     */
+    virtual void enqueueBulk(const T* values, size_t count);
+
+    /**
+     * Moves up to count elements from the front of this queue into out, in
+     * dequeue order, and removes them. Returns the number of elements moved.
+     * Consumer only.
+     *
+     * @param out receives the dequeued elements
+     * @param count maximum number of elements to dequeue
+     * @return
+     */
+    virtual size_t dequeueBulk(T* out, size_t count);
+
+    /**
+     * Removes up to max elements from the front of this queue, passing each
+     * one to consumer as an rvalue, and returns the number removed. If
+     * consumer throws, the element it was given is removed all the same.
+     * Consumer only.
+     *
+     * @param consumer function object called with each element
+     * @param max maximum number of elements to remove
+     * @return
+     */
+    template <typename Consumer>
+    size_t drain(Consumer consumer, size_t max = size_t(-1));
+
+private:
+
+    MpscQueue(const MpscQueue&);
+    void operator=(const MpscQueue&);
+
+    enum {
+        kCacheLine = 64
+    };
+
+    struct Node {
+        Node() : mNext(0), mItem() {}
+
+        std::atomic<Node*> mNext;
+        T mItem;
+    };
+
+    /**
+     * Returns a node holding value, taken from the pool or allocated, with a
+     * null link.
+     * This operation provides strong exception safety.
+     *
+     * @param value
+     * @return
+     */
+    Node* acquire(const T& value);
+
+    /**
+     * Returns node to the pool, or deletes it if the pool is full.
+     * This operation is a no-throw.
+     *
+     * @param node
+     */
+    void recycle(Node* node) throw ();
+
+    /**
+     * Makes first..last the end of this queue with one exchange.
+     * This operation is a no-throw.
+     *
+     * @param first
+     * @param last
+     */
+    void publish(Node* first, Node* last) throw ();
+
+    /**
+     * Returns the node following the consumed head node, or null if this
+     * queue is empty. Consumer only.
+     *
+     * @return
+     */
+    Node* next() const throw ();
+
+    /**
+     * Makes node, which follows the head node, the new head and recycles the
+     * old one. Consumer only.
+     *
+     * @param node
+     */
+    void advance(Node* node) throw ();
+
+    /**
+     * Deletes the chain of nodes starting at node.
+     *
+     * @param node
+     */
+    static void destroy(Node* node) throw ();
+
+    MpmcBoundedQueue<Node*> mPool;
+
+    // Consumer side
+    Node* mHead;
+    char mPad0[kCacheLine - sizeof(Node*)];
+
+    // Producer side
+    std::atomic<Node*> mTail;
+    char mPad1[kCacheLine - sizeof(std::atomic<Node*>)];
+};
+
+#include "../src/MpscQueue.cpp"
+
+#endif
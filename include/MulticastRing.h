@@ -0,0 +1,226 @@
+#ifndef _MULTICAST_RING_H_
+#define _MULTICAST_RING_H_
+
+#include <atomic>
+#include <cstdlib>          // For size_t
+#include <memory>           // For std::unique_ptr
+#include <stdint.h>         // For uint64_t
+#include <vector>
+#include "ScopedArray.h"
+#include "WaitStrategy.h"
+
+/**
+ * A preallocated ring that carries one stream of events from a producer to
+ * several consumers, each of which sees every event, in the style of the
+ * LMAX Disruptor. An event is written once into its slot and read in place
+ * by every consumer; nothing is copied or allocated per event.
+ *
+ * Progress is tracked with sequences that only grow: the producer's
+ * published sequence and one cursor per consumer, each on its own cache
+ * line. Sequence s lives in slot s modulo the capacity, which is a power of
+ * two. A consumer may read every event below the published sequence and
+ * below the cursors of the consumers it depends on, so that a consumer
+ * registered after "persist" sees an event only once persisting it is done.
+ * The producer may reuse a slot once every consumer has moved past it.
+ *
+ * The producer claims a batch of slots with claim(), fills them through
+ * operator[] and makes the whole batch visible with one publish(). A
+ * consumer learns how far it may read with waitFor() or available(), and
+ * reports its progress for the whole batch with one release(); drain()
+ * wraps the three. Wait is a wait strategy (see WaitStrategy.h) used by both
+ * sides.
+ *
+ * There is exactly one producer thread, and each consumer is used by one
+ * thread at a time. Consumers must be added before any thread uses the ring.
+ * halt() makes waitFor() return even if nothing new arrives, so that
+ * consumer threads can be stopped, and makes claim() throw Halted rather
+ * than wait for consumers that are no longer running.
+ */
+template <typename T, typename Wait = YieldWait>
+class MulticastRing {
+public:
+
+    typedef T value_type;
+
+    /**
+     * Initializes a ring with at least capacity slots, rounded up to a power
+     * of two, holding default constructed events.
+     *
+     * @param capacity minimum number of slots
+     */
+    explicit MulticastRing(size_t capacity);
+
+    /**
+     * Registers a consumer that sees every event after the consumers in
+     * dependencies are done with it, and returns its id. Consumers must be
+     * added before any thread uses the ring.
+     *
+     * @param dependencies ids of the consumers that must run first
+     * @return
+     */
+    size_t addConsumer(const std::vector<size_t>& dependencies = std::vector<size_t>());
+
+    /**
+     * Claims the next count slots, waiting until every consumer is done with
+     * the events they held, and returns the sequence of the first. Throws
+     * Halted without claiming anything if it has to wait once halt() has been
+     * called. Producer only.
+     *
+     * @param count number of slots to claim, at most the capacity
+     * @return
+     */
+    uint64_t claim(size_t count = 1);
+
+    /**
+     * Makes every claimed event visible to the consumers. Producer only.
+     */
+    void publish();
+
+    /**
+     * Returns a reference to the event with the given sequence.
+     * This operation is a no-throw.
+     *
+     * @param sequence
+     * @return
+     */
+    value_type& operator[](uint64_t sequence) throw ();
+
+    /**
+     * Returns a constant reference to the event with the given sequence.
+     * This operation is a no-throw.
+     *
+     * @param sequence
+     * @return
+     */
+    const value_type& operator[](uint64_t sequence) const throw ();
+
+    /**
+     * Returns the sequence of the next event consumer will read.
+     * This operation is a no-throw.
+     *
+     * @param consumer
+     * @return
+     */
+    uint64_t cursor(size_t consumer) const throw ();
+
+    /**
+     * Returns the sequence one past the last event consumer may read now.
+     * This operation is a no-throw.
+     *
+     * @param consumer
+     * @return
+     */
+    uint64_t available(size_t consumer) const throw ();
+
+    /**
+     * Waits until consumer may read at least one event past its cursor, or
+     * until halt() is called, and returns the sequence one past the last
+     * event it may read.
+     *
+     * @param consumer
+     * @return
+     */
+    uint64_t waitFor(size_t consumer);
+
+    /**
+     * Records that consumer is done with every event below sequence.
+     *
+     * @param consumer
+     * @param sequence
+     */
+    void release(size_t consumer, uint64_t sequence);
+
+    /**
+     * Passes every event consumer may read now to handler, as
+     * handler(event, sequence), releases them with one update and returns
+     * their number. If handler throws, the events before the one that threw
+     * are released.
+     *
+     * @param consumer
+     * @param handler
+     * @return
+     */
+    template <typename Handler>
+    size_t drain(size_t consumer, Handler handler);
+
+    /**
+     * Makes every current and future waitFor() return without waiting, and
+     * every claim() that finds the ring full throw Halted.
+     */
+    void halt();
+
+    /**
+     * Returns the number of slots.
+     * This operation is a no-throw.
+     *
+     * @return
+     */
+    size_t capacity() const throw ();
+
+    /**
+     * An exception class used when the producer waits for room in a halted
+     * ring.
+     */
+    class Halted {};
+
+private:
+
+    MulticastRing(const MulticastRing&);
+    void operator=(const MulticastRing&);
+
+    enum {
+        kCacheLine = 64
+    };
+
+    struct Cursor {
+        Cursor() : mSequence(0) {}
+
+        std::atomic<uint64_t> mSequence;
+        char mPad[kCacheLine - sizeof(std::atomic<uint64_t>)];
+    };
+
+    /**
+     * The consumer's cursor and the cursors it waits for.
+     */
+    struct Consumer {
+        Cursor mCursor;
+        std::vector<const Cursor*> mBarrier;
+    };
+
+    /**
+     * Returns the smallest cursor among all consumers, or the claimed
+     * sequence if there are none.
+     * This operation is a no-throw.
+     *
+     * @return
+     */
+    uint64_t slowestConsumer() const throw ();
+
+    /**
+     * Returns the smallest power of two that is at least capacity and 2.
+     *
+     * @param capacity
+     * @return
+     */
+    static size_t roundCapacity(size_t capacity);
+
+    ScopedArray<T> mEvents;
+    size_t mMask;
+    std::vector<std::unique_ptr<Consumer> > mConsumers;
+    char mPad0[kCacheLine];
+
+    // Producer only
+    uint64_t mClaimed;
+    uint64_t mSlowestCache;
+    char mPad1[kCacheLine - 2 * sizeof(uint64_t)];
+
+    Cursor mPublished;
+    std::atomic<bool> mHalted;
+    char mPad2[kCacheLine - sizeof(std::atomic<bool>)];
+
+    Wait mWait;
+};
+
+#include "../src/MulticastRing.cpp"
+
+#endif
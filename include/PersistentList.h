@@ -0,0 +1,471 @@
+#ifndef _PERSISTENT_LIST_H_
+#define _PERSISTENT_LIST_H_
+
+#include <atomic>
+#include <cstdlib>          // For size_t
+#include <stdint.h>         // For uint64_t
+
+// Forward declarations
+template <typename T>
+class PersistentListConstIterator;
+
+namespace std {
+    class out_of_range;
+}
+
+/**
+ * An immutable list with structural sharing, in the style of Clojure's
+ * vector. The elements live in the leaves of a 32-way trie indexed by the
+ * bits of the element index, except for the last (up to) 32 elements which
+ * are kept in a separate tail leaf. add(), set() and removeLast() leave this
+ * list untouched and return a new version that shares all but O(log32 n)
+ * nodes with it; appending usually only copies the tail. Lookups walk at most
+ * log32 n levels, which is 4 levels for a million elements.
+ *
+ * Every version is a value: copying one takes constant time, and versions
+ * may be read concurrently from several threads. Nodes are reference counted
+ * with atomic counters and are freed when the last version using them goes
+ * away.
+ *
+ * Building a large list one version at a time allocates a new tail for every
+ * element. A Transient avoids that: it edits nodes it created in place and is
+ * turned back into a PersistentList in constant time once the batch is done.
+ *
+ * This class provides a set of STL-style constant forward iterators. Since a
+ * version never changes, iterators stay valid for as long as the version
+ * they were obtained from exists.
+ */
+template <typename T>
+class PersistentList {
+private:
+
+    struct Node;
+    struct Branch;
+    struct Leaf;
+
+public:
+
+    typedef T value_type;
+    typedef const T& reference;
+    typedef const T& const_reference;
+    typedef PersistentListConstIterator<T> iterator;
+    typedef PersistentListConstIterator<T> const_iterator;
+
+    /**
+     * A mutable builder for a PersistentList. A Transient starts from the
+     * contents of a PersistentList and modifies nodes it owns in place,
+     * copying shared nodes on their first modification only. Call
+     * persistent() to obtain the result, after which the Transient can no
+     * longer be used. A Transient must not be shared between threads.
+     */
+    class Transient {
+    public:
+
+        /**
+         * Initializes a Transient holding the contents of list in constant time.
+         * This operation provides strong exception safety.
+         *
+         * @param list the version to start from
+         */
+        explicit Transient(const PersistentList<T>& list = PersistentList<T>());
+
+        /**
+         * Releases the nodes held by this Transient.
+         * This operation is a no-throw.
+         */
+        ~Transient() throw ();
+
+        /**
+         * Adds value to the end in amortized constant time.
+         * Throws std::logic_error if persistent() was already called.
+         * This operation provides basic exception safety.
+         *
+         * @param value value to append
+         * @return *this, used for chaining.
+         */
+        Transient& add(const_reference value);
+
+        /**
+         * Sets the element at the specified index to the provided value. If
+         * index is out of bounds, an std::out_of_range exception is thrown with
+         * the index as its message. Throws std::logic_error if persistent() was
+         * already called.
+         * This operation provides basic exception safety.
+         *
+         * @param index index of the object to set
+         * @param value the new value
+         * @return *this, used for chaining.
+         */
+        Transient& set(size_t index, const_reference value);
+
+        /**
+         * Returns a constant reference to the element stored at the provided
+         * index. If index is out of bounds, an std::out_of_range exception is
+         * thrown with the index as its message.
+         * This operation provides strong exception safety.
+         *
+         * @param index index of the element to return
+         * @return constant reference to the element at the index.
+         */
+        const_reference get(size_t index) const;
+
+        /**
+         * Return the number of elements added so far.
+         * This operation is a no-throw.
+         *
+         * @return
+         */
+        size_t size() const throw ();
+
+        /**
+         * Returns the built list in constant time and ends this Transient.
+         * Throws std::logic_error if persistent() was already called.
+         *
+         * @return
+         */
+        PersistentList<T> persistent();
+
+    private:
+
+        Transient(const Transient&);
+        void operator=(const Transient&);
+
+        /**
+         * Throws std::logic_error if persistent() was already called.
+         */
+        void ensureValid() const;
+
+        /**
+         * Returns the node in slot, first replacing it with a copy owned by this
+         * Transient if it is shared. A null slot receives a new empty node.
+         * This operation provides strong exception safety.
+         *
+         * @param slot
+         * @param level
+         * @return
+         */
+        Node* editable(Node*& slot, unsigned level);
+
+        size_t mSize;
+        unsigned mShift;
+        Node* mRoot;
+        Leaf* mTail;
+        uint64_t mEdit;
+    };
+
+    /**
+     * Initializes an empty PersistentList.
+     * This operation is a no-throw.
+     */
+    PersistentList() throw ();
+
+    /**
+     * Initializes the PersistentList to share the contents of src in constant
+     * time.
+     * This operation is a no-throw.
+     *
+     * @param src PersistentList to copy
+     */
+    PersistentList(const PersistentList<T>& src) throw ();
+
+    /**
+     * Releases this version's share of its nodes.
+     * This operation is a no-throw.
+     */
+    ~PersistentList() throw ();
+
+    /**
+     * Makes this object share the contents of rhs in constant time.
+     * This operation is a no-throw.
+     *
+     * @param rhs PersistentList to copy
+     * @return *this, used for chaining.
+     */
+    const PersistentList<T>& operator=(const PersistentList<T>& rhs) throw ();
+
+    /**
+     * Returns a new version with value added to the end. Usually only the
+     * tail is copied; every 32nd call also copies one path of the trie.
+     * This operation provides strong exception safety.
+     *
+     * @param value value to append
+     * @return the new version
+     */
+    PersistentList<T> add(const_reference value) const;
+
+    /**
+     * Returns a new version with the element at index replaced by value,
+     * copying one path of the trie. If index is out of bounds, an
+     * std::out_of_range exception is thrown with the index as its message.
+     * This operation provides strong exception safety.
+     *
+     * @param index index of the object to set
+     * @param value the new value
+     * @return the new version
+     */
+    PersistentList<T> set(size_t index, const_reference value) const;
+
+    /**
+     * Returns a new version without the last element. If this PersistentList
+     * is empty, an std::out_of_range exception is thrown with 0 as its message.
+     * This operation provides strong exception safety.
+     *
+     * @return the new version
+     */
+    PersistentList<T> removeLast() const;
+
+    /**
+     * Returns a constant reference to the element stored at the provided index.
+     * If index is out of bounds, an std::out_of_range exception is thrown with
+     * the index as its message.
+     * This operation provides strong exception safety.
+     *
+     * @param index index of the element to return
+     * @return constant reference to the element at the index.
+     */
+    const_reference get(size_t index) const throw (std::out_of_range);
+
+    /**
+     * Returns a constant reference to the element stored at the provided index.
+     * No bounds checking is performed.
+     * This operation is a no-throw.
+     *
+     * @param index index of the element to return
+     * @return constant reference to the element at the index.
+     */
+    const_reference operator[](size_t index) const throw ();
+
+    /**
+     * Returns true if this PersistentList is logically equal to rhs.
+     *
+     * @param rhs
+     * @return
+     */
+    bool operator==(const PersistentList<T>& rhs) const;
+
+    /**
+     * Returns false if this PersistentList is logically equal to rhs.
+     *
+     * @param rhs
+     * @return
+     */
+    bool operator!=(const PersistentList<T>& rhs) const;
+
+    /**
+     * Returns a constant iterator to the first element.
+     * This operation is a no-throw.
+     *
+     * @return
+     */
+    const_iterator begin() const throw ();
+
+    /**
+     * Returns a constant iterator one past the last element.
+     * This operation is a no-throw.
+     *
+     * @return
+     */
+    const_iterator end() const throw ();
+
+    /**
+     * Returns true if this PersistentList is empty and false otherwise.
+     * This operation is a no-throw.
+     *
+     * @return
+     */
+    bool isEmpty() const throw ();
+
+    /**
+     * Return the size of this PersistentList.
+     * This operation is a no-throw.
+     *
+     * @return
+     */
+    size_t size() const throw ();
+
+private:
+
+    friend class PersistentListConstIterator<T>;
+
+    enum {
+        kBits = 5,
+        kWidth = 1 << kBits,
+        kMask = kWidth - 1
+    };
+
+    /**
+     * The reference counted part shared by branches and leaves. mEdit is the
+     * Transient that may modify the node in place, or 0 once it is shared.
+     */
+    struct Node {
+        explicit Node(uint64_t edit) : mRefs(1), mEdit(edit) {}
+
+        std::atomic<size_t> mRefs;
+        uint64_t mEdit;
+    };
+
+    struct Branch : Node {
+        explicit Branch(uint64_t edit);
+
+        Node* mChildren[kWidth];
+    };
+
+    struct Leaf : Node {
+        explicit Leaf(uint64_t edit) : Node(edit) {}
+
+        T mValues[kWidth];
+    };
+
+    /**
+     * Releases the node it holds unless dismissed, so that partially built
+     * paths are freed if an exception is thrown.
+     */
+    class Guard {
+    public:
+        Guard(Node* node, unsigned level) : mNode(node), mLevel(level) {}
+        ~Guard() { release(mNode, mLevel); }
+        Node* get() const { return mNode; }
+        Node* dismiss() { Node* node = mNode; mNode = 0; return node; }
+    private:
+        Guard(const Guard&);
+        void operator=(const Guard&);
+        Node* mNode;
+        unsigned mLevel;
+    };
+
+    /**
+     * Takes ownership of the provided nodes.
+     *
+     * @param size
+     * @param shift
+     * @param root
+     * @param tail
+     */
+    PersistentList(size_t size, unsigned shift, Node* root, Leaf* tail) throw ();
+
+    /**
+     * Returns the index of the first element stored in the tail of a list
+     * with size elements.
+     *
+     * @param size
+     * @return
+     */
+    static size_t tailOffset(size_t size) throw ();
+
+    /**
+     * Returns the leaf holding the element at index.
+     *
+     * @param root
+     * @param shift
+     * @param tail
+     * @param size
+     * @param index
+     * @return
+     */
+    static const Leaf* leafFor(const Node* root, unsigned shift, const Leaf* tail, size_t size, size_t index) throw ();
+
+    /**
+     * Adds a reference to node, which may be null, and returns it.
+     *
+     * @param node
+     * @return
+     */
+    static Node* retain(const Node* node) throw ();
+
+    /**
+     * Drops a reference to node, which may be null and sits level bits above
+     * the leaves, freeing it and its unreferenced children if that was the
+     * last one.
+     *
+     * @param node
+     * @param level
+     */
+    static void release(Node* node, unsigned level) throw ();
+
+    /**
+     * Returns a copy of branch, or a new empty branch if branch is null,
+     * owned by edit.
+     *
+     * @param branch
+     * @param edit
+     * @return
+     */
+    static Branch* cloneBranch(const Branch* branch, uint64_t edit);
+
+    /**
+     * Returns a leaf owned by edit holding the first count values of leaf,
+     * which may be null.
+     *
+     * @param leaf
+     * @param count
+     * @param edit
+     * @return
+     */
+    static Leaf* cloneLeaf(const Leaf* leaf, size_t count, uint64_t edit);
+
+    /**
+     * Returns a chain of new branches owned by edit leading level bits down
+     * to node, with a new reference to node.
+     *
+     * @param level
+     * @param node
+     * @param edit
+     * @return
+     */
+    static Node* newPath(unsigned level, const Node* node, uint64_t edit);
+
+    /**
+     * Returns a copy of parent with leaf added as the last leaf of a tree
+     * holding size elements including those of leaf.
+     *
+     * @param level
+     * @param parent
+     * @param leaf
+     * @param size
+     * @return
+     */
+    static Node* pushTail(unsigned level, const Node* parent, const Leaf* leaf, size_t size);
+
+    /**
+     * Returns a copy of node with the element at index set to value.
+     *
+     * @param level
+     * @param node
+     * @param index
+     * @param value
+     * @return
+     */
+    static Node* doSet(unsigned level, const Node* node, size_t index, const_reference value);
+
+    /**
+     * Returns a copy of node without its last leaf, or null if nothing is
+     * left, for a tree holding size elements before the removal.
+     *
+     * @param level
+     * @param node
+     * @param size
+     * @return
+     */
+    static Node* popTail(unsigned level, const Node* node, size_t size);
+
+    /**
+     * Given an index, this method throws an std::out_of_range with the index as
+     * its message if index is out of bounds or is a no-op otherwise.
+     * This operation provides strong exception safety.
+     *
+     * @param index index to check
+     * @param size
+     */
+    static void rangeCheck(size_t index, size_t size) throw (std::out_of_range);
+
+    static std::atomic<uint64_t> sNextEdit;
+
+    size_t mSize;
+    unsigned mShift;
+    Node* mRoot;
+    Leaf* mTail;
+};
+
+#include "../src/PersistentList.cpp"
+
+#endif
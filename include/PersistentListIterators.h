@@ -0,0 +1,62 @@
+#ifndef _PERSISTENT_LIST_ITERATORS_H_
+#define _PERSISTENT_LIST_ITERATORS_H_
+
+#include <cstdlib>          // For size_t
+#include <iterator>
+#include "PersistentList.h"
+
+template <typename T>
+class PersistentListConstIterator : public std::iterator<std::forward_iterator_tag, T> {
+private:
+
+    friend class PersistentList<T>;
+    const PersistentList<T>* mList;
+    const T* mValues;
+    size_t mIndex;
+
+    PersistentListConstIterator(const PersistentList<T>* list, size_t index)
+            : mList(list), mValues(0), mIndex(index) {
+        refresh();
+    }
+
+    // Looks up the leaf of the current element, once per 32 elements
+    void refresh() {
+        if (mIndex < mList->mSize)
+            mValues = PersistentList<T>::leafFor(mList->mRoot, mList->mShift, mList->mTail,
+                                                 mList->mSize, mIndex)->mValues;
+    }
+
+public:
+
+    PersistentListConstIterator() : mList(0), mValues(0), mIndex(0) {}
+
+    bool operator==(const PersistentListConstIterator<T>& rhs) const {
+        return mIndex == rhs.mIndex;
+    }
+
+    bool operator!=(const PersistentListConstIterator<T>& rhs) const {
+        return !(*this == rhs);
+    }
+
+    const T& operator*() const {
+        return mValues[mIndex & PersistentList<T>::kMask];
+    }
+
+    const T* operator->() const {
+        return &mValues[mIndex & PersistentList<T>::kMask];
+    }
+
+    PersistentListConstIterator<T>& operator++() {
+        if ((++mIndex & PersistentList<T>::kMask) == 0)
+            refresh();
+        return *this;
+    }
+
+    PersistentListConstIterator<T> operator++(int) {
+        PersistentListConstIterator<T> copy(*this);
+        ++*this;
+        return copy;
+    }
+};
+
+#endif
@@ -2,6 +2,7 @@
 #define _QUEUE_ADAPTER_H_
 
 #include "QueueBase.h"
+#include "StaticQueue.h"
 #include <cstdlib>          // For size_t
 
 /**
@@ -17,6 +18,13 @@
  *   - a remove(size_t) method
  *   - a size_t size() const method
  *
+ * If the container also offers front(), removeFirst(), reserve(size_t) or
+ * emplace(...), they are detected at compile time (see ContainerTraits.h) and
+ * used instead of the index based calls above.
+ *
+ * The work is done by a StaticQueue; use one directly where the container type
+ * is known at compile time to avoid the virtual calls.
+ *
  * @author Krzysztof Zienkiewicz
  * @date October 21, 2011
  */
@@ -32,6 +40,14 @@ public:
      */
     virtual void dequeue();
 
+    /**
+     * Removes the front element and returns it, moved out rather than copied.
+     * Throws Underflow if this queue is empty.
+     *
+     * @return
+     */
+    virtual value_type dequeueValue();
+
     /**
      * Adds value to the end of this queue.
      *
@@ -39,6 +55,23 @@ public:
      */
     virtual void enqueue(const value_type& value);
 
+    /**
+     * Adds an element constructed from args to the end of this queue, in place
+     * if the container supports emplace().
+     *
+     * @param args
+     */
+    template <typename... Args>
+    void emplace(Args&&... args);
+
+    /**
+     * Makes room for capacity elements if the container supports reserve(),
+     * or does nothing otherwise.
+     *
+     * @param capacity
+     */
+    void reserve(size_t capacity);
+
     /**
      * Returns a reference to the front of this queue. Throws Underflow if this
      * queue is empty.
@@ -54,9 +87,40 @@ public:
      */
     virtual size_t size() const;
 
+    /**
+     * Moves the front element into out, removes it and returns true, or
+     * returns false if this queue is empty.
+     *
+     * @param out receives the front element
+     * @return
+     */
+    virtual bool tryDequeue(value_type& out);
+
+    /**
+     * Adds the count elements of values to the end of this queue, in order.
+     * The container's addAll() is used when it has one.
+     *
+     * @param values elements to enqueue
+     * @param count number of elements to enqueue
+     */
+    virtual void enqueueBulk(const value_type* values, size_t count);
+
+    /**
+     * Moves up to count elements from the front of this queue into out, in
+     * dequeue order, and removes them. Returns the number of elements moved,
+     * which is less than count only if the queue ran empty.
+     * The container's removeRange() is used when it has one and no
+     * removeFirst().
+     *
+     * @param out receives the dequeued elements
+     * @param count maximum number of elements to dequeue
+     * @return
+     */
+    virtual size_t dequeueBulk(value_type* out, size_t count);
+
 private:
 
-    Container mContainer;
+    StaticQueue<Container> mQueue;
 };
 
 #include "../src/QueueAdapter.cpp"
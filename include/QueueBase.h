@@ -25,6 +25,14 @@ public:
      */
     virtual void dequeue() = 0;
 
+    /**
+     * Removes the front element and returns it, moved out rather than copied.
+     * Throws Underflow if this queue is empty.
+     *
+     * @return
+     */
+    virtual T dequeueValue();
+
     /**
      * Adds value to the end of this queue.
      *
@@ -62,6 +70,38 @@ public:
      */
     virtual size_t size() const = 0;
 
+    /**
+     * Moves the front element into out, removes it and returns true, or
+     * returns false if this queue is empty. Unlike dequeue(), an empty queue
+     * is not an error, so polling a mostly empty queue costs a branch rather
+     * than an exception.
+     *
+     * @param out receives the front element
+     * @return
+     */
+    virtual bool tryDequeue(T& out);
+
+    /**
+     * Adds the count elements of values to the end of this queue, in order.
+     * The default implementation enqueues them one at a time.
+     *
+     * @param values elements to enqueue
+     * @param count number of elements to enqueue
+     */
+    virtual void enqueueBulk(const T* values, size_t count);
+
+    /**
+     * Moves up to count elements from the front of this queue into out, in
+     * dequeue order, and removes them. Returns the number of elements moved,
+     * which is less than count only if the queue ran empty.
+     * The default implementation dequeues them one at a time.
+     *
+     * @param out receives the dequeued elements
+     * @param count maximum number of elements to dequeue
+     * @return
+     */
+    virtual size_t dequeueBulk(T* out, size_t count);
+
     /**
      * An exception class used when an empty queue is asked for the front
      * element.
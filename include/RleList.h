@@ -0,0 +1,247 @@
+#ifndef _RLE_LIST_H_
+#define _RLE_LIST_H_
+
+#include <cstdlib>          // For size_t
+#include <vector>
+
+// Forward declarations
+template <typename T>
+class RleListConstIterator;
+
+namespace std {
+    class out_of_range;
+}
+
+/**
+ * A run-length encoded list implementation. Consecutive equal elements are
+ * stored once as a (value, runLength) pair, so lists dominated by long runs of
+ * a few distinct values take space proportional to the number of runs rather
+ * than the number of elements. In particular, RleList(size, value) and
+ * add(index, value) past the end never materialize the filler elements.
+ *
+ * A prefix-sum index over the run lengths is kept alongside the runs, which
+ * lets get(size_t) locate the run holding an index with a binary search.
+ * Mutating methods split a run where needed and merge neighboring runs that
+ * become equal, so the run list is always maximally compact. Their cost is
+ * proportional to the number of runs after the affected position.
+ *
+ * In addition to the assumptions made by the ArrayList, the parametrizing type
+ * must provide an equality operator.
+ *
+ * Since elements do not have individual storage, only constant access is
+ * offered; use set(size_t, const_reference) to modify an element. This class
+ * provides a set of STL-style constant forward iterators which expand the runs
+ * lazily. Modifying the RleList while iterating over it invalidates all
+ * current iterators.
+ */
+template <typename T>
+class RleList {
+public:
+
+    typedef T value_type;
+    typedef const T& const_reference;
+    typedef RleListConstIterator<T> iterator;
+    typedef RleListConstIterator<T> const_iterator;
+
+    /**
+     * Initializes the RleList with size elements all set to value using a
+     * single run. If size is not supplied, an empty RleList is created.
+     * This operation provides strong exception safety.
+     *
+     * @param size size of the RleList to create
+     * @param value value used to fill the RleList
+     */
+    explicit RleList(size_t size = 0, const_reference value = value_type());
+
+    /**
+     * Adds value to the end of this RleList. If value equals the last element
+     * the last run is simply extended. This operation completes in amortized
+     * constant time.
+     * This operation provides strong exception safety.
+     *
+     * @param value value to append to this RleList
+     */
+    void add(const_reference value);
+
+    /**
+     * Inserts value at the specified index. All elements at or to the right of
+     * index are shifted down by one spot. If this RleList needs to be enlarged,
+     * a single run of default values is used to fill the gap.
+     * This operation provides strong exception safety.
+     *
+     * @param index index at which to insert value
+     * @param value the element to insert
+     */
+    void add(size_t index, const_reference value);
+
+    /**
+     * Empties this RleList.
+     * This operation is a no-throw.
+     */
+    void clear() throw ();
+
+    /**
+     * Returns a constant reference to the element stored at the provided index.
+     * If index is out of bounds, an std::out_of_range exception is thrown with
+     * the index as its message. Time proportional to the logarithm of the
+     * number of runs is needed.
+     * This operation provides strong exception safety.
+     *
+     * @param index index of the element to return
+     * @return constant reference to the element at the index.
+     */
+    const_reference get(size_t index) const throw (std::out_of_range);
+
+    /**
+     * Returns a constant reference to the element stored at the provided index.
+     * No range checking is performed on the index.
+     *
+     * @param index index of the element to return
+     * @return constant reference to the element at the index.
+     */
+    const_reference operator[](size_t index) const throw ();
+
+    /**
+     * Returns true if this RleList is equal to rhs and false otherwise. Since
+     * runs are always maximal, this compares runs rather than elements.
+     *
+     * @param rhs
+     * @return
+     */
+    bool operator==(const RleList<T>& rhs) const;
+
+    /**
+     * Returns false if this RleList is equal to rhs and true otherwise.
+     *
+     * @param rhs
+     * @return
+     */
+    bool operator!=(const RleList<T>& rhs) const;
+
+    /**
+     * Returns a constant iterator to the beginning.
+     * This operation is a no-throw.
+     *
+     * @return
+     */
+    const_iterator begin() const throw ();
+
+    /**
+     * Returns a constant iterator to the end.
+     * This operation is a no-throw.
+     *
+     * @return
+     */
+    const_iterator end() const throw ();
+
+    /**
+     * Returns true if this RleList is empty and false otherwise.
+     * This operation is a no-throw.
+     *
+     * @return
+     */
+    bool isEmpty() const throw ();
+
+    /**
+     * Removes and returns the element at the specified index. If index is out
+     * of bounds, an std::out_of_range exception is thrown with index as its
+     * message. If the removal empties a run, its neighbors are merged when
+     * they hold equal values.
+     * This operation provides basic exception safety.
+     *
+     * @param index index of the object to remove.
+     * @return copy of the just removed object.
+     */
+    value_type remove(size_t index);
+
+    /**
+     * Sets the element at the specified index to the provided value, splitting
+     * and merging runs as needed. If index is out of bounds, an
+     * std::out_of_range exception is thrown with the index as its message.
+     * This operation provides strong exception safety.
+     *
+     * @param index index of the object to set
+     * @param value the new value
+     */
+    void set(size_t index, const_reference value);
+
+    /**
+     * Return the size of this RleList.
+     * This operation is a no-throw.
+     *
+     * @return
+     */
+    size_t size() const throw ();
+
+    /**
+     * Returns the number of runs used to store this RleList.
+     * This operation is a no-throw.
+     *
+     * @return
+     */
+    size_t runCount() const throw ();
+
+private:
+
+    friend class RleListConstIterator<T>;
+
+    struct Run {
+        Run(const_reference value, size_t length) : mValue(value), mLength(length) {}
+
+        T mValue;
+        size_t mLength;
+    };
+
+    /**
+     * Returns the number of the run holding index.
+     *
+     * @param index
+     * @return
+     */
+    size_t findRun(size_t index) const throw ();
+
+    /**
+     * Returns the index of the first element of the provided run.
+     *
+     * @param run
+     * @return
+     */
+    size_t runStart(size_t run) const throw ();
+
+    /**
+     * Appends run to the end of runs, extending the last run instead if it holds
+     * an equal value. Empty runs are dropped.
+     *
+     * @param runs the runs to extend
+     * @param run the run to append
+     */
+    static void appendRun(std::vector<Run>& runs, const Run& run);
+
+    /**
+     * Replaces count runs starting at first with the runs in replacement
+     * (dropping empty ones), merges equal neighbors around the replaced range
+     * and brings the prefix-sum index up to date.
+     * This operation provides strong exception safety.
+     *
+     * @param first number of the first run to replace
+     * @param count number of runs to replace
+     * @param replacement the new runs
+     */
+    void splice(size_t first, size_t count, const std::vector<Run>& replacement);
+
+    /**
+     * Given an index, this method throws an std::out_of_range with the index as
+     * its message if index is out of bounds or is a no-op otherwise.
+     * This operation provides strong exception safety.
+     *
+     * @param index index to check
+     */
+    void rangeCheck(size_t index) const throw (std::out_of_range);
+
+    std::vector<Run> mRuns;
+    std::vector<size_t> mEnds;      // mEnds[i] is one past the last index of run i
+};
+
+#include "../src/RleList.cpp"
+
+#endif
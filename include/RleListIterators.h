@@ -0,0 +1,57 @@
+#ifndef _RLE_LIST_ITERATORS_H_
+#define _RLE_LIST_ITERATORS_H_
+
+#include <iterator>
+#include "RleList.h"
+
+/**
+ * A constant forward iterator for the RleList. Runs are expanded lazily: the
+ * iterator tracks a run and an offset within it, and never copies elements.
+ */
+template <typename T>
+class RleListConstIterator : public std::iterator<std::forward_iterator_tag, T> {
+private:
+
+    friend class RleList<T>;
+    const RleList<T>* mList;
+    size_t mRun;
+    size_t mOffset;
+
+    RleListConstIterator(const RleList<T>* list, size_t run) : mList(list), mRun(run), mOffset(0) {}
+
+public:
+
+    RleListConstIterator() : mList(0), mRun(0), mOffset(0) {}
+
+    bool operator==(const RleListConstIterator<T>& rhs) const {
+        return mList == rhs.mList && mRun == rhs.mRun && mOffset == rhs.mOffset;
+    }
+
+    bool operator!=(const RleListConstIterator<T>& rhs) const {
+        return !(*this == rhs);
+    }
+
+    const T& operator*() const {
+        return mList->mRuns[mRun].mValue;
+    }
+
+    const T* operator->() const {
+        return &mList->mRuns[mRun].mValue;
+    }
+
+    RleListConstIterator<T>& operator++() {
+        if (++mOffset == mList->mRuns[mRun].mLength) {
+            ++mRun;
+            mOffset = 0;
+        }
+        return *this;
+    }
+
+    RleListConstIterator<T> operator++(int) {
+        RleListConstIterator<T> copy(*this);
+        ++*this;
+        return copy;
+    }
+};
+
+#endif
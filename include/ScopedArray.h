@@ -3,17 +3,43 @@
 // TODO comment
 
 #include <algorithm>        // For std::swap
+#include <new>              // For placement new
+#include <type_traits>      // For std::is_trivial
+#include "ArrayStorage.h"
 
 template <typename T>
 class ScopedArray {
 public:
 
-    explicit ScopedArray(T* ptr = 0) : mPtr(ptr) {}
+    explicit ScopedArray(T* ptr = 0) : mPtr(ptr), mCount(0), mStorage() {}
+
+    // Allocates count default constructed elements from the provided storage.
+    ScopedArray(size_t count, const ArrayStorage& storage) : mPtr(0), mCount(count), mStorage(storage) {
+        if (mStorage.backing() == ArrayStorage::HEAP) {
+            mPtr = new T[count];
+            return;
+        }
+
+        T* ptr = static_cast<T*>(mStorage.allocate(count * sizeof(T)));
+        if (!std::is_trivial<T>::value) {
+            size_t built = 0;
+            try {
+                for (; built < count; ++built)
+                    new (ptr + built) T();
+            } catch (...) {
+                destroyElements(ptr, built);
+                mStorage.deallocate(ptr, count * sizeof(T));
+                throw;
+            }
+        }
+        mPtr = ptr;
+    }
 
     ~ScopedArray() {
-        delete[] mPtr;
+        destroy();
     }
 
+    // Only valid for arrays that were adopted from new[].
     T* release() {
         T* ptr = mPtr;
         mPtr = 0;
@@ -21,8 +47,25 @@ public:
     }
 
     void reset(T* ptr = 0) {
-        delete[] mPtr;
+        destroy();
         mPtr = ptr;
+        mCount = 0;
+        mStorage = ArrayStorage();
+    }
+
+    // Resizes the array in place (see ArrayStorage::reallocate) when the
+    // storage and element type allow it. Returns false, leaving the array
+    // untouched, otherwise.
+    bool regrow(size_t count) {
+        if (!std::is_trivial<T>::value)
+            return false;
+
+        void* ptr = mStorage.reallocate(mPtr, mCount * sizeof(T), count * sizeof(T));
+        if (!ptr)
+            return false;
+        mPtr = static_cast<T*>(ptr);
+        mCount = count;
+        return true;
     }
 
     T& operator[](size_t index) const {
@@ -37,8 +80,14 @@ public:
         return mPtr;
     }
 
+    const ArrayStorage& storage() const {
+        return mStorage;
+    }
+
     void swap(ScopedArray& other) {
         std::swap(mPtr, other.mPtr);
+        std::swap(mCount, other.mCount);
+        std::swap(mStorage, other.mStorage);
     }
 
 private:
@@ -46,7 +95,25 @@ private:
     ScopedArray(const ScopedArray&);
     void operator=(const ScopedArray& rhs);
 
+    static void destroyElements(T* ptr, size_t count) {
+        if (!std::is_trivial<T>::value) {
+            for (size_t i = 0; i < count; ++i)
+                ptr[i].~T();
+        }
+    }
+
+    void destroy() {
+        if (mStorage.backing() == ArrayStorage::HEAP) {
+            delete[] mPtr;
+        } else if (mPtr) {
+            destroyElements(mPtr, mCount);
+            mStorage.deallocate(mPtr, mCount * sizeof(T));
+        }
+    }
+
     T* mPtr;
+    size_t mCount;          // Not tracked for arrays adopted from new[]
+    ArrayStorage mStorage;
 };
 
 #endif  // _SCOPED_ARRAY_H_
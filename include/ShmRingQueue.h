@@ -0,0 +1,414 @@
+#ifndef _SHM_RING_QUEUE_H_
+#define _SHM_RING_QUEUE_H_
+
+#include <atomic>
+#include <cstdlib>          // For size_t
+#include <stdint.h>         // For uint32_t, uint64_t
+#include <string>
+#include "QueueBase.h"
+
+/**
+ * A bounded queue that lives in a POSIX shared-memory segment, so that
+ * several processes can exchange elements without system calls or copies
+ * through the kernel. Every process constructs a ShmRingQueue with the same
+ * name; the first one creates and sizes the segment, the others attach to
+ * it. Only trivially copyable types may be stored, since elements are read
+ * straight out of memory written by another process.
+ *
+ * The segment starts with a header holding the positions, followed by a
+ * table of peers and by the ring. The header refers to the other parts by
+ * their offsets and elements are addressed by position, so no pointer is
+ * ever stored in the segment and each process may map it at a different
+ * address. The positions only grow and wrap into the ring with a mask.
+ *
+ * In MPMC mode, any number of producers and consumers share the ring, which
+ * works like MpmcBoundedQueue: every slot carries a sequence number and
+ * positions are claimed with a compare-and-swap. In SPSC mode there is one
+ * producer and one consumer at a time, which works like SpscRingQueue and
+ * needs no read-modify-write operations at all.
+ *
+ * Each ShmRingQueue object is one peer: it registers its process id in the
+ * peer table when it attaches and removes it when destroyed, and it must be
+ * used by one thread at a time. Threads that share a ring each construct
+ * their own ShmRingQueue. In MPMC mode a peer also records the position it
+ * is working on, so that a slot claimed by a process that then crashed does
+ * not stall the ring forever. deadPeers() reports peers whose process has
+ * exited without detaching, and recover() removes them: a slot a dead
+ * producer claimed is skipped by consumers, and a slot a dead consumer
+ * claimed is handed back to producers, losing its element. Neither happens
+ * on its own; enqueue() waits forever on a ring filled up behind a crashed
+ * consumer, so call recover() when a peer is known or suspected to be gone.
+ * Liveness is judged by the process id, which the system may eventually
+ * reuse.
+ *
+ * Failures of the underlying system calls are reported through
+ * std::system_error. A segment created for another element type, capacity
+ * or mode is rejected with std::runtime_error. The segment outlives the
+ * processes using it until remove() is called.
+ */
+template <typename T>
+class ShmRingQueue final : public QueueBase<T> {
+public:
+
+    /**
+     * The sharing discipline of a ring, fixed when the segment is created.
+     */
+    enum Mode {
+        SPSC,
+        MPMC
+    };
+
+    /**
+     * Attaches to the shared-memory segment called name, creating it if it
+     * does not exist yet. name is a POSIX shared-memory name such as
+     * "/sidecar-events". The capacity is rounded up to a power of two, and
+     * is at least 2. Throws std::system_error if the segment cannot be
+     * opened or mapped and std::runtime_error if it was created for another
+     * element type, capacity or mode, or if its peer table is full.
+     *
+     * @param name name of the segment
+     * @param capacity minimum number of elements the queue can hold
+     * @param mode sharing discipline of the ring
+     */
+    ShmRingQueue(const std::string& name, size_t capacity, Mode mode = MPMC);
+
+    /**
+     * Removes this peer from the segment and unmaps it. The segment itself
+     * stays until remove() is called.
+     * This operation is a no-throw.
+     */
+    ~ShmRingQueue() throw ();
+
+    /**
+     * Removes the front element from this queue. Throws Underflow if this queue
+     * is empty.
+     */
+    virtual void dequeue();
+
+    /**
+     * Removes the front element and returns it. Throws Underflow if this queue
+     * is empty.
+     *
+     * @return
+     */
+    virtual T dequeueValue();
+
+    /**
+     * Adds value to the end of this queue, yielding the processor while the
+     * queue is full.
+     *
+     * @param
+     */
+    virtual void enqueue(const T& value);
+
+    /**
+     * Returns a reference to the front of this queue. Throws Underflow if this
+     * queue is empty. The reference is only stable while no other consumer
+     * runs.
+     *
+     * @return
+     */
+    virtual const T& front() const;
+
+    /**
+     * Returns the number of elements in this queue.
+     *
+     * @return
+     */
+    virtual size_t size() const;
+
+    /**
+     * Copies the front element into out, removes it and returns true, or
+     * returns false if this queue is empty.
+     *
+     * @param out receives the front element
+     * @return
+     */
+    virtual bool tryDequeue(T& out);
+
+    /**
+     * Adds value to the end of this queue and returns true, or returns false
+     * if the queue is full.
+     *
+     * @param value value to enqueue
+     * @return
+     */
+    bool tryEnqueue(const T& value);
+
+    /**
+     * Returns the number of elements this queue can hold.
+     * This operation is a no-throw.
+     *
+     * @return
+     */
+    size_t capacity() const throw ();
+
+    /**
+     * Returns the sharing discipline of the ring.
+     * This operation is a no-throw.
+     *
+     * @return
+     */
+    Mode mode() const throw ();
+
+    /**
+     * Returns the number of registered peers whose process has exited
+     * without detaching.
+     *
+     * @return
+     */
+    size_t deadPeers() const;
+
+    /**
+     * Removes every peer whose process has exited without detaching, and
+     * repairs the slots it left half claimed. A peer that died while racing a
+     * live peer for a slot is kept until a later call can tell which of the two
+     * got it. Returns the number of peers removed.
+     *
+     * @return
+     */
+    size_t recover();
+
+    /**
+     * Removes the name of the segment, which is destroyed once every process
+     * has unmapped it. Throws std::system_error if the name cannot be
+     * removed.
+     *
+     * @param name name of the segment
+     */
+    static void remove(const std::string& name);
+
+private:
+
+    ShmRingQueue(const ShmRingQueue&);
+    void operator=(const ShmRingQueue&);
+
+    enum {
+        kCacheLine = 64,
+        kMagic = 0x53525147,
+        kVersion = 1,
+        kMaxPeers = 64,
+        kAttachTries = 1000,
+        kRecovering = -1,
+        kEnqueue = 1,
+        kDequeue = 2,
+        kWon = 4
+    };
+
+    /**
+     * The start of the segment. Everything but the magic number is written
+     * once by the creator before the magic number is published.
+     */
+    struct Header {
+        std::atomic<uint32_t> mMagic;
+        uint32_t mVersion;
+        uint32_t mElementSize;
+        uint32_t mMode;
+        uint64_t mCapacity;
+        uint64_t mPeersOffset;
+        uint64_t mCellsOffset;
+        char mPad0[kCacheLine - 4 * sizeof(uint32_t) - 3 * sizeof(uint64_t)];
+
+        std::atomic<uint64_t> mEnqueuePos;
+        char mPad1[kCacheLine - sizeof(std::atomic<uint64_t>)];
+
+        std::atomic<uint64_t> mDequeuePos;
+        char mPad2[kCacheLine - sizeof(std::atomic<uint64_t>)];
+    };
+
+    /**
+     * An entry of the peer table. mPid is 0 while the entry is free and
+     * kRecovering while a dead peer is being removed. mClaim is 0 while the
+     * peer is idle, or the position it is claiming shifted left by three and
+     * combined with kEnqueue or kDequeue, and with kWon once the claim
+     * succeeded.
+     */
+    struct Peer {
+        std::atomic<int> mPid;
+        std::atomic<uint64_t> mClaim;
+        char mPad[kCacheLine - 2 * sizeof(std::atomic<uint64_t>)];
+    };
+
+    /**
+     * A slot of an MPMC ring. SPSC rings hold bare elements.
+     */
+    struct Cell {
+        std::atomic<uint64_t> mSequence;
+        T mValue;
+    };
+
+    /**
+     * Fills in the header, peer table and ring of a new segment and
+     * publishes it.
+     *
+     * @param capacity
+     * @param mode
+     */
+    void initialize(size_t capacity, Mode mode);
+
+    /**
+     * Waits for the creator to publish the segment and checks that it holds
+     * a ring of this element type, capacity and mode.
+     *
+     * @param name
+     * @param capacity
+     * @param mode
+     */
+    void validate(const std::string& name, size_t capacity, Mode mode) const;
+
+    /**
+     * Registers this peer in a free entry of the peer table, removing dead
+     * peers first if the table is full.
+     *
+     * @param name
+     */
+    void attach(const std::string& name);
+
+    /**
+     * Returns the MPMC slot of position pos.
+     * This operation is a no-throw.
+     *
+     * @param pos
+     * @return
+     */
+    Cell* cell(uint64_t pos) const throw ();
+
+    /**
+     * Returns the SPSC slot of position pos.
+     * This operation is a no-throw.
+     *
+     * @param pos
+     * @return
+     */
+    T* slot(uint64_t pos) const throw ();
+
+    /**
+     * Records that this peer is about to claim pos for role.
+     * This operation is a no-throw.
+     *
+     * @param pos
+     * @param role
+     */
+    void claim(uint64_t pos, int role) const throw ();
+
+    /**
+     * Records that this peer has claimed pos for role.
+     * This operation is a no-throw.
+     *
+     * @param pos
+     * @param role
+     */
+    void won(uint64_t pos, int role) const throw ();
+
+    /**
+     * Records that this peer is idle.
+     * This operation is a no-throw.
+     */
+    void unclaim() const throw ();
+
+    /**
+     * Claims the MPMC slot at the dequeue position, passing over slots left
+     * by dead producers, or returns null if the queue is empty. On success pos
+     * holds the claimed position.
+     *
+     * @param pos
+     * @return
+     */
+    Cell* claimFront(uint64_t& pos) const;
+
+    /**
+     * Hands the claimed MPMC slot at pos back to producers.
+     *
+     * @param pos
+     */
+    void releaseFront(uint64_t pos) const;
+
+    /**
+     * Claims and releases the slot at pos, which a dead producer left
+     * behind, unless another consumer got to it first.
+     *
+     * @param pos
+     */
+    void skipFront(uint64_t pos) const;
+
+    /**
+     * Repairs the slot described by claim, which a dead peer recorded, if the
+     * peer had claimed it. Returns false if a live peer is racing for the same
+     * slot, in which case the owner cannot be told yet.
+     *
+     * @param dead
+     * @param claim
+     * @return
+     */
+    bool repair(const Peer* dead, uint64_t claim);
+
+    /**
+     * Returns the sequence number marking a slot that consumers pass over
+     * instead of sequence.
+     *
+     * @param sequence
+     * @return
+     */
+    static uint64_t skipped(uint64_t sequence) throw ();
+
+    /**
+     * Returns true if the process with the given id still exists.
+     *
+     * @param pid
+     * @return
+     */
+    static bool alive(int pid) throw ();
+
+    /**
+     * Returns the segment length needed for a ring of capacity elements.
+     *
+     * @param capacity
+     * @param mode
+     * @return
+     */
+    static size_t bytesFor(size_t capacity, Mode mode) throw ();
+
+    /**
+     * Returns the smallest power of two that is at least capacity and 2.
+     *
+     * @param capacity
+     * @return
+     */
+    static size_t roundCapacity(size_t capacity);
+
+    /**
+     * Sleeps for a moment while waiting for the creator of the segment, or
+     * throws std::runtime_error once attempt reaches kAttachTries.
+     *
+     * @param attempt
+     * @param name
+     */
+    static void awaitCreator(int attempt, const std::string& name);
+
+    /**
+     * Throws an std::system_error for the current errno, naming the failed
+     * call in its message.
+     *
+     * @param call
+     */
+    static void throwSystemError(const char* call);
+
+    // Local to this process: where the parts of the segment are mapped
+    int mFd;
+    size_t mLength;
+    Header* mHeader;
+    Peer* mPeers;
+    Peer* mSelf;
+    char* mRing;
+    uint64_t mMask;
+    Mode mMode;
+
+    // The last position of the other side seen by an SPSC producer or
+    // consumer
+    uint64_t mHeadCache;
+    uint64_t mTailCache;
+};
+
+#include "../src/ShmRingQueue.cpp"
+
+#endif
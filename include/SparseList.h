@@ -0,0 +1,224 @@
+#ifndef _SPARSE_LIST_H_
+#define _SPARSE_LIST_H_
+
+#include <cstdlib>          // For size_t
+#include <vector>
+
+// Forward declarations
+template <typename T>
+class SparseListConstIterator;
+
+namespace std {
+    class out_of_range;
+}
+
+/**
+ * A list implementation that only stores the positions that were explicitly
+ * written. Positions that were never written (holes) read as a default
+ * constructed value. The index semantics match those of ArrayList and
+ * LinkedList: add(index, value) shifts every element at or to the right of
+ * index down by one spot, and an index past the end enlarges the list. Unlike
+ * those lists, the gap is not materialized, so writing to index 10,000,000 of an
+ * empty SparseList stores a single entry.
+ *
+ * Present entries are kept in a vector sorted by index. Lookups are binary
+ * searches, and shifting operations cost time proportional to the number of
+ * present entries to the right of the affected index rather than to the size
+ * of the list.
+ *
+ * This class provides a set of STL-style constant forward iterators which
+ * visit only the present entries in increasing index order; index() reports
+ * the position of the current entry. Modifying the SparseList while iterating
+ * over it invalidates all current iterators.
+ */
+template <typename T>
+class SparseList {
+public:
+
+    typedef T value_type;
+    typedef const T& const_reference;
+    typedef SparseListConstIterator<T> iterator;
+    typedef SparseListConstIterator<T> const_iterator;
+
+    /**
+     * Initializes the SparseList with size holes. If size is not supplied, an
+     * empty SparseList is created. No storage is used for the holes.
+     * This operation provides strong exception safety.
+     *
+     * @param size size of the SparseList to create
+     */
+    explicit SparseList(size_t size = 0);
+
+    /**
+     * Adds value to the end of this SparseList in amortized constant time.
+     * This operation provides strong exception safety.
+     *
+     * @param value value to append to this SparseList
+     */
+    void add(const_reference value);
+
+    /**
+     * Inserts value at the specified index. All elements at or to the right of
+     * index are shifted down by one spot. If index is past the end, this
+     * SparseList is enlarged and the gap is left as holes.
+     * This operation provides basic exception safety.
+     *
+     * @param index index at which to insert value
+     * @param value the element to insert
+     */
+    void add(size_t index, const_reference value);
+
+    /**
+     * Empties this SparseList.
+     * This operation is a no-throw.
+     */
+    void clear() throw ();
+
+    /**
+     * Returns true if the element at index was explicitly written and false if
+     * it is a hole or out of bounds.
+     * This operation is a no-throw.
+     *
+     * @param index
+     * @return
+     */
+    bool contains(size_t index) const throw ();
+
+    /**
+     * Returns a constant reference to the element stored at the provided index,
+     * or to a default value if the index is a hole. If index is out of bounds,
+     * an std::out_of_range exception is thrown with the index as its message.
+     * This operation provides strong exception safety.
+     *
+     * @param index index of the element to return
+     * @return constant reference to the element at the index.
+     */
+    const_reference get(size_t index) const throw (std::out_of_range);
+
+    /**
+     * Returns true if this SparseList is logically equal to rhs, treating
+     * holes as default values.
+     *
+     * @param rhs
+     * @return
+     */
+    bool operator==(const SparseList<T>& rhs) const;
+
+    /**
+     * Returns false if this SparseList is logically equal to rhs.
+     *
+     * @param rhs
+     * @return
+     */
+    bool operator!=(const SparseList<T>& rhs) const;
+
+    /**
+     * Returns a constant iterator to the first present entry.
+     * This operation is a no-throw.
+     *
+     * @return
+     */
+    const_iterator begin() const throw ();
+
+    /**
+     * Returns a constant iterator past the last present entry.
+     * This operation is a no-throw.
+     *
+     * @return
+     */
+    const_iterator end() const throw ();
+
+    /**
+     * Returns true if this SparseList is empty and false otherwise.
+     * This operation is a no-throw.
+     *
+     * @return
+     */
+    bool isEmpty() const throw ();
+
+    /**
+     * Removes and returns the element at the specified index. If index is out
+     * of bounds, an std::out_of_range exception is thrown with index as its
+     * message.
+     * This operation provides basic exception safety.
+     *
+     * @param index index of the object to remove.
+     * @return copy of the just removed object.
+     */
+    value_type remove(size_t index);
+
+    /**
+     * Sets the element at the specified index to the provided value, turning a
+     * hole into a present entry if needed. If index is out of bounds, an
+     * std::out_of_range exception is thrown with the index as its message.
+     * This operation provides basic exception safety.
+     *
+     * @param index index of the object to set
+     * @param value the new value
+     */
+    void set(size_t index, const_reference value);
+
+    /**
+     * Return the size of this SparseList, holes included.
+     * This operation is a no-throw.
+     *
+     * @return
+     */
+    size_t size() const throw ();
+
+    /**
+     * Returns the number of present entries.
+     * This operation is a no-throw.
+     *
+     * @return
+     */
+    size_t entryCount() const throw ();
+
+private:
+
+    friend class SparseListConstIterator<T>;
+
+    struct Entry {
+        Entry(size_t index, const_reference value) : mIndex(index), mValue(value) {}
+
+        size_t mIndex;
+        T mValue;
+    };
+
+    typedef typename std::vector<Entry>::iterator EntryIterator;
+    typedef typename std::vector<Entry>::const_iterator EntryConstIterator;
+
+    /**
+     * Returns the first entry whose index is not less than index.
+     *
+     * @param index
+     * @return
+     */
+    EntryIterator lowerBound(size_t index) throw ();
+    EntryConstIterator lowerBound(size_t index) const throw ();
+
+    /**
+     * Adds delta to the index of every entry starting at first.
+     *
+     * @param first
+     * @param delta
+     */
+    void shift(EntryIterator first, size_t delta) throw ();
+
+    /**
+     * Given an index, this method throws an std::out_of_range with the index as
+     * its message if index is out of bounds or is a no-op otherwise.
+     * This operation provides strong exception safety.
+     *
+     * @param index index to check
+     */
+    void rangeCheck(size_t index) const throw (std::out_of_range);
+
+    size_t mSize;
+    std::vector<Entry> mEntries;
+    T mDefault;
+};
+
+#include "../src/SparseList.cpp"
+
+#endif
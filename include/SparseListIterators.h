@@ -0,0 +1,62 @@
+#ifndef _SPARSE_LIST_ITERATORS_H_
+#define _SPARSE_LIST_ITERATORS_H_
+
+#include <iterator>
+#include "SparseList.h"
+
+/**
+ * A constant forward iterator over the present entries of a SparseList. Holes
+ * are skipped; index() reports the position of the current entry.
+ */
+template <typename T>
+class SparseListConstIterator : public std::iterator<std::forward_iterator_tag, T> {
+private:
+
+    friend class SparseList<T>;
+    typedef typename SparseList<T>::EntryConstIterator EntryConstIterator;
+    EntryConstIterator mIter;
+
+    explicit SparseListConstIterator(EntryConstIterator iter) : mIter(iter) {}
+
+public:
+
+    SparseListConstIterator() : mIter() {}
+
+    bool operator==(const SparseListConstIterator<T>& rhs) const {
+        return mIter == rhs.mIter;
+    }
+
+    bool operator!=(const SparseListConstIterator<T>& rhs) const {
+        return !(*this == rhs);
+    }
+
+    const T& operator*() const {
+        return mIter->mValue;
+    }
+
+    const T* operator->() const {
+        return &mIter->mValue;
+    }
+
+    /**
+     * Returns the list position of the current entry.
+     *
+     * @return
+     */
+    size_t index() const {
+        return mIter->mIndex;
+    }
+
+    SparseListConstIterator<T>& operator++() {
+        ++mIter;
+        return *this;
+    }
+
+    SparseListConstIterator<T> operator++(int) {
+        SparseListConstIterator<T> copy(*this);
+        ++*this;
+        return copy;
+    }
+};
+
+#endif
@@ -0,0 +1,173 @@
+#ifndef _SPSC_RING_QUEUE_H_
+#define _SPSC_RING_QUEUE_H_
+
+#include <atomic>
+#include <cstdlib>          // For size_t
+#include "QueueBase.h"
+#include "ScopedArray.h"
+
+/**
+ * A bounded, lock-free queue for exactly one producer thread and one consumer
+ * thread. The elements live in a ring whose size is a power of two, so that
+ * positions wrap with a mask instead of a division.
+ *
+ * The producer owns the tail index and the consumer owns the head index. Each
+ * index sits on its own cache line together with the owner's cached copy of
+ * the other index. The other side's line is only read when the cached copy
+ * says the ring is full (producer) or empty (consumer), so in the steady
+ * state the two threads do not bounce cache lines between them. An index is
+ * published with a release store and read with an acquire load, which makes
+ * the element written before it visible to the other thread. The bulk
+ * operations move a whole batch and publish it with one store.
+ *
+ * enqueue(), enqueueBulk() and the non-virtual tryEnqueue()/tryEnqueueBulk()
+ * may only be called from the producer thread. dequeue(), front(),
+ * tryDequeue(), dequeueValue() and dequeueBulk() may only be called from the
+ * consumer thread. size() and isEmpty() may be called from either one and
+ * are exact only when the other side is idle. Since the class is final, calls
+ * made through an SpscRingQueue rather than a QueueBase are not virtual.
+ */
+template <typename T>
+class SpscRingQueue final : public QueueBase<T> {
+public:
+
+    /**
+     * Initializes an empty queue that holds up to capacity elements. The
+     * capacity is rounded up to a power of two, and is at least 2.
+     *
+     * @param capacity minimum number of elements the queue can hold
+     */
+    explicit SpscRingQueue(size_t capacity);
+
+    /**
+     * Removes the front element from this queue. Throws Underflow if this queue
+     * is empty. Consumer only.
+     */
+    virtual void dequeue();
+
+    /**
+     * Removes the front element and returns it, moved out rather than copied.
+     * Throws Underflow if this queue is empty. Consumer only.
+     *
+     * @return
+     */
+    virtual T dequeueValue();
+
+    /**
+     * Adds value to the end of this queue, yielding the processor while the
+     * queue is full. Producer only.
+     *
+     * @param
+     */
+    virtual void enqueue(const T& value);
+
+    /**
+     * Returns a reference to the front of this queue. Throws Underflow if this
+     * queue is empty. Consumer only.
+     *
+     * @return
+     */
+    virtual const T& front() const;
+
+    /**
+     * Returns the number of elements in this queue.
+     *
+     * @return
+     */
+    virtual size_t size() const;
+
+    /**
+     * Moves the front element into out, removes it and returns true, or
+     * returns false if this queue is empty. Consumer only.
+     *
+     * @param out receives the front element
+     * @return
+     */
+    virtual bool tryDequeue(T& out);
+
+    /**
+     * Adds the count elements of values to the end of this queue, in order,
+     * yielding the processor while the queue is full. Each run of elements
+     * that fits is published at once. Producer only.
+     *
+     * @param values elements to enqueue
+     * @param count number of elements to enqueue
+     */
+    virtual void enqueueBulk(const T* values, size_t count);
+
+    /**
+     * Moves up to count elements from the front of this queue into out, in
+     * dequeue order, and removes them with a single store. Returns the number
+     * of elements moved, which is less than count only if the queue ran empty.
+     * Consumer only.
+     *
+     * @param out receives the dequeued elements
+     * @param count maximum number of elements to dequeue
+     * @return
+     */
+    virtual size_t dequeueBulk(T* out, size_t count);
+
+    /**
+     * Adds value to the end of this queue and returns true, or returns false
+     * if the queue is full. Producer only.
+     *
+     * @param value value to enqueue
+     * @return
+     */
+    bool tryEnqueue(const T& value);
+
+    /**
+     * Adds as many of the count elements of values as fit to the end of this
+     * queue, publishing them with a single store, and returns how many were
+     * added. Producer only.
+     *
+     * @param values elements to enqueue
+     * @param count number of elements to enqueue
+     * @return
+     */
+    size_t tryEnqueueBulk(const T* values, size_t count);
+
+    /**
+     * Returns the number of elements this queue can hold.
+     * This operation is a no-throw.
+     *
+     * @return
+     */
+    size_t capacity() const throw ();
+
+private:
+
+    SpscRingQueue(const SpscRingQueue&);
+    void operator=(const SpscRingQueue&);
+
+    enum {
+        kCacheLine = 64
+    };
+
+    /**
+     * Returns the smallest power of two that is at least capacity and 2.
+     *
+     * @param capacity
+     * @return
+     */
+    static size_t roundCapacity(size_t capacity);
+
+    // Read-only after construction
+    ScopedArray<T> mSlots;
+    size_t mMask;
+    char mPad0[kCacheLine];
+
+    // Producer line: the next position to write and the last head it saw
+    std::atomic<size_t> mTail;
+    size_t mHeadCache;
+    char mPad1[kCacheLine - sizeof(std::atomic<size_t>) - sizeof(size_t)];
+
+    // Consumer line: the next position to read and the last tail it saw
+    std::atomic<size_t> mHead;
+    size_t mTailCache;
+    char mPad2[kCacheLine - sizeof(std::atomic<size_t>) - sizeof(size_t)];
+};
+
+#include "../src/SpscRingQueue.cpp"
+
+#endif
@@ -2,6 +2,7 @@
 #define _STACK_ADAPTER_H_
 
 #include "StackBase.h"
+#include "StaticStack.h"
 #include <cstdlib>          // For size_t
 
 /**
@@ -17,6 +18,13 @@
  *   - a remove(size_t) method
  *   - a size_t size() const method
  *
+ * If the container also offers back(), removeLast(), reserve(size_t) or
+ * emplace(...), they are detected at compile time (see ContainerTraits.h) and
+ * used instead of the index based calls above.
+ *
+ * The work is done by a StaticStack; use one directly where the container type
+ * is known at compile time to avoid the virtual calls.
+ *
  * @author Krzysztof Zienkiewicz
  * @date October 21, 2011
  */
@@ -32,6 +40,14 @@ public:
      */
     virtual void pop();
 
+    /**
+     * Removes the top element and returns it, moved out rather than copied.
+     * Throws Underflow if this stack is empty.
+     *
+     * @return
+     */
+    virtual value_type popValue();
+
     /**
      * Adds value to the top of the stack.
      *
@@ -39,6 +55,23 @@ public:
      */
     virtual void push(const value_type& value);
 
+    /**
+     * Adds an element constructed from args to the top of the stack, in place
+     * if the container supports emplace().
+     *
+     * @param args
+     */
+    template <typename... Args>
+    void emplace(Args&&... args);
+
+    /**
+     * Makes room for capacity elements if the container supports reserve(),
+     * or does nothing otherwise.
+     *
+     * @param capacity
+     */
+    void reserve(size_t capacity);
+
     /**
      * Returns the size of this stack.
      *
@@ -46,6 +79,36 @@ public:
      */
     virtual size_t size() const;
 
+    /**
+     * Moves the top element into out, removes it and returns true, or returns
+     * false if this stack is empty.
+     *
+     * @param out receives the top element
+     * @return
+     */
+    virtual bool tryPop(value_type& out);
+
+    /**
+     * Adds the count elements of values to the top of the stack, so that
+     * values[count - 1] ends up on top.
+     * The container's addAll() is used when it has one.
+     *
+     * @param values elements to push
+     * @param count number of elements to push
+     */
+    virtual void pushBulk(const value_type* values, size_t count);
+
+    /**
+     * Moves up to count elements from the top of the stack into out, the top
+     * first, and removes them. Returns the number of elements moved, which is
+     * less than count only if the stack ran empty.
+     *
+     * @param out receives the popped elements
+     * @param count maximum number of elements to pop
+     * @return
+     */
+    virtual size_t popBulk(value_type* out, size_t count);
+
     /**
      * Returns a reference to the top of the stack. Throws Underflow if this
      * stack is empty.
@@ -56,7 +119,7 @@ public:
 
 private:
 
-    Container mContainer;
+    StaticStack<Container> mStack;
 };
 
 #include "../src/StackAdapter.cpp"
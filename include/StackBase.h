@@ -32,6 +32,14 @@ public:
      */
     virtual void pop() = 0;
 
+    /**
+     * Removes the top element and returns it, moved out rather than copied.
+     * Throws Underflow if this stack is empty.
+     *
+     * @return
+     */
+    virtual T popValue();
+
     /**
      * Adds value to the top of the stack.
      *
@@ -46,6 +54,39 @@ public:
      */
     virtual size_t size() const = 0;
 
+    /**
+     * Moves the top element into out, removes it and returns true, or returns
+     * false if this stack is empty. Unlike pop(), an empty stack is not an
+     * error, so polling a mostly empty stack costs a branch rather than an
+     * exception.
+     *
+     * @param out receives the top element
+     * @return
+     */
+    virtual bool tryPop(T& out);
+
+    /**
+     * Adds the count elements of values to the top of the stack, so that
+     * values[count - 1] ends up on top.
+     * The default implementation pushes them one at a time.
+     *
+     * @param values elements to push
+     * @param count number of elements to push
+     */
+    virtual void pushBulk(const T* values, size_t count);
+
+    /**
+     * Moves up to count elements from the top of the stack into out, the top
+     * first, and removes them. Returns the number of elements moved, which is
+     * less than count only if the stack ran empty.
+     * The default implementation pops them one at a time.
+     *
+     * @param out receives the popped elements
+     * @param count maximum number of elements to pop
+     * @return
+     */
+    virtual size_t popBulk(T* out, size_t count);
+
     /**
      * Returns a reference to the top of the stack. Throws Underflow if this
      * stack is empty.
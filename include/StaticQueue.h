@@ -0,0 +1,119 @@
+#ifndef _STATIC_QUEUE_H_
+#define _STATIC_QUEUE_H_
+
+#include "StaticQueueBase.h"
+#include <cstdlib>          // For size_t
+#include <type_traits>      // For std::true_type, std::false_type
+
+/**
+ * A statically dispatched queue on top of a container, with the same
+ * requirements on the container as QueueAdapter. No call made on a
+ * StaticQueue is virtual, so enqueue(), dequeue() and front() inline down to
+ * the container's own methods. As with QueueAdapter, front(), removeFirst(),
+ * reserve(size_t) and emplace(...) are used when the container has them.
+ *
+ * QueueAdapter wraps a StaticQueue, so both behave identically.
+ */
+template <typename Container>
+class StaticQueue : public StaticQueueBase<StaticQueue<Container>, typename Container::value_type> {
+public:
+
+    typedef typename Container::value_type value_type;
+
+    /**
+     * Adds an element constructed from args to the end of this queue, in place
+     * if the container supports emplace().
+     *
+     * @param args
+     */
+    template <typename... Args>
+    void emplace(Args&&... args);
+
+    /**
+     * Adds the elements of the forward range [first, last) to the end of this
+     * queue, in order. The container's addAll() is used when it has one;
+     * otherwise room is reserved once if possible.
+     *
+     * @param first iterator to the first element to enqueue
+     * @param last iterator one past the last element to enqueue
+     */
+    template <typename InputIterator>
+    void enqueueBulk(InputIterator first, InputIterator last);
+
+    /**
+     * Adds the count elements of values to the end of this queue, in order.
+     *
+     * @param values elements to enqueue
+     * @param count number of elements to enqueue
+     */
+    void enqueueBulk(const value_type* values, size_t count);
+
+    /**
+     * Moves up to count elements from the front of this queue into out, in
+     * dequeue order, and removes them. Returns the number of elements moved,
+     * which is less than count only if the queue ran empty. Containers with
+     * removeFirst() give up their elements one by one; otherwise the
+     * container's removeRange() is used to shift the rest down only once.
+     * In that case the elements are copied out rather than moved, and if
+     * removing them throws, the ones not yet removed stay in this queue while
+     * out may already hold copies of them.
+     *
+     * @param out receives the dequeued elements
+     * @param count maximum number of elements to dequeue
+     * @return
+     */
+    size_t dequeueBulk(value_type* out, size_t count);
+
+    /**
+     * Makes room for capacity elements if the container supports reserve(),
+     * or does nothing otherwise.
+     *
+     * @param capacity
+     */
+    void reserve(size_t capacity);
+
+    /**
+     * Returns the size of this queue.
+     *
+     * @return
+     */
+    size_t size() const;
+
+private:
+
+    friend class StaticQueueBase<StaticQueue<Container>, value_type>;
+
+    void doDequeue();
+    void doEnqueue(const value_type& value);
+    const value_type& doFront() const;
+
+    void popFront(std::true_type);
+    void popFront(std::false_type);
+
+    const value_type& peek(std::true_type) const;
+    const value_type& peek(std::false_type) const;
+
+    template <typename... Args>
+    void emplaceBack(std::true_type, Args&&... args);
+    template <typename... Args>
+    void emplaceBack(std::false_type, Args&&... args);
+
+    template <typename InputIterator>
+    void appendAll(InputIterator first, InputIterator last, std::true_type);
+    template <typename InputIterator>
+    void appendAll(InputIterator first, InputIterator last, std::false_type);
+
+    template <typename HasRange>
+    void takeFront(value_type* out, size_t count, std::true_type, HasRange);
+    void takeFront(value_type* out, size_t count, std::false_type, std::true_type);
+    void takeFront(value_type* out, size_t count, std::false_type, std::false_type);
+
+    void reserve(size_t capacity, std::true_type);
+    void reserve(size_t capacity, std::false_type);
+
+    Container mContainer;
+};
+
+#include "../src/StaticQueue.cpp"
+
+#endif
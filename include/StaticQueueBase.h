@@ -0,0 +1,89 @@
+#ifndef _STATIC_QUEUE_BASE_H_
+#define _STATIC_QUEUE_BASE_H_
+
+#include <cstdlib>      // For size_t
+
+/**
+ * A CRTP counterpart of QueueBase for queues whose type is known at compile
+ * time. It offers the same interface and the same Underflow behavior (it
+ * throws QueueBase<T>::Underflow), but every call is resolved statically and
+ * can be inlined into the caller. Derived must provide:
+ *   - a size_t size() const method
+ *   - a doEnqueue(const T&) method
+ *   - a doDequeue() method, only called when the queue is not empty
+ *   - a const T& doFront() const method, only called when the queue is not
+ *     empty
+ *
+ * Derived classes are not meant to be used through a pointer to this class,
+ * which is why its destructor is protected and non-virtual.
+ */
+template <typename Derived, typename T>
+class StaticQueueBase {
+public:
+
+    /**
+     * Removes the front element from this queue. Throws
+     * QueueBase<T>::Underflow if this queue is empty.
+     */
+    void dequeue();
+
+    /**
+     * Removes the front element and returns it, moved out rather than copied.
+     * Throws QueueBase<T>::Underflow if this queue is empty.
+     *
+     * @return
+     */
+    T dequeueValue();
+
+    /**
+     * Adds value to the end of this queue.
+     *
+     * @param
+     */
+    void enqueue(const T& value);
+
+    /**
+     * Returns a reference to the front of this queue. Throws
+     * QueueBase<T>::Underflow if this queue is empty.
+     *
+     * @return
+     */
+    const T& front() const;
+
+    /**
+     * Returns a reference to the front of this queue. Throws
+     * QueueBase<T>::Underflow if this queue is empty.
+     *
+     * @return
+     */
+    T& front();
+
+    /**
+     * Returns true if this queue is empty.
+     *
+     * @return
+     */
+    bool isEmpty() const;
+
+    /**
+     * Moves the front element into out, removes it and returns true, or
+     * returns false if this queue is empty.
+     *
+     * @param out receives the front element
+     * @return
+     */
+    bool tryDequeue(T& out);
+
+protected:
+
+    ~StaticQueueBase() {}
+
+private:
+
+    const Derived& derived() const;
+    Derived& derived();
+};
+
+#include "../src/StaticQueueBase.cpp"
+
+#endif
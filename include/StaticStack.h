@@ -0,0 +1,110 @@
+#ifndef _STATIC_STACK_H_
+#define _STATIC_STACK_H_
+
+#include "StaticStackBase.h"
+#include <cstdlib>          // For size_t
+#include <type_traits>      // For std::true_type, std::false_type
+
+/**
+ * A statically dispatched stack on top of a container, with the same
+ * requirements on the container as StackAdapter. No call made on a
+ * StaticStack is virtual, so push(), pop() and top() inline down to the
+ * container's own methods. As with StackAdapter, back(), removeLast(),
+ * reserve(size_t) and emplace(...) are used when the container has them.
+ *
+ * StackAdapter wraps a StaticStack, so both behave identically.
+ */
+template <typename Container>
+class StaticStack : public StaticStackBase<StaticStack<Container>, typename Container::value_type> {
+public:
+
+    typedef typename Container::value_type value_type;
+
+    /**
+     * Adds an element constructed from args to the top of the stack, in place
+     * if the container supports emplace().
+     *
+     * @param args
+     */
+    template <typename... Args>
+    void emplace(Args&&... args);
+
+    /**
+     * Adds the elements of the forward range [first, last) to the top of the
+     * stack, the last one ending up on top. The container's addAll() is used
+     * when it has one; otherwise room is reserved once if possible.
+     *
+     * @param first iterator to the first element to push
+     * @param last iterator one past the last element to push
+     */
+    template <typename InputIterator>
+    void pushBulk(InputIterator first, InputIterator last);
+
+    /**
+     * Adds the count elements of values to the top of the stack, so that
+     * values[count - 1] ends up on top.
+     *
+     * @param values elements to push
+     * @param count number of elements to push
+     */
+    void pushBulk(const value_type* values, size_t count);
+
+    /**
+     * Moves up to count elements from the top of the stack into out, the top
+     * first, and removes them. Returns the number of elements moved, which is
+     * less than count only if the stack ran empty.
+     *
+     * @param out receives the popped elements
+     * @param count maximum number of elements to pop
+     * @return
+     */
+    size_t popBulk(value_type* out, size_t count);
+
+    /**
+     * Makes room for capacity elements if the container supports reserve(),
+     * or does nothing otherwise.
+     *
+     * @param capacity
+     */
+    void reserve(size_t capacity);
+
+    /**
+     * Returns the size of this stack.
+     *
+     * @return
+     */
+    size_t size() const;
+
+private:
+
+    friend class StaticStackBase<StaticStack<Container>, value_type>;
+
+    void doPop();
+    void doPush(const value_type& value);
+    const value_type& doTop() const;
+
+    void popBack(std::true_type);
+    void popBack(std::false_type);
+
+    const value_type& peek(std::true_type) const;
+    const value_type& peek(std::false_type) const;
+
+    template <typename... Args>
+    void emplaceBack(std::true_type, Args&&... args);
+    template <typename... Args>
+    void emplaceBack(std::false_type, Args&&... args);
+
+    template <typename InputIterator>
+    void appendAll(InputIterator first, InputIterator last, std::true_type);
+    template <typename InputIterator>
+    void appendAll(InputIterator first, InputIterator last, std::false_type);
+
+    void reserve(size_t capacity, std::true_type);
+    void reserve(size_t capacity, std::false_type);
+
+    Container mContainer;
+};
+
+#include "../src/StaticStack.cpp"
+
+#endif
@@ -0,0 +1,88 @@
+#ifndef _STATIC_STACK_BASE_H_
+#define _STATIC_STACK_BASE_H_
+
+#include <cstdlib>      // For size_t
+
+/**
+ * A CRTP counterpart of StackBase for stacks whose type is known at compile
+ * time. It offers the same interface and the same Underflow behavior (it
+ * throws StackBase<T>::Underflow), but every call is resolved statically and
+ * can be inlined into the caller. Derived must provide:
+ *   - a size_t size() const method
+ *   - a doPush(const T&) method
+ *   - a doPop() method, only called when the stack is not empty
+ *   - a const T& doTop() const method, only called when the stack is not empty
+ *
+ * Derived classes are not meant to be used through a pointer to this class,
+ * which is why its destructor is protected and non-virtual.
+ */
+template <typename Derived, typename T>
+class StaticStackBase {
+public:
+
+    /**
+     * Returns true if this stack is empty.
+     *
+     * @return
+     */
+    bool isEmpty() const;
+
+    /**
+     * Removes the top element from the stack. Throws StackBase<T>::Underflow
+     * if this stack is empty.
+     */
+    void pop();
+
+    /**
+     * Removes the top element and returns it, moved out rather than copied.
+     * Throws StackBase<T>::Underflow if this stack is empty.
+     *
+     * @return
+     */
+    T popValue();
+
+    /**
+     * Adds value to the top of the stack.
+     *
+     * @param
+     */
+    void push(const T& value);
+
+    /**
+     * Moves the top element into out, removes it and returns true, or returns
+     * false if this stack is empty.
+     *
+     * @param out receives the top element
+     * @return
+     */
+    bool tryPop(T& out);
+
+    /**
+     * Returns a reference to the top of the stack. Throws
+     * StackBase<T>::Underflow if this stack is empty.
+     *
+     * @return
+     */
+    const T& top() const;
+
+    /**
+     * Returns a reference to the top of the stack. Throws
+     * StackBase<T>::Underflow if this stack is empty.
+     *
+     * @return
+     */
+    T& top();
+
+protected:
+
+    ~StaticStackBase() {}
+
+private:
+
+    const Derived& derived() const;
+    Derived& derived();
+};
+
+#include "../src/StaticStackBase.cpp"
+
+#endif
@@ -0,0 +1,201 @@
+#ifndef _TASK_POOL_H_
+#define _TASK_POOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>          // For size_t
+#include <functional>       // For std::function
+#include <memory>           // For std::unique_ptr
+#include <mutex>
+#include <stdint.h>         // For uint32_t, uint64_t
+#include <thread>
+#include <vector>
+#include "BlockingQueue.h"
+#include "LinkedList.h"
+#include "WorkStealingDeque.h"
+
+/**
+ * A fixed set of worker threads that run submitted tasks, balancing the load
+ * by work stealing instead of through a central queue.
+ *
+ * Every worker owns a WorkStealingDeque. A task submitted from a worker goes
+ * to the bottom of that worker's deque, and the worker runs its own tasks
+ * newest first. A worker whose deque is empty takes tasks submitted from
+ * outside the pool, which wait in a shared queue, and then steals the oldest
+ * task of a victim picked at random. In recursive decomposition the oldest
+ * task is the largest piece left, so a few steals spread the work. A worker
+ * that keeps finding nothing parks on a condition variable until a task is
+ * submitted.
+ *
+ * parallelFor() splits an index range in halves down to a grain size. The
+ * calling thread works on the range itself and, while it waits for the rest,
+ * runs other tasks, so parallelFor() may be nested inside tasks without
+ * running out of threads. wait() helps in the same way.
+ *
+ * A task passed to submit() must not throw; as with std::thread, an escaping
+ * exception terminates the program. The first exception thrown by the body
+ * of a parallelFor() is rethrown to its caller once the range is done.
+ */
+class TaskPool {
+public:
+
+    /**
+     * Starts workers worker threads. If workers is 0, one worker per hardware
+     * thread is started.
+     *
+     * @param workers number of worker threads
+     */
+    explicit TaskPool(size_t workers = 0);
+
+    /**
+     * Waits for all tasks to finish and stops the workers.
+     */
+    ~TaskPool();
+
+    /**
+     * Schedules work, a function object taking no arguments, to run on one of
+     * the workers.
+     *
+     * @param work task to run
+     */
+    template <typename Function>
+    void submit(Function work);
+
+    /**
+     * Calls body(i) for every i in [begin, end), in parallel, and returns once
+     * all calls are done. Ranges of at most grain indices are not split
+     * further. If a call throws, the first exception is rethrown once the
+     * other calls are done; the rest of the range that threw is skipped.
+     *
+     * @param begin first index
+     * @param end index one past the last
+     * @param body function object called with each index
+     * @param grain size of the smallest range run as one task
+     */
+    template <typename Function>
+    void parallelFor(size_t begin, size_t end, Function body, size_t grain = 1);
+
+    /**
+     * Runs tasks on the calling thread until every submitted task, and every
+     * task those submitted, has finished.
+     */
+    void wait();
+
+    /**
+     * Returns the number of worker threads.
+     * This operation is a no-throw.
+     *
+     * @return
+     */
+    size_t workerCount() const throw ();
+
+private:
+
+    typedef std::function<void()> Task;
+
+    TaskPool(const TaskPool&);
+    void operator=(const TaskPool&);
+
+    enum {
+        kIdleRounds = 16
+    };
+
+    struct Worker {
+        WorkStealingDeque<Task*> mDeque;
+        std::thread mThread;
+    };
+
+    /**
+     * The pool and worker index the calling thread works for, if any.
+     */
+    struct Current {
+        TaskPool* mPool;
+        size_t mIndex;
+    };
+
+    /**
+     * The loop run by worker index.
+     *
+     * @param index
+     */
+    void run(size_t index);
+
+    /**
+     * Counts task as pending and hands it to the calling worker's deque, or to
+     * the shared queue if the calling thread is not one of this pool's
+     * workers.
+     *
+     * @param task
+     */
+    void schedule(Task* task);
+
+    /**
+     * Returns a task for the calling thread, from its own deque if it is a
+     * worker, then from the shared queue, then stolen from a random victim,
+     * or null if none was found.
+     *
+     * @return
+     */
+    Task* findTask();
+
+    /**
+     * Runs and deletes task.
+     *
+     * @param task
+     */
+    void execute(Task* task);
+
+    /**
+     * Runs tasks on the calling thread until done() returns true, parking
+     * when there is nothing to run.
+     *
+     * @param done
+     */
+    template <typename Predicate>
+    void helpUntil(Predicate done);
+
+    /**
+     * Parks the calling thread until notify() is called after epoch was read
+     * or the pool stops.
+     *
+     * @param epoch
+     */
+    void park(uint64_t epoch);
+
+    /**
+     * Tells parked threads that something changed, waking one of them or all.
+     *
+     * @param all
+     */
+    void notify(bool all);
+
+    /**
+     * Returns the calling thread's Current.
+     *
+     * @return
+     */
+    static Current& current() throw ();
+
+    /**
+     * Returns a pseudo-random number from a generator private to the calling
+     * thread.
+     *
+     * @return
+     */
+    static uint32_t random() throw ();
+
+    std::vector<std::unique_ptr<Worker> > mWorkers;
+    BlockingQueue<LinkedList<Task*> > mInjected;
+    std::atomic<size_t> mPending;
+
+    // Parking
+    std::atomic<uint64_t> mEpoch;
+    std::atomic<size_t> mParked;
+    std::atomic<bool> mStopping;
+    std::mutex mMutex;
+    std::condition_variable mWake;
+};
+
+#include "../src/TaskPool.cpp"
+
+#endif
@@ -0,0 +1,162 @@
+#ifndef _VARIANT_QUEUE_H_
+#define _VARIANT_QUEUE_H_
+
+#include <cstdlib>          // For size_t
+#include "ArrayList.h"
+#include "LinkedList.h"
+#include "StaticQueue.h"
+
+/**
+ * A queue whose backing container is chosen at runtime, like the queues
+ * returned through QueueBase pointers, but without virtual calls. The
+ * StaticQueue for each supported container lives in a tagged union, and
+ * every operation switches on the tag. The branch is predictable in a loop
+ * and each case inlines, unlike an indirect call through a vtable.
+ *
+ * The interface and the Underflow behavior are those of QueueBase.
+ * VariantQueues can be copied but not assigned.
+ */
+template <typename T>
+class VariantQueue {
+public:
+
+    typedef T value_type;
+
+    /**
+     * The supported backing containers.
+     */
+    enum Kind {
+        ARRAY,      // ArrayList<T>
+        LINKED      // LinkedList<T>
+    };
+
+    /**
+     * Initializes an empty queue backed by the container selected by kind.
+     * This operation provides strong exception safety.
+     *
+     * @param kind backing container to use
+     */
+    explicit VariantQueue(Kind kind = ARRAY);
+
+    /**
+     * Initializes the VariantQueue to be a copy of src, using the same kind of
+     * container.
+     * This operation provides strong exception safety.
+     *
+     * @param src VariantQueue to copy
+     */
+    VariantQueue(const VariantQueue<T>& src);
+
+    /**
+     * Destroys the active container.
+     */
+    ~VariantQueue();
+
+    /**
+     * Returns true if this queue is empty.
+     *
+     * @return
+     */
+    bool isEmpty() const;
+
+    /**
+     * Returns the kind of container backing this queue.
+     * This operation is a no-throw.
+     *
+     * @return
+     */
+    Kind kind() const throw ();
+
+    /**
+     * Removes the front element from this queue. Throws
+     * QueueBase<T>::Underflow if this queue is empty.
+     */
+    void dequeue();
+
+    /**
+     * Removes the front element and returns it, moved out rather than copied.
+     * Throws QueueBase<T>::Underflow if this queue is empty.
+     *
+     * @return
+     */
+    T dequeueValue();
+
+    /**
+     * Adds value to the end of this queue.
+     *
+     * @param
+     */
+    void enqueue(const T& value);
+
+    /**
+     * Returns the size of this queue.
+     *
+     * @return
+     */
+    size_t size() const;
+
+    /**
+     * Moves the front element into out, removes it and returns true, or
+     * returns false if this queue is empty.
+     *
+     * @param out receives the front element
+     * @return
+     */
+    bool tryDequeue(T& out);
+
+    /**
+     * Adds the count elements of values to the end of this queue, in order.
+     *
+     * @param values elements to enqueue
+     * @param count number of elements to enqueue
+     */
+    void enqueueBulk(const T* values, size_t count);
+
+    /**
+     * Moves up to count elements from the front of this queue into out, in
+     * dequeue order, and removes them. Returns the number of elements moved,
+     * which is less than count only if the queue ran empty.
+     *
+     * @param out receives the dequeued elements
+     * @param count maximum number of elements to dequeue
+     * @return
+     */
+    size_t dequeueBulk(T* out, size_t count);
+
+    /**
+     * Returns a reference to the front of this queue. Throws
+     * QueueBase<T>::Underflow if this queue is empty.
+     *
+     * @return
+     */
+    const T& front() const;
+
+    /**
+     * Returns a reference to the front of this queue. Throws
+     * QueueBase<T>::Underflow if this queue is empty.
+     *
+     * @return
+     */
+    T& front();
+
+private:
+
+    // Not assignable: replacing one kind of container with another could not
+    // be done with strong exception safety.
+    void operator=(const VariantQueue<T>&);
+
+    /**
+     * Destroys the active member of the union.
+     */
+    void destroy();
+
+    Kind mKind;
+    union {
+        StaticQueue<ArrayList<T> > mArray;
+        StaticQueue<LinkedList<T> > mLinked;
+    };
+};
+
+#include "../src/VariantQueue.cpp"
+
+#endif
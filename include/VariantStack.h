@@ -0,0 +1,163 @@
+#ifndef _VARIANT_STACK_H_
+#define _VARIANT_STACK_H_
+
+#include <cstdlib>          // For size_t
+#include "ArrayList.h"
+#include "LinkedList.h"
+#include "StaticStack.h"
+
+/**
+ * A stack whose backing container is chosen at runtime, like the stacks
+ * returned through StackBase pointers, but without virtual calls. The
+ * StaticStack for each supported container lives in a tagged union, and
+ * every operation switches on the tag. The branch is predictable in a loop
+ * and each case inlines, unlike an indirect call through a vtable.
+ *
+ * The interface and the Underflow behavior are those of StackBase.
+ * VariantStacks can be copied but not assigned.
+ */
+template <typename T>
+class VariantStack {
+public:
+
+    typedef T value_type;
+
+    /**
+     * The supported backing containers.
+     */
+    enum Kind {
+        ARRAY,      // ArrayList<T>
+        LINKED      // LinkedList<T>
+    };
+
+    /**
+     * Initializes an empty stack backed by the container selected by kind.
+     * This operation provides strong exception safety.
+     *
+     * @param kind backing container to use
+     */
+    explicit VariantStack(Kind kind = ARRAY);
+
+    /**
+     * Initializes the VariantStack to be a copy of src, using the same kind of
+     * container.
+     * This operation provides strong exception safety.
+     *
+     * @param src VariantStack to copy
+     */
+    VariantStack(const VariantStack<T>& src);
+
+    /**
+     * Destroys the active container.
+     */
+    ~VariantStack();
+
+    /**
+     * Returns true if this stack is empty.
+     *
+     * @return
+     */
+    bool isEmpty() const;
+
+    /**
+     * Returns the kind of container backing this stack.
+     * This operation is a no-throw.
+     *
+     * @return
+     */
+    Kind kind() const throw ();
+
+    /**
+     * Removes the top element from the stack. Throws StackBase<T>::Underflow
+     * if this stack is empty.
+     */
+    void pop();
+
+    /**
+     * Removes the top element and returns it, moved out rather than copied.
+     * Throws StackBase<T>::Underflow if this stack is empty.
+     *
+     * @return
+     */
+    T popValue();
+
+    /**
+     * Adds value to the top of the stack.
+     *
+     * @param
+     */
+    void push(const T& value);
+
+    /**
+     * Returns the size of this stack.
+     *
+     * @return
+     */
+    size_t size() const;
+
+    /**
+     * Moves the top element into out, removes it and returns true, or
+     * returns false if this stack is empty.
+     *
+     * @param out receives the top element
+     * @return
+     */
+    bool tryPop(T& out);
+
+    /**
+     * Adds the count elements of values to the top of the stack, so that
+     * values[count - 1] ends up on top.
+     *
+     * @param values elements to push
+     * @param count number of elements to push
+     */
+    void pushBulk(const T* values, size_t count);
+
+    /**
+     * Moves up to count elements from the top of the stack into out, the top
+     * first, and removes them. Returns the number of elements moved, which is
+     * less than count only if the stack ran empty.
+     *
+     * @param out receives the popped elements
+     * @param count maximum number of elements to pop
+     * @return
+     */
+    size_t popBulk(T* out, size_t count);
+
+    /**
+     * Returns a reference to the top of the stack. Throws
+     * StackBase<T>::Underflow if this stack is empty.
+     *
+     * @return
+     */
+    const T& top() const;
+
+    /**
+     * Returns a reference to the top of the stack. Throws
+     * StackBase<T>::Underflow if this stack is empty.
+     *
+     * @return
+     */
+    T& top();
+
+private:
+
+    // Not assignable: replacing one kind of container with another could not
+    // be done with strong exception safety.
+    void operator=(const VariantStack<T>&);
+
+    /**
+     * Destroys the active member of the union.
+     */
+    void destroy();
+
+    Kind mKind;
+    union {
+        StaticStack<ArrayList<T> > mArray;
+        StaticStack<LinkedList<T> > mLinked;
+    };
+};
+
+#include "../src/VariantStack.cpp"
+
+#endif
@@ -0,0 +1,105 @@
+#ifndef _WAIT_STRATEGY_H_
+#define _WAIT_STRATEGY_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>          // For size_t
+#include <mutex>
+
+/**
+ * Wait strategies decide how a thread waits for a condition that another
+ * thread will make true, such as a sequence advancing in a MulticastRing.
+ * They are used as template parameters, so the choice costs nothing at run
+ * time. Each offers:
+ *   - waitUntil(ready), which returns once ready() returns true.
+ *   - signal(), which the other thread calls after every change that may
+ *     make a waiter's condition true.
+ *
+ * BusySpinWait burns its core and reacts fastest; use it only with a core
+ * per waiting thread. YieldWait spins briefly and then yields the processor
+ * between checks. BlockingWait spins briefly and then parks on a condition
+ * variable; it is the only one that leaves an idle core idle, at the price
+ * of a check on every signal() and a wake-up latency.
+ */
+class BusySpinWait {
+public:
+
+    /**
+     * Spins until ready() returns true.
+     *
+     * @param ready
+     */
+    template <typename Predicate>
+    void waitUntil(Predicate ready);
+
+    /**
+     * Does nothing, since nobody sleeps.
+     * This operation is a no-throw.
+     */
+    void signal() throw ();
+};
+
+class YieldWait {
+public:
+
+    /**
+     * Spins for a while, then yields the processor between calls to ready()
+     * until it returns true.
+     *
+     * @param ready
+     */
+    template <typename Predicate>
+    void waitUntil(Predicate ready);
+
+    /**
+     * Does nothing, since nobody sleeps.
+     * This operation is a no-throw.
+     */
+    void signal() throw ();
+
+private:
+
+    enum {
+        kSpinCount = 100
+    };
+};
+
+class BlockingWait {
+public:
+
+    /**
+     * Initializes the strategy with nobody waiting.
+     */
+    BlockingWait();
+
+    /**
+     * Spins for a while, then parks until ready() returns true.
+     *
+     * @param ready
+     */
+    template <typename Predicate>
+    void waitUntil(Predicate ready);
+
+    /**
+     * Wakes parked waiters, if there are any, so that they recheck their
+     * conditions.
+     */
+    void signal();
+
+private:
+
+    BlockingWait(const BlockingWait&);
+    void operator=(const BlockingWait&);
+
+    enum {
+        kSpinCount = 100
+    };
+
+    std::atomic<size_t> mWaiters;
+    std::mutex mMutex;
+    std::condition_variable mWake;
+};
+
+#include "../src/WaitStrategy.cpp"
+
+#endif
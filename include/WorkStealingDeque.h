@@ -0,0 +1,146 @@
+#ifndef _WORK_STEALING_DEQUE_H_
+#define _WORK_STEALING_DEQUE_H_
+
+#include <atomic>
+#include <cstdlib>          // For size_t
+#include <stdint.h>         // For int64_t
+
+/**
+ * A lock-free double-ended queue owned by one thread and robbed by others,
+ * after Chase and Lev, with the memory orders of Lê, Pop, Cohen and Zappa
+ * Nardelli. It is meant as the per-worker task list of a work-stealing
+ * scheduler (see TaskPool).
+ *
+ * The owner pushes and pops at the bottom, so it works on its most recent,
+ * cache-hot elements in LIFO order and only synchronizes with thieves when
+ * one element is left. Any other thread may steal from the top, taking the
+ * oldest element, which in recursive decomposition is the largest piece of
+ * work. A steal that loses a race against the owner or another thief fails
+ * instead of retrying, so that the thief can try another victim.
+ *
+ * The elements live in a circular array whose size is a power of two. When
+ * the owner finds it full, it copies the live elements into an array twice
+ * as large. Thieves may still be reading the old array, so retired arrays
+ * are kept until the deque is destroyed; they add up to less than the final
+ * array.
+ *
+ * Elements are read by thieves while the owner may overwrite them, so they
+ * are held in atomics and T must be trivially copyable; pointers and
+ * indices are the intended use.
+ */
+template <typename T>
+class WorkStealingDeque {
+public:
+
+    typedef T value_type;
+
+    /**
+     * Initializes an empty deque with room for capacity elements before it
+     * first grows. The capacity is rounded up to a power of two.
+     *
+     * @param capacity initial number of slots
+     */
+    explicit WorkStealingDeque(size_t capacity = 64);
+
+    /**
+     * Destroys the deque and all of its arrays. No thread may use the deque
+     * any more.
+     * This operation is a no-throw.
+     */
+    ~WorkStealingDeque() throw ();
+
+    /**
+     * Adds value at the bottom, growing the array if it is full. Owner only.
+     * This operation provides strong exception safety.
+     *
+     * @param value value to push
+     */
+    void push(value_type value);
+
+    /**
+     * Removes the bottom element into out and returns true, or returns false
+     * if the deque is empty or a thief took the last element. Owner only.
+     * This operation is a no-throw.
+     *
+     * @param out receives the bottom element
+     * @return
+     */
+    bool pop(value_type& out) throw ();
+
+    /**
+     * Removes the top element into out and returns true, or returns false if
+     * the deque is empty or another thread won the race for the element. Any
+     * thread.
+     * This operation is a no-throw.
+     *
+     * @param out receives the top element
+     * @return
+     */
+    bool steal(value_type& out) throw ();
+
+    /**
+     * Returns true if the deque looked empty.
+     * This operation is a no-throw.
+     *
+     * @return
+     */
+    bool isEmpty() const throw ();
+
+    /**
+     * Returns the number of elements the deque held a moment ago.
+     * This operation is a no-throw.
+     *
+     * @return
+     */
+    size_t size() const throw ();
+
+private:
+
+    WorkStealingDeque(const WorkStealingDeque&);
+    void operator=(const WorkStealingDeque&);
+
+    enum {
+        kCacheLine = 64
+    };
+
+    /**
+     * A circular array of slots, linked to the array it replaced.
+     */
+    struct Array {
+        explicit Array(size_t capacity) : mMask(capacity - 1), mSlots(new std::atomic<T>[capacity]), mPrevious(0) {}
+        ~Array() { delete[] mSlots; }
+
+        T get(int64_t index) const { return mSlots[index & mMask].load(std::memory_order_relaxed); }
+        void put(int64_t index, T value) { mSlots[index & mMask].store(value, std::memory_order_relaxed); }
+        int64_t capacity() const { return static_cast<int64_t>(mMask + 1); }
+
+        size_t mMask;
+        std::atomic<T>* mSlots;
+        Array* mPrevious;
+    };
+
+    /**
+     * Replaces array, which holds the elements [top, bottom), with one twice
+     * as large and returns the new array. Owner only.
+     * This operation provides strong exception safety.
+     *
+     * @param array
+     * @param top
+     * @param bottom
+     * @return
+     */
+    Array* grow(Array* array, int64_t top, int64_t bottom);
+
+    // Stolen from by every thread
+    std::atomic<int64_t> mTop;
+    char mPad0[kCacheLine - sizeof(std::atomic<int64_t>)];
+
+    // Written by the owner only
+    std::atomic<int64_t> mBottom;
+    std::atomic<Array*> mArray;
+    char mPad1[kCacheLine - sizeof(std::atomic<int64_t>) - sizeof(std::atomic<Array*>)];
+};
+
+#include "../src/WorkStealingDeque.cpp"
+
+#endif
@@ -4,37 +4,60 @@
 #include "../include/ArrayList.h"
 #include "../include/ScopedArray.h"
 #include "../include/ArrayListIterators.h"
+#include "../include/ListSerialization.h"
+#include "../include/ArrayListSubList.h"
 #include <cstdlib>                  // For size_t
-#include <stdexcept>                // For std::out_of_range
+#include <stdexcept>                // For std::out_of_range, std::runtime_error
 #include <sstream>                  // For std::ostringstream
 #include <algorithm>
+#include <iterator>                 // For std::distance
+#include <limits>                   // For std::numeric_limits
+#include <type_traits>              // For std::is_trivial, std::is_trivially_copyable,
+                                    // std::is_nothrow_copy_assignable
 
 
 /**
  * Initializes the ArrayList with size elements all set to value. If size is
  * not supplied, an empty ArrayList is created. If value is not supplied,
  * the default value for the parametrized type will be used.
+ * The optional storage selects where this ArrayList obtains its memory
+ * for the rest of its lifetime (see ArrayStorage), e.g. huge page backed
+ * mappings for very large lists or 64-byte aligned heap memory for SIMD.
+ * If storage is the default HEAP, the parametrized type is trivial and
+ * value is all zero bytes, the storage is requested zero-filled from the
+ * system instead of being filled element by element. Large lists then
+ * only commit memory for the pages that are actually written.
  * This operation provides strong exception safety.
  *
  * @param size size of the ArrayList to create
  * @param value value used to fill the ArrayList
+ * @param storage where to allocate the elements from
  */
 template <typename T>
-ArrayList<T>::ArrayList(size_t size, const_reference value)
-        : mSize(size), mCapacity(size * 2), mArray(new T[mCapacity]) {
-    std::fill(begin(), end(), value);
+ArrayList<T>::ArrayList(size_t size, const_reference value, const ArrayStorage& storage)
+        : mSize(size), mCapacity(size * 2), mArray() {
+    bool zero = isZeroFill(value);
+    ArrayStorage actual = storage;
+    if (zero && actual.backing() == ArrayStorage::HEAP)
+        actual = ArrayStorage(ArrayStorage::ZEROED);
+
+    ScopedArray<T> temp(mCapacity, actual);
+    if (!(zero && actual.zeroFilled()))
+        std::fill(temp.get(), temp.get() + mSize, value);
+    mArray.swap(temp);
 }
 
 /**
  * Initializes the ArrayList to be a copy of src. Only the logical values of
  * src are copied. This means that any excess capacity of src is ignored.
+ * The copy uses the same kind of storage as src.
  * This operation provides strong exception safety.
  *
  * @param src ArrayList to copy
  */
 template <typename T>
 ArrayList<T>::ArrayList(const ArrayList<T>& src)
-        : mSize(src.mSize), mCapacity(src.mSize), mArray(new T[mCapacity]) {
+        : mSize(src.mSize), mCapacity(src.mSize), mArray(mCapacity, src.mArray.storage()) {
     std::copy(src.begin(), src.end(), begin());
 }
 
@@ -59,7 +82,8 @@ const ArrayList<T>& ArrayList<T>::operator=(const ArrayList<T>& rhs) {
 /**
  * Adds value to the end of this ArrayList. If we have excess capacity,
  * the insertion is performed in constant time. Otherwise, time proportional
- * to the size of this ArrayList is needed.
+ * to the size of this ArrayList is needed, unless the storage can be
+ * remapped in place (see ArrayStorage::MAPPED).
  * This operation provides strong exception safety.
  *
  * @param value value to append to this ArrayList
@@ -67,9 +91,11 @@ const ArrayList<T>& ArrayList<T>::operator=(const ArrayList<T>& rhs) {
 template <typename T>
 void ArrayList<T>::add(const_reference value) {
     if (mSize >= mCapacity) {                   // If need more space
-        ScopedArray<T> temp(new T[2 * mSize + 2]);
-        std::copy(begin(), end(), temp.get());
-        mArray.swap(temp);
+        if (!mArray.regrow(2 * mSize + 2)) {
+            ScopedArray<T> temp(2 * mSize + 2, mArray.storage());
+            std::copy(begin(), end(), temp.get());
+            mArray.swap(temp);
+        }
         mCapacity = 2 * mSize + 2;
     }
 
@@ -95,7 +121,7 @@ void ArrayList<T>::add(size_t index, const_reference value) {
     size_t newSize = std::max(index, mSize) + 1;
     size_t newCap = 2 * newSize;
 
-    ScopedArray<T> temp(new T[newCap]);
+    ScopedArray<T> temp(newCap, mArray.storage());
     std::copy(begin(), begin() + std::min(index, mSize), temp.get());
 
     if (index < mSize)
@@ -109,14 +135,38 @@ void ArrayList<T>::add(size_t index, const_reference value) {
     std::swap(mCapacity, newCap);
 }
 
+/**
+ * Adds the elements of the range [first, last) to the end of this
+ * ArrayList. The range is measured first, so at most one reallocation
+ * happens however long it is. InputIterator must be a forward iterator,
+ * and the range must not lie within this ArrayList.
+ * This operation provides strong exception safety.
+ *
+ * @param first iterator to the first element to append
+ * @param last iterator one past the last element to append
+ */
+template <typename T>
+template <typename InputIterator>
+void ArrayList<T>::addAll(InputIterator first, InputIterator last) {
+    size_t count = std::distance(first, last);
+    if (mSize + count > mCapacity)
+        reserve(std::max(mSize + count, 2 * mSize + 2));
+
+    // The new elements only become visible once they have all been copied
+    std::copy(first, last, mArray.get() + mSize);
+    mSize += count;
+}
+
 /**
  * Empties this ArrayList releasing all of its resources (i.e., returning
+ * this ArrayList to the same state as the default constructor). The kind
+ * of storage is retained.
  * This operation is no-throw under the assumption that the parametrizing
  * type's destructor is no-throw.
  */
 template <typename T>
 void ArrayList<T>::clear() throw () {
-    ArrayList<T> empty;
+    ArrayList<T> empty(0, value_type(), mArray.storage());
     swap(empty);
 }
 
@@ -176,6 +226,58 @@ typename ArrayList<T>::reference ArrayList<T>::operator[](size_t index) throw ()
     return mArray[index];
 }
 
+/**
+ * Returns a constant reference to the first element. If this ArrayList is
+ * empty, an std::out_of_range exception is thrown with 0 as its message.
+ * This operation provides strong exception safety.
+ *
+ * @return constant reference to the first element.
+ */
+template <typename T>
+typename ArrayList<T>::const_reference ArrayList<T>::front() const throw (std::out_of_range) {
+    rangeCheck(0);
+    return mArray[0];
+}
+
+/**
+ * Returns a reference to the first element. If this ArrayList is empty, an
+ * std::out_of_range exception is thrown with 0 as its message.
+ * This operation provides strong exception safety.
+ *
+ * @return reference to the first element.
+ */
+template <typename T>
+typename ArrayList<T>::reference ArrayList<T>::front() throw (std::out_of_range) {
+    rangeCheck(0);
+    return mArray[0];
+}
+
+/**
+ * Returns a constant reference to the last element. If this ArrayList is
+ * empty, an std::out_of_range exception is thrown with 0 as its message.
+ * This operation provides strong exception safety.
+ *
+ * @return constant reference to the last element.
+ */
+template <typename T>
+typename ArrayList<T>::const_reference ArrayList<T>::back() const throw (std::out_of_range) {
+    rangeCheck(0);
+    return mArray[mSize - 1];
+}
+
+/**
+ * Returns a reference to the last element. If this ArrayList is empty, an
+ * std::out_of_range exception is thrown with 0 as its message.
+ * This operation provides strong exception safety.
+ *
+ * @return reference to the last element.
+ */
+template <typename T>
+typename ArrayList<T>::reference ArrayList<T>::back() throw (std::out_of_range) {
+    rangeCheck(0);
+    return mArray[mSize - 1];
+}
+
 /**
  * Returns true if this ArrayList is equal to rhs and false otherwise
  * This operation provides strong exception safety.
@@ -273,7 +375,7 @@ typename ArrayList<T>::value_type ArrayList<T>::remove(size_t index) {
 
     value_type result = mArray[index];
     if (index < mSize - 1) {
-        ScopedArray<T> temp(new T[mCapacity]);
+        ScopedArray<T> temp(mCapacity, mArray.storage());
         std::copy(begin(), begin() + index, temp.get());
         std::copy(begin() + index + 1, end(), temp.get() + index);
         mArray.swap(temp);
@@ -283,6 +385,71 @@ typename ArrayList<T>::value_type ArrayList<T>::remove(size_t index) {
     return result;
 }
 
+/**
+ * Removes and returns the last element in constant time, without ever
+ * reallocating. If this ArrayList is empty, an std::out_of_range exception
+ * is thrown with 0 as its message.
+ * This operation provides strong exception safety.
+ *
+ * @return copy of the just removed object.
+ */
+template <typename T>
+typename ArrayList<T>::value_type ArrayList<T>::removeLast() {
+    rangeCheck(0);
+    value_type result = mArray[mSize - 1];
+    --mSize;
+    return result;
+}
+
+/**
+ * Removes the elements in the range [from, to), shifting the elements
+ * after it down once. If to is past the end or from is past to, an
+ * std::out_of_range exception is thrown with the offending index as its
+ * message. Types whose copy assignment cannot throw are shifted in place;
+ * others are copied to a new array of the same capacity.
+ * This operation provides strong exception safety.
+ *
+ * @param from index of the first element to remove
+ * @param to index one past the last element to remove
+ */
+template <typename T>
+void ArrayList<T>::removeRange(size_t from, size_t to) {
+    sliceCheck(from, to);
+    if (from == to)
+        return;
+
+    if (std::is_nothrow_copy_assignable<T>::value) {
+        std::copy(begin() + to, end(), begin() + from);
+    } else if (to < mSize) {
+        ScopedArray<T> temp(mCapacity, mArray.storage());
+        std::copy(begin(), begin() + from, temp.get());
+        std::copy(begin() + to, end(), temp.get() + from);
+        mArray.swap(temp);
+    }
+    mSize -= to - from;
+}
+
+/**
+ * Makes sure that at least capacity elements fit without reallocation, so
+ * that a known number of add(const_reference) calls runs in constant time
+ * each. Does nothing if the capacity is already large enough.
+ * This operation provides strong exception safety.
+ *
+ * @param capacity number of elements to make room for
+ */
+template <typename T>
+void ArrayList<T>::reserve(size_t capacity) {
+    if (capacity <= mCapacity)
+        return;
+
+    if (!mArray.regrow(capacity)) {
+        ScopedArray<T> temp(capacity, mArray.storage());
+        std::copy(begin(), end(), temp.get());
+        mArray.swap(temp);
+    }
+    mCapacity = capacity;
+}
+
 /**
  * Sets the element at the specified index to the provided value. If index
  * is out of bounds, an std::out_of_range exception is thrown with the index
@@ -306,6 +473,117 @@ size_t ArrayList<T>::size() const throw () {
     return mSize;
 }
 
+/**
+ * Returns a view of the elements of this ArrayList in the range
+ * [from, to). The view costs constant time to create and shares the
+ * elements of this ArrayList. If to is past the end or from is past to,
+ * an std::out_of_range exception is thrown with the offending index as
+ * its message.
+ * This operation provides strong exception safety.
+ *
+ * @param from index of the first element of the view
+ * @param to index one past the last element of the view
+ * @return
+ */
+template <typename T>
+ArrayListSubList<T> ArrayList<T>::subList(size_t from, size_t to) throw (std::out_of_range) {
+    sliceCheck(from, to);
+    return ArrayListSubList<T>(mArray.get() + from, to - from);
+}
+
+/**
+ * Returns a constant view of the elements of this ArrayList in the range
+ * [from, to). If to is past the end or from is past to, an
+ * std::out_of_range exception is thrown with the offending index as its
+ * message.
+ * This operation provides strong exception safety.
+ *
+ * @param from index of the first element of the view
+ * @param to index one past the last element of the view
+ * @return
+ */
+template <typename T>
+ArrayListSubList<const T> ArrayList<T>::subList(size_t from, size_t to) const throw (std::out_of_range) {
+    sliceCheck(from, to);
+    return ArrayListSubList<const T>(mArray.get() + from, to - from);
+}
+
+/**
+ * Writes this ArrayList to the file descriptor fd in the versioned binary
+ * format described by ListFileHeader. Trivially copyable elements are
+ * written in a single block. Throws std::system_error if writing fails.
+ *
+ * @param fd file descriptor to write to
+ */
+template <typename T>
+void ArrayList<T>::writeTo(int fd) const {
+    ListWriter out(fd);
+    serialize(out);
+}
+
+/**
+ * Writes this ArrayList to os in the versioned binary format described by
+ * ListFileHeader. Throws std::ios_base::failure if writing fails.
+ *
+ * @param os stream to write to
+ */
+template <typename T>
+void ArrayList<T>::writeTo(std::ostream& os) const {
+    ListWriter out(os);
+    serialize(out);
+}
+
+/**
+ * Replaces the contents of this ArrayList with a list read from the file
+ * descriptor fd, as written by writeTo. Trivially copyable elements are
+ * read in a single block. Throws std::runtime_error if the data is
+ * truncated or was written for another element type.
+ * This operation provides strong exception safety.
+ *
+ * @param fd file descriptor to read from
+ */
+template <typename T>
+void ArrayList<T>::readFrom(int fd) {
+    ListReader in(fd);
+    deserialize(in);
+    in.finish();
+}
+
+/**
+ * Replaces the contents of this ArrayList with a list read from is, as
+ * written by writeTo. Throws std::runtime_error if the data is truncated
+ * or was written for another element type.
+ * This operation provides strong exception safety.
+ *
+ * @param is stream to read from
+ */
+template <typename T>
+void ArrayList<T>::readFrom(std::istream& is) {
+    ListReader in(is);
+    deserialize(in);
+}
+
+/**
+ * Returns true if value is of a trivial type and consists of zero bytes
+ * only, meaning zero-filled memory is indistinguishable from a fill.
+ * This operation is a no-throw.
+ *
+ * @param value
+ * @return
+ */
+template <typename T>
+bool ArrayList<T>::isZeroFill(const_reference value) throw () {
+    if (!std::is_trivial<T>::value)
+        return false;
+
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&value);
+    for (size_t i = 0; i < sizeof(T); ++i) {
+        if (bytes[i] != 0)
+            return false;
+    }
+    return true;
+}
+
 /**
  * Given an index, this method throws an std::out_of_range with the index as
  * its message if index is out of bounds or is a no-op otherwise.
@@ -322,6 +600,82 @@ void ArrayList<T>::rangeCheck(size_t index) const throw (std::out_of_range) {
     }
 }
 
+/**
+ * Throws an std::out_of_range with the offending index as its message if
+ * [from, to) is not a range of this ArrayList.
+ * This operation provides strong exception safety.
+ *
+ * @param from
+ * @param to
+ */
+template <typename T>
+void ArrayList<T>::sliceCheck(size_t from, size_t to) const throw (std::out_of_range) {
+    if (to > mSize || from > to) {
+        std::ostringstream os;
+        os << (to > mSize ? to : from);
+        throw std::out_of_range(os.str());
+    }
+}
+
+/**
+ * Writes the header and elements to out.
+ *
+ * @param out
+ */
+template <typename T>
+void ArrayList<T>::serialize(ListWriter& out) const {
+    bool raw = std::is_trivially_copyable<T>::value;
+    ListFileHeader header;
+    header.init(sizeof(T), mSize, mSize, raw ? ListFileHeader::RAW : ListFileHeader::STREAM);
+    out.write(&header, sizeof(header));
+
+    if (raw) {
+        out.write(mArray.get(), mSize * sizeof(T));
+    } else {
+        for (size_t i = 0; i < mSize; ++i)
+            Serializer<T>::write(out, mArray[i]);
+    }
+    out.flush();
+}
+
+/**
+ * Replaces the contents with the header and elements read from in.
+ * This operation provides strong exception safety.
+ *
+ * @param in
+ */
+template <typename T>
+void ArrayList<T>::deserialize(ListReader& in) {
+    bool raw = std::is_trivially_copyable<T>::value;
+    ListFileHeader header;
+    in.read(&header, sizeof(header));
+    if (!header.valid(sizeof(T), raw ? ListFileHeader::RAW : ListFileHeader::STREAM))
+        throw std::runtime_error("incompatible list data");
+    // The size comes from the data, so it must not be able to wrap around
+    // in the allocation or the read below
+    if (header.mSize > std::numeric_limits<size_t>::max() / (2 * sizeof(T)))
+        throw std::runtime_error("incompatible list data");
+
+    // Nor may it decide the allocation up front: the elements are read in
+    // chunks of about kReadChunk bytes and the storage grows as they arrive,
+    // so truncated data fails after at most one chunk too many
+    size_t chunk = std::max<size_t>(kReadChunk / sizeof(T), 1);
+    ArrayList<T> temp;
+    while (temp.mSize < header.mSize) {
+        size_t count = std::min<size_t>(header.mSize - temp.mSize, chunk);
+        if (temp.mSize + count > temp.mCapacity)
+            temp.reserve(std::min<size_t>(std::max(temp.mSize + count, temp.mCapacity * 2), header.mSize));
+        if (raw) {
+            in.read(temp.mArray.get() + temp.mSize, count * sizeof(T));
+            temp.mSize += count;
+        } else {
+            for (size_t i = 0; i < count; ++i, ++temp.mSize)
+                Serializer<T>::read(in, temp.mArray[temp.mSize]);
+        }
+    }
+    swap(temp);
+}
+
 /**
  * Swaps the contents of this ArrayList with that of other in constant time.
  * This operation is a no-throw.
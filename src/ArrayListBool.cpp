@@ -0,0 +1,419 @@
+#ifndef _ARRAY_LIST_BOOL_CPP_
+#define _ARRAY_LIST_BOOL_CPP_
+
+#include "../include/ArrayListBool.h"
+#include "../include/ArrayListBoolIterators.h"
+#include "../include/ScopedArray.h"
+#include <cstdlib>                  // For size_t
+#include <stdint.h>                 // For uint64_t
+#include <stdexcept>                // For std::out_of_range
+#include <sstream>                  // For std::ostringstream
+#include <algorithm>
+
+/**
+ * Initializes the ArrayList with size elements all set to value. If size is
+ * not supplied, an empty ArrayList is created. If value is not supplied,
+ * false is used.
+ * This operation provides strong exception safety.
+ *
+ * @param size size of the ArrayList to create
+ * @param value value used to fill the ArrayList
+ */
+inline ArrayList<bool>::ArrayList(size_t size, bool value)
+        : mSize(size), mCapacity(wordsFor(size) * kWordBits), mArray(new uint64_t[wordsFor(size)]()) {
+    if (value && mSize > 0) {
+        size_t words = wordsFor(mSize);
+        std::fill(mArray.get(), mArray.get() + words, ~uint64_t(0));
+        if (mSize % kWordBits != 0)
+            mArray[words - 1] = lowMask(mSize % kWordBits);
+    }
+}
+
+/**
+ * Initializes the ArrayList to be a copy of src. Only the logical values of
+ * src are copied. This means that any excess capacity of src is ignored.
+ * This operation provides strong exception safety.
+ *
+ * @param src ArrayList to copy
+ */
+inline ArrayList<bool>::ArrayList(const ArrayList<bool>& src)
+        : mSize(src.mSize), mCapacity(wordsFor(src.mSize) * kWordBits),
+          mArray(new uint64_t[wordsFor(src.mSize)]) {
+    std::copy(src.mArray.get(), src.mArray.get() + wordsFor(mSize), mArray.get());
+}
+
+/**
+ * Makes this object a copy of rhs using the same guidelines as the copy
+ * constructor. Note that calling this method on yourself (a = a;) is
+ * equivalent to a no-op.
+ * This operation provides strong exception safety.
+ *
+ * @param src ArrayList to copy
+ * @return *this, used for chaining.
+ */
+inline const ArrayList<bool>& ArrayList<bool>::operator=(const ArrayList<bool>& rhs) {
+    if (this != &rhs) {
+        ArrayList<bool> copy(rhs);
+        swap(copy);
+    }
+    return *this;
+}
+
+/**
+ * Adds value to the end of this ArrayList. If we have excess capacity,
+ * the insertion is performed in constant time. Otherwise, time proportional
+ * to the size of this ArrayList is needed.
+ * This operation provides strong exception safety.
+ *
+ * @param value value to append to this ArrayList
+ */
+inline void ArrayList<bool>::add(bool value) {
+    ensureCapacity(mSize + 1);
+    if (value)
+        mArray[mSize / kWordBits] |= uint64_t(1) << (mSize % kWordBits);
+    ++mSize;
+}
+
+/**
+ * Inserts value at the specified index. All elements at or to the right of
+ * index are shifted down by one spot, a word at a time. If this ArrayList
+ * needs to be enlarged, false is used to fill the gaps.
+ * This operation provides strong exception safety.
+ *
+ * @param index index at which to insert value
+ * @param value the element to insert
+ */
+inline void ArrayList<bool>::add(size_t index, bool value) {
+    if (index >= mSize) {
+        // The gap is already cleared since bits past mSize are always zero
+        ensureCapacity(index + 1);
+        mSize = index;
+        add(value);
+        return;
+    }
+
+    ensureCapacity(mSize + 1);
+    uint64_t* words = mArray.get();
+    size_t first = index / kWordBits;
+    size_t last = mSize / kWordBits;        // Word receiving the new last bit
+
+    for (size_t i = last; i > first; --i)
+        words[i] = (words[i] << 1) | (words[i - 1] >> (kWordBits - 1));
+
+    uint64_t keep = lowMask(index % kWordBits);
+    words[first] = (words[first] & keep) | ((words[first] & ~keep) << 1);
+    ++mSize;
+    (*this)[index] = value;
+}
+
+/**
+ * Empties this ArrayList releasing all of its resources (i.e., returning
+ * this ArrayList to the same state as the default constructor).
+ * This operation is no-throw.
+ */
+inline void ArrayList<bool>::clear() throw () {
+    mArray.reset();
+    mSize = 0;
+    mCapacity = 0;
+}
+
+/**
+ * Returns the value of the element stored at the provided index. If index
+ * is out of bounds, an std::out_of_range exception is thrown with the index
+ * as its message.
+ * This operation provides strong exception safety.
+ *
+ * @param index index of the element to return
+ * @return value of the element at the index.
+ */
+inline ArrayList<bool>::const_reference ArrayList<bool>::get(size_t index) const throw (std::out_of_range) {
+    rangeCheck(index);
+    return (*this)[index];
+}
+
+/**
+ * Returns a proxy reference to the element stored at the provided index. If
+ * index is out of bounds, an std::out_of_range exception is thrown with the
+ * index as its message.
+ * This operation provides strong exception safety.
+ *
+ * @param index index of the element to return
+ * @return proxy reference to the element at the index.
+ */
+inline ArrayList<bool>::reference ArrayList<bool>::get(size_t index) throw (std::out_of_range) {
+    rangeCheck(index);
+    return (*this)[index];
+}
+
+/**
+ * Returns the value of the element stored at the provided index. No range
+ * checking is performed on the index.
+ * This operation is no-throw.
+ *
+ * @param index index of the element to return
+ * @return value of the element at the index.
+ */
+inline ArrayList<bool>::const_reference ArrayList<bool>::operator[](size_t index) const throw () {
+    return (mArray[index / kWordBits] >> (index % kWordBits)) & 1;
+}
+
+/**
+ * Returns a proxy reference to the element stored at the provided index.
+ * No range checking is performed on the index.
+ * This operation is no-throw.
+ *
+ * @param index index of the element to return
+ * @return proxy reference to the element at the index.
+ */
+inline ArrayList<bool>::reference ArrayList<bool>::operator[](size_t index) throw () {
+    return reference(mArray.get() + index / kWordBits, index % kWordBits);
+}
+
+/**
+ * Returns true if this ArrayList is equal to rhs and false otherwise. The
+ * comparison is performed a word at a time.
+ * This operation is no-throw.
+ *
+ * @param rhs
+ * @return
+ */
+inline bool ArrayList<bool>::operator==(const ArrayList<bool>& rhs) const throw () {
+    return mSize == rhs.mSize
+           && std::equal(mArray.get(), mArray.get() + wordsFor(mSize), rhs.mArray.get());
+}
+
+/**
+ * Returns false if this ArrayList is equal to rhs and true otherwise
+ * This operation is no-throw.
+ *
+ * @param rhs
+ * @return
+ */
+inline bool ArrayList<bool>::operator!=(const ArrayList<bool>& rhs) const throw () {
+    return !(*this == rhs);
+}
+
+/**
+ * Returns a constant iterator to the beginning.
+ * This operation is a no-throw.
+ *
+ * @return
+ */
+inline ArrayList<bool>::const_iterator ArrayList<bool>::begin() const throw () {
+    return const_iterator(mArray.get(), 0);
+}
+
+/**
+ * Returns an iterator to the beginning.
+ * This operation is a no-throw.
+ *
+ * @return
+ */
+inline ArrayList<bool>::iterator ArrayList<bool>::begin() throw () {
+    return iterator(mArray.get(), 0);
+}
+
+/**
+ * Returns a constant iterator to the end.
+ * This operation is a no-throw.
+ *
+ * @return
+ */
+inline ArrayList<bool>::const_iterator ArrayList<bool>::end() const throw () {
+    return const_iterator(mArray.get(), mSize);
+}
+
+/**
+ * Returns an iterator to the end.
+ * This operation is a no-throw.
+ *
+ * @return
+ */
+inline ArrayList<bool>::iterator ArrayList<bool>::end() throw () {
+    return iterator(mArray.get(), mSize);
+}
+
+/**
+ * Returns true if this ArrayList is empty and false otherwise.
+ * This operation is a no-throw.
+ *
+ * @return
+ */
+inline bool ArrayList<bool>::isEmpty() const throw () {
+    return mSize == 0;
+}
+
+/**
+ * Removes and returns the element at the specified index. If index is out
+ * of bounds, an std::out_of_range exception is thrown with index as its
+ * message. The elements to the right of index are shifted in place a word
+ * at a time, so no reallocation ever takes place.
+ * This operation provides strong exception safety.
+ *
+ * @param index index of the object to remove.
+ * @return value of the just removed object.
+ */
+inline ArrayList<bool>::value_type ArrayList<bool>::remove(size_t index) {
+    rangeCheck(index);
+
+    bool result = (*this)[index];
+    uint64_t* words = mArray.get();
+    size_t first = index / kWordBits;
+    size_t last = (mSize - 1) / kWordBits;
+
+    // Bits past mSize are zero, so the vacated last bit is cleared for free
+    uint64_t keep = lowMask(index % kWordBits);
+    words[first] = (words[first] & keep) | ((words[first] >> 1) & ~keep);
+    for (size_t i = first; i < last; ++i) {
+        words[i] |= words[i + 1] << (kWordBits - 1);
+        words[i + 1] >>= 1;
+    }
+
+    --mSize;
+    return result;
+}
+
+/**
+ * Sets the element at the specified index to the provided value. If index
+ * is out of bounds, an std::out_of_range exception is thrown with the index
+ * as its message. This method completes in constant time.
+ * This operation provides strong exception safety.
+ */
+inline void ArrayList<bool>::set(size_t index, bool value) {
+    rangeCheck(index);
+    (*this)[index] = value;
+}
+
+/**
+ * Return the size of this ArrayList.
+ * This operation is a no-throw.
+ *
+ * @return
+ */
+inline size_t ArrayList<bool>::size() const throw () {
+    return mSize;
+}
+
+/**
+ * Returns the number of elements set to true.
+ * This operation is a no-throw.
+ *
+ * @return
+ */
+inline size_t ArrayList<bool>::count() const throw () {
+    size_t result = 0;
+    for (size_t i = 0, words = wordsFor(mSize); i < words; ++i)
+        result += __builtin_popcountll(mArray[i]);
+    return result;
+}
+
+/**
+ * Returns the index of the first element set to true, or size() if there
+ * is none.
+ * This operation is a no-throw.
+ *
+ * @return
+ */
+inline size_t ArrayList<bool>::findFirst() const throw () {
+    return scanFrom(0);
+}
+
+/**
+ * Returns the index of the first element after index that is set to true,
+ * or size() if there is none.
+ * This operation is a no-throw.
+ *
+ * @param index index to start searching after
+ * @return
+ */
+inline size_t ArrayList<bool>::findNext(size_t index) const throw () {
+    return index + 1 >= mSize ? mSize : scanFrom(index + 1);
+}
+
+/**
+ * Returns the number of words needed to hold bits bits.
+ *
+ * @param bits
+ * @return
+ */
+inline size_t ArrayList<bool>::wordsFor(size_t bits) throw () {
+    return (bits + kWordBits - 1) / kWordBits;
+}
+
+/**
+ * Returns a word with the low bits bits set.
+ *
+ * @param bits
+ * @return
+ */
+inline uint64_t ArrayList<bool>::lowMask(size_t bits) throw () {
+    return bits == 0 ? 0 : ~uint64_t(0) >> (kWordBits - bits);
+}
+
+/**
+ * Returns the index of the first set bit at or after index, or size().
+ *
+ * @param index
+ * @return
+ */
+inline size_t ArrayList<bool>::scanFrom(size_t index) const throw () {
+    size_t words = wordsFor(mSize);
+    size_t i = index / kWordBits;
+    if (i >= words)
+        return mSize;
+
+    uint64_t word = mArray[i] & ~lowMask(index % kWordBits);
+    while (word == 0) {
+        if (++i == words)
+            return mSize;
+        word = mArray[i];
+    }
+    return i * kWordBits + __builtin_ctzll(word);
+}
+
+/**
+ * Grows the storage so that at least minSize bits fit, requesting twice
+ * minSize if a reallocation is necessary.
+ * This operation provides strong exception safety.
+ *
+ * @param minSize
+ */
+inline void ArrayList<bool>::ensureCapacity(size_t minSize) {
+    if (minSize <= mCapacity)
+        return;
+
+    size_t newWords = wordsFor(2 * minSize);
+    ScopedArray<uint64_t> temp(new uint64_t[newWords]());
+    std::copy(mArray.get(), mArray.get() + wordsFor(mSize), temp.get());
+    mArray.swap(temp);
+    mCapacity = newWords * kWordBits;
+}
+
+/**
+ * Given an index, this method throws an std::out_of_range with the index as
+ * its message if index is out of bounds or is a no-op otherwise.
+ * This operation provides strong exception safety.
+ *
+ * @param index index to check
+ */
+inline void ArrayList<bool>::rangeCheck(size_t index) const throw (std::out_of_range) {
+    if (index >= mSize) {
+        std::ostringstream os;
+        os << index;
+        throw std::out_of_range(os.str());
+    }
+}
+
+/**
+ * Swaps the contents of this ArrayList with that of other in constant time.
+ * This operation is a no-throw.
+ *
+ * @param other the ArrayList to swap with
+ */
+inline void ArrayList<bool>::swap(ArrayList<bool>& other) throw () {
+    std::swap(mSize, other.mSize);
+    std::swap(mCapacity, other.mCapacity);
+    mArray.swap(other.mArray);
+}
+
+#endif
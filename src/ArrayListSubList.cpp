@@ -0,0 +1,248 @@
+#ifndef _ARRAY_LIST_SUB_LIST_CPP_
+#define _ARRAY_LIST_SUB_LIST_CPP_
+
+#include "../include/ArrayListSubList.h"
+#include "../include/ArrayListIterators.h"
+#include <cstdlib>                  // For size_t
+#include <stdexcept>                // For std::out_of_range
+#include <sstream>                  // For std::ostringstream
+#include <algorithm>
+
+
+/**
+ * A private constructor used by ArrayList::subList and nested views.
+ *
+ * @param data first element of the view
+ * @param size number of elements in the view
+ */
+template <typename T>
+ArrayListSubList<T>::ArrayListSubList(T* data, size_t size) throw () : mData(data), mSize(size) {
+}
+
+/**
+ * Returns a constant reference to the element stored at the provided index.
+ * If index is out of bounds, an std::out_of_range exception is thrown with
+ * the index as its message.
+ * This operation provides strong exception safety.
+ *
+ * @param index index of the element to return
+ * @return constant reference to the element at the index.
+ */
+template <typename T>
+typename ArrayListSubList<T>::const_reference ArrayListSubList<T>::get(size_t index) const throw (std::out_of_range) {
+    rangeCheck(index);
+    return mData[index];
+}
+
+/**
+ * Returns a reference to the element stored at the provided index.
+ * If index is out of bounds, an std::out_of_range exception is thrown with
+ * the index as its message.
+ * This operation provides strong exception safety.
+ *
+ * @param index index of the element to return
+ * @return reference to the element at the index.
+ */
+template <typename T>
+typename ArrayListSubList<T>::reference ArrayListSubList<T>::get(size_t index) throw (std::out_of_range) {
+    rangeCheck(index);
+    return mData[index];
+}
+
+/**
+ * Returns a constant reference to the element stored at the provided index.
+ * No bounds checking is performed.
+ * This operation is a no-throw.
+ *
+ * @param index index of the element to return
+ * @return constant reference to the element at the index.
+ */
+template <typename T>
+typename ArrayListSubList<T>::const_reference ArrayListSubList<T>::operator[](size_t index) const throw () {
+    return mData[index];
+}
+
+/**
+ * Returns a reference to the element stored at the provided index.
+ * No bounds checking is performed.
+ * This operation is a no-throw.
+ *
+ * @param index index of the element to return
+ * @return reference to the element at the index.
+ */
+template <typename T>
+typename ArrayListSubList<T>::reference ArrayListSubList<T>::operator[](size_t index) throw () {
+    return mData[index];
+}
+
+/**
+ * Returns true if this ArrayListSubList is logically equal to rhs.
+ *
+ * @param rhs
+ * @return
+ */
+template <typename T>
+bool ArrayListSubList<T>::operator==(const ArrayListSubList<T>& rhs) const {
+    return mSize == rhs.mSize && std::equal(begin(), end(), rhs.begin());
+}
+
+/**
+ * Returns false if this ArrayListSubList is logically equal to rhs.
+ *
+ * @param rhs
+ * @return
+ */
+template <typename T>
+bool ArrayListSubList<T>::operator!=(const ArrayListSubList<T>& rhs) const {
+    return !(*this == rhs);
+}
+
+/**
+ * Returns a constant iterator to the first element.
+ * This operation is a no-throw.
+ *
+ * @return
+ */
+template <typename T>
+typename ArrayListSubList<T>::const_iterator ArrayListSubList<T>::begin() const throw () {
+    return const_iterator(const_cast<value_type*>(mData));
+}
+
+/**
+ * Returns an iterator to the first element.
+ * This operation is a no-throw.
+ *
+ * @return
+ */
+template <typename T>
+typename ArrayListSubList<T>::iterator ArrayListSubList<T>::begin() throw () {
+    return iterator(const_cast<value_type*>(mData));
+}
+
+/**
+ * Returns a constant iterator one past the last element.
+ * This operation is a no-throw.
+ *
+ * @return
+ */
+template <typename T>
+typename ArrayListSubList<T>::const_iterator ArrayListSubList<T>::end() const throw () {
+    return const_iterator(const_cast<value_type*>(mData + mSize));
+}
+
+/**
+ * Returns an iterator one past the last element.
+ * This operation is a no-throw.
+ *
+ * @return
+ */
+template <typename T>
+typename ArrayListSubList<T>::iterator ArrayListSubList<T>::end() throw () {
+    return iterator(const_cast<value_type*>(mData + mSize));
+}
+
+/**
+ * Returns true if this ArrayListSubList is empty and false otherwise.
+ * This operation is a no-throw.
+ *
+ * @return
+ */
+template <typename T>
+bool ArrayListSubList<T>::isEmpty() const throw () {
+    return mSize == 0;
+}
+
+/**
+ * Sets the element at the specified index to the provided value. If index
+ * is out of bounds, an std::out_of_range exception is thrown with the index
+ * as its message. This method completes in constant time.
+ * This operation provides no exception safety.
+ *
+ * @param index index of the object to set
+ * @param value the new value
+ */
+template <typename T>
+void ArrayListSubList<T>::set(size_t index, const_reference value) {
+    rangeCheck(index);
+    mData[index] = value;
+}
+
+/**
+ * Return the size of this ArrayListSubList.
+ * This operation is a no-throw.
+ *
+ * @return
+ */
+template <typename T>
+size_t ArrayListSubList<T>::size() const throw () {
+    return mSize;
+}
+
+/**
+ * Returns a view of the elements of this ArrayListSubList in the range
+ * [from, to). If to is past the end or from is past to, an
+ * std::out_of_range exception is thrown with the offending index as its
+ * message.
+ * This operation provides strong exception safety.
+ *
+ * @param from index of the first element of the view
+ * @param to index one past the last element of the view
+ * @return
+ */
+template <typename T>
+ArrayListSubList<T> ArrayListSubList<T>::subList(size_t from, size_t to) throw (std::out_of_range) {
+    sliceCheck(from, to);
+    return ArrayListSubList<T>(mData + from, to - from);
+}
+
+/**
+ * Returns a constant view of the elements of this ArrayListSubList in the
+ * range [from, to). If to is past the end or from is past to, an
+ * std::out_of_range exception is thrown with the offending index as its
+ * message.
+ * This operation provides strong exception safety.
+ *
+ * @param from index of the first element of the view
+ * @param to index one past the last element of the view
+ * @return
+ */
+template <typename T>
+ArrayListSubList<const T> ArrayListSubList<T>::subList(size_t from, size_t to) const throw (std::out_of_range) {
+    sliceCheck(from, to);
+    return ArrayListSubList<const T>(mData + from, to - from);
+}
+
+/**
+ * Given an index, this method throws an std::out_of_range with the index as
+ * its message if index is out of bounds or is a no-op otherwise.
+ * This operation provides strong exception safety.
+ *
+ * @param index index to check
+ */
+template <typename T>
+void ArrayListSubList<T>::rangeCheck(size_t index) const throw (std::out_of_range) {
+    if (index >= mSize) {
+        std::ostringstream os;
+        os << index;
+        throw std::out_of_range(os.str());
+    }
+}
+
+/**
+ * Throws an std::out_of_range with the offending index as its message if
+ * [from, to) is not a range of this ArrayListSubList.
+ * This operation provides strong exception safety.
+ *
+ * @param from
+ * @param to
+ */
+template <typename T>
+void ArrayListSubList<T>::sliceCheck(size_t from, size_t to) const throw (std::out_of_range) {
+    if (to > mSize || from > to) {
+        std::ostringstream os;
+        os << (to > mSize ? to : from);
+        throw std::out_of_range(os.str());
+    }
+}
+
+#endif
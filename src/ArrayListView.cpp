@@ -0,0 +1,150 @@
+#ifndef _ARRAY_LIST_VIEW_CPP_
+#define _ARRAY_LIST_VIEW_CPP_
+
+#include "../include/ArrayListView.h"
+#include "../include/ArrayListIterators.h"
+#include "../include/ListSerialization.h"
+#include <cstdlib>                  // For size_t
+#include <stdexcept>                // For std::out_of_range, std::runtime_error
+#include <sstream>                  // For std::ostringstream
+#include <stdint.h>                 // For uintptr_t
+#include <type_traits>              // For std::is_trivially_copyable, std::alignment_of
+#include <algorithm>
+
+
+/**
+ * Initializes the view over the list serialized in the length bytes at
+ * buffer. Throws std::runtime_error if the buffer does not hold a RAW
+ * list of this element type, is truncated, or is not suitably aligned.
+ * This operation provides strong exception safety.
+ *
+ * @param buffer start of the serialized list
+ * @param length number of bytes available at buffer
+ */
+template <typename T>
+ArrayListView<T>::ArrayListView(const void* buffer, size_t length) : mData(0), mSize(0) {
+    static_assert(std::is_trivially_copyable<T>::value, "ArrayListView requires a trivially copyable type");
+
+    if (length < sizeof(ListFileHeader) || reinterpret_cast<uintptr_t>(buffer) % std::alignment_of<T>::value != 0)
+        throw std::runtime_error("incompatible list data");
+
+    const ListFileHeader* header = static_cast<const ListFileHeader*>(buffer);
+    if (!header->valid(sizeof(T), ListFileHeader::RAW)
+            || header->mSize > (length - sizeof(ListFileHeader)) / sizeof(T))
+        throw std::runtime_error("incompatible list data");
+
+    mData = reinterpret_cast<const T*>(header + 1);
+    mSize = header->mSize;
+}
+
+/**
+ * Returns a constant reference to the element stored at the provided index.
+ * If index is out of bounds, an std::out_of_range exception is thrown with
+ * the index as its message.
+ * This operation provides strong exception safety.
+ *
+ * @param index index of the element to return
+ * @return constant reference to the element at the index.
+ */
+template <typename T>
+typename ArrayListView<T>::const_reference ArrayListView<T>::get(size_t index) const throw (std::out_of_range) {
+    rangeCheck(index);
+    return mData[index];
+}
+
+/**
+ * Returns a constant reference to the element stored at the provided index.
+ * No bounds checking is performed.
+ * This operation is a no-throw.
+ *
+ * @param index index of the element to return
+ * @return constant reference to the element at the index.
+ */
+template <typename T>
+typename ArrayListView<T>::const_reference ArrayListView<T>::operator[](size_t index) const throw () {
+    return mData[index];
+}
+
+/**
+ * Returns true if this ArrayListView is logically equal to rhs.
+ *
+ * @param rhs
+ * @return
+ */
+template <typename T>
+bool ArrayListView<T>::operator==(const ArrayListView<T>& rhs) const {
+    return mSize == rhs.mSize && std::equal(begin(), end(), rhs.begin());
+}
+
+/**
+ * Returns false if this ArrayListView is logically equal to rhs.
+ *
+ * @param rhs
+ * @return
+ */
+template <typename T>
+bool ArrayListView<T>::operator!=(const ArrayListView<T>& rhs) const {
+    return !(*this == rhs);
+}
+
+/**
+ * Returns a constant iterator to the first element.
+ * This operation is a no-throw.
+ *
+ * @return
+ */
+template <typename T>
+typename ArrayListView<T>::const_iterator ArrayListView<T>::begin() const throw () {
+    return const_iterator(const_cast<T*>(mData));
+}
+
+/**
+ * Returns a constant iterator one past the last element.
+ * This operation is a no-throw.
+ *
+ * @return
+ */
+template <typename T>
+typename ArrayListView<T>::const_iterator ArrayListView<T>::end() const throw () {
+    return const_iterator(const_cast<T*>(mData + mSize));
+}
+
+/**
+ * Returns true if this ArrayListView is empty and false otherwise.
+ * This operation is a no-throw.
+ *
+ * @return
+ */
+template <typename T>
+bool ArrayListView<T>::isEmpty() const throw () {
+    return mSize == 0;
+}
+
+/**
+ * Return the size of this ArrayListView.
+ * This operation is a no-throw.
+ *
+ * @return
+ */
+template <typename T>
+size_t ArrayListView<T>::size() const throw () {
+    return mSize;
+}
+
+/**
+ * Given an index, this method throws an std::out_of_range with the index as
+ * its message if index is out of bounds or is a no-op otherwise.
+ * This operation provides strong exception safety.
+ *
+ * @param index index to check
+ */
+template <typename T>
+void ArrayListView<T>::rangeCheck(size_t index) const throw (std::out_of_range) {
+    if (index >= mSize) {
+        std::ostringstream os;
+        os << index;
+        throw std::out_of_range(os.str());
+    }
+}
+
+#endif
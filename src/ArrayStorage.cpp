@@ -0,0 +1,201 @@
+#ifndef _ARRAY_STORAGE_CPP_
+#define _ARRAY_STORAGE_CPP_
+
+#include "../include/ArrayStorage.h"
+#include <cstdlib>          // For size_t, calloc, free, posix_memalign
+#include <new>              // For std::bad_alloc
+#include <stdint.h>         // For uintptr_t
+#include <sys/mman.h>       // For mmap, mremap, madvise, munmap
+#include <unistd.h>         // For sysconf
+
+#ifndef MAP_ANONYMOUS
+#define MAP_ANONYMOUS MAP_ANON
+#endif
+
+
+/**
+ * Returns a descriptor for heap memory aligned to alignment bytes, which
+ * must be a power of two.
+ *
+ * @param alignment
+ * @return
+ */
+inline ArrayStorage ArrayStorage::aligned(size_t alignment) {
+    ArrayStorage storage(ALIGNED);
+    storage.mAlignment = alignment < sizeof(void*) ? sizeof(void*) : alignment;
+    return storage;
+}
+
+/**
+ * Returns a descriptor for anonymous mappings using the provided
+ * combination of MapFlags.
+ *
+ * @param flags
+ * @return
+ */
+inline ArrayStorage ArrayStorage::mapped(unsigned flags) {
+    ArrayStorage storage(MAPPED);
+    storage.mFlags = flags;
+    return storage;
+}
+
+/**
+ * Allocates bytes bytes of raw memory. A request for zero bytes returns a
+ * null pointer. Throws std::bad_alloc if the memory cannot be obtained.
+ * Must not be called for the HEAP backing.
+ *
+ * @param bytes
+ * @return
+ */
+inline void* ArrayStorage::allocate(size_t bytes) const {
+    if (bytes == 0)
+        return 0;
+
+    void* ptr = 0;
+    if (mBacking == ALIGNED) {
+        if (posix_memalign(&ptr, mAlignment, bytes) != 0)
+            ptr = 0;
+    } else if (mBacking == MAPPED) {
+        size_t length = mappedLength(bytes);
+        int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+        if (mFlags & HUGE_PAGES) {
+            // Over-map so that a huge page aligned window can be carved out
+            char* raw = static_cast<char*>(mmap(0, length + kHugePageSize, PROT_READ | PROT_WRITE, flags, -1, 0));
+            if (raw != MAP_FAILED) {
+                uintptr_t mask = kHugePageSize - 1;
+                char* start = reinterpret_cast<char*>((reinterpret_cast<uintptr_t>(raw) + mask) & ~mask);
+                if (start != raw)
+                    munmap(raw, start - raw);
+                if (start + length != raw + length + kHugePageSize)
+                    munmap(start + length, raw + kHugePageSize - start);
+                ptr = start;
+                advise(ptr, length);
+                if (mFlags & POPULATE)
+                    prefault(ptr, length);
+            }
+        } else {
+#ifdef MAP_POPULATE
+            if (mFlags & POPULATE)
+                flags |= MAP_POPULATE;
+#endif
+            ptr = mmap(0, length, PROT_READ | PROT_WRITE, flags, -1, 0);
+            if (ptr == MAP_FAILED) {
+                ptr = 0;
+            } else {
+#ifndef MAP_POPULATE
+                if (mFlags & POPULATE)
+                    prefault(ptr, length);
+#endif
+            }
+        }
+    } else if (bytes >= kMapThreshold) {
+        ptr = mmap(0, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (ptr == MAP_FAILED)
+            ptr = 0;
+    } else {
+        ptr = std::calloc(bytes, 1);
+    }
+
+    if (!ptr)
+        throw std::bad_alloc();
+    return ptr;
+}
+
+/**
+ * Attempts to resize a block obtained from allocate(oldBytes) to newBytes
+ * without copying through user space, preserving its contents. Returns
+ * the (possibly moved) block, or a null pointer if this storage cannot
+ * resize in place, in which case the original block is left untouched.
+ * This operation is a no-throw.
+ *
+ * @param ptr
+ * @param oldBytes
+ * @param newBytes
+ * @return
+ */
+inline void* ArrayStorage::reallocate(void* ptr, size_t oldBytes, size_t newBytes) const throw () {
+    if (mBacking != MAPPED || !ptr || newBytes == 0)
+        return 0;
+
+    size_t oldLength = mappedLength(oldBytes);
+    size_t newLength = mappedLength(newBytes);
+    if (newLength == oldLength)
+        return ptr;
+
+#ifdef MREMAP_MAYMOVE
+    void* result = mremap(ptr, oldLength, newLength, MREMAP_MAYMOVE);
+    if (result == MAP_FAILED)
+        return 0;
+
+    advise(result, newLength);
+    if ((mFlags & POPULATE) && newLength > oldLength)
+        prefault(static_cast<char*>(result) + oldLength, newLength - oldLength);
+    return result;
+#else
+    return 0;
+#endif
+}
+
+/**
+ * Releases memory obtained from allocate(bytes) of an equivalent storage.
+ * This operation is a no-throw.
+ *
+ * @param ptr
+ * @param bytes
+ */
+inline void ArrayStorage::deallocate(void* ptr, size_t bytes) const throw () {
+    if (!ptr)
+        return;
+
+    if (mBacking == ALIGNED)
+        std::free(ptr);
+    else if (mBacking == MAPPED)
+        munmap(ptr, mappedLength(bytes));
+    else if (bytes >= kMapThreshold)
+        munmap(ptr, bytes);
+    else
+        std::free(ptr);
+}
+
+/**
+ * Returns bytes rounded up to the granularity of this MAPPED storage.
+ *
+ * @param bytes
+ * @return
+ */
+inline size_t ArrayStorage::mappedLength(size_t bytes) const throw () {
+    size_t granularity = (mFlags & HUGE_PAGES) ? size_t(kHugePageSize) : size_t(sysconf(_SC_PAGESIZE));
+    return (bytes + granularity - 1) / granularity * granularity;
+}
+
+/**
+ * Applies the huge page advice to a freshly mapped region. Kernels without
+ * transparent huge page support reject the advice, which is harmless.
+ *
+ * @param ptr
+ * @param length
+ */
+inline void ArrayStorage::advise(void* ptr, size_t length) const throw () {
+#ifdef MADV_HUGEPAGE
+    if (mFlags & HUGE_PAGES)
+        madvise(ptr, length, MADV_HUGEPAGE);
+#else
+    (void) ptr;
+    (void) length;
+#endif
+}
+
+/**
+ * Faults in every page of a mapped region by writing to it.
+ *
+ * @param ptr
+ * @param length
+ */
+inline void ArrayStorage::prefault(void* ptr, size_t length) throw () {
+    size_t page = sysconf(_SC_PAGESIZE);
+    volatile char* bytes = static_cast<char*>(ptr);
+    for (size_t offset = 0; offset < length; offset += page)
+        bytes[offset] = 0;
+}
+
+#endif
@@ -0,0 +1,362 @@
+#ifndef _BLOCKING_QUEUE_CPP_
+#define _BLOCKING_QUEUE_CPP_
+
+#include "../include/BlockingQueue.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>                  // For size_t
+#include <algorithm>                // For std::min
+#include <mutex>
+
+
+/**
+ * Initializes an empty, open queue. A capacity of 0 makes the queue
+ * unbounded.
+ *
+ * @param capacity maximum number of elements, or 0 for no limit
+ */
+template <typename Container>
+BlockingQueue<Container>::BlockingQueue(size_t capacity)
+        : mCapacity(capacity), mConsumersParked(0), mProducersParked(0), mSize(0), mClosed(false) {
+    mQueue.reserve(capacity);
+}
+
+/**
+ * Removes the front element from this queue, waiting for one if the queue
+ * is empty. Throws Underflow if the queue is closed and empty.
+ */
+template <typename Container>
+void BlockingQueue<Container>::dequeue() {
+    std::unique_lock<std::mutex> lock(mMutex, std::defer_lock);
+    if (!awaitElement(lock, 0))
+        throw typename QueueBase<value_type>::Underflow();
+    mQueue.dequeue();
+    removed(lock, 1);
+}
+
+/**
+ * Removes the front element and returns it, moved out rather than copied,
+ * waiting for one if the queue is empty. Throws Underflow if the queue is
+ * closed and empty.
+ *
+ * @return
+ */
+template <typename Container>
+typename BlockingQueue<Container>::value_type BlockingQueue<Container>::dequeueValue() {
+    std::unique_lock<std::mutex> lock(mMutex, std::defer_lock);
+    if (!awaitElement(lock, 0))
+        throw typename QueueBase<value_type>::Underflow();
+    value_type value(mQueue.dequeueValue());
+    removed(lock, 1);
+    return value;
+}
+
+/**
+ * Adds value to the end of this queue, waiting for room if the queue is
+ * full. Throws Closed if the queue is closed.
+ *
+ * @param
+ */
+template <typename Container>
+void BlockingQueue<Container>::enqueue(const value_type& value) {
+    std::unique_lock<std::mutex> lock(mMutex, std::defer_lock);
+    awaitRoom(lock);
+    mQueue.enqueue(value);
+    added(lock, 1);
+}
+
+/**
+ * Returns a reference to the front of this queue. Throws Underflow if this
+ * queue is empty. The reference is invalidated by any later modification.
+ *
+ * @return
+ */
+template <typename Container>
+const typename BlockingQueue<Container>::value_type& BlockingQueue<Container>::front() const {
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mQueue.front();
+}
+
+/**
+ * Returns the size of this queue.
+ *
+ * @return
+ */
+template <typename Container>
+size_t BlockingQueue<Container>::size() const {
+    return mSize.load(std::memory_order_acquire);
+}
+
+/**
+ * Moves the front element into out, removes it and returns true, or
+ * returns false at once if this queue is empty.
+ *
+ * @param out receives the front element
+ * @return
+ */
+template <typename Container>
+bool BlockingQueue<Container>::tryDequeue(value_type& out) {
+    if (mSize.load(std::memory_order_acquire) == 0)
+        return false;               // Spare the lock when there is obviously nothing
+
+    std::unique_lock<std::mutex> lock(mMutex);
+    if (!mQueue.tryDequeue(out))
+        return false;
+    removed(lock, 1);
+    return true;
+}
+
+/**
+ * Adds the count elements of values to the end of this queue, in order,
+ * waiting for room as needed. Throws Closed if the queue is closed before
+ * all of them are added; the ones added so far stay in the queue.
+ *
+ * @param values elements to enqueue
+ * @param count number of elements to enqueue
+ */
+template <typename Container>
+void BlockingQueue<Container>::enqueueBulk(const value_type* values, size_t count) {
+    while (count > 0) {
+        std::unique_lock<std::mutex> lock(mMutex, std::defer_lock);
+        awaitRoom(lock);
+        size_t n = mCapacity == 0 ? count : std::min(count, mCapacity - mQueue.size());
+        mQueue.enqueueBulk(values, n);
+        added(lock, n);
+        values += n;
+        count -= n;
+    }
+}
+
+/**
+ * Moves up to count elements from the front of this queue into out, in
+ * dequeue order, and removes them, without waiting. Returns the number of
+ * elements moved.
+ *
+ * @param out receives the dequeued elements
+ * @param count maximum number of elements to dequeue
+ * @return
+ */
+template <typename Container>
+size_t BlockingQueue<Container>::dequeueBulk(value_type* out, size_t count) {
+    std::unique_lock<std::mutex> lock(mMutex);
+    size_t dequeued = mQueue.dequeueBulk(out, count);
+    if (dequeued > 0)
+        removed(lock, dequeued);
+    return dequeued;
+}
+
+/**
+ * Moves the front element into out and removes it, waiting at most
+ * timeout for one to arrive. Returns false if none arrived in time or the
+ * queue is closed and empty.
+ *
+ * @param out receives the front element
+ * @param timeout longest time to wait
+ * @return
+ */
+template <typename Container>
+template <typename Rep, typename Period>
+bool BlockingQueue<Container>::dequeueFor(value_type& out, const std::chrono::duration<Rep, Period>& timeout) {
+    Clock::time_point deadline = Clock::now() + std::chrono::duration_cast<Clock::duration>(timeout);
+    std::unique_lock<std::mutex> lock(mMutex, std::defer_lock);
+    if (!awaitElement(lock, &deadline))
+        return false;
+    mQueue.tryDequeue(out);
+    removed(lock, 1);
+    return true;
+}
+
+/**
+ * Moves up to max elements from the front of this queue into out, in
+ * dequeue order, and removes them, waiting at most timeout for the first
+ * one. Returns the number of elements moved, which is 0 only if none
+ * arrived in time or the queue is closed and empty.
+ *
+ * @param out receives the dequeued elements
+ * @param max maximum number of elements to dequeue
+ * @param timeout longest time to wait
+ * @return
+ */
+template <typename Container>
+template <typename Rep, typename Period>
+size_t BlockingQueue<Container>::dequeueBatch(value_type* out, size_t max,
+                                              const std::chrono::duration<Rep, Period>& timeout) {
+    if (max == 0)
+        return 0;
+
+    Clock::time_point deadline = Clock::now() + std::chrono::duration_cast<Clock::duration>(timeout);
+    std::unique_lock<std::mutex> lock(mMutex, std::defer_lock);
+    if (!awaitElement(lock, &deadline))
+        return 0;
+    size_t dequeued = mQueue.dequeueBulk(out, max);
+    removed(lock, dequeued);
+    return dequeued;
+}
+
+/**
+ * Adds value to the end of this queue and returns true, or returns false
+ * at once if the queue is full. Throws Closed if the queue is closed.
+ *
+ * @param value value to enqueue
+ * @return
+ */
+template <typename Container>
+bool BlockingQueue<Container>::tryEnqueue(const value_type& value) {
+    std::unique_lock<std::mutex> lock(mMutex);
+    if (mClosed.load(std::memory_order_relaxed))
+        throw Closed();
+    if (isFull())
+        return false;
+    mQueue.enqueue(value);
+    added(lock, 1);
+    return true;
+}
+
+/**
+ * Closes this queue and wakes every waiting thread. Elements already in
+ * the queue can still be dequeued. Closing a closed queue does nothing.
+ */
+template <typename Container>
+void BlockingQueue<Container>::close() {
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mClosed.store(true, std::memory_order_release);
+    }
+    mNotEmpty.notify_all();
+    mNotFull.notify_all();
+}
+
+/**
+ * Returns true if close() has been called.
+ * This operation is a no-throw.
+ *
+ * @return
+ */
+template <typename Container>
+bool BlockingQueue<Container>::isClosed() const throw () {
+    return mClosed.load(std::memory_order_acquire);
+}
+
+/**
+ * Returns the maximum number of elements, or 0 if the queue is unbounded.
+ * This operation is a no-throw.
+ *
+ * @return
+ */
+template <typename Container>
+size_t BlockingQueue<Container>::capacity() const throw () {
+    return mCapacity;
+}
+
+/**
+ * Spins for a short while until an element is available or the queue is
+ * closed, then takes the lock and parks until then or until deadline, if
+ * one is given. Returns with the lock held; true if an element is
+ * available.
+ *
+ * @param lock unlocked lock on mMutex
+ * @param deadline latest time to wait until, or null to wait forever
+ * @return
+ */
+template <typename Container>
+bool BlockingQueue<Container>::awaitElement(std::unique_lock<std::mutex>& lock, const Clock::time_point* deadline) {
+    for (unsigned spin = 0; spin < kSpinCount; ++spin) {
+        if (mSize.load(std::memory_order_acquire) > 0 || mClosed.load(std::memory_order_acquire))
+            break;
+    }
+
+    lock.lock();
+    while (mQueue.isEmpty()) {
+        if (mClosed.load(std::memory_order_relaxed))
+            return false;
+        ++mConsumersParked;
+        bool timedOut = false;
+        if (deadline)
+            timedOut = mNotEmpty.wait_until(lock, *deadline) == std::cv_status::timeout;
+        else
+            mNotEmpty.wait(lock);
+        --mConsumersParked;
+        if (timedOut && mQueue.isEmpty())
+            return false;
+    }
+    return true;
+}
+
+/**
+ * Spins for a short while until there is room or the queue is closed,
+ * then takes the lock and parks until then. Throws Closed if the queue is
+ * closed. Returns with the lock held and room for at least one element.
+ *
+ * @param lock unlocked lock on mMutex
+ */
+template <typename Container>
+void BlockingQueue<Container>::awaitRoom(std::unique_lock<std::mutex>& lock) {
+    if (mCapacity != 0) {
+        for (unsigned spin = 0; spin < kSpinCount; ++spin) {
+            if (mSize.load(std::memory_order_acquire) < mCapacity || mClosed.load(std::memory_order_acquire))
+                break;
+        }
+    }
+
+    lock.lock();
+    while (isFull() && !mClosed.load(std::memory_order_relaxed)) {
+        ++mProducersParked;
+        mNotFull.wait(lock);
+        --mProducersParked;
+    }
+    if (mClosed.load(std::memory_order_relaxed))
+        throw Closed();
+}
+
+/**
+ * Publishes the new size after elements were added and wakes a parked
+ * consumer, if any. The lock is released.
+ *
+ * @param lock locked lock on mMutex
+ * @param count number of elements added
+ */
+template <typename Container>
+void BlockingQueue<Container>::added(std::unique_lock<std::mutex>& lock, size_t count) {
+    mSize.store(mQueue.size(), std::memory_order_release);
+    bool wake = mConsumersParked > 0;
+    lock.unlock();
+    if (!wake)
+        return;
+    if (count == 1)
+        mNotEmpty.notify_one();
+    else
+        mNotEmpty.notify_all();
+}
+
+/**
+ * Publishes the new size after elements were removed and wakes parked
+ * producers, if any. The lock is released.
+ *
+ * @param lock locked lock on mMutex
+ * @param count number of elements removed
+ */
+template <typename Container>
+void BlockingQueue<Container>::removed(std::unique_lock<std::mutex>& lock, size_t count) {
+    mSize.store(mQueue.size(), std::memory_order_release);
+    bool wake = mProducersParked > 0;
+    lock.unlock();
+    if (!wake)
+        return;
+    if (count == 1)
+        mNotFull.notify_one();
+    else
+        mNotFull.notify_all();
+}
+
+/**
+ * Returns true if no more elements fit. The lock must be held.
+ *
+ * @return
+ */
+template <typename Container>
+bool BlockingQueue<Container>::isFull() const {
+    return mCapacity != 0 && mQueue.size() >= mCapacity;
+}
+
+#endif
@@ -0,0 +1,316 @@
+#ifndef _COMPRESSED_INT_LIST_CPP_
+#define _COMPRESSED_INT_LIST_CPP_
+
+#include "../include/CompressedIntList.h"
+#include "../include/CompressedIntListIterators.h"
+#include "../include/ArrayList.h"
+#include <cstdlib>                  // For size_t
+#include <stdint.h>                 // For uint64_t, uint8_t
+#include <stdexcept>                // For std::out_of_range
+#include <sstream>                  // For std::ostringstream
+#include <algorithm>
+
+
+/**
+ * Initializes an empty CompressedIntList.
+ * This operation provides strong exception safety.
+ */
+inline CompressedIntList::CompressedIntList() : mSize(0), mTailSize(0) {
+}
+
+/**
+ * Adds value to the end of this list. This is a constant time operation
+ * unless the tail block is full, in which case time proportional to
+ * kBlockSize is needed to seal it first.
+ * This operation provides strong exception safety.
+ *
+ * @param value value to append to this list
+ */
+inline void CompressedIntList::add(value_type value) {
+    if (mTailSize == kBlockSize)
+        sealTail();
+    mTail[mTailSize++] = value;
+    ++mSize;
+}
+
+/**
+ * Empties this list releasing all of its resources.
+ * This operation is a no-throw.
+ */
+inline void CompressedIntList::clear() throw () {
+    mBlocks.clear();
+    mData.clear();
+    mSize = 0;
+    mTailSize = 0;
+}
+
+/**
+ * Returns the value stored at the provided index. If index is out of
+ * bounds, an std::out_of_range exception is thrown with the index as its
+ * message. Time proportional to kBlockSize is needed in the worst case.
+ * This operation provides strong exception safety.
+ *
+ * @param index index of the element to return
+ * @return the element at the index.
+ */
+inline CompressedIntList::value_type CompressedIntList::get(size_t index) const throw (std::out_of_range) {
+    rangeCheck(index);
+    return (*this)[index];
+}
+
+/**
+ * Returns the value stored at the provided index. No range checking is
+ * performed on the index.
+ *
+ * @param index index of the element to return
+ * @return the element at the index.
+ */
+inline CompressedIntList::value_type CompressedIntList::operator[](size_t index) const throw () {
+    size_t blockNum = index / kBlockSize;
+    size_t pos = index % kBlockSize;
+    if (blockNum == mBlocks.size())
+        return mTail[pos];
+
+    const Block& block = mBlocks[blockNum];
+    if (block.mEncoding == FRAME_OF_REFERENCE) {
+        if (block.mWidth == 0)
+            return block.mMin;
+        return block.mMin + readBits(&mData[block.mOffset], pos * block.mWidth, block.mWidth);
+    }
+
+    const uint8_t* ptr = &mData[block.mOffset];
+    value_type value = block.mFirst;
+    for (size_t i = 0; i < pos; ++i)
+        value += unzigzag(readVarint(ptr));
+    return value;
+}
+
+/**
+ * Returns true if this list holds the same values as rhs.
+ *
+ * @param rhs
+ * @return
+ */
+inline bool CompressedIntList::operator==(const CompressedIntList& rhs) const {
+    return mSize == rhs.mSize && std::equal(begin(), end(), rhs.begin());
+}
+
+/**
+ * Returns false if this list holds the same values as rhs.
+ *
+ * @param rhs
+ * @return
+ */
+inline bool CompressedIntList::operator!=(const CompressedIntList& rhs) const {
+    return !(*this == rhs);
+}
+
+/**
+ * Returns a constant iterator to the beginning.
+ *
+ * @return
+ */
+inline CompressedIntList::const_iterator CompressedIntList::begin() const {
+    return const_iterator(this, 0);
+}
+
+/**
+ * Returns a constant iterator to the end.
+ *
+ * @return
+ */
+inline CompressedIntList::const_iterator CompressedIntList::end() const {
+    return const_iterator(this, mSize);
+}
+
+/**
+ * Returns true if this list is empty and false otherwise.
+ * This operation is a no-throw.
+ *
+ * @return
+ */
+inline bool CompressedIntList::isEmpty() const throw () {
+    return mSize == 0;
+}
+
+/**
+ * Return the size of this list.
+ * This operation is a no-throw.
+ *
+ * @return
+ */
+inline size_t CompressedIntList::size() const throw () {
+    return mSize;
+}
+
+/**
+ * Returns the number of bytes of encoded payload and skip index currently
+ * in use, excluding the fixed-size tail buffer.
+ * This operation is a no-throw.
+ *
+ * @return
+ */
+inline size_t CompressedIntList::compressedBytes() const throw () {
+    return mData.size() + mBlocks.size() * sizeof(Block);
+}
+
+/**
+ * Decodes the block with the provided number (the tail being number
+ * mBlocks.size()) into out and returns the number of values written.
+ *
+ * @param blockNum
+ * @param out array of at least kBlockSize elements
+ * @return
+ */
+inline size_t CompressedIntList::decodeBlock(size_t blockNum, value_type* out) const throw () {
+    if (blockNum == mBlocks.size()) {
+        std::copy(mTail, mTail + mTailSize, out);
+        return mTailSize;
+    }
+
+    const Block& block = mBlocks[blockNum];
+    if (block.mEncoding == FRAME_OF_REFERENCE) {
+        if (block.mWidth == 0) {
+            std::fill(out, out + kBlockSize, block.mMin);
+        } else {
+            const uint8_t* data = &mData[block.mOffset];
+            for (size_t i = 0; i < kBlockSize; ++i)
+                out[i] = block.mMin + readBits(data, i * block.mWidth, block.mWidth);
+        }
+    } else {
+        const uint8_t* ptr = &mData[block.mOffset];
+        out[0] = block.mFirst;
+        for (size_t i = 1; i < kBlockSize; ++i)
+            out[i] = out[i - 1] + unzigzag(readVarint(ptr));
+    }
+    return kBlockSize;
+}
+
+/**
+ * Encodes the full tail buffer into a new block and empties the tail. If
+ * an allocation fails, the bytes already written are dropped again.
+ * This operation provides strong exception safety.
+ */
+inline void CompressedIntList::sealTail() {
+    Block block;
+    block.mFirst = mTail[0];
+    block.mOffset = mData.size();
+    block.mMin = *std::min_element(mTail, mTail + kBlockSize);
+
+    uint64_t range = *std::max_element(mTail, mTail + kBlockSize) - block.mMin;
+    block.mWidth = range == 0 ? 0 : 64 - __builtin_clzll(range);
+
+    size_t deltaBytes = 0;
+    for (size_t i = 1; i < kBlockSize; ++i)
+        deltaBytes += varintLength(zigzag(mTail[i] - mTail[i - 1]));
+    size_t forBytes = (kBlockSize * block.mWidth + 7) / 8;
+
+    try {
+        if (forBytes <= deltaBytes) {
+            block.mEncoding = FRAME_OF_REFERENCE;
+            for (size_t i = 0; i < forBytes; ++i)
+                mData.add(0);
+            for (size_t i = 0; i < kBlockSize; ++i) {
+                uint64_t offset = mTail[i] - block.mMin;
+                size_t bitPos = i * block.mWidth;
+                for (unsigned written = 0; written < block.mWidth; ) {
+                    unsigned shift = bitPos % 8;
+                    unsigned chunk = std::min(8 - shift, block.mWidth - written);
+                    uint8_t bits = (offset >> written) & ((1u << chunk) - 1);
+                    mData[block.mOffset + bitPos / 8] |= bits << shift;
+                    written += chunk;
+                    bitPos += chunk;
+                }
+            }
+        } else {
+            block.mEncoding = DELTA_VARINT;
+            for (size_t i = 1; i < kBlockSize; ++i) {
+                uint64_t code = zigzag(mTail[i] - mTail[i - 1]);
+                while (code >= 0x80) {
+                    mData.add(static_cast<uint8_t>(code | 0x80));
+                    code >>= 7;
+                }
+                mData.add(static_cast<uint8_t>(code));
+            }
+        }
+
+        mBlocks.add(block);
+    } catch (...) {
+        mData.removeRange(block.mOffset, mData.size());
+        throw;
+    }
+    mTailSize = 0;
+}
+
+/**
+ * Given an index, this method throws an std::out_of_range with the index as
+ * its message if index is out of bounds or is a no-op otherwise.
+ * This operation provides strong exception safety.
+ *
+ * @param index index to check
+ */
+inline void CompressedIntList::rangeCheck(size_t index) const throw (std::out_of_range) {
+    if (index >= mSize) {
+        std::ostringstream os;
+        os << index;
+        throw std::out_of_range(os.str());
+    }
+}
+
+/**
+ * Maps a signed delta (stored two's complement) to an unsigned code so that
+ * small magnitudes of either sign get small codes.
+ */
+inline uint64_t CompressedIntList::zigzag(uint64_t delta) throw () {
+    return (delta << 1) ^ static_cast<uint64_t>(static_cast<int64_t>(delta) >> 63);
+}
+
+/**
+ * Inverse of zigzag(uint64_t).
+ */
+inline uint64_t CompressedIntList::unzigzag(uint64_t code) throw () {
+    return (code >> 1) ^ (~(code & 1) + 1);
+}
+
+/**
+ * Returns the number of bytes needed to varint-encode value.
+ */
+inline size_t CompressedIntList::varintLength(uint64_t value) throw () {
+    size_t length = 1;
+    while (value >= 0x80) {
+        value >>= 7;
+        ++length;
+    }
+    return length;
+}
+
+/**
+ * Decodes the varint at ptr and advances ptr past it.
+ */
+inline uint64_t CompressedIntList::readVarint(const uint8_t*& ptr) throw () {
+    uint64_t value = 0;
+    for (unsigned shift = 0; ; shift += 7) {
+        uint8_t byte = *ptr++;
+        value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if (byte < 0x80)
+            return value;
+    }
+}
+
+/**
+ * Reads width bits (LSB first) starting at bit bitPos of data.
+ */
+inline uint64_t CompressedIntList::readBits(const uint8_t* data, size_t bitPos, unsigned width) throw () {
+    uint64_t value = 0;
+    for (unsigned read = 0; read < width; ) {
+        unsigned shift = bitPos % 8;
+        unsigned chunk = std::min(8 - shift, width - read);
+        uint64_t bits = (data[bitPos / 8] >> shift) & ((1u << chunk) - 1);
+        value |= bits << read;
+        read += chunk;
+        bitPos += chunk;
+    }
+    return value;
+}
+
+#endif
@@ -0,0 +1,298 @@
+#ifndef _CONCURRENT_STACK_CPP_
+#define _CONCURRENT_STACK_CPP_
+
+#include "../include/ConcurrentStack.h"
+#include <atomic>
+#include <cstdlib>                  // For size_t
+#include <new>                      // For std::bad_alloc
+#include <stdint.h>                 // For uint32_t, uint64_t
+#include <utility>                  // For std::move
+
+
+/**
+ * Initializes an empty stack.
+ */
+template <typename T>
+ConcurrentStack<T>::ConcurrentStack() : mHead(0), mFree(0), mNextIndex(1), mSize(0) {
+    for (size_t k = 0; k < kMaxChunks; ++k)
+        mChunks[k].store(0, std::memory_order_relaxed);
+}
+
+/**
+ * Destroys the stack and all of its nodes. No thread may use the stack
+ * any more.
+ */
+template <typename T>
+ConcurrentStack<T>::~ConcurrentStack() {
+    for (size_t k = 0; k < kMaxChunks; ++k)
+        delete[] mChunks[k].load(std::memory_order_relaxed);
+}
+
+/**
+ * Removes the top element from this stack. Throws Underflow if this stack
+ * is empty.
+ */
+template <typename T>
+void ConcurrentStack<T>::pop() {
+    uint32_t index = popIndex(mHead);
+    if (index == 0)
+        throw typename StackBase<T>::Underflow();
+    mSize.fetch_sub(1, std::memory_order_relaxed);
+    node(index).mItem = T();        // Release whatever the element holds
+    pushChain(mFree, index, index);
+}
+
+/**
+ * Removes the top element and returns it, moved out rather than copied.
+ * Throws Underflow if this stack is empty.
+ *
+ * @return
+ */
+template <typename T>
+T ConcurrentStack<T>::popValue() {
+    uint32_t index = popIndex(mHead);
+    if (index == 0)
+        throw typename StackBase<T>::Underflow();
+    mSize.fetch_sub(1, std::memory_order_relaxed);
+    T value(std::move(node(index).mItem));
+    pushChain(mFree, index, index);
+    return value;
+}
+
+/**
+ * Pushes value onto this stack.
+ * This operation provides strong exception safety.
+ *
+ * @param
+ */
+template <typename T>
+void ConcurrentStack<T>::push(const T& value) {
+    uint32_t index = acquire(value);
+    mSize.fetch_add(1, std::memory_order_relaxed);
+    pushChain(mHead, index, index);
+}
+
+/**
+ * Returns the number of elements in this stack.
+ *
+ * @return
+ */
+template <typename T>
+size_t ConcurrentStack<T>::size() const {
+    return mSize.load(std::memory_order_relaxed);
+}
+
+/**
+ * Moves the top element into out, removes it and returns true, or returns
+ * false if this stack is empty.
+ *
+ * @param out receives the top element
+ * @return
+ */
+template <typename T>
+bool ConcurrentStack<T>::tryPop(T& out) {
+    uint32_t index = popIndex(mHead);
+    if (index == 0)
+        return false;
+    try {
+        out = std::move(node(index).mItem);
+    } catch (...) {
+        pushChain(mHead, index, index);
+        throw;
+    }
+    mSize.fetch_sub(1, std::memory_order_relaxed);
+    pushChain(mFree, index, index);
+    return true;
+}
+
+/**
+ * Pushes the count elements of values in order, so that the last one ends
+ * on top, with a single compare-and-swap. No other thread's element ends
+ * up in between.
+ * This operation provides strong exception safety.
+ *
+ * @param values elements to push
+ * @param count number of elements to push
+ */
+template <typename T>
+void ConcurrentStack<T>::pushBulk(const T* values, size_t count) {
+    if (count == 0)
+        return;
+
+    // Link the chain privately from the new top down to the first value
+    uint32_t first = 0;
+    uint32_t last = 0;
+    try {
+        for (size_t i = 0; i < count; ++i) {
+            uint32_t index = acquire(values[i]);
+            node(index).mNext.store(first, std::memory_order_relaxed);
+            if (first == 0)
+                last = index;
+            first = index;
+        }
+    } catch (...) {
+        if (first != 0)
+            pushChain(mFree, first, last);
+        throw;
+    }
+    mSize.fetch_add(count, std::memory_order_relaxed);
+    pushChain(mHead, first, last);
+}
+
+/**
+ * Returns a reference to the top of this stack. Throws Underflow if this
+ * stack is empty. The reference is only stable while no other thread
+ * pops.
+ *
+ * @return
+ */
+template <typename T>
+const T& ConcurrentStack<T>::top() const {
+    uint32_t index = static_cast<uint32_t>(mHead.load(std::memory_order_acquire));
+    if (index == 0)
+        throw typename StackBase<T>::Underflow();
+    return node(index).mItem;
+}
+
+/**
+ * Returns the node with the given non-zero index.
+ * This operation is a no-throw.
+ *
+ * @param index
+ * @return
+ */
+template <typename T>
+typename ConcurrentStack<T>::Node& ConcurrentStack<T>::node(uint32_t index) const throw () {
+    // Index i lives at offset j - (kFirstChunk << k) of chunk k, where
+    // j = i - 1 + kFirstChunk and k is the position of j's top bit minus
+    // kFirstChunkBits
+    uint64_t j = static_cast<uint64_t>(index) - 1 + kFirstChunk;
+    unsigned k = 63 - __builtin_clzll(j) - kFirstChunkBits;
+    return mChunks[k].load(std::memory_order_acquire)[j - (static_cast<uint64_t>(kFirstChunk) << k)];
+}
+
+/**
+ * Returns the index of a node holding value, taken from the free list or
+ * carved from a chunk.
+ * This operation provides strong exception safety.
+ *
+ * @param value
+ * @return
+ */
+template <typename T>
+uint32_t ConcurrentStack<T>::acquire(const T& value) {
+    uint32_t index = popIndex(mFree);
+    if (index == 0) {
+        uint64_t fresh = mNextIndex.fetch_add(1, std::memory_order_relaxed);
+        if (fresh > (static_cast<uint64_t>(kFirstChunk) << kMaxChunks) - kFirstChunk)
+            throw std::bad_alloc();
+        index = static_cast<uint32_t>(fresh);
+
+        // The first thread to need a chunk allocates it; a loser of the race
+        // throws its copy away
+        uint64_t j = fresh - 1 + kFirstChunk;
+        unsigned k = 63 - __builtin_clzll(j) - kFirstChunkBits;
+        if (!mChunks[k].load(std::memory_order_acquire)) {
+            Node* chunk = new Node[static_cast<size_t>(kFirstChunk) << k];
+            Node* expected = 0;
+            if (!mChunks[k].compare_exchange_strong(expected, chunk, std::memory_order_acq_rel))
+                delete[] chunk;
+        }
+    }
+
+    try {
+        node(index).mItem = value;
+    } catch (...) {
+        pushChain(mFree, index, index);
+        throw;
+    }
+    return index;
+}
+
+/**
+ * Links the chain first..last, whose last node's link is rewritten, on top
+ * of list with one compare-and-swap.
+ * This operation is a no-throw.
+ *
+ * @param list
+ * @param first
+ * @param last
+ */
+template <typename T>
+void ConcurrentStack<T>::pushChain(std::atomic<uint64_t>& list, uint32_t first, uint32_t last) throw () {
+    uint64_t old = list.load(std::memory_order_relaxed);
+    while (!casPush(list, first, last, old))
+        ;
+}
+
+/**
+ * Unlinks and returns the top node index of list, or 0 if list is empty.
+ * This operation is a no-throw.
+ *
+ * @param list
+ * @return
+ */
+template <typename T>
+uint32_t ConcurrentStack<T>::popIndex(std::atomic<uint64_t>& list) throw () {
+    uint64_t old = list.load(std::memory_order_acquire);
+    uint32_t index;
+    while (!casPop(list, old, index))
+        ;
+    return index;
+}
+
+/**
+ * Makes one attempt at linking the chain first..last on top of list, whose
+ * head was last seen as old. Returns false, with old refreshed, if another
+ * thread changed list in between.
+ * This operation is a no-throw.
+ *
+ * @param list
+ * @param first
+ * @param last
+ * @param old
+ * @return
+ */
+template <typename T>
+bool ConcurrentStack<T>::casPush(std::atomic<uint64_t>& list, uint32_t first, uint32_t last, uint64_t& old) throw () {
+    node(last).mNext.store(static_cast<uint32_t>(old), std::memory_order_relaxed);
+    return list.compare_exchange_weak(old, tagged(first, old), std::memory_order_release, std::memory_order_relaxed);
+}
+
+/**
+ * Makes one attempt at unlinking the top node of list, whose head was last
+ * seen as old. Returns true with the node's index in index, or 0 if list
+ * is empty, or false, with old refreshed, if another thread changed list
+ * in between.
+ * This operation is a no-throw.
+ *
+ * @param list
+ * @param old
+ * @param index
+ * @return
+ */
+template <typename T>
+bool ConcurrentStack<T>::casPop(std::atomic<uint64_t>& list, uint64_t& old, uint32_t& index) throw () {
+    index = static_cast<uint32_t>(old);
+    if (index == 0)
+        return true;
+    // The node may be popped and reused under our feet; the tag makes the
+    // exchange fail in that case, so a stale link is never installed
+    uint32_t next = node(index).mNext.load(std::memory_order_relaxed);
+    return list.compare_exchange_weak(old, tagged(next, old), std::memory_order_acquire, std::memory_order_acquire);
+}
+
+/**
+ * Returns a tagged list head holding index, with the tag of old bumped.
+ * This operation is a no-throw.
+ *
+ * @param index
+ * @param old
+ * @return
+ */
+template <typename T>
+uint64_t ConcurrentStack<T>::tagged(uint32_t index, uint64_t old) throw () {
+    return (((old >> 32) + 1) << 32) | index;
+}
+
+#endif
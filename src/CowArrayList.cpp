@@ -0,0 +1,273 @@
+#ifndef _COW_ARRAY_LIST_CPP_
+#define _COW_ARRAY_LIST_CPP_
+
+#include "../include/CowArrayList.h"
+#include <atomic>
+#include <cstdlib>                  // For size_t
+#include <stdexcept>                // For std::out_of_range
+
+
+/**
+ * Initializes the CowArrayList with size elements all set to value. If size
+ * is not supplied, an empty CowArrayList is created. If value is not
+ * supplied, the default value for the parametrized type will be used.
+ * This operation provides strong exception safety.
+ *
+ * @param size size of the CowArrayList to create
+ * @param value value used to fill the CowArrayList
+ */
+template <typename T>
+CowArrayList<T>::CowArrayList(size_t size, const_reference value) : mBuffer(new Buffer(size, value)) {
+}
+
+/**
+ * Initializes the CowArrayList to share the buffer of src in constant time.
+ * This operation is a no-throw.
+ *
+ * @param src CowArrayList to copy
+ */
+template <typename T>
+CowArrayList<T>::CowArrayList(const CowArrayList<T>& src) throw () : mBuffer(src.mBuffer) {
+    mBuffer->mRefs.fetch_add(1, std::memory_order_relaxed);
+}
+
+/**
+ * Releases this CowArrayList's share of its buffer, destroying the buffer
+ * if this was the last share.
+ * This operation is a no-throw.
+ */
+template <typename T>
+CowArrayList<T>::~CowArrayList() throw () {
+    release(mBuffer);
+}
+
+/**
+ * Makes this object share the buffer of rhs in constant time. Note that
+ * calling this method on yourself (a = a;) is equivalent to a no-op.
+ * This operation is a no-throw.
+ *
+ * @param rhs CowArrayList to copy
+ * @return *this, used for chaining.
+ */
+template <typename T>
+const CowArrayList<T>& CowArrayList<T>::operator=(const CowArrayList<T>& rhs) throw () {
+    rhs.mBuffer->mRefs.fetch_add(1, std::memory_order_relaxed);
+    release(mBuffer);
+    mBuffer = rhs.mBuffer;
+    return *this;
+}
+
+/**
+ * Adds value to the end of this CowArrayList, cloning a shared buffer
+ * first.
+ * This operation provides strong exception safety.
+ *
+ * @param value value to append to this CowArrayList
+ */
+template <typename T>
+void CowArrayList<T>::add(const_reference value) {
+    detach().add(value);
+}
+
+/**
+ * Inserts value at the specified index, cloning a shared buffer first. All
+ * elements at or to the right of index are shifted down by one spot. If
+ * this CowArrayList needs to be enlarged, default values are used to fill
+ * the gaps.
+ * This operation provides strong exception safety.
+ *
+ * @param index index at which to insert value
+ * @param value the element to insert
+ */
+template <typename T>
+void CowArrayList<T>::add(size_t index, const_reference value) {
+    detach().add(index, value);
+}
+
+/**
+ * Empties this CowArrayList. A shared buffer is released rather than
+ * cleared.
+ * This operation provides strong exception safety.
+ */
+template <typename T>
+void CowArrayList<T>::clear() {
+    if (unique()) {
+        mBuffer->mList.clear();
+    } else {
+        Buffer* empty = new Buffer(0, value_type());
+        release(mBuffer);
+        mBuffer = empty;
+    }
+}
+
+/**
+ * Returns a constant reference to the element stored at the provided index.
+ * If index is out of bounds, an std::out_of_range exception is thrown with
+ * the index as its message.
+ * This operation provides strong exception safety.
+ *
+ * @param index index of the element to return
+ * @return constant reference to the element at the index.
+ */
+template <typename T>
+typename CowArrayList<T>::const_reference CowArrayList<T>::get(size_t index) const throw (std::out_of_range) {
+    const ArrayList<T>& list = mBuffer->mList;
+    return list.get(index);
+}
+
+/**
+ * Returns a constant reference to the element stored at the provided index.
+ * No bounds checking is performed.
+ * This operation is a no-throw.
+ *
+ * @param index index of the element to return
+ * @return constant reference to the element at the index.
+ */
+template <typename T>
+typename CowArrayList<T>::const_reference CowArrayList<T>::operator[](size_t index) const throw () {
+    const ArrayList<T>& list = mBuffer->mList;
+    return list[index];
+}
+
+/**
+ * Returns true if this CowArrayList is logically equal to rhs. Lists
+ * sharing a buffer compare equal in constant time.
+ *
+ * @param rhs
+ * @return
+ */
+template <typename T>
+bool CowArrayList<T>::operator==(const CowArrayList<T>& rhs) const {
+    return mBuffer == rhs.mBuffer || mBuffer->mList == rhs.mBuffer->mList;
+}
+
+/**
+ * Returns false if this CowArrayList is logically equal to rhs.
+ *
+ * @param rhs
+ * @return
+ */
+template <typename T>
+bool CowArrayList<T>::operator!=(const CowArrayList<T>& rhs) const {
+    return !(*this == rhs);
+}
+
+/**
+ * Returns a constant iterator to the first element.
+ * This operation is a no-throw.
+ *
+ * @return
+ */
+template <typename T>
+typename CowArrayList<T>::const_iterator CowArrayList<T>::begin() const throw () {
+    const ArrayList<T>& list = mBuffer->mList;
+    return list.begin();
+}
+
+/**
+ * Returns a constant iterator one past the last element.
+ * This operation is a no-throw.
+ *
+ * @return
+ */
+template <typename T>
+typename CowArrayList<T>::const_iterator CowArrayList<T>::end() const throw () {
+    const ArrayList<T>& list = mBuffer->mList;
+    return list.end();
+}
+
+/**
+ * Returns true if this CowArrayList is empty and false otherwise.
+ * This operation is a no-throw.
+ *
+ * @return
+ */
+template <typename T>
+bool CowArrayList<T>::isEmpty() const throw () {
+    return mBuffer->mList.isEmpty();
+}
+
+/**
+ * Removes and returns the element at the specified index, cloning a shared
+ * buffer first. If index is out of bounds, an std::out_of_range exception
+ * is thrown with index as its message.
+ * This operation provides strong exception safety.
+ *
+ * @param index index of the object to remove.
+ * @return copy of the just removed object.
+ */
+template <typename T>
+typename CowArrayList<T>::value_type CowArrayList<T>::remove(size_t index) {
+    mBuffer->mList.get(index);      // Range check before cloning
+    return detach().remove(index);
+}
+
+/**
+ * Sets the element at the specified index to the provided value, cloning a
+ * shared buffer first. If index is out of bounds, an std::out_of_range
+ * exception is thrown with the index as its message.
+ * This operation provides strong exception safety if the buffer had to be
+ * cloned and no exception safety otherwise.
+ *
+ * @param index index of the object to set
+ * @param value the new value
+ */
+template <typename T>
+void CowArrayList<T>::set(size_t index, const_reference value) {
+    mBuffer->mList.get(index);      // Range check before cloning
+    detach().set(index, value);
+}
+
+/**
+ * Return the size of this CowArrayList.
+ * This operation is a no-throw.
+ *
+ * @return
+ */
+template <typename T>
+size_t CowArrayList<T>::size() const throw () {
+    return mBuffer->mList.size();
+}
+
+/**
+ * Returns true if no other CowArrayList shares this one's buffer, meaning
+ * the next modification will not clone it.
+ * This operation is a no-throw.
+ *
+ * @return
+ */
+template <typename T>
+bool CowArrayList<T>::unique() const throw () {
+    return mBuffer->mRefs.load(std::memory_order_acquire) == 1;
+}
+
+/**
+ * Gives this CowArrayList a buffer of its own, cloning the shared one if
+ * needed, and returns its list.
+ * This operation provides strong exception safety.
+ *
+ * @return
+ */
+template <typename T>
+ArrayList<T>& CowArrayList<T>::detach() {
+    if (!unique()) {
+        Buffer* copy = new Buffer(mBuffer->mList);
+        release(mBuffer);
+        mBuffer = copy;
+    }
+    return mBuffer->mList;
+}
+
+/**
+ * Drops one share of buffer, destroying it if that was the last one.
+ * This operation is a no-throw.
+ *
+ * @param buffer
+ */
+template <typename T>
+void CowArrayList<T>::release(Buffer* buffer) throw () {
+    if (buffer->mRefs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        delete buffer;
+}
+
+#endif
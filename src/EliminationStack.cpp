@@ -0,0 +1,274 @@
+#ifndef _ELIMINATION_STACK_CPP_
+#define _ELIMINATION_STACK_CPP_
+
+#include "../include/EliminationStack.h"
+#include "../include/ArrayStorage.h"
+#include <atomic>
+#include <cstdlib>                  // For size_t
+#include <algorithm>                // For std::min, std::max
+#include <functional>               // For std::hash
+#include <stdint.h>                 // For uint32_t, uint64_t
+#include <thread>                   // For std::thread::hardware_concurrency
+#include <utility>                  // For std::move
+
+
+/**
+ * Initializes an empty stack whose elimination array has slots slots. If
+ * slots is 0, half the number of hardware threads is used.
+ *
+ * @param slots maximum number of elimination slots
+ */
+template <typename T>
+EliminationStack<T>::EliminationStack(size_t slots)
+        : mSlots(slotCount(slots), ArrayStorage()), mSlotCount(slotCount(slots)), mRange(1), mWait(kMinWait) {
+}
+
+/**
+ * Removes the top element from this stack. Throws Underflow if this stack
+ * is empty.
+ */
+template <typename T>
+void EliminationStack<T>::pop() {
+    uint32_t index = popNode();
+    if (index == 0)
+        throw typename StackBase<T>::Underflow();
+    mStack.node(index).mItem = T(); // Release whatever the element holds
+    mStack.pushChain(mStack.mFree, index, index);
+}
+
+/**
+ * Removes the top element and returns it, moved out rather than copied.
+ * Throws Underflow if this stack is empty.
+ *
+ * @return
+ */
+template <typename T>
+T EliminationStack<T>::popValue() {
+    uint32_t index = popNode();
+    if (index == 0)
+        throw typename StackBase<T>::Underflow();
+    T value(std::move(mStack.node(index).mItem));
+    mStack.pushChain(mStack.mFree, index, index);
+    return value;
+}
+
+/**
+ * Pushes value onto this stack.
+ * This operation provides strong exception safety.
+ *
+ * @param
+ */
+template <typename T>
+void EliminationStack<T>::push(const T& value) {
+    uint32_t index = mStack.acquire(value);
+    mStack.mSize.fetch_add(1, std::memory_order_relaxed);
+    for (;;) {
+        uint64_t old = mStack.mHead.load(std::memory_order_relaxed);
+        if (mStack.casPush(mStack.mHead, index, index, old) || offer(index))
+            return;
+    }
+}
+
+/**
+ * Returns the number of elements in this stack.
+ *
+ * @return
+ */
+template <typename T>
+size_t EliminationStack<T>::size() const {
+    return mStack.size();
+}
+
+/**
+ * Moves the top element into out, removes it and returns true, or returns
+ * false if this stack is empty.
+ *
+ * @param out receives the top element
+ * @return
+ */
+template <typename T>
+bool EliminationStack<T>::tryPop(T& out) {
+    uint32_t index = popNode();
+    if (index == 0)
+        return false;
+    try {
+        out = std::move(mStack.node(index).mItem);
+    } catch (...) {
+        mStack.mSize.fetch_add(1, std::memory_order_relaxed);
+        mStack.pushChain(mStack.mHead, index, index);
+        throw;
+    }
+    mStack.pushChain(mStack.mFree, index, index);
+    return true;
+}
+
+/**
+ * Pushes the count elements of values in order, so that the last one ends
+ * on top. The batch goes to the central stack with a single
+ * compare-and-swap and is never eliminated.
+ * This operation provides strong exception safety.
+ *
+ * @param values elements to push
+ * @param count number of elements to push
+ */
+template <typename T>
+void EliminationStack<T>::pushBulk(const T* values, size_t count) {
+    mStack.pushBulk(values, count);
+}
+
+/**
+ * Returns a reference to the top of this stack. Throws Underflow if this
+ * stack is empty. The reference is only stable while no other thread
+ * pops.
+ *
+ * @return
+ */
+template <typename T>
+const T& EliminationStack<T>::top() const {
+    return mStack.top();
+}
+
+/**
+ * Unlinks the top node, from the central stack or from a pusher met in
+ * the elimination array, and returns its index, or 0 if the stack is
+ * empty.
+ * This operation is a no-throw.
+ *
+ * @return
+ */
+template <typename T>
+uint32_t EliminationStack<T>::popNode() throw () {
+    uint32_t index;
+    for (;;) {
+        uint64_t old = mStack.mHead.load(std::memory_order_acquire);
+        if (mStack.casPop(mStack.mHead, old, index)) {
+            if (index == 0)
+                return 0;
+            break;
+        }
+        if ((index = take()) != 0)
+            break;
+    }
+    mStack.mSize.fetch_sub(1, std::memory_order_relaxed);
+    return index;
+}
+
+/**
+ * Offers node index in a random slot of the elimination array and waits
+ * for a popper to take it. Returns true if one did.
+ * This operation is a no-throw.
+ *
+ * @param index
+ * @return
+ */
+template <typename T>
+bool EliminationStack<T>::offer(uint32_t index) throw () {
+    Slot& slot = randomSlot();
+    uint64_t offered = static_cast<uint64_t>(index) << 1;
+    uint64_t expected = kEmpty;
+    if (!slot.mState.compare_exchange_strong(expected, offered, std::memory_order_release,
+                                             std::memory_order_relaxed)) {
+        adapt(false, true);
+        return false;
+    }
+
+    for (unsigned wait = mWait.load(std::memory_order_relaxed); wait > 0; --wait) {
+        if (slot.mState.load(std::memory_order_acquire) == kTaken) {
+            slot.mState.store(kEmpty, std::memory_order_relaxed);
+            adapt(true, false);
+            return true;
+        }
+    }
+
+    // Withdraw the offer, unless a popper takes it at the last moment
+    expected = offered;
+    bool withdrawn = slot.mState.compare_exchange_strong(expected, kEmpty, std::memory_order_acquire,
+                                                         std::memory_order_acquire);
+    if (!withdrawn)
+        slot.mState.store(kEmpty, std::memory_order_relaxed);
+    adapt(!withdrawn, false);
+    return !withdrawn;
+}
+
+/**
+ * Waits in a random slot of the elimination array for a pusher's offer.
+ * Returns the offered node index, or 0 if none came.
+ * This operation is a no-throw.
+ *
+ * @return
+ */
+template <typename T>
+uint32_t EliminationStack<T>::take() throw () {
+    Slot& slot = randomSlot();
+    for (unsigned wait = mWait.load(std::memory_order_relaxed); wait > 0; --wait) {
+        uint64_t state = slot.mState.load(std::memory_order_relaxed);
+        if (state != kEmpty && state != kTaken &&
+                slot.mState.compare_exchange_strong(state, kTaken, std::memory_order_acquire,
+                                                    std::memory_order_relaxed)) {
+            adapt(true, false);
+            return static_cast<uint32_t>(state >> 1);
+        }
+    }
+    adapt(false, false);
+    return 0;
+}
+
+/**
+ * Returns a slot picked at random among the ones in use.
+ * This operation is a no-throw.
+ *
+ * @return
+ */
+template <typename T>
+typename EliminationStack<T>::Slot& EliminationStack<T>::randomSlot() throw () {
+    // xorshift, seeded differently for every thread
+    static thread_local uint32_t seed =
+            static_cast<uint32_t>(std::hash<std::thread::id>()(std::this_thread::get_id())) | 1;
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    return mSlots[seed % mRange.load(std::memory_order_relaxed)];
+}
+
+/**
+ * Records the outcome of a visit to the elimination array, adapting the
+ * slot range and the waiting time to it.
+ * This operation is a no-throw.
+ *
+ * @param exchanged true if the visit met a partner
+ * @param crowded true if the slot was held by another thread of the same kind
+ */
+template <typename T>
+void EliminationStack<T>::adapt(bool exchanged, bool crowded) throw () {
+    size_t range = mRange.load(std::memory_order_relaxed);
+    unsigned wait = mWait.load(std::memory_order_relaxed);
+    if (exchanged) {
+        if (wait < kMaxWait)
+            mWait.store(wait * 2, std::memory_order_relaxed);
+    } else if (crowded) {
+        if (range < mSlotCount)
+            mRange.store(range + 1, std::memory_order_relaxed);
+    } else {
+        if (wait > kMinWait)
+            mWait.store(wait / 2, std::memory_order_relaxed);
+        if (range > 1)
+            mRange.store(range - 1, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * Returns the number of slots to use when slots were asked for: at least
+ * 1 and at most kMaxSlots, with 0 meaning half the hardware threads.
+ * This operation is a no-throw.
+ *
+ * @param slots
+ * @return
+ */
+template <typename T>
+size_t EliminationStack<T>::slotCount(size_t slots) throw () {
+    if (slots == 0)
+        slots = std::thread::hardware_concurrency() / 2;
+    return std::max<size_t>(1, std::min<size_t>(slots, kMaxSlots));
+}
+
+#endif
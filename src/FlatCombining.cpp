@@ -0,0 +1,282 @@
+#ifndef _FLAT_COMBINING_CPP_
+#define _FLAT_COMBINING_CPP_
+
+#include "../include/FlatCombining.h"
+#include "../include/ArrayStorage.h"
+#include <atomic>
+#include <cstdlib>                  // For size_t
+#include <algorithm>                // For std::min, std::max
+#include <exception>                // For std::exception_ptr
+#include <functional>               // For std::hash
+#include <thread>                   // For std::this_thread
+#include <type_traits>              // For std::true_type, std::false_type
+
+
+/**
+ * Initializes a wrapper around a default constructed adapter with slots
+ * publication slots. If slots is 0, two per hardware thread are used.
+ *
+ * @param slots number of publication slots
+ */
+template <typename Adapter>
+FlatCombining<Adapter>::FlatCombining(size_t slots)
+        : mSlots(slotsFor(slots), ArrayStorage()), mSlotCount(slotsFor(slots)), mLocked(false) {
+}
+
+/**
+ * Adds value to the adapter: pushes it onto a stack or enqueues it at the
+ * end of a queue.
+ * This operation provides strong exception safety.
+ *
+ * @param value value to add
+ */
+template <typename Adapter>
+void FlatCombining<Adapter>::add(const value_type& value) {
+    Slot& slot = claim();
+    slot.mOperation = kAdd;
+    slot.mValue = &value;
+    perform(slot);
+}
+
+/**
+ * Moves the next element out of the adapter, the top of a stack or the
+ * front of a queue, into out and returns true, or returns false if the
+ * adapter is empty.
+ *
+ * @param out receives the element
+ * @return
+ */
+template <typename Adapter>
+bool FlatCombining<Adapter>::tryRemove(value_type& out) {
+    Slot& slot = claim();
+    slot.mOperation = kRemove;
+    slot.mOut = &out;
+    return perform(slot);
+}
+
+/**
+ * Calls function(adapter) as one request, with no other request applied
+ * at the same time. References into the adapter must not escape
+ * function.
+ *
+ * @param function function object taking an Adapter&
+ */
+template <typename Adapter>
+template <typename Function>
+void FlatCombining<Adapter>::apply(Function function) {
+    Slot& slot = claim();
+    slot.mOperation = kApply;
+    slot.mApply = &invoke<Function>;
+    slot.mContext = &function;
+    perform(slot);
+}
+
+/**
+ * Returns the number of elements in the adapter.
+ *
+ * @return
+ */
+template <typename Adapter>
+size_t FlatCombining<Adapter>::size() {
+    size_t size = 0;
+    apply([&size](Adapter& adapter) { size = adapter.size(); });
+    return size;
+}
+
+/**
+ * Returns the number of publication slots.
+ * This operation is a no-throw.
+ *
+ * @return
+ */
+template <typename Adapter>
+size_t FlatCombining<Adapter>::slotCount() const throw () {
+    return mSlotCount;
+}
+
+/**
+ * Claims a free slot for the calling thread, waiting for one if needed.
+ *
+ * @return
+ */
+template <typename Adapter>
+typename FlatCombining<Adapter>::Slot& FlatCombining<Adapter>::claim() {
+    size_t home = homeSlot();
+    for (;;) {
+        for (size_t i = 0; i < mSlotCount; ++i) {
+            Slot& slot = mSlots[(home + i) % mSlotCount];
+            unsigned expected = kFree;
+            if (slot.mState.load(std::memory_order_relaxed) == kFree &&
+                    slot.mState.compare_exchange_strong(expected, kClaimed, std::memory_order_acquire,
+                                                        std::memory_order_relaxed))
+                return slot;
+        }
+        std::this_thread::yield();
+    }
+}
+
+/**
+ * Publishes the request written into slot, waits until it is done,
+ * combining if the lock is free, and releases the slot. Rethrows the
+ * exception the request threw, if any; otherwise returns its result.
+ *
+ * @param slot
+ * @return
+ */
+template <typename Adapter>
+bool FlatCombining<Adapter>::perform(Slot& slot) {
+    slot.mState.store(kPending, std::memory_order_release);
+
+    unsigned spins = 0;
+    while (slot.mState.load(std::memory_order_acquire) != kDone) {
+        if (!mLocked.load(std::memory_order_relaxed) && !mLocked.exchange(true, std::memory_order_acquire)) {
+            combine();
+            mLocked.store(false, std::memory_order_release);
+        } else if (++spins >= kSpinCount) {
+            std::this_thread::yield();
+        }
+    }
+
+    bool result = slot.mResult;
+    std::exception_ptr error = slot.mError;
+    slot.mError = std::exception_ptr();
+    slot.mState.store(kFree, std::memory_order_release);
+    if (error)
+        std::rethrow_exception(error);
+    return result;
+}
+
+/**
+ * Applies every pending request. The combiner lock must be held.
+ */
+template <typename Adapter>
+void FlatCombining<Adapter>::combine() {
+    // Reserve room for all pending additions at once
+    size_t adds = 0;
+    for (size_t i = 0; i < mSlotCount; ++i) {
+        Slot& slot = mSlots[i];
+        if (slot.mState.load(std::memory_order_acquire) == kPending && slot.mOperation == kAdd)
+            ++adds;
+    }
+    if (adds > 1) {
+        try {
+            mAdapter.reserve(mAdapter.size() + adds);
+        } catch (...) {
+            // Only an optimization; the additions report their own failures
+        }
+    }
+
+    for (size_t i = 0; i < mSlotCount; ++i) {
+        Slot& slot = mSlots[i];
+        if (slot.mState.load(std::memory_order_acquire) == kPending) {
+            execute(slot);
+            slot.mState.store(kDone, std::memory_order_release);
+        }
+    }
+}
+
+/**
+ * Applies the request in slot, recording its result or exception.
+ *
+ * @param slot
+ */
+template <typename Adapter>
+void FlatCombining<Adapter>::execute(Slot& slot) {
+    try {
+        switch (slot.mOperation) {
+            case kAdd:
+                doAdd(*slot.mValue, IsStack());
+                break;
+            case kRemove:
+                slot.mResult = doRemove(*slot.mOut, IsStack());
+                break;
+            case kApply:
+                slot.mApply(slot.mContext, mAdapter);
+                break;
+        }
+    } catch (...) {
+        slot.mError = std::current_exception();
+    }
+}
+
+/**
+ * Adds value to a stack.
+ *
+ * @param value
+ */
+template <typename Adapter>
+void FlatCombining<Adapter>::doAdd(const value_type& value, std::true_type) {
+    mAdapter.push(value);
+}
+
+/**
+ * Adds value to a queue.
+ *
+ * @param value
+ */
+template <typename Adapter>
+void FlatCombining<Adapter>::doAdd(const value_type& value, std::false_type) {
+    mAdapter.enqueue(value);
+}
+
+/**
+ * Removes the top of a stack into out.
+ *
+ * @param out
+ * @return
+ */
+template <typename Adapter>
+bool FlatCombining<Adapter>::doRemove(value_type& out, std::true_type) {
+    return mAdapter.tryPop(out);
+}
+
+/**
+ * Removes the front of a queue into out.
+ *
+ * @param out
+ * @return
+ */
+template <typename Adapter>
+bool FlatCombining<Adapter>::doRemove(value_type& out, std::false_type) {
+    return mAdapter.tryDequeue(out);
+}
+
+/**
+ * Calls the function object of type Function at context on adapter.
+ *
+ * @param context
+ * @param adapter
+ */
+template <typename Adapter>
+template <typename Function>
+void FlatCombining<Adapter>::invoke(void* context, Adapter& adapter) {
+    (*static_cast<Function*>(context))(adapter);
+}
+
+/**
+ * Returns the number of slots to use when slots were asked for.
+ * This operation is a no-throw.
+ *
+ * @param slots
+ * @return
+ */
+template <typename Adapter>
+size_t FlatCombining<Adapter>::slotsFor(size_t slots) throw () {
+    if (slots == 0)
+        slots = 2 * std::thread::hardware_concurrency();
+    return std::max<size_t>(1, std::min<size_t>(slots, kMaxSlots));
+}
+
+/**
+ * Returns the slot the calling thread starts looking from.
+ * This operation is a no-throw.
+ *
+ * @return
+ */
+template <typename Adapter>
+size_t FlatCombining<Adapter>::homeSlot() const throw () {
+    static thread_local size_t hash = std::hash<std::thread::id>()(std::this_thread::get_id());
+    return hash % mSlotCount;
+}
+
+#endif
@@ -3,10 +3,13 @@
 
 #include "../include/LinkedList.h"
 #include "../include/LinkedListIterators.h"
+#include "../include/ListSerialization.h"
+#include "../include/LinkedListSubList.h"
 #include <cstdlib>          // For size_t
-#include <stdexcept>        // For out_of_range
+#include <stdexcept>        // For out_of_range, runtime_error
 #include <sstream>          // For ostringstream
 #include <algorithm>
+#include <type_traits>      // For is_trivially_copyable
 
 
 /**
@@ -114,6 +117,35 @@ void LinkedList<T>::add(size_t index, const_reference value) {
     }
 }
 
+/**
+ * Adds the elements of the range [first, last) to the end of this
+ * LinkedList. The nodes are built on the side and spliced in at once.
+ * This operation provides strong exception safety.
+ *
+ * @param first iterator to the first element to append
+ * @param last iterator one past the last element to append
+ */
+template <typename T>
+template <typename InputIterator>
+void LinkedList<T>::addAll(InputIterator first, InputIterator last) {
+    LinkedList<T> temp;
+    for (; first != last; ++first)
+        temp.add(*first);
+    if (temp.isEmpty())
+        return;
+
+    LinkedListNode<T>* curLast = mTail->mPrev;
+    LinkedListNode<T>* tempFirst = temp.mTail->mNext;
+    LinkedListNode<T>* tempLast = temp.mTail->mPrev;
+
+    LinkedListNode<T>::link(curLast, tempFirst);
+    LinkedListNode<T>::link(tempLast, mTail.get());
+    LinkedListNode<T>::link(temp.mTail.get(), temp.mTail.get());
+
+    mSize += temp.mSize;
+    temp.mSize = 0;
+}
+
 /**
  * Empties this LinkedList returning it to the same state as the default
  * constructor.
@@ -160,6 +192,62 @@ typename LinkedList<T>::reference LinkedList<T>::get(size_t index) throw (std::o
     return *iter;
 }
 
+/**
+ * Returns a constant reference to the first element in constant time. If
+ * this LinkedList is empty, an std::out_of_range exception is thrown with 0
+ * as its message.
+ * This operation provides strong exception safety.
+ *
+ * @return constant reference to the first element.
+ */
+template <typename T>
+typename LinkedList<T>::const_reference LinkedList<T>::front() const throw (std::out_of_range) {
+    rangeCheck(0);
+    return mTail->mNext->mItem;
+}
+
+/**
+ * Returns a reference to the first element in constant time. If this
+ * LinkedList is empty, an std::out_of_range exception is thrown with 0 as
+ * its message.
+ * This operation provides strong exception safety.
+ *
+ * @return reference to the first element.
+ */
+template <typename T>
+typename LinkedList<T>::reference LinkedList<T>::front() throw (std::out_of_range) {
+    rangeCheck(0);
+    return mTail->mNext->mItem;
+}
+
+/**
+ * Returns a constant reference to the last element in constant time. If
+ * this LinkedList is empty, an std::out_of_range exception is thrown with 0
+ * as its message.
+ * This operation provides strong exception safety.
+ *
+ * @return constant reference to the last element.
+ */
+template <typename T>
+typename LinkedList<T>::const_reference LinkedList<T>::back() const throw (std::out_of_range) {
+    rangeCheck(0);
+    return mTail->mPrev->mItem;
+}
+
+/**
+ * Returns a reference to the last element in constant time. If this
+ * LinkedList is empty, an std::out_of_range exception is thrown with 0 as
+ * its message.
+ * This operation provides strong exception safety.
+ *
+ * @return reference to the last element.
+ */
+template <typename T>
+typename LinkedList<T>::reference LinkedList<T>::back() throw (std::out_of_range) {
+    rangeCheck(0);
+    return mTail->mPrev->mItem;
+}
+
 /**
  * Returns true if this LinkedList is equal to rhs and false otherwise
  * This operation provides strong exception safety.
@@ -256,6 +344,30 @@ void LinkedList<T>::remove(size_t index) throw (std::out_of_range) {
     removeNode(iter);
 }
 
+/**
+ * Removes the first element in constant time. If this LinkedList is empty,
+ * an std::out_of_range exception is thrown with 0 as its message.
+ * This operation is no-throw under the assumption that the parametrizing
+ * type's destructor is no-throw.
+ */
+template <typename T>
+void LinkedList<T>::removeFirst() throw (std::out_of_range) {
+    rangeCheck(0);
+    removeNode(begin());
+}
+
+/**
+ * Removes the last element in constant time. If this LinkedList is empty,
+ * an std::out_of_range exception is thrown with 0 as its message.
+ * This operation is no-throw under the assumption that the parametrizing
+ * type's destructor is no-throw.
+ */
+template <typename T>
+void LinkedList<T>::removeLast() throw (std::out_of_range) {
+    rangeCheck(0);
+    removeNode(iterator(mTail->mPrev));
+}
+
 /**
  * Sets the element at the specified index to the provided value. If index
  * is out of bounds, an std::out_of_range exception is thrown with the index
@@ -288,6 +400,107 @@ size_t LinkedList<T>::size() const throw () {
     return mSize;
 }
 
+/**
+ * Returns a view of the elements of this LinkedList in the range
+ * [from, to). Creating the view takes time proportional to to, after
+ * which it shares the nodes of this LinkedList. If to is past the end or
+ * from is past to, an std::out_of_range exception is thrown with the
+ * offending index as its message.
+ * This operation provides strong exception safety.
+ *
+ * @param from index of the first element of the view
+ * @param to index one past the last element of the view
+ * @return
+ */
+template <typename T>
+LinkedListSubList<T> LinkedList<T>::subList(size_t from, size_t to) throw (std::out_of_range) {
+    sliceCheck(from, to);
+    LinkedListNode<T>* first = mTail->mNext;
+    for (size_t i = 0; i < from; ++i)
+        first = first->mNext;
+    LinkedListNode<T>* last = first;
+    for (size_t i = from; i < to; ++i)
+        last = last->mNext;
+    return LinkedListSubList<T>(first, last, to - from);
+}
+
+/**
+ * Returns a constant view of the elements of this LinkedList in the range
+ * [from, to). If to is past the end or from is past to, an
+ * std::out_of_range exception is thrown with the offending index as its
+ * message.
+ * This operation provides strong exception safety.
+ *
+ * @param from index of the first element of the view
+ * @param to index one past the last element of the view
+ * @return
+ */
+template <typename T>
+LinkedListSubList<const T> LinkedList<T>::subList(size_t from, size_t to) const throw (std::out_of_range) {
+    sliceCheck(from, to);
+    LinkedListNode<T>* first = mTail->mNext;
+    for (size_t i = 0; i < from; ++i)
+        first = first->mNext;
+    LinkedListNode<T>* last = first;
+    for (size_t i = from; i < to; ++i)
+        last = last->mNext;
+    return LinkedListSubList<const T>(first, last, to - from);
+}
+
+/**
+ * Writes this LinkedList to the file descriptor fd in the versioned binary
+ * format described by ListFileHeader. The elements are streamed one by one
+ * through their Serializer. Throws std::system_error if writing fails.
+ *
+ * @param fd file descriptor to write to
+ */
+template <typename T>
+void LinkedList<T>::writeTo(int fd) const {
+    ListWriter out(fd);
+    serialize(out);
+}
+
+/**
+ * Writes this LinkedList to os in the versioned binary format described by
+ * ListFileHeader. Throws std::ios_base::failure if writing fails.
+ *
+ * @param os stream to write to
+ */
+template <typename T>
+void LinkedList<T>::writeTo(std::ostream& os) const {
+    ListWriter out(os);
+    serialize(out);
+}
+
+/**
+ * Replaces the contents of this LinkedList with a list read from the file
+ * descriptor fd, as written by writeTo. Throws std::runtime_error if the
+ * data is truncated or was written for another element type.
+ * This operation provides strong exception safety.
+ *
+ * @param fd file descriptor to read from
+ */
+template <typename T>
+void LinkedList<T>::readFrom(int fd) {
+    ListReader in(fd);
+    deserialize(in);
+    in.finish();
+}
+
+/**
+ * Replaces the contents of this LinkedList with a list read from is, as
+ * written by writeTo. Throws std::runtime_error if the data is truncated
+ * or was written for another element type.
+ * This operation provides strong exception safety.
+ *
+ * @param is stream to read from
+ */
+template <typename T>
+void LinkedList<T>::readFrom(std::istream& is) {
+    ListReader in(is);
+    deserialize(in);
+}
+
 /**
  * Given an index, this method throws an std::out_of_range with the index as
  * its message if index is out of bounds or is a no-op otherwise.
@@ -317,6 +530,63 @@ void LinkedList<T>::removeNode(iterator iter) throw () {
     --mSize;
 }
 
+/**
+ * Throws an std::out_of_range with the offending index as its message if
+ * [from, to) is not a range of this LinkedList.
+ * This operation provides strong exception safety.
+ *
+ * @param from
+ * @param to
+ */
+template <typename T>
+void LinkedList<T>::sliceCheck(size_t from, size_t to) const throw (std::out_of_range) {
+    if (to > mSize || from > to) {
+        std::ostringstream os;
+        os << (to > mSize ? to : from);
+        throw std::out_of_range(os.str());
+    }
+}
+
+/**
+ * Writes the header and elements to out.
+ *
+ * @param out
+ */
+template <typename T>
+void LinkedList<T>::serialize(ListWriter& out) const {
+    bool raw = std::is_trivially_copyable<T>::value;
+    ListFileHeader header;
+    header.init(sizeof(T), mSize, mSize, raw ? ListFileHeader::RAW : ListFileHeader::STREAM);
+    out.write(&header, sizeof(header));
+
+    for (const_iterator iter = begin(); iter != end(); ++iter)
+        Serializer<T>::write(out, *iter);
+    out.flush();
+}
+
+/**
+ * Replaces the contents with the header and elements read from in.
+ * This operation provides strong exception safety.
+ *
+ * @param in
+ */
+template <typename T>
+void LinkedList<T>::deserialize(ListReader& in) {
+    bool raw = std::is_trivially_copyable<T>::value;
+    ListFileHeader header;
+    in.read(&header, sizeof(header));
+    if (!header.valid(sizeof(T), raw ? ListFileHeader::RAW : ListFileHeader::STREAM))
+        throw std::runtime_error("incompatible list data");
+
+    LinkedList<T> temp;
+    value_type value = value_type();
+    for (size_t i = 0; i < header.mSize; ++i) {
+        Serializer<T>::read(in, value);
+        temp.add(value);
+    }
+    swap(temp);
+}
+
 /**
  * Swaps the contents of this LinkedList with that of other in constant time.
  * This operation is a no-throw.
@@ -0,0 +1,252 @@
+#ifndef _LINKED_LIST_SUB_LIST_CPP_
+#define _LINKED_LIST_SUB_LIST_CPP_
+
+#include "../include/LinkedListSubList.h"
+#include "../include/LinkedListIterators.h"
+#include <cstdlib>          // For size_t
+#include <stdexcept>        // For out_of_range
+#include <sstream>          // For ostringstream
+#include <algorithm>
+#include <type_traits>      // For std::enable_if, std::is_const
+
+
+/**
+ * A private constructor used by LinkedList::subList and nested views.
+ *
+ * @param first first node of the view
+ * @param end node one past the last node of the view
+ * @param size number of nodes in the view
+ */
+template <typename T>
+LinkedListSubList<T>::LinkedListSubList(Node* first, Node* end, size_t size) throw ()
+        : mFirst(first), mEnd(end), mSize(size) {
+}
+
+/**
+ * Returns a constant reference to the element stored at the provided index.
+ * If index is out of bounds, an std::out_of_range exception is thrown with
+ * the index as its message. Time proportional to index is needed.
+ * This operation provides strong exception safety.
+ *
+ * @param index index of the element to return
+ * @return constant reference to the element at the index.
+ */
+template <typename T>
+typename LinkedListSubList<T>::const_reference LinkedListSubList<T>::get(size_t index) const throw (std::out_of_range) {
+    rangeCheck(index);
+    return nodeAt(index)->mItem;
+}
+
+/**
+ * Returns a reference to the element stored at the provided index.
+ * If index is out of bounds, an std::out_of_range exception is thrown with
+ * the index as its message. Time proportional to index is needed.
+ * This operation provides strong exception safety.
+ *
+ * @param index index of the element to return
+ * @return reference to the element at the index.
+ */
+template <typename T>
+typename LinkedListSubList<T>::reference LinkedListSubList<T>::get(size_t index) throw (std::out_of_range) {
+    rangeCheck(index);
+    return nodeAt(index)->mItem;
+}
+
+/**
+ * Returns true if this LinkedListSubList is logically equal to rhs.
+ *
+ * @param rhs
+ * @return
+ */
+template <typename T>
+bool LinkedListSubList<T>::operator==(const LinkedListSubList<T>& rhs) const {
+    return mSize == rhs.mSize && std::equal(begin(), end(), rhs.begin());
+}
+
+/**
+ * Returns false if this LinkedListSubList is logically equal to rhs.
+ *
+ * @param rhs
+ * @return
+ */
+template <typename T>
+bool LinkedListSubList<T>::operator!=(const LinkedListSubList<T>& rhs) const {
+    return !(*this == rhs);
+}
+
+/**
+ * Returns a constant iterator to the first element.
+ * This operation is a no-throw.
+ *
+ * @return
+ */
+template <typename T>
+typename LinkedListSubList<T>::const_iterator LinkedListSubList<T>::begin() const throw () {
+    return const_iterator(mFirst);
+}
+
+/**
+ * Returns an iterator to the first element.
+ * This operation is a no-throw.
+ *
+ * @return
+ */
+template <typename T>
+typename LinkedListSubList<T>::iterator LinkedListSubList<T>::begin() throw () {
+    return iterator(mFirst);
+}
+
+/**
+ * Returns a constant iterator one past the last element.
+ * This operation is a no-throw.
+ *
+ * @return
+ */
+template <typename T>
+typename LinkedListSubList<T>::const_iterator LinkedListSubList<T>::end() const throw () {
+    return const_iterator(mEnd);
+}
+
+/**
+ * Returns an iterator one past the last element.
+ * This operation is a no-throw.
+ *
+ * @return
+ */
+template <typename T>
+typename LinkedListSubList<T>::iterator LinkedListSubList<T>::end() throw () {
+    return iterator(mEnd);
+}
+
+/**
+ * Returns true if this LinkedListSubList is empty and false otherwise.
+ * This operation is a no-throw.
+ *
+ * @return
+ */
+template <typename T>
+bool LinkedListSubList<T>::isEmpty() const throw () {
+    return mSize == 0;
+}
+
+/**
+ * Sets the element at the specified index to the provided value. If index
+ * is out of bounds, an std::out_of_range exception is thrown with the index
+ * as its message. Time proportional to index is needed. Views of a
+ * constant LinkedList do not have this method.
+ * This operation provides no exception safety.
+ *
+ * @param index index of the object to set
+ * @param value the new value
+ */
+template <typename T>
+template <typename U>
+typename std::enable_if<!std::is_const<U>::value>::type LinkedListSubList<T>::set(size_t index, const_reference value) {
+    rangeCheck(index);
+    // Assigning through reference keeps set<int>() on a const view from compiling
+    reference item = nodeAt(index)->mItem;
+    item = value;
+}
+
+/**
+ * Return the size of this LinkedListSubList.
+ * This operation is a no-throw.
+ *
+ * @return
+ */
+template <typename T>
+size_t LinkedListSubList<T>::size() const throw () {
+    return mSize;
+}
+
+/**
+ * Returns a view of the elements of this LinkedListSubList in the range
+ * [from, to). Creating the view takes time proportional to to. If to is
+ * past the end or from is past to, an std::out_of_range exception is
+ * thrown with the offending index as its message.
+ * This operation provides strong exception safety.
+ *
+ * @param from index of the first element of the view
+ * @param to index one past the last element of the view
+ * @return
+ */
+template <typename T>
+LinkedListSubList<T> LinkedListSubList<T>::subList(size_t from, size_t to) throw (std::out_of_range) {
+    sliceCheck(from, to);
+    Node* first = nodeAt(from);
+    Node* last = first;
+    for (size_t i = from; i < to; ++i)
+        last = last->mNext;
+    return LinkedListSubList<T>(first, last, to - from);
+}
+
+/**
+ * Returns a constant view of the elements of this LinkedListSubList in
+ * the range [from, to). If to is past the end or from is past to, an
+ * std::out_of_range exception is thrown with the offending index as its
+ * message.
+ * This operation provides strong exception safety.
+ *
+ * @param from index of the first element of the view
+ * @param to index one past the last element of the view
+ * @return
+ */
+template <typename T>
+LinkedListSubList<const T> LinkedListSubList<T>::subList(size_t from, size_t to) const throw (std::out_of_range) {
+    sliceCheck(from, to);
+    Node* first = nodeAt(from);
+    Node* last = first;
+    for (size_t i = from; i < to; ++i)
+        last = last->mNext;
+    return LinkedListSubList<const T>(first, last, to - from);
+}
+
+/**
+ * Returns the node index positions after the first one of this view.
+ * This operation is a no-throw.
+ *
+ * @param index
+ * @return
+ */
+template <typename T>
+typename LinkedListSubList<T>::Node* LinkedListSubList<T>::nodeAt(size_t index) const throw () {
+    Node* node = mFirst;
+    for (; index > 0; --index)
+        node = node->mNext;
+    return node;
+}
+
+/**
+ * Given an index, this method throws an std::out_of_range with the index as
+ * its message if index is out of bounds or is a no-op otherwise.
+ * This operation provides strong exception safety.
+ *
+ * @param index index to check
+ */
+template <typename T>
+void LinkedListSubList<T>::rangeCheck(size_t index) const throw (std::out_of_range) {
+    if (index >= mSize) {
+        std::ostringstream os;
+        os << index;
+        throw std::out_of_range(os.str());
+    }
+}
+
+/**
+ * Throws an std::out_of_range with the offending index as its message if
+ * [from, to) is not a range of this LinkedListSubList.
+ * This operation provides strong exception safety.
+ *
+ * @param from
+ * @param to
+ */
+template <typename T>
+void LinkedListSubList<T>::sliceCheck(size_t from, size_t to) const throw (std::out_of_range) {
+    if (to > mSize || from > to) {
+        std::ostringstream os;
+        os << (to > mSize ? to : from);
+        throw std::out_of_range(os.str());
+    }
+}
+
+#endif
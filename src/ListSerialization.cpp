@@ -0,0 +1,278 @@
+#ifndef _LIST_SERIALIZATION_CPP_
+#define _LIST_SERIALIZATION_CPP_
+
+#include "../include/ListSerialization.h"
+#include <algorithm>                // For std::min
+#include <cerrno>                   // For errno, EINTR
+#include <cstring>                  // For memcpy, memcmp
+#include <ios>                      // For std::ios_base::failure
+#include <istream>
+#include <limits>                   // For std::numeric_limits
+#include <ostream>
+#include <stdexcept>                // For std::runtime_error
+#include <system_error>             // For std::system_error
+#include <type_traits>              // For std::is_trivially_copyable
+#include <unistd.h>                 // For read, write, lseek
+
+static_assert(sizeof(ListFileHeader) == 64, "ListFileHeader must stay 64 bytes");
+
+static const char kListFileMagic[8] = { 'L', 'I', 'S', 'T', 'F', 'I', 'L', 'E' };
+
+
+/**
+ * Fills in the header for size elements of elementSize bytes each, with
+ * room for capacity elements after it.
+ * This operation is a no-throw.
+ *
+ * @param elementSize
+ * @param size
+ * @param capacity
+ * @param encoding
+ */
+inline void ListFileHeader::init(size_t elementSize, size_t size, size_t capacity, Encoding encoding) throw () {
+    std::memset(this, 0, sizeof(*this));
+    std::memcpy(mMagic, kListFileMagic, sizeof(mMagic));
+    mVersion = kVersion;
+    mElementSize = elementSize;
+    mSize = size;
+    mCapacity = capacity;
+    mEncoding = encoding;
+}
+
+/**
+ * Returns true if this header was written by a compatible version for
+ * elements of elementSize bytes with the provided encoding, and its
+ * capacity in bytes fits in a size_t.
+ * This operation is a no-throw.
+ *
+ * @param elementSize
+ * @param encoding
+ * @return
+ */
+inline bool ListFileHeader::valid(size_t elementSize, Encoding encoding) const throw () {
+    return std::memcmp(mMagic, kListFileMagic, sizeof(mMagic)) == 0
+        && mVersion == kVersion
+        && mElementSize == elementSize
+        && mEncoding == static_cast<uint32_t>(encoding)
+        && mSize <= mCapacity
+        && mCapacity <= std::numeric_limits<size_t>::max() / elementSize;
+}
+
+
+/**
+ * Initializes a writer appending to the file descriptor fd.
+ *
+ * @param fd
+ */
+inline ListWriter::ListWriter(int fd) : mFd(fd), mStream(0), mUsed(0) {
+}
+
+/**
+ * Initializes a writer appending to the stream os.
+ *
+ * @param os
+ */
+inline ListWriter::ListWriter(std::ostream& os) : mFd(-1), mStream(&os), mUsed(0) {
+}
+
+/**
+ * Writes count bytes. Large blocks bypass the buffer.
+ *
+ * @param bytes
+ * @param count
+ */
+inline void ListWriter::write(const void* bytes, size_t count) {
+    if (count == 0)
+        return;
+
+    const char* data = static_cast<const char*>(bytes);
+    if (mUsed + count <= kBufferSize) {
+        std::memcpy(mBuffer + mUsed, data, count);
+        mUsed += count;
+        return;
+    }
+
+    flush();
+    if (count < kBufferSize) {
+        std::memcpy(mBuffer, data, count);
+        mUsed = count;
+    } else {
+        writeOut(data, count);
+    }
+}
+
+/**
+ * Writes out everything buffered so far.
+ */
+inline void ListWriter::flush() {
+    size_t used = mUsed;
+    mUsed = 0;
+    writeOut(mBuffer, used);
+    if (mStream)
+        mStream->flush();
+}
+
+/**
+ * Writes count bytes straight to the destination.
+ *
+ * @param bytes
+ * @param count
+ */
+inline void ListWriter::writeOut(const char* bytes, size_t count) {
+    if (mStream) {
+        if (!mStream->write(bytes, count))
+            throw std::ios_base::failure("list write failed");
+        return;
+    }
+
+    while (count > 0) {
+        ssize_t written = ::write(mFd, bytes, count);
+        if (written < 0) {
+            if (errno == EINTR)
+                continue;
+            throw std::system_error(errno, std::generic_category(), "write");
+        }
+        bytes += written;
+        count -= written;
+    }
+}
+
+
+/**
+ * Initializes a reader consuming the file descriptor fd.
+ *
+ * @param fd
+ */
+inline ListReader::ListReader(int fd) : mFd(fd), mStream(0), mStart(0), mEnd(0) {
+}
+
+/**
+ * Initializes a reader consuming the stream is.
+ *
+ * @param is
+ */
+inline ListReader::ListReader(std::istream& is) : mFd(-1), mStream(&is), mStart(0), mEnd(0) {
+}
+
+/**
+ * Reads exactly count bytes into bytes. Large blocks bypass the buffer.
+ *
+ * @param bytes
+ * @param count
+ */
+inline void ListReader::read(void* bytes, size_t count) {
+    char* data = static_cast<char*>(bytes);
+    while (count > 0) {
+        if (mStart == mEnd) {
+            if (count >= kBufferSize || mStream) {
+                // Streams buffer on their own
+                size_t got = readIn(data, count);
+                if (got == 0)
+                    throw std::runtime_error("truncated list data");
+                data += got;
+                count -= got;
+                continue;
+            }
+
+            mStart = 0;
+            mEnd = readIn(mBuffer, kBufferSize);
+            if (mEnd == 0)
+                throw std::runtime_error("truncated list data");
+        }
+
+        size_t chunk = std::min(count, mEnd - mStart);
+        std::memcpy(data, mBuffer + mStart, chunk);
+        mStart += chunk;
+        data += chunk;
+        count -= chunk;
+    }
+}
+
+/**
+ * Returns the unconsumed read ahead to the file descriptor.
+ * This operation is a no-throw.
+ */
+inline void ListReader::finish() throw () {
+    if (mStart != mEnd)
+        lseek(mFd, -static_cast<off_t>(mEnd - mStart), SEEK_CUR);
+    mStart = mEnd = 0;
+}
+
+/**
+ * Reads up to count bytes straight from the source, returning how many
+ * were read. Zero means the end of the data.
+ *
+ * @param bytes
+ * @param count
+ * @return
+ */
+inline size_t ListReader::readIn(char* bytes, size_t count) {
+    if (mStream) {
+        mStream->read(bytes, count);
+        if (mStream->bad())
+            throw std::ios_base::failure("list read failed");
+        return mStream->gcount();
+    }
+
+    for (;;) {
+        ssize_t got = ::read(mFd, bytes, count);
+        if (got >= 0)
+            return got;
+        if (errno != EINTR)
+            throw std::system_error(errno, std::generic_category(), "read");
+    }
+}
+
+
+/**
+ * Writes value to out.
+ *
+ * @param out
+ * @param value
+ */
+template <typename T>
+void Serializer<T>::write(ListWriter& out, const T& value) {
+    static_assert(std::is_trivially_copyable<T>::value, "Specialize Serializer for types that are not trivially copyable");
+    out.write(&value, sizeof(T));
+}
+
+/**
+ * Reads value back from in.
+ *
+ * @param in
+ * @param value
+ */
+template <typename T>
+void Serializer<T>::read(ListReader& in, T& value) {
+    static_assert(std::is_trivially_copyable<T>::value, "Specialize Serializer for types that are not trivially copyable");
+    in.read(&value, sizeof(T));
+}
+
+/**
+ * Writes value to out.
+ *
+ * @param out
+ * @param value
+ */
+inline void Serializer<std::string>::write(ListWriter& out, const std::string& value) {
+    uint64_t length = value.size();
+    out.write(&length, sizeof(length));
+    out.write(value.data(), value.size());
+}
+
+/**
+ * Reads value back from in.
+ *
+ * @param in
+ * @param value
+ */
+inline void Serializer<std::string>::read(ListReader& in, std::string& value) {
+    uint64_t length;
+    in.read(&length, sizeof(length));
+    std::string temp(length, '\0');
+    if (length > 0)
+        in.read(&temp[0], length);
+    value.swap(temp);
+}
+
+#endif
@@ -0,0 +1,426 @@
+#ifndef _MAPPED_ARRAY_LIST_CPP_
+#define _MAPPED_ARRAY_LIST_CPP_
+
+#include "../include/MappedArrayList.h"
+#include "../include/ArrayListIterators.h"
+#include <cerrno>                   // For errno
+#include <cstdlib>                  // For size_t
+#include <cstring>                  // For memmove
+#include <stdexcept>                // For std::out_of_range, std::runtime_error
+#include <sstream>                  // For std::ostringstream
+#include <system_error>             // For std::system_error
+#include <type_traits>              // For std::is_trivially_copyable
+#include <algorithm>
+#include <fcntl.h>                  // For open
+#include <sys/mman.h>               // For mmap, mremap, msync, munmap
+#include <sys/stat.h>               // For fstat
+#include <unistd.h>                 // For ftruncate, close
+
+
+/**
+ * Opens the list stored in the file at path, creating an empty one if the
+ * file does not exist or is empty. Throws std::system_error if the file
+ * cannot be opened or mapped and std::runtime_error if it does not hold a
+ * list of this element type.
+ *
+ * @param path the file backing this MappedArrayList
+ */
+template <typename T>
+MappedArrayList<T>::MappedArrayList(const std::string& path) : mFd(-1), mLength(0), mHeader(0) {
+    static_assert(std::is_trivially_copyable<T>::value, "MappedArrayList requires a trivially copyable type");
+
+    mFd = open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (mFd < 0)
+        throwSystemError("open");
+
+    try {
+        struct stat info;
+        if (fstat(mFd, &info) != 0)
+            throwSystemError("fstat");
+
+        bool created = info.st_size == 0;
+        if (created) {
+            mLength = bytesFor(0);
+            if (ftruncate(mFd, mLength) != 0)
+                throwSystemError("ftruncate");
+        } else if (static_cast<size_t>(info.st_size) < sizeof(Header)) {
+            throw std::runtime_error(path + ": not a MappedArrayList file");
+        } else {
+            mLength = info.st_size;
+        }
+
+        void* ptr = mmap(0, mLength, PROT_READ | PROT_WRITE, MAP_SHARED, mFd, 0);
+        if (ptr == MAP_FAILED)
+            throwSystemError("mmap");
+        mHeader = static_cast<Header*>(ptr);
+
+        if (created) {
+            mHeader->init(sizeof(T), 0, 0, Header::RAW);
+        } else if (!mHeader->valid(sizeof(T), Header::RAW) || bytesFor(mHeader->mCapacity) > mLength) {
+            throw std::runtime_error(path + ": incompatible MappedArrayList file");
+        }
+    } catch (...) {
+        if (mHeader)
+            munmap(mHeader, mLength);
+        close(mFd);
+        throw;
+    }
+}
+
+/**
+ * Unmaps and closes the file. Pending modifications are written back by
+ * the kernel eventually; call sync() beforehand to wait for them.
+ * This operation is a no-throw.
+ */
+template <typename T>
+MappedArrayList<T>::~MappedArrayList() throw () {
+    munmap(mHeader, mLength);
+    close(mFd);
+}
+
+/**
+ * Adds value to the end of this MappedArrayList. If we have excess
+ * capacity, the insertion is performed in constant time. Otherwise the
+ * file is enlarged to twice the size first.
+ * This operation provides strong exception safety.
+ *
+ * @param value value to append to this MappedArrayList
+ */
+template <typename T>
+void MappedArrayList<T>::add(const_reference value) {
+    size_t count = mHeader->mSize;
+    if (count >= mHeader->mCapacity) {
+        // value may live in the mapping that is about to move
+        value_type copy = value;
+        grow(2 * count + 2);
+        data()[count] = copy;
+    } else {
+        data()[count] = value;
+    }
+    mHeader->mSize = count + 1;
+}
+
+/**
+ * Inserts value at the specified index. All elements at or to the right of
+ * index are shifted down by one spot. If this MappedArrayList needs to be
+ * enlarged, default values are used to fill the gaps.
+ * This operation provides strong exception safety.
+ *
+ * @param index index at which to insert value
+ * @param value the element to insert
+ */
+template <typename T>
+void MappedArrayList<T>::add(size_t index, const_reference value) {
+    size_t count = mHeader->mSize;
+    size_t newSize = std::max(index, count) + 1;
+    value_type copy = value;
+    if (newSize > mHeader->mCapacity)
+        grow(2 * newSize);
+
+    T* array = data();
+    if (index < count)
+        std::memmove(array + index + 1, array + index, (count - index) * sizeof(T));
+    else
+        std::fill(array + count, array + index, value_type());
+
+    array[index] = copy;
+    mHeader->mSize = newSize;
+}
+
+/**
+ * Empties this MappedArrayList. The file keeps its capacity.
+ * This operation is a no-throw.
+ */
+template <typename T>
+void MappedArrayList<T>::clear() throw () {
+    mHeader->mSize = 0;
+}
+
+/**
+ * Returns a constant reference to the element stored at the provided index.
+ * If index is out of bounds, an std::out_of_range exception is thrown with
+ * the index as its message.
+ * This operation provides strong exception safety.
+ *
+ * @param index index of the element to return
+ * @return constant reference to the element at the index.
+ */
+template <typename T>
+typename MappedArrayList<T>::const_reference MappedArrayList<T>::get(size_t index) const throw (std::out_of_range) {
+    rangeCheck(index);
+    return data()[index];
+}
+
+/**
+ * Returns a reference to the element stored at the provided index.
+ * If index is out of bounds, an std::out_of_range exception is thrown with
+ * the index as its message.
+ * This operation provides strong exception safety.
+ *
+ * @param index index of the element to return
+ * @return reference to the element at the index.
+ */
+template <typename T>
+typename MappedArrayList<T>::reference MappedArrayList<T>::get(size_t index) throw (std::out_of_range) {
+    rangeCheck(index);
+    return data()[index];
+}
+
+/**
+ * Returns a constant reference to the element stored at the provided index.
+ * No bounds checking is performed.
+ * This operation is a no-throw.
+ *
+ * @param index index of the element to return
+ * @return constant reference to the element at the index.
+ */
+template <typename T>
+typename MappedArrayList<T>::const_reference MappedArrayList<T>::operator[](size_t index) const throw () {
+    return data()[index];
+}
+
+/**
+ * Returns a reference to the element stored at the provided index.
+ * No bounds checking is performed.
+ * This operation is a no-throw.
+ *
+ * @param index index of the element to return
+ * @return reference to the element at the index.
+ */
+template <typename T>
+typename MappedArrayList<T>::reference MappedArrayList<T>::operator[](size_t index) throw () {
+    return data()[index];
+}
+
+/**
+ * Returns true if this MappedArrayList is logically equal to rhs.
+ *
+ * @param rhs
+ * @return
+ */
+template <typename T>
+bool MappedArrayList<T>::operator==(const MappedArrayList<T>& rhs) const {
+    return size() == rhs.size() && std::equal(begin(), end(), rhs.begin());
+}
+
+/**
+ * Returns false if this MappedArrayList is logically equal to rhs.
+ *
+ * @param rhs
+ * @return
+ */
+template <typename T>
+bool MappedArrayList<T>::operator!=(const MappedArrayList<T>& rhs) const {
+    return !(*this == rhs);
+}
+
+/**
+ * Returns a constant iterator to the first element.
+ * This operation is a no-throw.
+ *
+ * @return
+ */
+template <typename T>
+typename MappedArrayList<T>::const_iterator MappedArrayList<T>::begin() const throw () {
+    return const_iterator(data());
+}
+
+/**
+ * Returns an iterator to the first element.
+ * This operation is a no-throw.
+ *
+ * @return
+ */
+template <typename T>
+typename MappedArrayList<T>::iterator MappedArrayList<T>::begin() throw () {
+    return iterator(data());
+}
+
+/**
+ * Returns a constant iterator one past the last element.
+ * This operation is a no-throw.
+ *
+ * @return
+ */
+template <typename T>
+typename MappedArrayList<T>::const_iterator MappedArrayList<T>::end() const throw () {
+    return const_iterator(data() + mHeader->mSize);
+}
+
+/**
+ * Returns an iterator one past the last element.
+ * This operation is a no-throw.
+ *
+ * @return
+ */
+template <typename T>
+typename MappedArrayList<T>::iterator MappedArrayList<T>::end() throw () {
+    return iterator(data() + mHeader->mSize);
+}
+
+/**
+ * Returns true if this MappedArrayList is empty and false otherwise.
+ * This operation is a no-throw.
+ *
+ * @return
+ */
+template <typename T>
+bool MappedArrayList<T>::isEmpty() const throw () {
+    return mHeader->mSize == 0;
+}
+
+/**
+ * Removes and returns the element at the specified index. If index is out
+ * of bounds, an std::out_of_range exception is thrown with index as its
+ * message. The elements to the right of index are shifted in place.
+ * This operation provides strong exception safety.
+ *
+ * @param index index of the object to remove.
+ * @return copy of the just removed object.
+ */
+template <typename T>
+typename MappedArrayList<T>::value_type MappedArrayList<T>::remove(size_t index) {
+    rangeCheck(index);
+
+    T* array = data();
+    value_type result = array[index];
+    size_t count = mHeader->mSize;
+    std::memmove(array + index, array + index + 1, (count - index - 1) * sizeof(T));
+    mHeader->mSize = count - 1;
+    return result;
+}
+
+/**
+ * Sets the element at the specified index to the provided value. If index
+ * is out of bounds, an std::out_of_range exception is thrown with the index
+ * as its message. This method completes in constant time.
+ * This operation provides strong exception safety.
+ *
+ * @param index index of the object to set
+ * @param value the new value
+ */
+template <typename T>
+void MappedArrayList<T>::set(size_t index, const_reference value) {
+    rangeCheck(index);
+    data()[index] = value;
+}
+
+/**
+ * Return the size of this MappedArrayList.
+ * This operation is a no-throw.
+ *
+ * @return
+ */
+template <typename T>
+size_t MappedArrayList<T>::size() const throw () {
+    return mHeader->mSize;
+}
+
+/**
+ * Return the number of elements the file can hold before it needs to be
+ * enlarged.
+ * This operation is a no-throw.
+ *
+ * @return
+ */
+template <typename T>
+size_t MappedArrayList<T>::capacity() const throw () {
+    return mHeader->mCapacity;
+}
+
+/**
+ * Blocks until every modification made so far has been written to the
+ * file. Throws std::system_error if the write back fails.
+ */
+template <typename T>
+void MappedArrayList<T>::sync() const {
+    if (msync(mHeader, mLength, MS_SYNC) != 0)
+        throwSystemError("msync");
+}
+
+/**
+ * Returns the file length needed for capacity elements.
+ *
+ * @param capacity
+ * @return
+ */
+template <typename T>
+size_t MappedArrayList<T>::bytesFor(size_t capacity) throw () {
+    return sizeof(Header) + capacity * sizeof(T);
+}
+
+/**
+ * Returns the first element of the mapping.
+ *
+ * @return
+ */
+template <typename T>
+T* MappedArrayList<T>::data() const throw () {
+    return reinterpret_cast<T*>(mHeader + 1);
+}
+
+/**
+ * Enlarges the file and the mapping so that at least capacity elements
+ * fit. On failure the list is left as it was.
+ * This operation provides strong exception safety.
+ *
+ * @param capacity
+ */
+template <typename T>
+void MappedArrayList<T>::grow(size_t capacity) {
+    size_t length = bytesFor(capacity);
+    if (length > mLength) {
+        if (ftruncate(mFd, length) != 0)
+            throwSystemError("ftruncate");
+
+#ifdef MREMAP_MAYMOVE
+        void* ptr = mremap(mHeader, mLength, length, MREMAP_MAYMOVE);
+#else
+        void* ptr = mmap(0, length, PROT_READ | PROT_WRITE, MAP_SHARED, mFd, 0);
+#endif
+        if (ptr == MAP_FAILED) {
+            int error = errno;
+            if (ftruncate(mFd, mLength) != 0) {
+                // Nothing more can be done; the file merely stays longer
+            }
+            errno = error;
+            throwSystemError("mremap");
+        }
+#ifndef MREMAP_MAYMOVE
+        munmap(mHeader, mLength);
+#endif
+
+        mHeader = static_cast<Header*>(ptr);
+        mLength = length;
+    }
+    mHeader->mCapacity = capacity;
+}
+
+/**
+ * Given an index, this method throws an std::out_of_range with the index as
+ * its message if index is out of bounds or is a no-op otherwise.
+ * This operation provides strong exception safety.
+ *
+ * @param index index to check
+ */
+template <typename T>
+void MappedArrayList<T>::rangeCheck(size_t index) const throw (std::out_of_range) {
+    if (index >= mHeader->mSize) {
+        std::ostringstream os;
+        os << index;
+        throw std::out_of_range(os.str());
+    }
+}
+
+/**
+ * Throws an std::system_error for the current errno, naming the failed
+ * call in its message.
+ *
+ * @param call
+ */
+template <typename T>
+void MappedArrayList<T>::throwSystemError(const char* call) {
+    throw std::system_error(errno, std::generic_category(), call);
+}
+
+#endif
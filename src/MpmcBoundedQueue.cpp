@@ -0,0 +1,240 @@
+#ifndef _MPMC_BOUNDED_QUEUE_CPP_
+#define _MPMC_BOUNDED_QUEUE_CPP_
+
+#include "../include/MpmcBoundedQueue.h"
+#include "../include/ArrayStorage.h"
+#include <atomic>
+#include <cstdlib>                  // For size_t
+#include <algorithm>                // For std::min
+#include <stdint.h>                 // For intptr_t
+#include <thread>                   // For std::this_thread::yield
+#include <utility>                  // For std::move
+
+
+/**
+ * Initializes an empty queue that holds up to capacity elements. The
+ * capacity is rounded up to a power of two, and is at least 2.
+ *
+ * @param capacity minimum number of elements the queue can hold
+ */
+template <typename T>
+MpmcBoundedQueue<T>::MpmcBoundedQueue(size_t capacity)
+        : mCells(roundCapacity(capacity), ArrayStorage()), mMask(roundCapacity(capacity) - 1),
+          mEnqueuePos(0), mDequeuePos(0) {
+    for (size_t i = 0; i <= mMask; ++i)
+        mCells[i].mSequence.store(i, std::memory_order_relaxed);
+}
+
+/**
+ * Removes the front element from this queue. Throws Underflow if this queue
+ * is empty.
+ */
+template <typename T>
+void MpmcBoundedQueue<T>::dequeue() {
+    size_t pos;
+    Cell* cell = claimFront(pos);
+    if (!cell)
+        throw typename QueueBase<T>::Underflow();
+    Release release(this, pos);
+    cell->mValue = T();             // Release whatever the element holds
+}
+
+/**
+ * Removes the front element and returns it, moved out rather than copied.
+ * Throws Underflow if this queue is empty.
+ *
+ * @return
+ */
+template <typename T>
+T MpmcBoundedQueue<T>::dequeueValue() {
+    size_t pos;
+    Cell* cell = claimFront(pos);
+    if (!cell)
+        throw typename QueueBase<T>::Underflow();
+    Release release(this, pos);
+    return T(std::move(cell->mValue));
+}
+
+/**
+ * Adds value to the end of this queue, yielding the processor while the
+ * queue is full.
+ *
+ * @param
+ */
+template <typename T>
+void MpmcBoundedQueue<T>::enqueue(const T& value) {
+    while (!tryEnqueue(value))
+        std::this_thread::yield();
+}
+
+/**
+ * Returns a reference to the front of this queue, looking past slots whose
+ * enqueue failed. Throws Underflow if this queue is empty. The reference is
+ * only stable while no other consumer runs.
+ *
+ * @return
+ */
+template <typename T>
+const T& MpmcBoundedQueue<T>::front() const {
+    size_t pos = mDequeuePos.load(std::memory_order_relaxed);
+    for (size_t i = 0; i <= mMask; ++i, ++pos) {
+        const Cell& cell = mCells[pos & mMask];
+        size_t sequence = cell.mSequence.load(std::memory_order_acquire);
+        if (sequence == pos + 1)
+            return cell.mValue;
+        if (sequence != skipped(pos + 1))
+            break;
+    }
+    throw typename QueueBase<T>::Underflow();
+}
+
+/**
+ * Returns the number of elements in this queue.
+ *
+ * @return
+ */
+template <typename T>
+size_t MpmcBoundedQueue<T>::size() const {
+    // The dequeue position is read first so that the difference can never be
+    // negative
+    size_t head = mDequeuePos.load(std::memory_order_acquire);
+    size_t tail = mEnqueuePos.load(std::memory_order_acquire);
+    return std::min(tail - head, capacity());
+}
+
+/**
+ * Moves the front element into out, removes it and returns true, or
+ * returns false if this queue is empty.
+ *
+ * @param out receives the front element
+ * @return
+ */
+template <typename T>
+bool MpmcBoundedQueue<T>::tryDequeue(T& out) {
+    size_t pos;
+    Cell* cell = claimFront(pos);
+    if (!cell)
+        return false;
+    Release release(this, pos);
+    out = std::move(cell->mValue);
+    return true;
+}
+
+/**
+ * Adds value to the end of this queue and returns true, or returns false
+ * if the queue is full.
+ *
+ * @param value value to enqueue
+ * @return
+ */
+template <typename T>
+bool MpmcBoundedQueue<T>::tryEnqueue(const T& value) {
+    size_t pos = mEnqueuePos.load(std::memory_order_relaxed);
+    Cell* cell;
+    for (;;) {
+        cell = &mCells[pos & mMask];
+        size_t sequence = cell->mSequence.load(std::memory_order_acquire);
+        intptr_t diff = static_cast<intptr_t>(sequence & ~kSkipped) - static_cast<intptr_t>(pos);
+        if (diff == 0) {
+            if (mEnqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                break;
+        } else if (diff < 0) {
+            return false;           // The slot still holds last lap's element
+        } else {
+            pos = mEnqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    try {
+        cell->mValue = value;
+    } catch (...) {
+        // The position is taken, so publish the slot for consumers to pass
+        // over rather than leave them waiting for it
+        cell->mSequence.store(skipped(pos + 1), std::memory_order_release);
+        throw;
+    }
+    cell->mSequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+/**
+ * Returns the number of elements this queue can hold.
+ * This operation is a no-throw.
+ *
+ * @return
+ */
+template <typename T>
+size_t MpmcBoundedQueue<T>::capacity() const throw () {
+    return mMask + 1;
+}
+
+/**
+ * Claims the slot at the dequeue position, passing over slots whose enqueue
+ * failed, or returns null if the queue is empty. On success pos holds the
+ * claimed position.
+ *
+ * @param pos
+ * @return
+ */
+template <typename T>
+typename MpmcBoundedQueue<T>::Cell* MpmcBoundedQueue<T>::claimFront(size_t& pos) {
+    pos = mDequeuePos.load(std::memory_order_relaxed);
+    for (;;) {
+        Cell* cell = &mCells[pos & mMask];
+        size_t sequence = cell->mSequence.load(std::memory_order_acquire);
+        bool skip = (sequence & kSkipped) != 0;
+        intptr_t diff = static_cast<intptr_t>(sequence & ~kSkipped) - static_cast<intptr_t>(pos + 1);
+        if (diff == 0) {
+            if (mDequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                if (!skip)
+                    return cell;
+                releaseFront(pos);
+                pos = mDequeuePos.load(std::memory_order_relaxed);
+            }
+        } else if (diff < 0) {
+            return 0;               // The slot has not been filled yet
+        } else {
+            pos = mDequeuePos.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+/**
+ * Hands the claimed slot at pos back to producers for the next lap.
+ * This operation is a no-throw.
+ *
+ * @param pos
+ */
+template <typename T>
+void MpmcBoundedQueue<T>::releaseFront(size_t pos) throw () {
+    mCells[pos & mMask].mSequence.store(pos + mMask + 1, std::memory_order_release);
+}
+
+/**
+ * Returns the sequence number marking a slot that consumers pass over
+ * instead of sequence.
+ * This operation is a no-throw.
+ *
+ * @param sequence
+ * @return
+ */
+template <typename T>
+size_t MpmcBoundedQueue<T>::skipped(size_t sequence) throw () {
+    return sequence | kSkipped;
+}
+
+/**
+ * Returns the smallest power of two that is at least capacity and 2.
+ *
+ * @param capacity
+ * @return
+ */
+template <typename T>
+size_t MpmcBoundedQueue<T>::roundCapacity(size_t capacity) {
+    size_t rounded = 2;
+    while (rounded < capacity)
+        rounded <<= 1;
+    return rounded;
+}
+
+#endif
@@ -0,0 +1,283 @@
+#ifndef _MPSC_QUEUE_CPP_
+#define _MPSC_QUEUE_CPP_
+
+#include "../include/MpscQueue.h"
+#include <atomic>
+#include <cstdlib>                  // For size_t
+#include <utility>                  // For std::move
+
+
+/**
+ * Initializes an empty queue whose node pool holds up to poolCapacity
+ * nodes, rounded up to a power of two.
+ *
+ * @param poolCapacity number of freed nodes kept for reuse
+ */
+template <typename T>
+MpscQueue<T>::MpscQueue(size_t poolCapacity) : mPool(poolCapacity), mHead(new Node()), mTail(mHead) {
+}
+
+/**
+ * Destroys the queue and all the nodes it holds. No thread may use the
+ * queue any more.
+ */
+template <typename T>
+MpscQueue<T>::~MpscQueue() {
+    destroy(mHead);
+    Node* node;
+    while (mPool.tryDequeue(node))
+        delete node;
+}
+
+/**
+ * Removes the front element from this queue. Throws Underflow if this queue
+ * is empty. Consumer only.
+ */
+template <typename T>
+void MpscQueue<T>::dequeue() {
+    Node* node = next();
+    if (!node)
+        throw typename QueueBase<T>::Underflow();
+    node->mItem = T();              // Release whatever the element holds
+    advance(node);
+}
+
+/**
+ * Removes the front element and returns it, moved out rather than copied.
+ * Throws Underflow if this queue is empty. Consumer only.
+ *
+ * @return
+ */
+template <typename T>
+T MpscQueue<T>::dequeueValue() {
+    Node* node = next();
+    if (!node)
+        throw typename QueueBase<T>::Underflow();
+    T value(std::move(node->mItem));
+    advance(node);
+    return value;
+}
+
+/**
+ * Adds value to the end of this queue.
+ * This operation provides strong exception safety.
+ *
+ * @param
+ */
+template <typename T>
+void MpscQueue<T>::enqueue(const T& value) {
+    Node* node = acquire(value);
+    publish(node, node);
+}
+
+/**
+ * Returns a reference to the front of this queue. Throws Underflow if this
+ * queue is empty. Consumer only.
+ *
+ * @return
+ */
+template <typename T>
+const T& MpscQueue<T>::front() const {
+    Node* node = next();
+    if (!node)
+        throw typename QueueBase<T>::Underflow();
+    return node->mItem;
+}
+
+/**
+ * Returns the number of elements in this queue, walking the nodes.
+ * Consumer only.
+ *
+ * @return
+ */
+template <typename T>
+size_t MpscQueue<T>::size() const {
+    size_t count = 0;
+    for (Node* node = next(); node; node = node->mNext.load(std::memory_order_acquire))
+        ++count;
+    return count;
+}
+
+/**
+ * Moves the front element into out, removes it and returns true, or
+ * returns false if this queue is empty. Consumer only.
+ *
+ * @param out receives the front element
+ * @return
+ */
+template <typename T>
+bool MpscQueue<T>::tryDequeue(T& out) {
+    Node* node = next();
+    if (!node)
+        return false;
+    out = std::move(node->mItem);
+    advance(node);
+    return true;
+}
+
+/**
+ * Adds count elements from values to the end of this queue, in order and
+ * with no element of another producer in between.
+ * This operation provides strong exception safety.
+ *
+ * @param values elements to enqueue
+ * @param count number of elements
+ */
+template <typename T>
+void MpscQueue<T>::enqueueBulk(const T* values, size_t count) {
+    if (count == 0)
+        return;
+
+    // Build a private chain first, so that only one exchange is needed
+    Node* first = acquire(values[0]);
+    Node* last = first;
+    try {
+        for (size_t i = 1; i < count; ++i) {
+            Node* node = acquire(values[i]);
+            last->mNext.store(node, std::memory_order_relaxed);
+            last = node;
+        }
+    } catch (...) {
+        while (first) {
+            Node* node = first->mNext.load(std::memory_order_relaxed);
+            recycle(first);
+            first = node;
+        }
+        throw;
+    }
+    publish(first, last);
+}
+
+/**
+ * Moves up to count elements from the front of this queue into out, in
+ * dequeue order, and removes them. Returns the number of elements moved.
+ * Consumer only.
+ *
+ * @param out receives the dequeued elements
+ * @param count maximum number of elements to dequeue
+ * @return
+ */
+template <typename T>
+size_t MpscQueue<T>::dequeueBulk(T* out, size_t count) {
+    size_t dequeued = 0;
+    Node* node;
+    while (dequeued < count && (node = next())) {
+        out[dequeued++] = std::move(node->mItem);
+        advance(node);
+    }
+    return dequeued;
+}
+
+/**
+ * Removes up to max elements from the front of this queue, passing each
+ * one to consumer as an rvalue, and returns the number removed. If
+ * consumer throws, the element it was given is removed all the same.
+ * Consumer only.
+ *
+ * @param consumer function object called with each element
+ * @param max maximum number of elements to remove
+ * @return
+ */
+template <typename T>
+template <typename Consumer>
+size_t MpscQueue<T>::drain(Consumer consumer, size_t max) {
+    size_t drained = 0;
+    Node* node;
+    while (drained < max && (node = next())) {
+        // Advance first, so that a throwing consumer leaves the queue intact;
+        // the element stays alive in the new head node until the next removal
+        advance(node);
+        ++drained;
+        consumer(std::move(node->mItem));
+    }
+    return drained;
+}
+
+/**
+ * Returns a node holding value, taken from the pool or allocated, with a
+ * null link.
+ * This operation provides strong exception safety.
+ *
+ * @param value
+ * @return
+ */
+template <typename T>
+typename MpscQueue<T>::Node* MpscQueue<T>::acquire(const T& value) {
+    Node* node;
+    if (!mPool.tryDequeue(node))
+        node = new Node();
+    try {
+        node->mItem = value;
+    } catch (...) {
+        recycle(node);
+        throw;
+    }
+    node->mNext.store(0, std::memory_order_relaxed);
+    return node;
+}
+
+/**
+ * Returns node to the pool, or deletes it if the pool is full.
+ * This operation is a no-throw.
+ *
+ * @param node
+ */
+template <typename T>
+void MpscQueue<T>::recycle(Node* node) throw () {
+    if (!mPool.tryEnqueue(node))
+        delete node;
+}
+
+/**
+ * Makes first..last the end of this queue with one exchange.
+ * This operation is a no-throw.
+ *
+ * @param first
+ * @param last
+ */
+template <typename T>
+void MpscQueue<T>::publish(Node* first, Node* last) throw () {
+    Node* prev = mTail.exchange(last, std::memory_order_acq_rel);
+    // Until this store the chain is unreachable from the head
+    prev->mNext.store(first, std::memory_order_release);
+}
+
+/**
+ * Returns the node following the consumed head node, or null if this
+ * queue is empty. Consumer only.
+ *
+ * @return
+ */
+template <typename T>
+typename MpscQueue<T>::Node* MpscQueue<T>::next() const throw () {
+    return mHead->mNext.load(std::memory_order_acquire);
+}
+
+/**
+ * Makes node, which follows the head node, the new head and recycles the
+ * old one. Consumer only.
+ *
+ * @param node
+ */
+template <typename T>
+void MpscQueue<T>::advance(Node* node) throw () {
+    Node* old = mHead;
+    mHead = node;
+    recycle(old);
+}
+
+/**
+ * Deletes the chain of nodes starting at node.
+ *
+ * @param node
+ */
+template <typename T>
+void MpscQueue<T>::destroy(Node* node) throw () {
+    while (node) {
+        Node* next = node->mNext.load(std::memory_order_relaxed);
+        delete node;
+        node = next;
+    }
+}
+
+#endif
@@ -0,0 +1,265 @@
+#ifndef _MULTICAST_RING_CPP_
+#define _MULTICAST_RING_CPP_
+
+#include "../include/MulticastRing.h"
+#include "../include/ArrayStorage.h"
+#include <atomic>
+#include <cstdlib>                  // For size_t
+#include <memory>                   // For std::unique_ptr
+#include <sstream>                  // For ostringstream
+#include <stdexcept>                // For std::out_of_range
+#include <stdint.h>                 // For uint64_t
+#include <utility>                  // For std::move
+#include <vector>
+
+
+/**
+ * Initializes a ring with at least capacity slots, rounded up to a power
+ * of two, holding default constructed events.
+ *
+ * @param capacity minimum number of slots
+ */
+template <typename T, typename Wait>
+MulticastRing<T, Wait>::MulticastRing(size_t capacity)
+        : mEvents(roundCapacity(capacity), ArrayStorage()), mMask(roundCapacity(capacity) - 1),
+          mClaimed(0), mSlowestCache(0), mHalted(false) {
+}
+
+/**
+ * Registers a consumer that sees every event after the consumers in
+ * dependencies are done with it, and returns its id. Consumers must be
+ * added before any thread uses the ring.
+ *
+ * @param dependencies ids of the consumers that must run first
+ * @return
+ */
+template <typename T, typename Wait>
+size_t MulticastRing<T, Wait>::addConsumer(const std::vector<size_t>& dependencies) {
+    std::unique_ptr<Consumer> consumer(new Consumer());
+    consumer->mBarrier.push_back(&mPublished);
+    for (size_t i = 0; i < dependencies.size(); ++i) {
+        if (dependencies[i] >= mConsumers.size()) {
+            std::ostringstream os;
+            os << dependencies[i];
+            throw std::out_of_range(os.str());
+        }
+        consumer->mBarrier.push_back(&mConsumers[dependencies[i]]->mCursor);
+    }
+    mConsumers.push_back(std::move(consumer));
+    return mConsumers.size() - 1;
+}
+
+/**
+ * Claims the next count slots, waiting until every consumer is done with
+ * the events they held, and returns the sequence of the first. Throws
+ * Halted without claiming anything if it has to wait once halt() has been
+ * called. Producer only.
+ *
+ * @param count number of slots to claim, at most the capacity
+ * @return
+ */
+template <typename T, typename Wait>
+uint64_t MulticastRing<T, Wait>::claim(size_t count) {
+    if (count > capacity()) {
+        std::ostringstream os;
+        os << count;
+        throw std::out_of_range(os.str());
+    }
+
+    uint64_t first = mClaimed;
+    uint64_t end = first + count;
+    // Only look at the consumers' cursors when the cached minimum says the
+    // ring may be full
+    if (end - mSlowestCache > capacity()) {
+        mWait.waitUntil([this, end]() {
+            mSlowestCache = slowestConsumer();
+            return end - mSlowestCache <= capacity() || mHalted.load(std::memory_order_acquire);
+        });
+        if (end - mSlowestCache > capacity())
+            throw Halted();
+    }
+    mClaimed = end;
+    return first;
+}
+
+/**
+ * Makes every claimed event visible to the consumers. Producer only.
+ */
+template <typename T, typename Wait>
+void MulticastRing<T, Wait>::publish() {
+    mPublished.mSequence.store(mClaimed, std::memory_order_release);
+    mWait.signal();
+}
+
+/**
+ * Returns a reference to the event with the given sequence.
+ * This operation is a no-throw.
+ *
+ * @param sequence
+ * @return
+ */
+template <typename T, typename Wait>
+typename MulticastRing<T, Wait>::value_type& MulticastRing<T, Wait>::operator[](uint64_t sequence) throw () {
+    return mEvents[sequence & mMask];
+}
+
+/**
+ * Returns a constant reference to the event with the given sequence.
+ * This operation is a no-throw.
+ *
+ * @param sequence
+ * @return
+ */
+template <typename T, typename Wait>
+const typename MulticastRing<T, Wait>::value_type& MulticastRing<T, Wait>::operator[](uint64_t sequence) const throw () {
+    return mEvents[sequence & mMask];
+}
+
+/**
+ * Returns the sequence of the next event consumer will read.
+ * This operation is a no-throw.
+ *
+ * @param consumer
+ * @return
+ */
+template <typename T, typename Wait>
+uint64_t MulticastRing<T, Wait>::cursor(size_t consumer) const throw () {
+    return mConsumers[consumer]->mCursor.mSequence.load(std::memory_order_relaxed);
+}
+
+/**
+ * Returns the sequence one past the last event consumer may read now.
+ * This operation is a no-throw.
+ *
+ * @param consumer
+ * @return
+ */
+template <typename T, typename Wait>
+uint64_t MulticastRing<T, Wait>::available(size_t consumer) const throw () {
+    const std::vector<const Cursor*>& barrier = mConsumers[consumer]->mBarrier;
+    uint64_t end = barrier[0]->mSequence.load(std::memory_order_acquire);
+    for (size_t i = 1; i < barrier.size(); ++i) {
+        uint64_t sequence = barrier[i]->mSequence.load(std::memory_order_acquire);
+        if (sequence < end)
+            end = sequence;
+    }
+    return end;
+}
+
+/**
+ * Waits until consumer may read at least one event past its cursor, or
+ * until halt() is called, and returns the sequence one past the last
+ * event it may read.
+ *
+ * @param consumer
+ * @return
+ */
+template <typename T, typename Wait>
+uint64_t MulticastRing<T, Wait>::waitFor(size_t consumer) {
+    uint64_t next = cursor(consumer);
+    uint64_t end = available(consumer);
+    if (end > next)
+        return end;
+    mWait.waitUntil([this, consumer, next, &end]() {
+        end = available(consumer);
+        return end > next || mHalted.load(std::memory_order_acquire);
+    });
+    return end;
+}
+
+/**
+ * Records that consumer is done with every event below sequence.
+ *
+ * @param consumer
+ * @param sequence
+ */
+template <typename T, typename Wait>
+void MulticastRing<T, Wait>::release(size_t consumer, uint64_t sequence) {
+    mConsumers[consumer]->mCursor.mSequence.store(sequence, std::memory_order_release);
+    mWait.signal();
+}
+
+/**
+ * Passes every event consumer may read now to handler, as
+ * handler(event, sequence), releases them with one update and returns
+ * their number. If handler throws, the events before the one that threw
+ * are released.
+ *
+ * @param consumer
+ * @param handler
+ * @return
+ */
+template <typename T, typename Wait>
+template <typename Handler>
+size_t MulticastRing<T, Wait>::drain(size_t consumer, Handler handler) {
+    const MulticastRing<T, Wait>& ring = *this;
+    uint64_t begin = cursor(consumer);
+    uint64_t end = available(consumer);
+    uint64_t sequence = begin;
+    try {
+        for (; sequence < end; ++sequence)
+            handler(ring[sequence], sequence);
+    } catch (...) {
+        if (sequence > begin)
+            release(consumer, sequence);
+        throw;
+    }
+    if (end > begin)
+        release(consumer, end);
+    return static_cast<size_t>(end - begin);
+}
+
+/**
+ * Makes every current and future waitFor() return without waiting, and
+ * every claim() that finds the ring full throw Halted.
+ */
+template <typename T, typename Wait>
+void MulticastRing<T, Wait>::halt() {
+    mHalted.store(true, std::memory_order_release);
+    mWait.signal();
+}
+
+/**
+ * Returns the number of slots.
+ * This operation is a no-throw.
+ *
+ * @return
+ */
+template <typename T, typename Wait>
+size_t MulticastRing<T, Wait>::capacity() const throw () {
+    return mMask + 1;
+}
+
+/**
+ * Returns the smallest cursor among all consumers, or the claimed
+ * sequence if there are none.
+ * This operation is a no-throw.
+ *
+ * @return
+ */
+template <typename T, typename Wait>
+uint64_t MulticastRing<T, Wait>::slowestConsumer() const throw () {
+    uint64_t slowest = mClaimed;
+    for (size_t i = 0; i < mConsumers.size(); ++i) {
+        uint64_t sequence = mConsumers[i]->mCursor.mSequence.load(std::memory_order_acquire);
+        if (sequence < slowest)
+            slowest = sequence;
+    }
+    return slowest;
+}
+
+/**
+ * Returns the smallest power of two that is at least capacity and 2.
+ *
+ * @param capacity
+ * @return
+ */
+template <typename T, typename Wait>
+size_t MulticastRing<T, Wait>::roundCapacity(size_t capacity) {
+    size_t rounded = 2;
+    while (rounded < capacity)
+        rounded <<= 1;
+    return rounded;
+}
+
+#endif
@@ -0,0 +1,697 @@
+#ifndef _PERSISTENT_LIST_CPP_
+#define _PERSISTENT_LIST_CPP_
+
+#include "../include/PersistentList.h"
+#include "../include/PersistentListIterators.h"
+#include <atomic>
+#include <cstdlib>                  // For size_t
+#include <memory>                   // For std::unique_ptr
+#include <stdexcept>                // For std::out_of_range, std::logic_error
+#include <sstream>                  // For std::ostringstream
+#include <algorithm>
+
+template <typename T>
+std::atomic<uint64_t> PersistentList<T>::sNextEdit(1);
+
+
+/**
+ * Initializes an empty PersistentList.
+ * This operation is a no-throw.
+ */
+template <typename T>
+PersistentList<T>::PersistentList() throw () : mSize(0), mShift(kBits), mRoot(0), mTail(0) {
+}
+
+/**
+ * Initializes the PersistentList to share the contents of src in constant
+ * time.
+ * This operation is a no-throw.
+ *
+ * @param src PersistentList to copy
+ */
+template <typename T>
+PersistentList<T>::PersistentList(const PersistentList<T>& src) throw ()
+        : mSize(src.mSize), mShift(src.mShift), mRoot(retain(src.mRoot)),
+          mTail(static_cast<Leaf*>(retain(src.mTail))) {
+}
+
+/**
+ * Releases this version's share of its nodes.
+ * This operation is a no-throw.
+ */
+template <typename T>
+PersistentList<T>::~PersistentList() throw () {
+    release(mRoot, mShift);
+    release(mTail, 0);
+}
+
+/**
+ * Makes this object share the contents of rhs in constant time.
+ * This operation is a no-throw.
+ *
+ * @param rhs PersistentList to copy
+ * @return *this, used for chaining.
+ */
+template <typename T>
+const PersistentList<T>& PersistentList<T>::operator=(const PersistentList<T>& rhs) throw () {
+    PersistentList<T> copy(rhs);
+    std::swap(mSize, copy.mSize);
+    std::swap(mShift, copy.mShift);
+    std::swap(mRoot, copy.mRoot);
+    std::swap(mTail, copy.mTail);
+    return *this;
+}
+
+/**
+ * Returns a new version with value added to the end. Usually only the
+ * tail is copied; every 32nd call also copies one path of the trie.
+ * This operation provides strong exception safety.
+ *
+ * @param value value to append
+ * @return the new version
+ */
+template <typename T>
+PersistentList<T> PersistentList<T>::add(const_reference value) const {
+    size_t tailCount = mSize - tailOffset(mSize);
+    if (tailCount < kWidth) {
+        Guard tail(cloneLeaf(mTail, tailCount, 0), 0);
+        static_cast<Leaf*>(tail.get())->mValues[tailCount] = value;
+        return PersistentList<T>(mSize + 1, mShift, retain(mRoot), static_cast<Leaf*>(tail.dismiss()));
+    }
+
+    Guard tail(cloneLeaf(0, 0, 0), 0);
+    static_cast<Leaf*>(tail.get())->mValues[0] = value;
+
+    // The full tail moves into the trie, growing it by a level if it is full
+    unsigned shift = mShift;
+    Node* root;
+    if ((mSize >> kBits) > (static_cast<size_t>(1) << mShift)) {
+        Guard grown(cloneBranch(0, 0), mShift + kBits);
+        Branch* branch = static_cast<Branch*>(grown.get());
+        branch->mChildren[0] = retain(mRoot);
+        branch->mChildren[1] = newPath(mShift, mTail, 0);
+        root = grown.dismiss();
+        shift += kBits;
+    } else {
+        root = pushTail(mShift, mRoot, mTail, mSize);
+    }
+    return PersistentList<T>(mSize + 1, shift, root, static_cast<Leaf*>(tail.dismiss()));
+}
+
+/**
+ * Returns a new version with the element at index replaced by value,
+ * copying one path of the trie. If index is out of bounds, an
+ * std::out_of_range exception is thrown with the index as its message.
+ * This operation provides strong exception safety.
+ *
+ * @param index index of the object to set
+ * @param value the new value
+ * @return the new version
+ */
+template <typename T>
+PersistentList<T> PersistentList<T>::set(size_t index, const_reference value) const {
+    rangeCheck(index, mSize);
+    if (index >= tailOffset(mSize)) {
+        Guard tail(cloneLeaf(mTail, mSize - tailOffset(mSize), 0), 0);
+        static_cast<Leaf*>(tail.get())->mValues[index & kMask] = value;
+        return PersistentList<T>(mSize, mShift, retain(mRoot), static_cast<Leaf*>(tail.dismiss()));
+    }
+
+    Guard root(doSet(mShift, mRoot, index, value), mShift);
+    return PersistentList<T>(mSize, mShift, root.dismiss(), static_cast<Leaf*>(retain(mTail)));
+}
+
+/**
+ * Returns a new version without the last element. If this PersistentList
+ * is empty, an std::out_of_range exception is thrown with 0 as its message.
+ * This operation provides strong exception safety.
+ *
+ * @return the new version
+ */
+template <typename T>
+PersistentList<T> PersistentList<T>::removeLast() const {
+    rangeCheck(0, mSize);
+    if (mSize == 1)
+        return PersistentList<T>();
+
+    size_t tailCount = mSize - tailOffset(mSize);
+    if (tailCount > 1) {
+        Leaf* tail = cloneLeaf(mTail, tailCount - 1, 0);
+        return PersistentList<T>(mSize - 1, mShift, retain(mRoot), tail);
+    }
+
+    // The last leaf of the trie becomes the tail
+    Guard tail(retain(leafFor(mRoot, mShift, mTail, mSize, mSize - 2)), 0);
+    Guard root(popTail(mShift, mRoot, mSize), mShift);
+    unsigned shift = mShift;
+    Branch* branch = static_cast<Branch*>(root.get());
+    if (branch && shift > kBits && branch->mChildren[1] == 0) {
+        Node* child = retain(branch->mChildren[0]);
+        release(root.dismiss(), shift);
+        shift -= kBits;
+        return PersistentList<T>(mSize - 1, shift, child, static_cast<Leaf*>(tail.dismiss()));
+    }
+    return PersistentList<T>(mSize - 1, shift, root.dismiss(), static_cast<Leaf*>(tail.dismiss()));
+}
+
+/**
+ * Returns a constant reference to the element stored at the provided index.
+ * If index is out of bounds, an std::out_of_range exception is thrown with
+ * the index as its message.
+ * This operation provides strong exception safety.
+ *
+ * @param index index of the element to return
+ * @return constant reference to the element at the index.
+ */
+template <typename T>
+typename PersistentList<T>::const_reference PersistentList<T>::get(size_t index) const throw (std::out_of_range) {
+    rangeCheck(index, mSize);
+    return (*this)[index];
+}
+
+/**
+ * Returns a constant reference to the element stored at the provided index.
+ * No bounds checking is performed.
+ * This operation is a no-throw.
+ *
+ * @param index index of the element to return
+ * @return constant reference to the element at the index.
+ */
+template <typename T>
+typename PersistentList<T>::const_reference PersistentList<T>::operator[](size_t index) const throw () {
+    return leafFor(mRoot, mShift, mTail, mSize, index)->mValues[index & kMask];
+}
+
+/**
+ * Returns true if this PersistentList is logically equal to rhs.
+ *
+ * @param rhs
+ * @return
+ */
+template <typename T>
+bool PersistentList<T>::operator==(const PersistentList<T>& rhs) const {
+    if (mSize != rhs.mSize)
+        return false;
+    if (mRoot == rhs.mRoot && mTail == rhs.mTail)
+        return true;
+    return std::equal(begin(), end(), rhs.begin());
+}
+
+/**
+ * Returns false if this PersistentList is logically equal to rhs.
+ *
+ * @param rhs
+ * @return
+ */
+template <typename T>
+bool PersistentList<T>::operator!=(const PersistentList<T>& rhs) const {
+    return !(*this == rhs);
+}
+
+/**
+ * Returns a constant iterator to the first element.
+ * This operation is a no-throw.
+ *
+ * @return
+ */
+template <typename T>
+typename PersistentList<T>::const_iterator PersistentList<T>::begin() const throw () {
+    return const_iterator(this, 0);
+}
+
+/**
+ * Returns a constant iterator one past the last element.
+ * This operation is a no-throw.
+ *
+ * @return
+ */
+template <typename T>
+typename PersistentList<T>::const_iterator PersistentList<T>::end() const throw () {
+    return const_iterator(this, mSize);
+}
+
+/**
+ * Returns true if this PersistentList is empty and false otherwise.
+ * This operation is a no-throw.
+ *
+ * @return
+ */
+template <typename T>
+bool PersistentList<T>::isEmpty() const throw () {
+    return mSize == 0;
+}
+
+/**
+ * Return the size of this PersistentList.
+ * This operation is a no-throw.
+ *
+ * @return
+ */
+template <typename T>
+size_t PersistentList<T>::size() const throw () {
+    return mSize;
+}
+
+/**
+ * Takes ownership of the provided nodes.
+ *
+ * @param size
+ * @param shift
+ * @param root
+ * @param tail
+ */
+template <typename T>
+PersistentList<T>::PersistentList(size_t size, unsigned shift, Node* root, Leaf* tail) throw ()
+        : mSize(size), mShift(shift), mRoot(root), mTail(tail) {
+}
+
+/**
+ * Initializes an empty branch.
+ *
+ * @param edit
+ */
+template <typename T>
+PersistentList<T>::Branch::Branch(uint64_t edit) : Node(edit) {
+    std::fill(mChildren, mChildren + kWidth, static_cast<Node*>(0));
+}
+
+/**
+ * Returns the index of the first element stored in the tail of a list
+ * with size elements.
+ *
+ * @param size
+ * @return
+ */
+template <typename T>
+size_t PersistentList<T>::tailOffset(size_t size) throw () {
+    return size < kWidth ? 0 : ((size - 1) >> kBits) << kBits;
+}
+
+/**
+ * Returns the leaf holding the element at index.
+ *
+ * @param root
+ * @param shift
+ * @param tail
+ * @param size
+ * @param index
+ * @return
+ */
+template <typename T>
+const typename PersistentList<T>::Leaf* PersistentList<T>::leafFor(const Node* root, unsigned shift, const Leaf* tail,
+                                                                 size_t size, size_t index) throw () {
+    if (index >= tailOffset(size))
+        return tail;
+
+    const Node* node = root;
+    for (unsigned level = shift; level > 0; level -= kBits)
+        node = static_cast<const Branch*>(node)->mChildren[(index >> level) & kMask];
+    return static_cast<const Leaf*>(node);
+}
+
+/**
+ * Adds a reference to node, which may be null, and returns it.
+ *
+ * @param node
+ * @return
+ */
+template <typename T>
+typename PersistentList<T>::Node* PersistentList<T>::retain(const Node* node) throw () {
+    Node* mutableNode = const_cast<Node*>(node);
+    if (mutableNode)
+        mutableNode->mRefs.fetch_add(1, std::memory_order_relaxed);
+    return mutableNode;
+}
+
+/**
+ * Drops a reference to node, which may be null and sits level bits above
+ * the leaves, freeing it and its unreferenced children if that was the
+ * last one.
+ *
+ * @param node
+ * @param level
+ */
+template <typename T>
+void PersistentList<T>::release(Node* node, unsigned level) throw () {
+    if (!node || node->mRefs.fetch_sub(1, std::memory_order_acq_rel) != 1)
+        return;
+
+    if (level == 0) {
+        delete static_cast<Leaf*>(node);
+    } else {
+        Branch* branch = static_cast<Branch*>(node);
+        for (size_t i = 0; i < kWidth; ++i)
+            release(branch->mChildren[i], level - kBits);
+        delete branch;
+    }
+}
+
+/**
+ * Returns a copy of branch, or a new empty branch if branch is null,
+ * owned by edit.
+ *
+ * @param branch
+ * @param edit
+ * @return
+ */
+template <typename T>
+typename PersistentList<T>::Branch* PersistentList<T>::cloneBranch(const Branch* branch, uint64_t edit) {
+    Branch* copy = new Branch(edit);
+    if (branch) {
+        for (size_t i = 0; i < kWidth; ++i)
+            copy->mChildren[i] = retain(branch->mChildren[i]);
+    }
+    return copy;
+}
+
+/**
+ * Returns a leaf owned by edit holding the first count values of leaf,
+ * which may be null.
+ *
+ * @param leaf
+ * @param count
+ * @param edit
+ * @return
+ */
+template <typename T>
+typename PersistentList<T>::Leaf* PersistentList<T>::cloneLeaf(const Leaf* leaf, size_t count, uint64_t edit) {
+    std::unique_ptr<Leaf> copy(new Leaf(edit));
+    if (leaf)
+        std::copy(leaf->mValues, leaf->mValues + count, copy->mValues);
+    return copy.release();
+}
+
+/**
+ * Returns a chain of new branches owned by edit leading level bits down
+ * to node, with a new reference to node.
+ *
+ * @param level
+ * @param node
+ * @param edit
+ * @return
+ */
+template <typename T>
+typename PersistentList<T>::Node* PersistentList<T>::newPath(unsigned level, const Node* node, uint64_t edit) {
+    Node* path = retain(node);
+    for (unsigned built = kBits; built <= level; built += kBits) {
+        Branch* branch;
+        try {
+            branch = new Branch(edit);
+        } catch (...) {
+            release(path, built - kBits);
+            throw;
+        }
+        branch->mChildren[0] = path;
+        path = branch;
+    }
+    return path;
+}
+
+/**
+ * Returns a copy of parent with leaf added as the last leaf of a tree
+ * holding size elements including those of leaf.
+ *
+ * @param level
+ * @param parent
+ * @param leaf
+ * @param size
+ * @return
+ */
+template <typename T>
+typename PersistentList<T>::Node* PersistentList<T>::pushTail(unsigned level, const Node* parent,
+                                                              const Leaf* leaf, size_t size) {
+    Guard result(cloneBranch(static_cast<const Branch*>(parent), 0), level);
+    Branch* branch = static_cast<Branch*>(result.get());
+    size_t sub = ((size - 1) >> level) & kMask;
+
+    Node* insert;
+    if (level == kBits) {
+        insert = retain(leaf);
+    } else if (branch->mChildren[sub]) {
+        insert = pushTail(level - kBits, branch->mChildren[sub], leaf, size);
+    } else {
+        insert = newPath(level - kBits, leaf, 0);
+    }
+
+    release(branch->mChildren[sub], level - kBits);
+    branch->mChildren[sub] = insert;
+    return result.dismiss();
+}
+
+/**
+ * Returns a copy of node with the element at index set to value.
+ *
+ * @param level
+ * @param node
+ * @param index
+ * @param value
+ * @return
+ */
+template <typename T>
+typename PersistentList<T>::Node* PersistentList<T>::doSet(unsigned level, const Node* node, size_t index,
+                                                           const_reference value) {
+    if (level == 0) {
+        Guard leaf(cloneLeaf(static_cast<const Leaf*>(node), kWidth, 0), 0);
+        static_cast<Leaf*>(leaf.get())->mValues[index & kMask] = value;
+        return leaf.dismiss();
+    }
+
+    Guard result(cloneBranch(static_cast<const Branch*>(node), 0), level);
+    Branch* branch = static_cast<Branch*>(result.get());
+    size_t sub = (index >> level) & kMask;
+    Node* child = doSet(level - kBits, branch->mChildren[sub], index, value);
+    release(branch->mChildren[sub], level - kBits);
+    branch->mChildren[sub] = child;
+    return result.dismiss();
+}
+
+/**
+ * Returns a copy of node without its last leaf, or null if nothing is
+ * left, for a tree holding size elements before the removal.
+ *
+ * @param level
+ * @param node
+ * @param size
+ * @return
+ */
+template <typename T>
+typename PersistentList<T>::Node* PersistentList<T>::popTail(unsigned level, const Node* node, size_t size) {
+    const Branch* branch = static_cast<const Branch*>(node);
+    size_t sub = ((size - 2) >> level) & kMask;
+    Node* popped = 0;
+    if (level > kBits) {
+        popped = popTail(level - kBits, branch->mChildren[sub], size);
+        if (!popped && sub == 0)
+            return 0;
+    } else if (sub == 0) {
+        return 0;
+    }
+
+    Guard child(popped, level - kBits);
+    Guard result(cloneBranch(branch, 0), level);
+    Branch* copy = static_cast<Branch*>(result.get());
+    release(copy->mChildren[sub], level - kBits);
+    copy->mChildren[sub] = child.dismiss();
+    return result.dismiss();
+}
+
+/**
+ * Given an index, this method throws an std::out_of_range with the index as
+ * its message if index is out of bounds or is a no-op otherwise.
+ * This operation provides strong exception safety.
+ *
+ * @param index index to check
+ * @param size
+ */
+template <typename T>
+void PersistentList<T>::rangeCheck(size_t index, size_t size) throw (std::out_of_range) {
+    if (index >= size) {
+        std::ostringstream os;
+        os << index;
+        throw std::out_of_range(os.str());
+    }
+}
+
+
+/**
+ * Initializes a Transient holding the contents of list in constant time.
+ * This operation provides strong exception safety.
+ *
+ * @param list the version to start from
+ */
+template <typename T>
+PersistentList<T>::Transient::Transient(const PersistentList<T>& list)
+        : mSize(list.mSize), mShift(list.mShift), mRoot(retain(list.mRoot)),
+          mTail(static_cast<Leaf*>(retain(list.mTail))),
+          mEdit(sNextEdit.fetch_add(1, std::memory_order_relaxed)) {
+}
+
+/**
+ * Releases the nodes held by this Transient.
+ * This operation is a no-throw.
+ */
+template <typename T>
+PersistentList<T>::Transient::~Transient() throw () {
+    release(mRoot, mShift);
+    release(mTail, 0);
+}
+
+/**
+ * Adds value to the end in amortized constant time.
+ * Throws std::logic_error if persistent() was already called.
+ * This operation provides basic exception safety.
+ *
+ * @param value value to append
+ * @return *this, used for chaining.
+ */
+template <typename T>
+typename PersistentList<T>::Transient& PersistentList<T>::Transient::add(const_reference value) {
+    ensureValid();
+    size_t tailCount = mSize - tailOffset(mSize);
+    if (tailCount < kWidth) {
+        Node* tail = mTail;
+        static_cast<Leaf*>(editable(tail, 0))->mValues[tailCount] = value;
+        mTail = static_cast<Leaf*>(tail);
+        ++mSize;
+        return *this;
+    }
+
+    Guard tail(cloneLeaf(0, 0, mEdit), 0);
+    static_cast<Leaf*>(tail.get())->mValues[0] = value;
+
+    // The full tail moves into the trie, growing it by a level if it is full
+    if ((mSize >> kBits) > (static_cast<size_t>(1) << mShift)) {
+        Guard grown(cloneBranch(0, mEdit), mShift + kBits);
+        Branch* branch = static_cast<Branch*>(grown.get());
+        branch->mChildren[1] = newPath(mShift, mTail, mEdit);
+        branch->mChildren[0] = mRoot;
+        mRoot = grown.dismiss();
+        mShift += kBits;
+    } else {
+        Node* node = editable(mRoot, mShift);
+        unsigned level = mShift;
+        size_t index = mSize - 1;
+        for (; level > kBits; level -= kBits) {
+            Node*& child = static_cast<Branch*>(node)->mChildren[(index >> level) & kMask];
+            if (!child) {
+                child = newPath(level - kBits, mTail, mEdit);
+                break;
+            }
+            node = editable(child, level - kBits);
+        }
+        if (level == kBits)
+            static_cast<Branch*>(node)->mChildren[(index >> level) & kMask] = retain(mTail);
+    }
+
+    release(mTail, 0);
+    mTail = static_cast<Leaf*>(tail.dismiss());
+    ++mSize;
+    return *this;
+}
+
+/**
+ * Sets the element at the specified index to the provided value. If
+ * index is out of bounds, an std::out_of_range exception is thrown with
+ * the index as its message. Throws std::logic_error if persistent() was
+ * already called.
+ * This operation provides basic exception safety.
+ *
+ * @param index index of the object to set
+ * @param value the new value
+ * @return *this, used for chaining.
+ */
+template <typename T>
+typename PersistentList<T>::Transient& PersistentList<T>::Transient::set(size_t index, const_reference value) {
+    ensureValid();
+    rangeCheck(index, mSize);
+    if (index >= tailOffset(mSize)) {
+        Node* tail = mTail;
+        static_cast<Leaf*>(editable(tail, 0))->mValues[index & kMask] = value;
+        mTail = static_cast<Leaf*>(tail);
+        return *this;
+    }
+
+    Node* node = editable(mRoot, mShift);
+    for (unsigned level = mShift; level > 0; level -= kBits)
+        node = editable(static_cast<Branch*>(node)->mChildren[(index >> level) & kMask], level - kBits);
+    static_cast<Leaf*>(node)->mValues[index & kMask] = value;
+    return *this;
+}
+
+/**
+ * Returns a constant reference to the element stored at the provided
+ * index. If index is out of bounds, an std::out_of_range exception is
+ * thrown with the index as its message.
+ * This operation provides strong exception safety.
+ *
+ * @param index index of the element to return
+ * @return constant reference to the element at the index.
+ */
+template <typename T>
+typename PersistentList<T>::const_reference PersistentList<T>::Transient::get(size_t index) const {
+    ensureValid();
+    rangeCheck(index, mSize);
+    return leafFor(mRoot, mShift, mTail, mSize, index)->mValues[index & kMask];
+}
+
+/**
+ * Return the number of elements added so far.
+ * This operation is a no-throw.
+ *
+ * @return
+ */
+template <typename T>
+size_t PersistentList<T>::Transient::size() const throw () {
+    return mSize;
+}
+
+/**
+ * Returns the built list in constant time and ends this Transient.
+ * Throws std::logic_error if persistent() was already called.
+ *
+ * @return
+ */
+template <typename T>
+PersistentList<T> PersistentList<T>::Transient::persistent() {
+    ensureValid();
+    PersistentList<T> result(mSize, mShift, mRoot, mTail);
+    mRoot = 0;
+    mTail = 0;
+    mEdit = 0;
+    return result;
+}
+
+/**
+ * Throws std::logic_error if persistent() was already called.
+ */
+template <typename T>
+void PersistentList<T>::Transient::ensureValid() const {
+    if (mEdit == 0)
+        throw std::logic_error("Transient used after persistent()");
+}
+
+/**
+ * Returns the node in slot, first replacing it with a copy owned by this
+ * Transient if it is shared. A null slot receives a new empty node.
+ * This operation provides strong exception safety.
+ *
+ * @param slot
+ * @param level
+ * @return
+ */
+template <typename T>
+typename PersistentList<T>::Node* PersistentList<T>::Transient::editable(Node*& slot, unsigned level) {
+    if (slot && slot->mEdit == mEdit)
+        return slot;
+
+    Node* copy;
+    if (level == 0)
+        copy = cloneLeaf(static_cast<Leaf*>(slot), kWidth, mEdit);
+    else
+        copy = cloneBranch(static_cast<Branch*>(slot), mEdit);
+    release(slot, level);
+    slot = copy;
+    return copy;
+}
+
+#endif
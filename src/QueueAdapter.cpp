@@ -0,0 +1,123 @@
+#ifndef _QUEUE_ADAPTER_CPP_
+#define _QUEUE_ADAPTER_CPP_
+
+#include "../include/QueueAdapter.h"
+#include <cstdlib>          // For size_t
+#include <utility>          // For std::forward
+
+
+/**
+ * Removes the front element from this queue. Throws Underflow if this queue
+ * is empty.
+ */
+template <typename Container>
+void QueueAdapter<Container>::dequeue() {
+    mQueue.dequeue();
+}
+
+/**
+ * Removes the front element and returns it, moved out rather than copied.
+ * Throws Underflow if this queue is empty.
+ *
+ * @return
+ */
+template <typename Container>
+typename QueueAdapter<Container>::value_type QueueAdapter<Container>::dequeueValue() {
+    return mQueue.dequeueValue();
+}
+
+/**
+ * Adds value to the end of this queue.
+ *
+ * @param
+ */
+template <typename Container>
+void QueueAdapter<Container>::enqueue(const value_type& value) {
+    mQueue.enqueue(value);
+}
+
+/**
+ * Adds an element constructed from args to the end of this queue, in place
+ * if the container supports emplace().
+ *
+ * @param args
+ */
+template <typename Container>
+template <typename... Args>
+void QueueAdapter<Container>::emplace(Args&&... args) {
+    mQueue.emplace(std::forward<Args>(args)...);
+}
+
+/**
+ * Makes room for capacity elements if the container supports reserve(),
+ * or does nothing otherwise.
+ *
+ * @param capacity
+ */
+template <typename Container>
+void QueueAdapter<Container>::reserve(size_t capacity) {
+    mQueue.reserve(capacity);
+}
+
+/**
+ * Returns a reference to the front of this queue. Throws Underflow if this
+ * queue is empty.
+ *
+ * @return
+ */
+template <typename Container>
+const typename QueueAdapter<Container>::value_type& QueueAdapter<Container>::front() const {
+    return mQueue.front();
+}
+
+/**
+ * Returns the size of this queue.
+ *
+ * @return
+ */
+template <typename Container>
+size_t QueueAdapter<Container>::size() const {
+    return mQueue.size();
+}
+
+/**
+ * Moves the front element into out, removes it and returns true, or
+ * returns false if this queue is empty.
+ *
+ * @param out receives the front element
+ * @return
+ */
+template <typename Container>
+bool QueueAdapter<Container>::tryDequeue(value_type& out) {
+    return mQueue.tryDequeue(out);
+}
+
+/**
+ * Adds the count elements of values to the end of this queue, in order.
+ * The container's addAll() is used when it has one.
+ *
+ * @param values elements to enqueue
+ * @param count number of elements to enqueue
+ */
+template <typename Container>
+void QueueAdapter<Container>::enqueueBulk(const value_type* values, size_t count) {
+    mQueue.enqueueBulk(values, count);
+}
+
+/**
+ * Moves up to count elements from the front of this queue into out, in
+ * dequeue order, and removes them. Returns the number of elements moved,
+ * which is less than count only if the queue ran empty.
+ * The container's removeRange() is used when it has one and no
+ * removeFirst().
+ *
+ * @param out receives the dequeued elements
+ * @param count maximum number of elements to dequeue
+ * @return
+ */
+template <typename Container>
+size_t QueueAdapter<Container>::dequeueBulk(value_type* out, size_t count) {
+    return mQueue.dequeueBulk(out, count);
+}
+
+#endif
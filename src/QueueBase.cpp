@@ -0,0 +1,100 @@
+#ifndef _QUEUE_BASE_CPP_
+#define _QUEUE_BASE_CPP_
+
+#include "../include/QueueBase.h"
+#include <cstdlib>          // For size_t
+#include <utility>          // For std::move
+
+
+/**
+ * Pure virtual destructor.
+ */
+template <typename T>
+QueueBase<T>::~QueueBase() {
+}
+
+/**
+ * Removes the front element and returns it, moved out rather than copied.
+ * Throws Underflow if this queue is empty.
+ *
+ * @return
+ */
+template <typename T>
+T QueueBase<T>::dequeueValue() {
+    T value(std::move(front()));
+    dequeue();
+    return value;
+}
+
+/**
+ * Returns a reference to the front of this queue. Throws Underflow if this
+ * queue is empty.
+ *
+ * @return
+ */
+template <typename T>
+T& QueueBase<T>::front() {
+    const QueueBase<T>* self = this;
+    return const_cast<T&>(self->front());
+}
+
+/**
+ * Returns true if this queue is empty.
+ *
+ * @return
+ */
+template <typename T>
+bool QueueBase<T>::isEmpty() const {
+    return size() == 0;
+}
+
+/**
+ * Moves the front element into out, removes it and returns true, or
+ * returns false if this queue is empty. Unlike dequeue(), an empty queue
+ * is not an error, so polling a mostly empty queue costs a branch rather
+ * than an exception.
+ *
+ * @param out receives the front element
+ * @return
+ */
+template <typename T>
+bool QueueBase<T>::tryDequeue(T& out) {
+    if (isEmpty())
+        return false;
+    out = std::move(front());
+    dequeue();
+    return true;
+}
+
+/**
+ * Adds the count elements of values to the end of this queue, in order.
+ * The default implementation enqueues them one at a time.
+ *
+ * @param values elements to enqueue
+ * @param count number of elements to enqueue
+ */
+template <typename T>
+void QueueBase<T>::enqueueBulk(const T* values, size_t count) {
+    for (size_t i = 0; i < count; ++i)
+        enqueue(values[i]);
+}
+
+/**
+ * Moves up to count elements from the front of this queue into out, in
+ * dequeue order, and removes them. Returns the number of elements moved,
+ * which is less than count only if the queue ran empty.
+ * The default implementation dequeues them one at a time.
+ *
+ * @param out receives the dequeued elements
+ * @param count maximum number of elements to dequeue
+ * @return
+ */
+template <typename T>
+size_t QueueBase<T>::dequeueBulk(T* out, size_t count) {
+    size_t dequeued = 0;
+    while (dequeued < count && tryDequeue(out[dequeued]))
+        ++dequeued;
+    return dequeued;
+}
+
+#endif
@@ -0,0 +1,352 @@
+#ifndef _RLE_LIST_CPP_
+#define _RLE_LIST_CPP_
+
+#include "../include/RleList.h"
+#include "../include/RleListIterators.h"
+#include <cstdlib>                  // For size_t
+#include <stdexcept>                // For std::out_of_range
+#include <sstream>                  // For std::ostringstream
+#include <algorithm>
+#include <vector>
+
+
+/**
+ * Initializes the RleList with size elements all set to value using a
+ * single run. If size is not supplied, an empty RleList is created.
+ * This operation provides strong exception safety.
+ *
+ * @param size size of the RleList to create
+ * @param value value used to fill the RleList
+ */
+template <typename T>
+RleList<T>::RleList(size_t size, const_reference value) {
+    if (size > 0) {
+        mRuns.push_back(Run(value, size));
+        mEnds.push_back(size);
+    }
+}
+
+/**
+ * Adds value to the end of this RleList. If value equals the last element
+ * the last run is simply extended. This operation completes in amortized
+ * constant time.
+ * This operation provides strong exception safety.
+ *
+ * @param value value to append to this RleList
+ */
+template <typename T>
+void RleList<T>::add(const_reference value) {
+    if (!mRuns.empty() && mRuns.back().mValue == value) {
+        ++mRuns.back().mLength;
+        ++mEnds.back();
+    } else {
+        mEnds.push_back(size() + 1);
+        try {
+            mRuns.push_back(Run(value, 1));
+        } catch (...) {
+            mEnds.pop_back();
+            throw;
+        }
+    }
+}
+
+/**
+ * Inserts value at the specified index. All elements at or to the right of
+ * index are shifted down by one spot. If this RleList needs to be enlarged,
+ * a single run of default values is used to fill the gap.
+ * This operation provides strong exception safety.
+ *
+ * @param index index at which to insert value
+ * @param value the element to insert
+ */
+template <typename T>
+void RleList<T>::add(size_t index, const_reference value) {
+    if (index >= size()) {
+        std::vector<Run> tail;
+        tail.push_back(Run(value_type(), index - size()));
+        tail.push_back(Run(value, 1));
+        splice(mRuns.size(), 0, tail);
+        return;
+    }
+
+    size_t run = findRun(index);
+    if (mRuns[run].mValue == value) {
+        ++mRuns[run].mLength;
+        for (size_t i = run; i < mEnds.size(); ++i)
+            ++mEnds[i];
+        return;
+    }
+
+    size_t offset = index - runStart(run);
+    std::vector<Run> replacement;
+    replacement.push_back(Run(mRuns[run].mValue, offset));
+    replacement.push_back(Run(value, 1));
+    replacement.push_back(Run(mRuns[run].mValue, mRuns[run].mLength - offset));
+    splice(run, 1, replacement);
+}
+
+/**
+ * Empties this RleList.
+ * This operation is a no-throw.
+ */
+template <typename T>
+void RleList<T>::clear() throw () {
+    mRuns.clear();
+    mEnds.clear();
+}
+
+/**
+ * Returns a constant reference to the element stored at the provided index.
+ * If index is out of bounds, an std::out_of_range exception is thrown with
+ * the index as its message. Time proportional to the logarithm of the
+ * number of runs is needed.
+ * This operation provides strong exception safety.
+ *
+ * @param index index of the element to return
+ * @return constant reference to the element at the index.
+ */
+template <typename T>
+typename RleList<T>::const_reference RleList<T>::get(size_t index) const throw (std::out_of_range) {
+    rangeCheck(index);
+    return (*this)[index];
+}
+
+/**
+ * Returns a constant reference to the element stored at the provided index.
+ * No range checking is performed on the index.
+ *
+ * @param index index of the element to return
+ * @return constant reference to the element at the index.
+ */
+template <typename T>
+typename RleList<T>::const_reference RleList<T>::operator[](size_t index) const throw () {
+    return mRuns[findRun(index)].mValue;
+}
+
+/**
+ * Returns true if this RleList is equal to rhs and false otherwise. Since
+ * runs are always maximal, this compares runs rather than elements.
+ *
+ * @param rhs
+ * @return
+ */
+template <typename T>
+bool RleList<T>::operator==(const RleList<T>& rhs) const {
+    if (mEnds != rhs.mEnds)
+        return false;
+    for (size_t i = 0; i < mRuns.size(); ++i) {
+        if (!(mRuns[i].mValue == rhs.mRuns[i].mValue))
+            return false;
+    }
+    return true;
+}
+
+/**
+ * Returns false if this RleList is equal to rhs and true otherwise.
+ *
+ * @param rhs
+ * @return
+ */
+template <typename T>
+bool RleList<T>::operator!=(const RleList<T>& rhs) const {
+    return !(*this == rhs);
+}
+
+/**
+ * Returns a constant iterator to the beginning.
+ * This operation is a no-throw.
+ *
+ * @return
+ */
+template <typename T>
+typename RleList<T>::const_iterator RleList<T>::begin() const throw () {
+    return const_iterator(this, 0);
+}
+
+/**
+ * Returns a constant iterator to the end.
+ * This operation is a no-throw.
+ *
+ * @return
+ */
+template <typename T>
+typename RleList<T>::const_iterator RleList<T>::end() const throw () {
+    return const_iterator(this, mRuns.size());
+}
+
+/**
+ * Returns true if this RleList is empty and false otherwise.
+ * This operation is a no-throw.
+ *
+ * @return
+ */
+template <typename T>
+bool RleList<T>::isEmpty() const throw () {
+    return mRuns.empty();
+}
+
+/**
+ * Removes and returns the element at the specified index. If index is out
+ * of bounds, an std::out_of_range exception is thrown with index as its
+ * message. If the removal empties a run, its neighbors are merged when
+ * they hold equal values.
+ * This operation provides basic exception safety.
+ *
+ * @param index index of the object to remove.
+ * @return copy of the just removed object.
+ */
+template <typename T>
+typename RleList<T>::value_type RleList<T>::remove(size_t index) {
+    rangeCheck(index);
+    size_t run = findRun(index);
+    value_type result = mRuns[run].mValue;
+
+    if (mRuns[run].mLength > 1) {
+        --mRuns[run].mLength;
+        for (size_t i = run; i < mEnds.size(); ++i)
+            --mEnds[i];
+    } else {
+        splice(run, 1, std::vector<Run>());
+    }
+    return result;
+}
+
+/**
+ * Sets the element at the specified index to the provided value, splitting
+ * and merging runs as needed. If index is out of bounds, an
+ * std::out_of_range exception is thrown with the index as its message.
+ * This operation provides strong exception safety.
+ *
+ * @param index index of the object to set
+ * @param value the new value
+ */
+template <typename T>
+void RleList<T>::set(size_t index, const_reference value) {
+    rangeCheck(index);
+    size_t run = findRun(index);
+    if (mRuns[run].mValue == value)
+        return;
+
+    size_t offset = index - runStart(run);
+    std::vector<Run> replacement;
+    replacement.push_back(Run(mRuns[run].mValue, offset));
+    replacement.push_back(Run(value, 1));
+    replacement.push_back(Run(mRuns[run].mValue, mRuns[run].mLength - offset - 1));
+    splice(run, 1, replacement);
+}
+
+/**
+ * Return the size of this RleList.
+ * This operation is a no-throw.
+ *
+ * @return
+ */
+template <typename T>
+size_t RleList<T>::size() const throw () {
+    return mEnds.empty() ? 0 : mEnds.back();
+}
+
+/**
+ * Returns the number of runs used to store this RleList.
+ * This operation is a no-throw.
+ *
+ * @return
+ */
+template <typename T>
+size_t RleList<T>::runCount() const throw () {
+    return mRuns.size();
+}
+
+/**
+ * Returns the number of the run holding index.
+ *
+ * @param index
+ * @return
+ */
+template <typename T>
+size_t RleList<T>::findRun(size_t index) const throw () {
+    return std::upper_bound(mEnds.begin(), mEnds.end(), index) - mEnds.begin();
+}
+
+/**
+ * Returns the index of the first element of the provided run.
+ *
+ * @param run
+ * @return
+ */
+template <typename T>
+size_t RleList<T>::runStart(size_t run) const throw () {
+    return run == 0 ? 0 : mEnds[run - 1];
+}
+
+/**
+ * Appends run to the end of runs, extending the last run instead if it holds
+ * an equal value. Empty runs are dropped.
+ *
+ * @param runs the runs to extend
+ * @param run the run to append
+ */
+template <typename T>
+void RleList<T>::appendRun(std::vector<Run>& runs, const Run& run) {
+    if (run.mLength == 0)
+        return;
+    if (!runs.empty() && runs.back().mValue == run.mValue)
+        runs.back().mLength += run.mLength;
+    else
+        runs.push_back(run);
+}
+
+/**
+ * Replaces count runs starting at first with the runs in replacement
+ * (dropping empty ones), merges equal neighbors around the replaced range
+ * and brings the prefix-sum index up to date.
+ * This operation provides strong exception safety.
+ *
+ * @param first number of the first run to replace
+ * @param count number of runs to replace
+ * @param replacement the new runs
+ */
+template <typename T>
+void RleList<T>::splice(size_t first, size_t count, const std::vector<Run>& replacement) {
+    // Build the new runs and prefix sums on the side and swap both in, so
+    // a throwing copy or comparison leaves this RleList untouched
+    std::vector<Run> runs;
+    runs.reserve(mRuns.size() - count + replacement.size());
+    runs.insert(runs.end(), mRuns.begin(), mRuns.begin() + first);
+
+    // Merge equal neighbors from the run before the splice to the one after
+    for (size_t i = 0; i < replacement.size(); ++i)
+        appendRun(runs, replacement[i]);
+    if (first + count < mRuns.size()) {
+        appendRun(runs, mRuns[first + count]);
+        runs.insert(runs.end(), mRuns.begin() + first + count + 1, mRuns.end());
+    }
+
+    size_t lo = first > 0 ? first - 1 : 0;
+    std::vector<size_t> ends;
+    ends.reserve(runs.size());
+    ends.insert(ends.end(), mEnds.begin(), mEnds.begin() + lo);
+    for (size_t i = lo; i < runs.size(); ++i)
+        ends.push_back((i == 0 ? 0 : ends[i - 1]) + runs[i].mLength);
+
+    mRuns.swap(runs);
+    mEnds.swap(ends);
+}
+
+/**
+ * Given an index, this method throws an std::out_of_range with the index as
+ * its message if index is out of bounds or is a no-op otherwise.
+ * This operation provides strong exception safety.
+ *
+ * @param index index to check
+ */
+template <typename T>
+void RleList<T>::rangeCheck(size_t index) const throw (std::out_of_range) {
+    if (index >= size()) {
+        std::ostringstream os;
+        os << index;
+        throw std::out_of_range(os.str());
+    }
+}
+
+#endif
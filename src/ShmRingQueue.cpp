@@ -0,0 +1,680 @@
+#ifndef _SHM_RING_QUEUE_CPP_
+#define _SHM_RING_QUEUE_CPP_
+
+#include "../include/ShmRingQueue.h"
+#include <atomic>
+#include <cerrno>                   // For errno
+#include <chrono>                   // For std::chrono::milliseconds
+#include <cstdlib>                  // For size_t
+#include <algorithm>                // For std::min
+#include <new>                      // For placement new
+#include <stdexcept>                // For std::runtime_error
+#include <stdint.h>                 // For int64_t, uint64_t
+#include <system_error>             // For std::system_error
+#include <thread>                   // For std::this_thread
+#include <type_traits>              // For std::is_trivially_copyable
+#include <fcntl.h>                  // For O_CREAT, O_EXCL, O_RDWR
+#include <signal.h>                 // For kill
+#include <sys/mman.h>               // For mmap, munmap, shm_open, shm_unlink
+#include <sys/stat.h>               // For fstat
+#include <unistd.h>                 // For close, ftruncate, getpid
+
+
+/**
+ * Attaches to the shared-memory segment called name, creating it if it
+ * does not exist yet. name is a POSIX shared-memory name such as
+ * "/sidecar-events". The capacity is rounded up to a power of two, and
+ * is at least 2. Throws std::system_error if the segment cannot be
+ * opened or mapped and std::runtime_error if it was created for another
+ * element type, capacity or mode, or if its peer table is full.
+ *
+ * @param name name of the segment
+ * @param capacity minimum number of elements the queue can hold
+ * @param mode sharing discipline of the ring
+ */
+template <typename T>
+ShmRingQueue<T>::ShmRingQueue(const std::string& name, size_t capacity, Mode mode)
+        : mFd(-1), mLength(bytesFor(roundCapacity(capacity), mode)), mHeader(0), mPeers(0), mSelf(0),
+          mRing(0), mMask(roundCapacity(capacity) - 1), mMode(mode), mHeadCache(0), mTailCache(0) {
+    static_assert(std::is_trivially_copyable<T>::value, "ShmRingQueue requires a trivially copyable type");
+    // Only lock-free atomics are plain memory that another process can share
+    static_assert(ATOMIC_INT_LOCK_FREE == 2 && ATOMIC_LLONG_LOCK_FREE == 2,
+                  "ShmRingQueue requires lock-free atomics");
+
+    bool created = true;
+    mFd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (mFd < 0 && errno == EEXIST) {
+        created = false;
+        mFd = shm_open(name.c_str(), O_RDWR, 0600);
+    }
+    if (mFd < 0)
+        throwSystemError("shm_open");
+
+    try {
+        if (created) {
+            if (ftruncate(mFd, mLength) != 0)
+                throwSystemError("ftruncate");
+        } else {
+            // The creator sizes the segment right after creating it
+            struct stat info;
+            for (int attempt = 0; ; ++attempt) {
+                if (fstat(mFd, &info) != 0)
+                    throwSystemError("fstat");
+                if (info.st_size != 0)
+                    break;
+                awaitCreator(attempt, name);
+            }
+            if (static_cast<size_t>(info.st_size) != mLength)
+                throw std::runtime_error(name + ": incompatible ShmRingQueue segment");
+        }
+
+        void* ptr = mmap(0, mLength, PROT_READ | PROT_WRITE, MAP_SHARED, mFd, 0);
+        if (ptr == MAP_FAILED)
+            throwSystemError("mmap");
+        mHeader = static_cast<Header*>(ptr);
+
+        if (created)
+            initialize(mMask + 1, mode);
+        else
+            validate(name, mMask + 1, mode);
+
+        char* base = static_cast<char*>(ptr);
+        mPeers = reinterpret_cast<Peer*>(base + mHeader->mPeersOffset);
+        mRing = base + mHeader->mCellsOffset;
+        mHeadCache = mHeader->mDequeuePos.load(std::memory_order_acquire);
+        mTailCache = mHeader->mEnqueuePos.load(std::memory_order_acquire);
+        attach(name);
+    } catch (...) {
+        if (mHeader)
+            munmap(mHeader, mLength);
+        close(mFd);
+        // Nobody else can use a segment that was never published
+        if (created)
+            shm_unlink(name.c_str());
+        throw;
+    }
+}
+
+/**
+ * Removes this peer from the segment and unmaps it. The segment itself
+ * stays until remove() is called.
+ * This operation is a no-throw.
+ */
+template <typename T>
+ShmRingQueue<T>::~ShmRingQueue() throw () {
+    mSelf->mClaim.store(0, std::memory_order_relaxed);
+    mSelf->mPid.store(0, std::memory_order_release);
+    munmap(mHeader, mLength);
+    close(mFd);
+}
+
+/**
+ * Removes the front element from this queue. Throws Underflow if this queue
+ * is empty.
+ */
+template <typename T>
+void ShmRingQueue<T>::dequeue() {
+    T discarded;
+    if (!tryDequeue(discarded))
+        throw typename QueueBase<T>::Underflow();
+}
+
+/**
+ * Removes the front element and returns it. Throws Underflow if this queue
+ * is empty.
+ *
+ * @return
+ */
+template <typename T>
+T ShmRingQueue<T>::dequeueValue() {
+    T value;
+    if (!tryDequeue(value))
+        throw typename QueueBase<T>::Underflow();
+    return value;
+}
+
+/**
+ * Adds value to the end of this queue, yielding the processor while the
+ * queue is full.
+ *
+ * @param
+ */
+template <typename T>
+void ShmRingQueue<T>::enqueue(const T& value) {
+    while (!tryEnqueue(value))
+        std::this_thread::yield();
+}
+
+/**
+ * Returns a reference to the front of this queue. Throws Underflow if this
+ * queue is empty. The reference is only stable while no other consumer
+ * runs.
+ *
+ * @return
+ */
+template <typename T>
+const T& ShmRingQueue<T>::front() const {
+    if (mMode == SPSC) {
+        uint64_t head = mHeader->mDequeuePos.load(std::memory_order_relaxed);
+        if (head == mHeader->mEnqueuePos.load(std::memory_order_acquire))
+            throw typename QueueBase<T>::Underflow();
+        return *slot(head);
+    }
+
+    for (;;) {
+        uint64_t pos = mHeader->mDequeuePos.load(std::memory_order_relaxed);
+        const Cell* front = cell(pos);
+        uint64_t sequence = front->mSequence.load(std::memory_order_acquire);
+        if (sequence == pos + 1)
+            return front->mValue;
+        if (sequence != skipped(pos + 1))
+            throw typename QueueBase<T>::Underflow();
+        skipFront(pos);
+    }
+}
+
+/**
+ * Returns the number of elements in this queue.
+ *
+ * @return
+ */
+template <typename T>
+size_t ShmRingQueue<T>::size() const {
+    // The dequeue position is read first so that the difference can never be
+    // negative
+    uint64_t head = mHeader->mDequeuePos.load(std::memory_order_acquire);
+    uint64_t tail = mHeader->mEnqueuePos.load(std::memory_order_acquire);
+    return std::min<uint64_t>(tail - head, capacity());
+}
+
+/**
+ * Copies the front element into out, removes it and returns true, or
+ * returns false if this queue is empty.
+ *
+ * @param out receives the front element
+ * @return
+ */
+template <typename T>
+bool ShmRingQueue<T>::tryDequeue(T& out) {
+    if (mMode == SPSC) {
+        uint64_t head = mHeader->mDequeuePos.load(std::memory_order_relaxed);
+        if (head == mTailCache) {
+            mTailCache = mHeader->mEnqueuePos.load(std::memory_order_acquire);
+            if (head == mTailCache)
+                return false;
+        }
+        out = *slot(head);
+        mHeader->mDequeuePos.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    uint64_t pos;
+    Cell* front = claimFront(pos);
+    if (!front)
+        return false;
+    out = front->mValue;
+    releaseFront(pos);
+    return true;
+}
+
+/**
+ * Adds value to the end of this queue and returns true, or returns false
+ * if the queue is full.
+ *
+ * @param value value to enqueue
+ * @return
+ */
+template <typename T>
+bool ShmRingQueue<T>::tryEnqueue(const T& value) {
+    if (mMode == SPSC) {
+        uint64_t tail = mHeader->mEnqueuePos.load(std::memory_order_relaxed);
+        if (tail - mHeadCache > mMask) {
+            mHeadCache = mHeader->mDequeuePos.load(std::memory_order_acquire);
+            if (tail - mHeadCache > mMask)
+                return false;
+        }
+        *slot(tail) = value;
+        mHeader->mEnqueuePos.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    uint64_t pos = mHeader->mEnqueuePos.load(std::memory_order_relaxed);
+    Cell* back;
+    for (;;) {
+        back = cell(pos);
+        uint64_t sequence = back->mSequence.load(std::memory_order_acquire);
+        int64_t diff = static_cast<int64_t>(sequence) - static_cast<int64_t>(pos);
+        if (diff == 0) {
+            // The claim is recorded before it is made and marked as won after,
+            // so that recover() can tell a slot this peer owns from one it
+            // merely tried to take
+            claim(pos, kEnqueue);
+            if (mHeader->mEnqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_release,
+                                                           std::memory_order_relaxed)) {
+                won(pos, kEnqueue);
+                break;
+            }
+        } else if (diff < 0) {
+            unclaim();
+            return false;           // The slot still holds last lap's element
+        } else {
+            pos = mHeader->mEnqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    back->mValue = value;
+    back->mSequence.store(pos + 1, std::memory_order_release);
+    unclaim();
+    return true;
+}
+
+/**
+ * Returns the number of elements this queue can hold.
+ * This operation is a no-throw.
+ *
+ * @return
+ */
+template <typename T>
+size_t ShmRingQueue<T>::capacity() const throw () {
+    return mMask + 1;
+}
+
+/**
+ * Returns the sharing discipline of the ring.
+ * This operation is a no-throw.
+ *
+ * @return
+ */
+template <typename T>
+typename ShmRingQueue<T>::Mode ShmRingQueue<T>::mode() const throw () {
+    return mMode;
+}
+
+/**
+ * Returns the number of registered peers whose process has exited
+ * without detaching.
+ *
+ * @return
+ */
+template <typename T>
+size_t ShmRingQueue<T>::deadPeers() const {
+    size_t dead = 0;
+    for (size_t i = 0; i < kMaxPeers; ++i) {
+        int pid = mPeers[i].mPid.load(std::memory_order_acquire);
+        if (pid > 0 && !alive(pid))
+            ++dead;
+    }
+    return dead;
+}
+
+/**
+ * Removes every peer whose process has exited without detaching, and
+ * repairs the slots it left half claimed. A peer that died while racing a
+ * live peer for a slot is kept until a later call can tell which of the two
+ * got it. Returns the number of peers removed.
+ *
+ * @return
+ */
+template <typename T>
+size_t ShmRingQueue<T>::recover() {
+    size_t removed = 0;
+    for (size_t i = 0; i < kMaxPeers; ++i) {
+        Peer& peer = mPeers[i];
+        int pid = peer.mPid.load(std::memory_order_acquire);
+        if (pid <= 0 || alive(pid))
+            continue;
+        // Whoever marks the entry first removes the peer; the entry cannot be
+        // reused before its claim has been dealt with
+        if (!peer.mPid.compare_exchange_strong(pid, kRecovering, std::memory_order_acq_rel))
+            continue;
+        if (mMode == MPMC && !repair(&peer, peer.mClaim.load(std::memory_order_acquire))) {
+            peer.mPid.store(pid, std::memory_order_release);
+            continue;
+        }
+        peer.mClaim.store(0, std::memory_order_relaxed);
+        peer.mPid.store(0, std::memory_order_release);
+        ++removed;
+    }
+    return removed;
+}
+
+/**
+ * Removes the name of the segment, which is destroyed once every process
+ * has unmapped it. Throws std::system_error if the name cannot be
+ * removed.
+ *
+ * @param name name of the segment
+ */
+template <typename T>
+void ShmRingQueue<T>::remove(const std::string& name) {
+    if (shm_unlink(name.c_str()) != 0)
+        throwSystemError("shm_unlink");
+}
+
+/**
+ * Fills in the header, peer table and ring of a new segment and
+ * publishes it.
+ *
+ * @param capacity
+ * @param mode
+ */
+template <typename T>
+void ShmRingQueue<T>::initialize(size_t capacity, Mode mode) {
+    // ftruncate zero filled the segment, which leaves nothing to release
+    Header* header = new (mHeader) Header();
+    header->mVersion = kVersion;
+    header->mElementSize = sizeof(T);
+    header->mMode = mode;
+    header->mCapacity = capacity;
+    header->mPeersOffset = sizeof(Header);
+    header->mCellsOffset = sizeof(Header) + kMaxPeers * sizeof(Peer);
+    header->mEnqueuePos.store(0, std::memory_order_relaxed);
+    header->mDequeuePos.store(0, std::memory_order_relaxed);
+
+    char* base = reinterpret_cast<char*>(header);
+    Peer* peers = reinterpret_cast<Peer*>(base + header->mPeersOffset);
+    for (size_t i = 0; i < kMaxPeers; ++i) {
+        new (&peers[i].mPid) std::atomic<int>(0);
+        new (&peers[i].mClaim) std::atomic<uint64_t>(0);
+    }
+    if (mode == MPMC) {
+        Cell* cells = reinterpret_cast<Cell*>(base + header->mCellsOffset);
+        for (size_t i = 0; i < capacity; ++i)
+            new (&cells[i].mSequence) std::atomic<uint64_t>(i);
+    }
+
+    header->mMagic.store(kMagic, std::memory_order_release);
+}
+
+/**
+ * Waits for the creator to publish the segment and checks that it holds
+ * a ring of this element type, capacity and mode.
+ *
+ * @param name
+ * @param capacity
+ * @param mode
+ */
+template <typename T>
+void ShmRingQueue<T>::validate(const std::string& name, size_t capacity, Mode mode) const {
+    for (int attempt = 0; mHeader->mMagic.load(std::memory_order_acquire) != kMagic; ++attempt)
+        awaitCreator(attempt, name);
+
+    if (mHeader->mVersion != kVersion || mHeader->mElementSize != sizeof(T) || mHeader->mMode != mode ||
+        mHeader->mCapacity != capacity)
+        throw std::runtime_error(name + ": incompatible ShmRingQueue segment");
+}
+
+/**
+ * Registers this peer in a free entry of the peer table, removing dead
+ * peers first if the table is full.
+ *
+ * @param name
+ */
+template <typename T>
+void ShmRingQueue<T>::attach(const std::string& name) {
+    int pid = getpid();
+    for (int pass = 0; pass < 2; ++pass) {
+        for (size_t i = 0; i < kMaxPeers; ++i) {
+            int expected = 0;
+            if (mPeers[i].mPid.compare_exchange_strong(expected, pid, std::memory_order_acq_rel)) {
+                mSelf = &mPeers[i];
+                return;
+            }
+        }
+        recover();
+    }
+    throw std::runtime_error(name + ": too many ShmRingQueue peers");
+}
+
+/**
+ * Returns the MPMC slot of position pos.
+ * This operation is a no-throw.
+ *
+ * @param pos
+ * @return
+ */
+template <typename T>
+typename ShmRingQueue<T>::Cell* ShmRingQueue<T>::cell(uint64_t pos) const throw () {
+    return reinterpret_cast<Cell*>(mRing) + (pos & mMask);
+}
+
+/**
+ * Returns the SPSC slot of position pos.
+ * This operation is a no-throw.
+ *
+ * @param pos
+ * @return
+ */
+template <typename T>
+T* ShmRingQueue<T>::slot(uint64_t pos) const throw () {
+    return reinterpret_cast<T*>(mRing) + (pos & mMask);
+}
+
+/**
+ * Records that this peer is about to claim pos for role.
+ * This operation is a no-throw.
+ *
+ * @param pos
+ * @param role
+ */
+template <typename T>
+void ShmRingQueue<T>::claim(uint64_t pos, int role) const throw () {
+    mSelf->mClaim.store(pos << 3 | role, std::memory_order_release);
+}
+
+/**
+ * Records that this peer has claimed pos for role.
+ * This operation is a no-throw.
+ *
+ * @param pos
+ * @param role
+ */
+template <typename T>
+void ShmRingQueue<T>::won(uint64_t pos, int role) const throw () {
+    mSelf->mClaim.store(pos << 3 | kWon | role, std::memory_order_release);
+}
+
+/**
+ * Records that this peer is idle.
+ * This operation is a no-throw.
+ */
+template <typename T>
+void ShmRingQueue<T>::unclaim() const throw () {
+    mSelf->mClaim.store(0, std::memory_order_release);
+}
+
+/**
+ * Claims the MPMC slot at the dequeue position, passing over slots left
+ * by dead producers, or returns null if the queue is empty. On success pos
+ * holds the claimed position.
+ *
+ * @param pos
+ * @return
+ */
+template <typename T>
+typename ShmRingQueue<T>::Cell* ShmRingQueue<T>::claimFront(uint64_t& pos) const {
+    pos = mHeader->mDequeuePos.load(std::memory_order_relaxed);
+    for (;;) {
+        Cell* front = cell(pos);
+        uint64_t sequence = front->mSequence.load(std::memory_order_acquire);
+        if (sequence == skipped(pos + 1)) {
+            skipFront(pos);
+            pos = mHeader->mDequeuePos.load(std::memory_order_relaxed);
+            continue;
+        }
+
+        int64_t diff = static_cast<int64_t>(sequence) - static_cast<int64_t>(pos + 1);
+        if (diff == 0) {
+            claim(pos, kDequeue);
+            if (mHeader->mDequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_release,
+                                                           std::memory_order_relaxed)) {
+                won(pos, kDequeue);
+                return front;
+            }
+        } else if (diff < 0) {
+            unclaim();
+            return 0;               // The slot has not been filled yet
+        } else {
+            pos = mHeader->mDequeuePos.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+/**
+ * Hands the claimed MPMC slot at pos back to producers.
+ *
+ * @param pos
+ */
+template <typename T>
+void ShmRingQueue<T>::releaseFront(uint64_t pos) const {
+    cell(pos)->mSequence.store(pos + mMask + 1, std::memory_order_release);
+    unclaim();
+}
+
+/**
+ * Claims and releases the slot at pos, which a dead producer left
+ * behind, unless another consumer got to it first.
+ *
+ * @param pos
+ */
+template <typename T>
+void ShmRingQueue<T>::skipFront(uint64_t pos) const {
+    claim(pos, kDequeue);
+    if (mHeader->mDequeuePos.compare_exchange_strong(pos, pos + 1, std::memory_order_release,
+                                                     std::memory_order_relaxed)) {
+        won(pos, kDequeue);
+        releaseFront(pos);
+    } else {
+        unclaim();
+    }
+}
+
+/**
+ * Repairs the slot described by claim, which a dead peer recorded, if the
+ * peer had claimed it. Returns false if a live peer is racing for the same
+ * slot, in which case the owner cannot be told yet.
+ *
+ * @param dead
+ * @param claim
+ * @return
+ */
+template <typename T>
+bool ShmRingQueue<T>::repair(const Peer* dead, uint64_t claim) {
+    if (claim == 0)
+        return true;
+    uint64_t pos = claim >> 3;
+    bool producer = (claim & 3) == kEnqueue;
+
+    // Reading the position synchronizes with the claim that moved it past
+    // pos, so a live peer that made that claim is visible in the table below
+    const std::atomic<uint64_t>& next = producer ? mHeader->mEnqueuePos : mHeader->mDequeuePos;
+    if (next.load(std::memory_order_acquire) <= pos)
+        return true;                // The claim was never made
+
+    // A claim that is not marked as won may have lost to a live peer, which
+    // records the same claim before its compare-and-swap
+    if (!(claim & kWon)) {
+        for (size_t i = 0; i < kMaxPeers; ++i) {
+            const Peer& peer = mPeers[i];
+            uint64_t other = peer.mClaim.load(std::memory_order_acquire);
+            if (&peer == dead || (other | kWon) != (claim | kWon))
+                continue;
+            int pid = peer.mPid.load(std::memory_order_acquire);
+            if (pid <= 0 || !alive(pid))
+                continue;
+            return (other & kWon) != 0;     // Either the live peer owns the slot or nobody knows yet
+        }
+    }
+
+    // The compare-and-swap fails if the owner finished with the slot after
+    // all, so the repair never undoes a completed operation
+    std::atomic<uint64_t>& sequence = cell(pos)->mSequence;
+    if (producer) {
+        uint64_t expected = pos;
+        sequence.compare_exchange_strong(expected, skipped(pos + 1), std::memory_order_acq_rel);
+    } else {
+        uint64_t expected = pos + 1;
+        if (!sequence.compare_exchange_strong(expected, pos + mMask + 1, std::memory_order_acq_rel)) {
+            expected = skipped(pos + 1);
+            sequence.compare_exchange_strong(expected, pos + mMask + 1, std::memory_order_acq_rel);
+        }
+    }
+    return true;
+}
+
+/**
+ * Returns the sequence number marking a slot that consumers pass over
+ * instead of sequence.
+ *
+ * @param sequence
+ * @return
+ */
+template <typename T>
+uint64_t ShmRingQueue<T>::skipped(uint64_t sequence) throw () {
+    return sequence | static_cast<uint64_t>(1) << 63;
+}
+
+/**
+ * Returns true if the process with the given id still exists.
+ *
+ * @param pid
+ * @return
+ */
+template <typename T>
+bool ShmRingQueue<T>::alive(int pid) throw () {
+    return kill(pid, 0) == 0 || errno != ESRCH;
+}
+
+/**
+ * Returns the segment length needed for a ring of capacity elements.
+ *
+ * @param capacity
+ * @param mode
+ * @return
+ */
+template <typename T>
+size_t ShmRingQueue<T>::bytesFor(size_t capacity, Mode mode) throw () {
+    size_t slotSize = mode == MPMC ? sizeof(Cell) : sizeof(T);
+    return sizeof(Header) + kMaxPeers * sizeof(Peer) + capacity * slotSize;
+}
+
+/**
+ * Returns the smallest power of two that is at least capacity and 2.
+ *
+ * @param capacity
+ * @return
+ */
+template <typename T>
+size_t ShmRingQueue<T>::roundCapacity(size_t capacity) {
+    size_t rounded = 2;
+    while (rounded < capacity)
+        rounded <<= 1;
+    return rounded;
+}
+
+/**
+ * Sleeps for a moment while waiting for the creator of the segment, or
+ * throws std::runtime_error once attempt reaches kAttachTries.
+ *
+ * @param attempt
+ * @param name
+ */
+template <typename T>
+void ShmRingQueue<T>::awaitCreator(int attempt, const std::string& name) {
+    if (attempt >= kAttachTries)
+        throw std::runtime_error(name + ": ShmRingQueue segment was never initialized");
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+}
+
+/**
+ * Throws an std::system_error for the current errno, naming the failed
+ * call in its message.
+ *
+ * @param call
+ */
+template <typename T>
+void ShmRingQueue<T>::throwSystemError(const char* call) {
+    throw std::system_error(errno, std::generic_category(), call);
+}
+
+#endif
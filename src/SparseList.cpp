@@ -0,0 +1,306 @@
+#ifndef _SPARSE_LIST_CPP_
+#define _SPARSE_LIST_CPP_
+
+#include "../include/SparseList.h"
+#include "../include/SparseListIterators.h"
+#include <cstdlib>                  // For size_t
+#include <stdexcept>                // For std::out_of_range
+#include <sstream>                  // For std::ostringstream
+#include <vector>
+
+
+/**
+ * Initializes the SparseList with size holes. If size is not supplied, an
+ * empty SparseList is created. No storage is used for the holes.
+ * This operation provides strong exception safety.
+ *
+ * @param size size of the SparseList to create
+ */
+template <typename T>
+SparseList<T>::SparseList(size_t size) : mSize(size), mDefault() {
+}
+
+/**
+ * Adds value to the end of this SparseList in amortized constant time.
+ * This operation provides strong exception safety.
+ *
+ * @param value value to append to this SparseList
+ */
+template <typename T>
+void SparseList<T>::add(const_reference value) {
+    mEntries.push_back(Entry(mSize, value));
+    ++mSize;
+}
+
+/**
+ * Inserts value at the specified index. All elements at or to the right of
+ * index are shifted down by one spot. If index is past the end, this
+ * SparseList is enlarged and the gap is left as holes.
+ * This operation provides basic exception safety.
+ *
+ * @param index index at which to insert value
+ * @param value the element to insert
+ */
+template <typename T>
+void SparseList<T>::add(size_t index, const_reference value) {
+    if (index >= mSize) {
+        mEntries.push_back(Entry(index, value));
+        mSize = index + 1;
+        return;
+    }
+
+    // Insert first so a throwing copy leaves the indices untouched
+    EntryIterator pos = mEntries.insert(lowerBound(index), Entry(index, value));
+    shift(pos + 1, 1);
+    ++mSize;
+}
+
+/**
+ * Empties this SparseList.
+ * This operation is a no-throw.
+ */
+template <typename T>
+void SparseList<T>::clear() throw () {
+    mEntries.clear();
+    mSize = 0;
+}
+
+/**
+ * Returns true if the element at index was explicitly written and false if
+ * it is a hole or out of bounds.
+ * This operation is a no-throw.
+ *
+ * @param index
+ * @return
+ */
+template <typename T>
+bool SparseList<T>::contains(size_t index) const throw () {
+    EntryConstIterator pos = lowerBound(index);
+    return pos != mEntries.end() && pos->mIndex == index;
+}
+
+/**
+ * Returns a constant reference to the element stored at the provided index,
+ * or to a default value if the index is a hole. If index is out of bounds,
+ * an std::out_of_range exception is thrown with the index as its message.
+ * This operation provides strong exception safety.
+ *
+ * @param index index of the element to return
+ * @return constant reference to the element at the index.
+ */
+template <typename T>
+typename SparseList<T>::const_reference SparseList<T>::get(size_t index) const throw (std::out_of_range) {
+    rangeCheck(index);
+    EntryConstIterator pos = lowerBound(index);
+    return pos != mEntries.end() && pos->mIndex == index ? pos->mValue : mDefault;
+}
+
+/**
+ * Returns true if this SparseList is logically equal to rhs, treating
+ * holes as default values.
+ *
+ * @param rhs
+ * @return
+ */
+template <typename T>
+bool SparseList<T>::operator==(const SparseList<T>& rhs) const {
+    if (mSize != rhs.mSize)
+        return false;
+
+    EntryConstIterator lhsIter = mEntries.begin();
+    EntryConstIterator rhsIter = rhs.mEntries.begin();
+    while (lhsIter != mEntries.end() || rhsIter != rhs.mEntries.end()) {
+        if (rhsIter == rhs.mEntries.end()
+                || (lhsIter != mEntries.end() && lhsIter->mIndex < rhsIter->mIndex)) {
+            if (!(lhsIter->mValue == mDefault))
+                return false;
+            ++lhsIter;
+        } else if (lhsIter == mEntries.end() || rhsIter->mIndex < lhsIter->mIndex) {
+            if (!(rhsIter->mValue == mDefault))
+                return false;
+            ++rhsIter;
+        } else {
+            if (!(lhsIter->mValue == rhsIter->mValue))
+                return false;
+            ++lhsIter;
+            ++rhsIter;
+        }
+    }
+    return true;
+}
+
+/**
+ * Returns false if this SparseList is logically equal to rhs.
+ *
+ * @param rhs
+ * @return
+ */
+template <typename T>
+bool SparseList<T>::operator!=(const SparseList<T>& rhs) const {
+    return !(*this == rhs);
+}
+
+/**
+ * Returns a constant iterator to the first present entry.
+ * This operation is a no-throw.
+ *
+ * @return
+ */
+template <typename T>
+typename SparseList<T>::const_iterator SparseList<T>::begin() const throw () {
+    return const_iterator(mEntries.begin());
+}
+
+/**
+ * Returns a constant iterator past the last present entry.
+ * This operation is a no-throw.
+ *
+ * @return
+ */
+template <typename T>
+typename SparseList<T>::const_iterator SparseList<T>::end() const throw () {
+    return const_iterator(mEntries.end());
+}
+
+/**
+ * Returns true if this SparseList is empty and false otherwise.
+ * This operation is a no-throw.
+ *
+ * @return
+ */
+template <typename T>
+bool SparseList<T>::isEmpty() const throw () {
+    return mSize == 0;
+}
+
+/**
+ * Removes and returns the element at the specified index. If index is out
+ * of bounds, an std::out_of_range exception is thrown with index as its
+ * message.
+ * This operation provides basic exception safety.
+ *
+ * @param index index of the object to remove.
+ * @return copy of the just removed object.
+ */
+template <typename T>
+typename SparseList<T>::value_type SparseList<T>::remove(size_t index) {
+    rangeCheck(index);
+    EntryIterator pos = lowerBound(index);
+    if (pos == mEntries.end() || pos->mIndex != index) {
+        value_type result = mDefault;
+        shift(pos, static_cast<size_t>(-1));
+        --mSize;
+        return result;
+    }
+
+    value_type result = pos->mValue;
+    pos = mEntries.erase(pos);
+    shift(pos, static_cast<size_t>(-1));
+    --mSize;
+    return result;
+}
+
+/**
+ * Sets the element at the specified index to the provided value, turning a
+ * hole into a present entry if needed. If index is out of bounds, an
+ * std::out_of_range exception is thrown with the index as its message.
+ * This operation provides basic exception safety.
+ *
+ * @param index index of the object to set
+ * @param value the new value
+ */
+template <typename T>
+void SparseList<T>::set(size_t index, const_reference value) {
+    rangeCheck(index);
+    EntryIterator pos = lowerBound(index);
+    if (pos != mEntries.end() && pos->mIndex == index)
+        pos->mValue = value;
+    else
+        mEntries.insert(pos, Entry(index, value));
+}
+
+/**
+ * Return the size of this SparseList, holes included.
+ * This operation is a no-throw.
+ *
+ * @return
+ */
+template <typename T>
+size_t SparseList<T>::size() const throw () {
+    return mSize;
+}
+
+/**
+ * Returns the number of present entries.
+ * This operation is a no-throw.
+ *
+ * @return
+ */
+template <typename T>
+size_t SparseList<T>::entryCount() const throw () {
+    return mEntries.size();
+}
+
+/**
+ * Returns the first entry whose index is not less than index.
+ *
+ * @param index
+ * @return
+ */
+template <typename T>
+typename SparseList<T>::EntryIterator SparseList<T>::lowerBound(size_t index) throw () {
+    EntryIterator first = mEntries.begin();
+    size_t count = mEntries.size();
+    while (count > 0) {
+        size_t half = count / 2;
+        if (first[half].mIndex < index) {
+            first += half + 1;
+            count -= half + 1;
+        } else {
+            count = half;
+        }
+    }
+    return first;
+}
+
+/**
+ * Returns the first entry whose index is not less than index.
+ *
+ * @param index
+ * @return
+ */
+template <typename T>
+typename SparseList<T>::EntryConstIterator SparseList<T>::lowerBound(size_t index) const throw () {
+    return const_cast<SparseList<T>*>(this)->lowerBound(index);
+}
+
+/**
+ * Adds delta to the index of every entry starting at first. Shifting left is
+ * expressed as adding the two's complement of the distance.
+ *
+ * @param first
+ * @param delta
+ */
+template <typename T>
+void SparseList<T>::shift(EntryIterator first, size_t delta) throw () {
+    for (; first != mEntries.end(); ++first)
+        first->mIndex += delta;
+}
+
+/**
+ * Given an index, this method throws an std::out_of_range with the index as
+ * its message if index is out of bounds or is a no-op otherwise.
+ * This operation provides strong exception safety.
+ *
+ * @param index index to check
+ */
+template <typename T>
+void SparseList<T>::rangeCheck(size_t index) const throw (std::out_of_range) {
+    if (index >= mSize) {
+        std::ostringstream os;
+        os << index;
+        throw std::out_of_range(os.str());
+    }
+}
+
+#endif
@@ -0,0 +1,230 @@
+#ifndef _SPSC_RING_QUEUE_CPP_
+#define _SPSC_RING_QUEUE_CPP_
+
+#include "../include/SpscRingQueue.h"
+#include "../include/ArrayStorage.h"
+#include <atomic>
+#include <cstdlib>                  // For size_t
+#include <algorithm>                // For std::min
+#include <thread>                   // For std::this_thread::yield
+#include <utility>                  // For std::move
+
+
+/**
+ * Initializes an empty queue that holds up to capacity elements. The
+ * capacity is rounded up to a power of two, and is at least 2.
+ *
+ * @param capacity minimum number of elements the queue can hold
+ */
+template <typename T>
+SpscRingQueue<T>::SpscRingQueue(size_t capacity)
+        : mSlots(roundCapacity(capacity), ArrayStorage()), mMask(roundCapacity(capacity) - 1),
+          mTail(0), mHeadCache(0), mHead(0), mTailCache(0) {
+}
+
+/**
+ * Removes the front element from this queue. Throws Underflow if this queue
+ * is empty. Consumer only.
+ */
+template <typename T>
+void SpscRingQueue<T>::dequeue() {
+    size_t head = mHead.load(std::memory_order_relaxed);
+    if (head == mTailCache) {
+        mTailCache = mTail.load(std::memory_order_acquire);
+        if (head == mTailCache)
+            throw typename QueueBase<T>::Underflow();
+    }
+    mSlots[head & mMask] = T();     // Release whatever the element holds
+    mHead.store(head + 1, std::memory_order_release);
+}
+
+/**
+ * Removes the front element and returns it, moved out rather than copied.
+ * Throws Underflow if this queue is empty. Consumer only.
+ *
+ * @return
+ */
+template <typename T>
+T SpscRingQueue<T>::dequeueValue() {
+    size_t head = mHead.load(std::memory_order_relaxed);
+    if (head == mTailCache) {
+        mTailCache = mTail.load(std::memory_order_acquire);
+        if (head == mTailCache)
+            throw typename QueueBase<T>::Underflow();
+    }
+    T value(std::move(mSlots[head & mMask]));
+    mHead.store(head + 1, std::memory_order_release);
+    return value;
+}
+
+/**
+ * Adds value to the end of this queue, yielding the processor while the
+ * queue is full. Producer only.
+ *
+ * @param
+ */
+template <typename T>
+void SpscRingQueue<T>::enqueue(const T& value) {
+    while (!tryEnqueue(value))
+        std::this_thread::yield();
+}
+
+/**
+ * Returns a reference to the front of this queue. Throws Underflow if this
+ * queue is empty. Consumer only.
+ *
+ * @return
+ */
+template <typename T>
+const T& SpscRingQueue<T>::front() const {
+    size_t head = mHead.load(std::memory_order_relaxed);
+    if (head == mTail.load(std::memory_order_acquire))
+        throw typename QueueBase<T>::Underflow();
+    return mSlots[head & mMask];
+}
+
+/**
+ * Returns the number of elements in this queue.
+ *
+ * @return
+ */
+template <typename T>
+size_t SpscRingQueue<T>::size() const {
+    // The head is read first so that the difference can never be negative
+    size_t head = mHead.load(std::memory_order_acquire);
+    size_t tail = mTail.load(std::memory_order_acquire);
+    return std::min(tail - head, capacity());
+}
+
+/**
+ * Moves the front element into out, removes it and returns true, or
+ * returns false if this queue is empty. Consumer only.
+ *
+ * @param out receives the front element
+ * @return
+ */
+template <typename T>
+bool SpscRingQueue<T>::tryDequeue(T& out) {
+    size_t head = mHead.load(std::memory_order_relaxed);
+    if (head == mTailCache) {
+        mTailCache = mTail.load(std::memory_order_acquire);
+        if (head == mTailCache)
+            return false;
+    }
+    out = std::move(mSlots[head & mMask]);
+    mHead.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+/**
+ * Adds the count elements of values to the end of this queue, in order,
+ * yielding the processor while the queue is full. Each run of elements
+ * that fits is published at once. Producer only.
+ *
+ * @param values elements to enqueue
+ * @param count number of elements to enqueue
+ */
+template <typename T>
+void SpscRingQueue<T>::enqueueBulk(const T* values, size_t count) {
+    while (count > 0) {
+        size_t added = tryEnqueueBulk(values, count);
+        if (added == 0)
+            std::this_thread::yield();
+        values += added;
+        count -= added;
+    }
+}
+
+/**
+ * Moves up to count elements from the front of this queue into out, in
+ * dequeue order, and removes them with a single store. Returns the number
+ * of elements moved, which is less than count only if the queue ran empty.
+ * Consumer only.
+ *
+ * @param out receives the dequeued elements
+ * @param count maximum number of elements to dequeue
+ * @return
+ */
+template <typename T>
+size_t SpscRingQueue<T>::dequeueBulk(T* out, size_t count) {
+    size_t head = mHead.load(std::memory_order_relaxed);
+    if (mTailCache - head < count)
+        mTailCache = mTail.load(std::memory_order_acquire);
+
+    size_t dequeued = std::min(count, mTailCache - head);
+    for (size_t i = 0; i < dequeued; ++i)
+        out[i] = std::move(mSlots[(head + i) & mMask]);
+    if (dequeued > 0)
+        mHead.store(head + dequeued, std::memory_order_release);
+    return dequeued;
+}
+
+/**
+ * Adds value to the end of this queue and returns true, or returns false
+ * if the queue is full. Producer only.
+ *
+ * @param value value to enqueue
+ * @return
+ */
+template <typename T>
+bool SpscRingQueue<T>::tryEnqueue(const T& value) {
+    size_t tail = mTail.load(std::memory_order_relaxed);
+    if (tail - mHeadCache > mMask) {
+        mHeadCache = mHead.load(std::memory_order_acquire);
+        if (tail - mHeadCache > mMask)
+            return false;
+    }
+    mSlots[tail & mMask] = value;
+    mTail.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+/**
+ * Adds as many of the count elements of values as fit to the end of this
+ * queue, publishing them with a single store, and returns how many were
+ * added. Producer only.
+ *
+ * @param values elements to enqueue
+ * @param count number of elements to enqueue
+ * @return
+ */
+template <typename T>
+size_t SpscRingQueue<T>::tryEnqueueBulk(const T* values, size_t count) {
+    size_t tail = mTail.load(std::memory_order_relaxed);
+    if (capacity() - (tail - mHeadCache) < count)
+        mHeadCache = mHead.load(std::memory_order_acquire);
+
+    size_t added = std::min(count, capacity() - (tail - mHeadCache));
+    for (size_t i = 0; i < added; ++i)
+        mSlots[(tail + i) & mMask] = values[i];
+    if (added > 0)
+        mTail.store(tail + added, std::memory_order_release);
+    return added;
+}
+
+/**
+ * Returns the number of elements this queue can hold.
+ * This operation is a no-throw.
+ *
+ * @return
+ */
+template <typename T>
+size_t SpscRingQueue<T>::capacity() const throw () {
+    return mMask + 1;
+}
+
+/**
+ * Returns the smallest power of two that is at least capacity and 2.
+ *
+ * @param capacity
+ * @return
+ */
+template <typename T>
+size_t SpscRingQueue<T>::roundCapacity(size_t capacity) {
+    size_t rounded = 2;
+    while (rounded < capacity)
+        rounded <<= 1;
+    return rounded;
+}
+
+#endif
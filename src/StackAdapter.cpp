@@ -0,0 +1,122 @@
+#ifndef _STACK_ADAPTER_CPP_
+#define _STACK_ADAPTER_CPP_
+
+#include "../include/StackAdapter.h"
+#include <cstdlib>          // For size_t
+#include <utility>          // For std::forward
+
+
+/**
+ * Removes the top element from the stack. Throws Underflow if this stack
+ * is empty.
+ */
+template <typename Container>
+void StackAdapter<Container>::pop() {
+    mStack.pop();
+}
+
+/**
+ * Removes the top element and returns it, moved out rather than copied.
+ * Throws Underflow if this stack is empty.
+ *
+ * @return
+ */
+template <typename Container>
+typename StackAdapter<Container>::value_type StackAdapter<Container>::popValue() {
+    return mStack.popValue();
+}
+
+/**
+ * Adds value to the top of the stack.
+ *
+ * @param
+ */
+template <typename Container>
+void StackAdapter<Container>::push(const value_type& value) {
+    mStack.push(value);
+}
+
+/**
+ * Adds an element constructed from args to the top of the stack, in place
+ * if the container supports emplace().
+ *
+ * @param args
+ */
+template <typename Container>
+template <typename... Args>
+void StackAdapter<Container>::emplace(Args&&... args) {
+    mStack.emplace(std::forward<Args>(args)...);
+}
+
+/**
+ * Makes room for capacity elements if the container supports reserve(),
+ * or does nothing otherwise.
+ *
+ * @param capacity
+ */
+template <typename Container>
+void StackAdapter<Container>::reserve(size_t capacity) {
+    mStack.reserve(capacity);
+}
+
+/**
+ * Returns the size of this stack.
+ *
+ * @return
+ */
+template <typename Container>
+size_t StackAdapter<Container>::size() const {
+    return mStack.size();
+}
+
+/**
+ * Moves the top element into out, removes it and returns true, or returns
+ * false if this stack is empty.
+ *
+ * @param out receives the top element
+ * @return
+ */
+template <typename Container>
+bool StackAdapter<Container>::tryPop(value_type& out) {
+    return mStack.tryPop(out);
+}
+
+/**
+ * Adds the count elements of values to the top of the stack, so that
+ * values[count - 1] ends up on top.
+ * The container's addAll() is used when it has one.
+ *
+ * @param values elements to push
+ * @param count number of elements to push
+ */
+template <typename Container>
+void StackAdapter<Container>::pushBulk(const value_type* values, size_t count) {
+    mStack.pushBulk(values, count);
+}
+
+/**
+ * Moves up to count elements from the top of the stack into out, the top
+ * first, and removes them. Returns the number of elements moved, which is
+ * less than count only if the stack ran empty.
+ *
+ * @param out receives the popped elements
+ * @param count maximum number of elements to pop
+ * @return
+ */
+template <typename Container>
+size_t StackAdapter<Container>::popBulk(value_type* out, size_t count) {
+    return mStack.popBulk(out, count);
+}
+
+/**
+ * Returns a reference to the top of the stack. Throws Underflow if this
+ * stack is empty.
+ *
+ * @return
+ */
+template <typename Container>
+const typename StackAdapter<Container>::value_type& StackAdapter<Container>::top() const {
+    return mStack.top();
+}
+
+#endif
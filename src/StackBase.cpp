@@ -0,0 +1,101 @@
+#ifndef _STACK_BASE_CPP_
+#define _STACK_BASE_CPP_
+
+#include "../include/StackBase.h"
+#include <cstdlib>          // For size_t
+#include <utility>          // For std::move
+
+
+/**
+ * Pure virtual destructor.
+ */
+template <typename T>
+StackBase<T>::~StackBase() {
+}
+
+/**
+ * Returns true if this stack is empty.
+ *
+ * @return
+ */
+template <typename T>
+bool StackBase<T>::isEmpty() const {
+    return size() == 0;
+}
+
+/**
+ * Removes the top element and returns it, moved out rather than copied.
+ * Throws Underflow if this stack is empty.
+ *
+ * @return
+ */
+template <typename T>
+T StackBase<T>::popValue() {
+    T value(std::move(top()));
+    pop();
+    return value;
+}
+
+/**
+ * Moves the top element into out, removes it and returns true, or returns
+ * false if this stack is empty. Unlike pop(), an empty stack is not an
+ * error, so polling a mostly empty stack costs a branch rather than an
+ * exception.
+ *
+ * @param out receives the top element
+ * @return
+ */
+template <typename T>
+bool StackBase<T>::tryPop(T& out) {
+    if (isEmpty())
+        return false;
+    out = std::move(top());
+    pop();
+    return true;
+}
+
+/**
+ * Returns a reference to the top of the stack. Throws Underflow if this
+ * stack is empty.
+ *
+ * @return
+ */
+template <typename T>
+T& StackBase<T>::top() {
+    const StackBase<T>* self = this;
+    return const_cast<T&>(self->top());
+}
+
+/**
+ * Adds the count elements of values to the top of the stack, so that
+ * values[count - 1] ends up on top.
+ * The default implementation pushes them one at a time.
+ *
+ * @param values elements to push
+ * @param count number of elements to push
+ */
+template <typename T>
+void StackBase<T>::pushBulk(const T* values, size_t count) {
+    for (size_t i = 0; i < count; ++i)
+        push(values[i]);
+}
+
+/**
+ * Moves up to count elements from the top of the stack into out, the top
+ * first, and removes them. Returns the number of elements moved, which is
+ * less than count only if the stack ran empty.
+ * The default implementation pops them one at a time.
+ *
+ * @param out receives the popped elements
+ * @param count maximum number of elements to pop
+ * @return
+ */
+template <typename T>
+size_t StackBase<T>::popBulk(T* out, size_t count) {
+    size_t popped = 0;
+    while (popped < count && tryPop(out[popped]))
+        ++popped;
+    return popped;
+}
+
+#endif
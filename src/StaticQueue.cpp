@@ -0,0 +1,270 @@
+#ifndef _STATIC_QUEUE_CPP_
+#define _STATIC_QUEUE_CPP_
+
+#include "../include/StaticQueue.h"
+#include "../include/ContainerTraits.h"
+#include <cstdlib>          // For size_t
+#include <algorithm>        // For std::min
+#include <iterator>         // For std::distance
+#include <utility>          // For std::forward, std::move
+
+
+/**
+ * Adds an element constructed from args to the end of this queue, in place
+ * if the container supports emplace().
+ *
+ * @param args
+ */
+template <typename Container>
+template <typename... Args>
+void StaticQueue<Container>::emplace(Args&&... args) {
+    emplaceBack(typename HasEmplace<Container, Args...>::type(), std::forward<Args>(args)...);
+}
+
+/**
+ * Adds the elements of the forward range [first, last) to the end of this
+ * queue, in order. The container's addAll() is used when it has one;
+ * otherwise room is reserved once if possible.
+ *
+ * @param first iterator to the first element to enqueue
+ * @param last iterator one past the last element to enqueue
+ */
+template <typename Container>
+template <typename InputIterator>
+void StaticQueue<Container>::enqueueBulk(InputIterator first, InputIterator last) {
+    appendAll(first, last, typename HasAddAll<Container>::type());
+}
+
+/**
+ * Adds the count elements of values to the end of this queue, in order.
+ *
+ * @param values elements to enqueue
+ * @param count number of elements to enqueue
+ */
+template <typename Container>
+void StaticQueue<Container>::enqueueBulk(const value_type* values, size_t count) {
+    enqueueBulk(values, values + count);
+}
+
+/**
+ * Moves up to count elements from the front of this queue into out, in
+ * dequeue order, and removes them. Returns the number of elements moved,
+ * which is less than count only if the queue ran empty. Containers with
+ * removeFirst() give up their elements one by one; otherwise the
+ * container's removeRange() is used to shift the rest down only once.
+ * In that case the elements are copied out rather than moved, and if
+ * removing them throws, the ones not yet removed stay in this queue while
+ * out may already hold copies of them.
+ *
+ * @param out receives the dequeued elements
+ * @param count maximum number of elements to dequeue
+ * @return
+ */
+template <typename Container>
+size_t StaticQueue<Container>::dequeueBulk(value_type* out, size_t count) {
+    size_t dequeued = std::min(count, mContainer.size());
+    takeFront(out, dequeued, typename HasRemoveFirst<Container>::type(),
+              typename HasRemoveRange<Container>::type());
+    return dequeued;
+}
+
+/**
+ * Makes room for capacity elements if the container supports reserve(),
+ * or does nothing otherwise.
+ *
+ * @param capacity
+ */
+template <typename Container>
+void StaticQueue<Container>::reserve(size_t capacity) {
+    reserve(capacity, typename HasReserve<Container>::type());
+}
+
+/**
+ * Returns the size of this queue.
+ *
+ * @return
+ */
+template <typename Container>
+size_t StaticQueue<Container>::size() const {
+    return mContainer.size();
+}
+
+/**
+ * Removes the front element of a non-empty queue.
+ */
+template <typename Container>
+void StaticQueue<Container>::doDequeue() {
+    popFront(typename HasRemoveFirst<Container>::type());
+}
+
+/**
+ * Adds value to the end of this queue.
+ *
+ * @param value
+ */
+template <typename Container>
+void StaticQueue<Container>::doEnqueue(const value_type& value) {
+    mContainer.add(value);
+}
+
+/**
+ * Returns the front element of a non-empty queue.
+ *
+ * @return
+ */
+template <typename Container>
+const typename StaticQueue<Container>::value_type& StaticQueue<Container>::doFront() const {
+    return peek(typename HasFront<Container>::type());
+}
+
+/**
+ * Removes the first element of a non-empty container through removeFirst().
+ */
+template <typename Container>
+void StaticQueue<Container>::popFront(std::true_type) {
+    mContainer.removeFirst();
+}
+
+/**
+ * Removes the first element of a non-empty container by index.
+ */
+template <typename Container>
+void StaticQueue<Container>::popFront(std::false_type) {
+    mContainer.remove(0);
+}
+
+/**
+ * Returns the first element of a non-empty container through front().
+ *
+ * @return
+ */
+template <typename Container>
+const typename StaticQueue<Container>::value_type& StaticQueue<Container>::peek(std::true_type) const {
+    return mContainer.front();
+}
+
+/**
+ * Returns the first element of a non-empty container by index.
+ *
+ * @return
+ */
+template <typename Container>
+const typename StaticQueue<Container>::value_type& StaticQueue<Container>::peek(std::false_type) const {
+    return mContainer.get(0);
+}
+
+/**
+ * Constructs the new last element in place through emplace().
+ *
+ * @param args
+ */
+template <typename Container>
+template <typename... Args>
+void StaticQueue<Container>::emplaceBack(std::true_type, Args&&... args) {
+    mContainer.emplace(std::forward<Args>(args)...);
+}
+
+/**
+ * Constructs the new last element as a temporary and adds a copy of it.
+ *
+ * @param args
+ */
+template <typename Container>
+template <typename... Args>
+void StaticQueue<Container>::emplaceBack(std::false_type, Args&&... args) {
+    mContainer.add(value_type(std::forward<Args>(args)...));
+}
+
+/**
+ * Appends [first, last) through the container's addAll().
+ *
+ * @param first
+ * @param last
+ */
+template <typename Container>
+template <typename InputIterator>
+void StaticQueue<Container>::appendAll(InputIterator first, InputIterator last, std::true_type) {
+    mContainer.addAll(first, last);
+}
+
+/**
+ * Appends [first, last) one element at a time, after reserving room for all
+ * of them if the container supports reserve().
+ *
+ * @param first
+ * @param last
+ */
+template <typename Container>
+template <typename InputIterator>
+void StaticQueue<Container>::appendAll(InputIterator first, InputIterator last, std::false_type) {
+    reserve(mContainer.size() + std::distance(first, last));
+    for (; first != last; ++first)
+        mContainer.add(*first);
+}
+
+/**
+ * Moves the first count elements into out through front() and
+ * removeFirst(), which are cheap for such containers and are expected not
+ * to throw once the front exists.
+ *
+ * @param out
+ * @param count
+ */
+template <typename Container>
+template <typename HasRange>
+void StaticQueue<Container>::takeFront(value_type* out, size_t count, std::true_type, HasRange) {
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = std::move(const_cast<value_type&>(doFront()));
+        doDequeue();
+    }
+}
+
+/**
+ * Copies the first count elements into out by index and removes them with a
+ * single removeRange(), so the remaining elements shift only once. The
+ * elements are copied rather than moved, so that they are still intact in
+ * the container if removeRange() throws.
+ *
+ * @param out
+ * @param count
+ */
+template <typename Container>
+void StaticQueue<Container>::takeFront(value_type* out, size_t count, std::false_type, std::true_type) {
+    for (size_t i = 0; i < count; ++i)
+        out[i] = mContainer.get(i);
+    mContainer.removeRange(0, count);
+}
+
+/**
+ * Copies the first count elements into out one remove(0) at a time. As above,
+ * an element is only copied, so a throwing remove(0) leaves it in place.
+ *
+ * @param out
+ * @param count
+ */
+template <typename Container>
+void StaticQueue<Container>::takeFront(value_type* out, size_t count, std::false_type, std::false_type) {
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = mContainer.get(0);
+        mContainer.remove(0);
+    }
+}
+
+/**
+ * Forwards to the container's reserve().
+ *
+ * @param capacity
+ */
+template <typename Container>
+void StaticQueue<Container>::reserve(size_t capacity, std::true_type) {
+    mContainer.reserve(capacity);
+}
+
+/**
+ * Does nothing for containers without reserve().
+ */
+template <typename Container>
+void StaticQueue<Container>::reserve(size_t, std::false_type) {
+}
+
+#endif
@@ -0,0 +1,117 @@
+#ifndef _STATIC_QUEUE_BASE_CPP_
+#define _STATIC_QUEUE_BASE_CPP_
+
+#include "../include/StaticQueueBase.h"
+#include "../include/QueueBase.h"
+#include <cstdlib>          // For size_t
+#include <utility>          // For std::move
+
+
+/**
+ * Removes the front element from this queue. Throws
+ * QueueBase<T>::Underflow if this queue is empty.
+ */
+template <typename Derived, typename T>
+void StaticQueueBase<Derived, T>::dequeue() {
+    if (isEmpty())
+        throw typename QueueBase<T>::Underflow();
+    derived().doDequeue();
+}
+
+/**
+ * Removes the front element and returns it, moved out rather than copied.
+ * Throws QueueBase<T>::Underflow if this queue is empty.
+ *
+ * @return
+ */
+template <typename Derived, typename T>
+T StaticQueueBase<Derived, T>::dequeueValue() {
+    if (isEmpty())
+        throw typename QueueBase<T>::Underflow();
+    T value(std::move(const_cast<T&>(derived().doFront())));
+    derived().doDequeue();
+    return value;
+}
+
+/**
+ * Adds value to the end of this queue.
+ *
+ * @param
+ */
+template <typename Derived, typename T>
+void StaticQueueBase<Derived, T>::enqueue(const T& value) {
+    derived().doEnqueue(value);
+}
+
+/**
+ * Returns a reference to the front of this queue. Throws
+ * QueueBase<T>::Underflow if this queue is empty.
+ *
+ * @return
+ */
+template <typename Derived, typename T>
+const T& StaticQueueBase<Derived, T>::front() const {
+    if (isEmpty())
+        throw typename QueueBase<T>::Underflow();
+    return derived().doFront();
+}
+
+/**
+ * Returns a reference to the front of this queue. Throws
+ * QueueBase<T>::Underflow if this queue is empty.
+ *
+ * @return
+ */
+template <typename Derived, typename T>
+T& StaticQueueBase<Derived, T>::front() {
+    const StaticQueueBase<Derived, T>* self = this;
+    return const_cast<T&>(self->front());
+}
+
+/**
+ * Returns true if this queue is empty.
+ *
+ * @return
+ */
+template <typename Derived, typename T>
+bool StaticQueueBase<Derived, T>::isEmpty() const {
+    return derived().size() == 0;
+}
+
+/**
+ * Moves the front element into out, removes it and returns true, or
+ * returns false if this queue is empty.
+ *
+ * @param out receives the front element
+ * @return
+ */
+template <typename Derived, typename T>
+bool StaticQueueBase<Derived, T>::tryDequeue(T& out) {
+    if (isEmpty())
+        return false;
+    out = std::move(const_cast<T&>(derived().doFront()));
+    derived().doDequeue();
+    return true;
+}
+
+/**
+ * Returns this object as the derived class.
+ *
+ * @return
+ */
+template <typename Derived, typename T>
+const Derived& StaticQueueBase<Derived, T>::derived() const {
+    return static_cast<const Derived&>(*this);
+}
+
+/**
+ * Returns this object as the derived class.
+ *
+ * @return
+ */
+template <typename Derived, typename T>
+Derived& StaticQueueBase<Derived, T>::derived() {
+    return static_cast<Derived&>(*this);
+}
+
+#endif
@@ -0,0 +1,220 @@
+#ifndef _STATIC_STACK_CPP_
+#define _STATIC_STACK_CPP_
+
+#include "../include/StaticStack.h"
+#include "../include/ContainerTraits.h"
+#include <cstdlib>          // For size_t
+#include <algorithm>        // For std::min
+#include <iterator>         // For std::distance
+#include <utility>          // For std::forward, std::move
+
+
+/**
+ * Adds an element constructed from args to the top of the stack, in place
+ * if the container supports emplace().
+ *
+ * @param args
+ */
+template <typename Container>
+template <typename... Args>
+void StaticStack<Container>::emplace(Args&&... args) {
+    emplaceBack(typename HasEmplace<Container, Args...>::type(), std::forward<Args>(args)...);
+}
+
+/**
+ * Adds the elements of the forward range [first, last) to the top of the
+ * stack, the last one ending up on top. The container's addAll() is used
+ * when it has one; otherwise room is reserved once if possible.
+ *
+ * @param first iterator to the first element to push
+ * @param last iterator one past the last element to push
+ */
+template <typename Container>
+template <typename InputIterator>
+void StaticStack<Container>::pushBulk(InputIterator first, InputIterator last) {
+    appendAll(first, last, typename HasAddAll<Container>::type());
+}
+
+/**
+ * Adds the count elements of values to the top of the stack, so that
+ * values[count - 1] ends up on top.
+ *
+ * @param values elements to push
+ * @param count number of elements to push
+ */
+template <typename Container>
+void StaticStack<Container>::pushBulk(const value_type* values, size_t count) {
+    pushBulk(values, values + count);
+}
+
+/**
+ * Moves up to count elements from the top of the stack into out, the top
+ * first, and removes them. Returns the number of elements moved, which is
+ * less than count only if the stack ran empty.
+ *
+ * @param out receives the popped elements
+ * @param count maximum number of elements to pop
+ * @return
+ */
+template <typename Container>
+size_t StaticStack<Container>::popBulk(value_type* out, size_t count) {
+    size_t popped = std::min(count, mContainer.size());
+    for (size_t i = 0; i < popped; ++i) {
+        out[i] = std::move(const_cast<value_type&>(doTop()));
+        doPop();
+    }
+    return popped;
+}
+
+/**
+ * Makes room for capacity elements if the container supports reserve(),
+ * or does nothing otherwise.
+ *
+ * @param capacity
+ */
+template <typename Container>
+void StaticStack<Container>::reserve(size_t capacity) {
+    reserve(capacity, typename HasReserve<Container>::type());
+}
+
+/**
+ * Returns the size of this stack.
+ *
+ * @return
+ */
+template <typename Container>
+size_t StaticStack<Container>::size() const {
+    return mContainer.size();
+}
+
+/**
+ * Removes the top element of a non-empty stack.
+ */
+template <typename Container>
+void StaticStack<Container>::doPop() {
+    popBack(typename HasRemoveLast<Container>::type());
+}
+
+/**
+ * Adds value to the top of the stack.
+ *
+ * @param value
+ */
+template <typename Container>
+void StaticStack<Container>::doPush(const value_type& value) {
+    mContainer.add(value);
+}
+
+/**
+ * Returns the top element of a non-empty stack.
+ *
+ * @return
+ */
+template <typename Container>
+const typename StaticStack<Container>::value_type& StaticStack<Container>::doTop() const {
+    return peek(typename HasBack<Container>::type());
+}
+
+/**
+ * Removes the last element of a non-empty container through removeLast().
+ */
+template <typename Container>
+void StaticStack<Container>::popBack(std::true_type) {
+    mContainer.removeLast();
+}
+
+/**
+ * Removes the last element of a non-empty container by index.
+ */
+template <typename Container>
+void StaticStack<Container>::popBack(std::false_type) {
+    mContainer.remove(mContainer.size() - 1);
+}
+
+/**
+ * Returns the last element of a non-empty container through back().
+ *
+ * @return
+ */
+template <typename Container>
+const typename StaticStack<Container>::value_type& StaticStack<Container>::peek(std::true_type) const {
+    return mContainer.back();
+}
+
+/**
+ * Returns the last element of a non-empty container by index.
+ *
+ * @return
+ */
+template <typename Container>
+const typename StaticStack<Container>::value_type& StaticStack<Container>::peek(std::false_type) const {
+    return mContainer.get(mContainer.size() - 1);
+}
+
+/**
+ * Constructs the new top element in place through emplace().
+ *
+ * @param args
+ */
+template <typename Container>
+template <typename... Args>
+void StaticStack<Container>::emplaceBack(std::true_type, Args&&... args) {
+    mContainer.emplace(std::forward<Args>(args)...);
+}
+
+/**
+ * Constructs the new top element as a temporary and adds a copy of it.
+ *
+ * @param args
+ */
+template <typename Container>
+template <typename... Args>
+void StaticStack<Container>::emplaceBack(std::false_type, Args&&... args) {
+    mContainer.add(value_type(std::forward<Args>(args)...));
+}
+
+/**
+ * Appends [first, last) through the container's addAll().
+ *
+ * @param first
+ * @param last
+ */
+template <typename Container>
+template <typename InputIterator>
+void StaticStack<Container>::appendAll(InputIterator first, InputIterator last, std::true_type) {
+    mContainer.addAll(first, last);
+}
+
+/**
+ * Appends [first, last) one element at a time, after reserving room for all
+ * of them if the container supports reserve().
+ *
+ * @param first
+ * @param last
+ */
+template <typename Container>
+template <typename InputIterator>
+void StaticStack<Container>::appendAll(InputIterator first, InputIterator last, std::false_type) {
+    reserve(mContainer.size() + std::distance(first, last));
+    for (; first != last; ++first)
+        mContainer.add(*first);
+}
+
+/**
+ * Forwards to the container's reserve().
+ *
+ * @param capacity
+ */
+template <typename Container>
+void StaticStack<Container>::reserve(size_t capacity, std::true_type) {
+    mContainer.reserve(capacity);
+}
+
+/**
+ * Does nothing for containers without reserve().
+ */
+template <typename Container>
+void StaticStack<Container>::reserve(size_t, std::false_type) {
+}
+
+#endif
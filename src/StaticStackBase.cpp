@@ -0,0 +1,117 @@
+#ifndef _STATIC_STACK_BASE_CPP_
+#define _STATIC_STACK_BASE_CPP_
+
+#include "../include/StaticStackBase.h"
+#include "../include/StackBase.h"
+#include <cstdlib>          // For size_t
+#include <utility>          // For std::move
+
+
+/**
+ * Returns true if this stack is empty.
+ *
+ * @return
+ */
+template <typename Derived, typename T>
+bool StaticStackBase<Derived, T>::isEmpty() const {
+    return derived().size() == 0;
+}
+
+/**
+ * Removes the top element from the stack. Throws StackBase<T>::Underflow
+ * if this stack is empty.
+ */
+template <typename Derived, typename T>
+void StaticStackBase<Derived, T>::pop() {
+    if (isEmpty())
+        throw typename StackBase<T>::Underflow();
+    derived().doPop();
+}
+
+/**
+ * Removes the top element and returns it, moved out rather than copied.
+ * Throws StackBase<T>::Underflow if this stack is empty.
+ *
+ * @return
+ */
+template <typename Derived, typename T>
+T StaticStackBase<Derived, T>::popValue() {
+    if (isEmpty())
+        throw typename StackBase<T>::Underflow();
+    T value(std::move(const_cast<T&>(derived().doTop())));
+    derived().doPop();
+    return value;
+}
+
+/**
+ * Adds value to the top of the stack.
+ *
+ * @param
+ */
+template <typename Derived, typename T>
+void StaticStackBase<Derived, T>::push(const T& value) {
+    derived().doPush(value);
+}
+
+/**
+ * Moves the top element into out, removes it and returns true, or returns
+ * false if this stack is empty.
+ *
+ * @param out receives the top element
+ * @return
+ */
+template <typename Derived, typename T>
+bool StaticStackBase<Derived, T>::tryPop(T& out) {
+    if (isEmpty())
+        return false;
+    out = std::move(const_cast<T&>(derived().doTop()));
+    derived().doPop();
+    return true;
+}
+
+/**
+ * Returns a reference to the top of the stack. Throws
+ * StackBase<T>::Underflow if this stack is empty.
+ *
+ * @return
+ */
+template <typename Derived, typename T>
+const T& StaticStackBase<Derived, T>::top() const {
+    if (isEmpty())
+        throw typename StackBase<T>::Underflow();
+    return derived().doTop();
+}
+
+/**
+ * Returns a reference to the top of the stack. Throws
+ * StackBase<T>::Underflow if this stack is empty.
+ *
+ * @return
+ */
+template <typename Derived, typename T>
+T& StaticStackBase<Derived, T>::top() {
+    const StaticStackBase<Derived, T>* self = this;
+    return const_cast<T&>(self->top());
+}
+
+/**
+ * Returns this object as the derived class.
+ *
+ * @return
+ */
+template <typename Derived, typename T>
+const Derived& StaticStackBase<Derived, T>::derived() const {
+    return static_cast<const Derived&>(*this);
+}
+
+/**
+ * Returns this object as the derived class.
+ *
+ * @return
+ */
+template <typename Derived, typename T>
+Derived& StaticStackBase<Derived, T>::derived() {
+    return static_cast<Derived&>(*this);
+}
+
+#endif
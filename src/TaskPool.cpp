@@ -0,0 +1,318 @@
+#ifndef _TASK_POOL_CPP_
+#define _TASK_POOL_CPP_
+
+#include "../include/TaskPool.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>                  // For size_t
+#include <exception>                // For std::exception_ptr
+#include <functional>               // For std::function, std::hash
+#include <memory>                   // For std::unique_ptr
+#include <mutex>
+#include <stdint.h>                 // For uint32_t, uint64_t
+#include <thread>
+
+
+/**
+ * Starts workers worker threads. If workers is 0, one worker per hardware
+ * thread is started.
+ *
+ * @param workers number of worker threads
+ */
+inline TaskPool::TaskPool(size_t workers) : mPending(0), mEpoch(0), mParked(0), mStopping(false) {
+    if (workers == 0)
+        workers = std::thread::hardware_concurrency();
+    if (workers == 0)
+        workers = 1;
+
+    // Every deque must exist before any worker starts stealing
+    for (size_t i = 0; i < workers; ++i)
+        mWorkers.push_back(std::unique_ptr<Worker>(new Worker()));
+    try {
+        for (size_t i = 0; i < workers; ++i)
+            mWorkers[i]->mThread = std::thread(&TaskPool::run, this, i);
+    } catch (...) {
+        mStopping.store(true, std::memory_order_release);
+        notify(true);
+        for (size_t i = 0; i < workers; ++i) {
+            if (mWorkers[i]->mThread.joinable())
+                mWorkers[i]->mThread.join();
+        }
+        throw;
+    }
+}
+
+/**
+ * Waits for all tasks to finish and stops the workers.
+ */
+inline TaskPool::~TaskPool() {
+    wait();
+    mStopping.store(true, std::memory_order_release);
+    notify(true);
+    for (size_t i = 0; i < mWorkers.size(); ++i)
+        mWorkers[i]->mThread.join();
+}
+
+/**
+ * Schedules work, a function object taking no arguments, to run on one of
+ * the workers.
+ *
+ * @param work task to run
+ */
+template <typename Function>
+void TaskPool::submit(Function work) {
+    schedule(new Task(work));
+}
+
+/**
+ * Calls body(i) for every i in [begin, end), in parallel, and returns once
+ * all calls are done. Ranges of at most grain indices are not split
+ * further. If a call throws, the first exception is rethrown once the
+ * other calls are done; the rest of the range that threw is skipped.
+ *
+ * @param begin first index
+ * @param end index one past the last
+ * @param body function object called with each index
+ * @param grain size of the smallest range run as one task
+ */
+template <typename Function>
+void TaskPool::parallelFor(size_t begin, size_t end, Function body, size_t grain) {
+    if (begin >= end)
+        return;
+    if (grain == 0)
+        grain = 1;
+
+    // Everything below lives on this frame, which outlives every task since
+    // we only return once all indices are accounted for
+    std::atomic<size_t> remaining(end - begin);
+    std::mutex failureMutex;
+    std::exception_ptr failure;
+
+    std::function<void(size_t, size_t)> range = [&](size_t first, size_t last) {
+        // Hand off the upper halves and keep splitting the lower one. If a
+        // half cannot be queued, the rest of the range runs right here, so
+        // that every index is still counted before the caller returns
+        while (last - first > grain) {
+            size_t middle = first + (last - first) / 2;
+            try {
+                submit([&range, middle, last]() { range(middle, last); });
+            } catch (...) {
+                break;
+            }
+            last = middle;
+        }
+        try {
+            for (size_t i = first; i < last; ++i)
+                body(i);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(failureMutex);
+            if (!failure)
+                failure = std::current_exception();
+        }
+        // Once the count drops to zero the caller may return and take this
+        // closure with it, so nothing captured may be touched afterwards
+        size_t count = last - first;
+        TaskPool* pool = this;
+        if (remaining.fetch_sub(count, std::memory_order_acq_rel) == count)
+            pool->notify(true);
+    };
+
+    range(begin, end);
+    helpUntil([&remaining]() { return remaining.load(std::memory_order_acquire) == 0; });
+    if (failure)
+        std::rethrow_exception(failure);
+}
+
+/**
+ * Runs tasks on the calling thread until every submitted task, and every
+ * task those submitted, has finished.
+ */
+inline void TaskPool::wait() {
+    helpUntil([this]() { return mPending.load(std::memory_order_acquire) == 0; });
+}
+
+/**
+ * Returns the number of worker threads.
+ * This operation is a no-throw.
+ *
+ * @return
+ */
+inline size_t TaskPool::workerCount() const throw () {
+    return mWorkers.size();
+}
+
+/**
+ * The loop run by worker index.
+ *
+ * @param index
+ */
+inline void TaskPool::run(size_t index) {
+    Current& me = current();
+    me.mPool = this;
+    me.mIndex = index;
+
+    unsigned idle = 0;
+    for (;;) {
+        uint64_t epoch = mEpoch.load(std::memory_order_seq_cst);
+        Task* task = findTask();
+        if (task) {
+            execute(task);
+            idle = 0;
+        } else if (mStopping.load(std::memory_order_acquire)) {
+            break;
+        } else if (++idle < kIdleRounds) {
+            std::this_thread::yield();
+        } else {
+            park(epoch);
+        }
+    }
+}
+
+/**
+ * Counts task as pending and hands it to the calling worker's deque, or to
+ * the shared queue if the calling thread is not one of this pool's
+ * workers.
+ *
+ * @param task
+ */
+inline void TaskPool::schedule(Task* task) {
+    std::unique_ptr<Task> owned(task);
+    mPending.fetch_add(1, std::memory_order_relaxed);
+    try {
+        Current& me = current();
+        if (me.mPool == this)
+            mWorkers[me.mIndex]->mDeque.push(task);
+        else
+            mInjected.enqueue(task);
+    } catch (...) {
+        mPending.fetch_sub(1, std::memory_order_relaxed);
+        throw;
+    }
+    owned.release();
+    notify(false);
+}
+
+/**
+ * Returns a task for the calling thread, from its own deque if it is a
+ * worker, then from the shared queue, then stolen from a random victim,
+ * or null if none was found.
+ *
+ * @return
+ */
+inline TaskPool::Task* TaskPool::findTask() {
+    Task* task = 0;
+    Current& me = current();
+    bool worker = me.mPool == this;
+    if (worker && mWorkers[me.mIndex]->mDeque.pop(task))
+        return task;
+    if (mInjected.tryDequeue(task))
+        return task;
+
+    size_t count = mWorkers.size();
+    size_t start = random() % count;
+    for (size_t i = 0; i < count; ++i) {
+        size_t victim = (start + i) % count;
+        if (worker && victim == me.mIndex)
+            continue;
+        if (mWorkers[victim]->mDeque.steal(task))
+            return task;
+    }
+    return 0;
+}
+
+/**
+ * Runs and deletes task.
+ *
+ * @param task
+ */
+inline void TaskPool::execute(Task* task) {
+    std::unique_ptr<Task> owned(task);
+    (*owned)();
+    if (mPending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        notify(true);
+}
+
+/**
+ * Runs tasks on the calling thread until done() returns true, parking
+ * when there is nothing to run.
+ *
+ * @param done
+ */
+template <typename Predicate>
+void TaskPool::helpUntil(Predicate done) {
+    unsigned idle = 0;
+    while (!done()) {
+        uint64_t epoch = mEpoch.load(std::memory_order_seq_cst);
+        Task* task = findTask();
+        if (task) {
+            execute(task);
+            idle = 0;
+        } else if (done()) {
+            break;
+        } else if (++idle < kIdleRounds) {
+            std::this_thread::yield();
+        } else {
+            park(epoch);
+        }
+    }
+}
+
+/**
+ * Parks the calling thread until notify() is called after epoch was read
+ * or the pool stops.
+ *
+ * @param epoch
+ */
+inline void TaskPool::park(uint64_t epoch) {
+    std::unique_lock<std::mutex> lock(mMutex);
+    mParked.fetch_add(1, std::memory_order_seq_cst);
+    while (mEpoch.load(std::memory_order_seq_cst) == epoch && !mStopping.load(std::memory_order_acquire))
+        mWake.wait(lock);
+    mParked.fetch_sub(1, std::memory_order_relaxed);
+}
+
+/**
+ * Tells parked threads that something changed, waking one of them or all.
+ *
+ * @param all
+ */
+inline void TaskPool::notify(bool all) {
+    // A thread about to park rechecks the epoch under the lock, so it either
+    // sees this increment or is counted as parked by the time we look
+    mEpoch.fetch_add(1, std::memory_order_seq_cst);
+    if (mParked.load(std::memory_order_seq_cst) == 0)
+        return;
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (all)
+        mWake.notify_all();
+    else
+        mWake.notify_one();
+}
+
+/**
+ * Returns the calling thread's Current.
+ *
+ * @return
+ */
+inline TaskPool::Current& TaskPool::current() throw () {
+    static thread_local Current current = {0, 0};
+    return current;
+}
+
+/**
+ * Returns a pseudo-random number from a generator private to the calling
+ * thread.
+ *
+ * @return
+ */
+inline uint32_t TaskPool::random() throw () {
+    // xorshift, seeded differently for every thread
+    static thread_local uint32_t seed =
+            static_cast<uint32_t>(std::hash<std::thread::id>()(std::this_thread::get_id())) | 1;
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    return seed;
+}
+
+#endif
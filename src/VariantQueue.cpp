@@ -0,0 +1,240 @@
+#ifndef _VARIANT_QUEUE_CPP_
+#define _VARIANT_QUEUE_CPP_
+
+#include "../include/VariantQueue.h"
+#include <cstdlib>          // For size_t
+#include <new>              // For placement new
+
+
+/**
+ * Initializes an empty queue backed by the container selected by kind.
+ * This operation provides strong exception safety.
+ *
+ * @param kind backing container to use
+ */
+template <typename T>
+VariantQueue<T>::VariantQueue(Kind kind) : mKind(kind) {
+    switch (mKind) {
+        case ARRAY:
+            new (&mArray) StaticQueue<ArrayList<T> >();
+            break;
+        case LINKED:
+            new (&mLinked) StaticQueue<LinkedList<T> >();
+            break;
+    }
+}
+
+/**
+ * Initializes the VariantQueue to be a copy of src, using the same kind of
+ * container.
+ * This operation provides strong exception safety.
+ *
+ * @param src VariantQueue to copy
+ */
+template <typename T>
+VariantQueue<T>::VariantQueue(const VariantQueue<T>& src) : mKind(src.mKind) {
+    switch (mKind) {
+        case ARRAY:
+            new (&mArray) StaticQueue<ArrayList<T> >(src.mArray);
+            break;
+        case LINKED:
+            new (&mLinked) StaticQueue<LinkedList<T> >(src.mLinked);
+            break;
+    }
+}
+
+/**
+ * Destroys the active container.
+ */
+template <typename T>
+VariantQueue<T>::~VariantQueue() {
+    destroy();
+}
+
+/**
+ * Returns true if this queue is empty.
+ *
+ * @return
+ */
+template <typename T>
+bool VariantQueue<T>::isEmpty() const {
+    return size() == 0;
+}
+
+/**
+ * Returns the kind of container backing this queue.
+ * This operation is a no-throw.
+ *
+ * @return
+ */
+template <typename T>
+typename VariantQueue<T>::Kind VariantQueue<T>::kind() const throw () {
+    return mKind;
+}
+
+/**
+ * Removes the front element from this queue. Throws
+ * QueueBase<T>::Underflow if this queue is empty.
+ */
+template <typename T>
+void VariantQueue<T>::dequeue() {
+    switch (mKind) {
+        case ARRAY:
+            mArray.dequeue();
+            break;
+        case LINKED:
+            mLinked.dequeue();
+            break;
+    }
+}
+
+/**
+ * Removes the front element and returns it, moved out rather than copied.
+ * Throws QueueBase<T>::Underflow if this queue is empty.
+ *
+ * @return
+ */
+template <typename T>
+T VariantQueue<T>::dequeueValue() {
+    switch (mKind) {
+        case ARRAY:
+            return mArray.dequeueValue();
+        default:
+            return mLinked.dequeueValue();
+    }
+}
+
+/**
+ * Adds value to the end of this queue.
+ *
+ * @param
+ */
+template <typename T>
+void VariantQueue<T>::enqueue(const T& value) {
+    switch (mKind) {
+        case ARRAY:
+            mArray.enqueue(value);
+            break;
+        case LINKED:
+            mLinked.enqueue(value);
+            break;
+    }
+}
+
+/**
+ * Returns the size of this queue.
+ *
+ * @return
+ */
+template <typename T>
+size_t VariantQueue<T>::size() const {
+    switch (mKind) {
+        case ARRAY:
+            return mArray.size();
+        default:
+            return mLinked.size();
+    }
+}
+
+/**
+ * Moves the front element into out, removes it and returns true, or
+ * returns false if this queue is empty.
+ *
+ * @param out receives the front element
+ * @return
+ */
+template <typename T>
+bool VariantQueue<T>::tryDequeue(T& out) {
+    switch (mKind) {
+        case ARRAY:
+            return mArray.tryDequeue(out);
+        default:
+            return mLinked.tryDequeue(out);
+    }
+}
+
+/**
+ * Adds the count elements of values to the end of this queue, in order.
+ *
+ * @param values elements to enqueue
+ * @param count number of elements to enqueue
+ */
+template <typename T>
+void VariantQueue<T>::enqueueBulk(const T* values, size_t count) {
+    switch (mKind) {
+        case ARRAY:
+            mArray.enqueueBulk(values, count);
+            break;
+        case LINKED:
+            mLinked.enqueueBulk(values, count);
+            break;
+    }
+}
+
+/**
+ * Moves up to count elements from the front of this queue into out, in
+ * dequeue order, and removes them. Returns the number of elements moved,
+ * which is less than count only if the queue ran empty.
+ *
+ * @param out receives the dequeued elements
+ * @param count maximum number of elements to dequeue
+ * @return
+ */
+template <typename T>
+size_t VariantQueue<T>::dequeueBulk(T* out, size_t count) {
+    switch (mKind) {
+        case ARRAY:
+            return mArray.dequeueBulk(out, count);
+        default:
+            return mLinked.dequeueBulk(out, count);
+    }
+}
+
+/**
+ * Returns a reference to the front of this queue. Throws
+ * QueueBase<T>::Underflow if this queue is empty.
+ *
+ * @return
+ */
+template <typename T>
+const T& VariantQueue<T>::front() const {
+    switch (mKind) {
+        case ARRAY:
+            return mArray.front();
+        default:
+            return mLinked.front();
+    }
+}
+
+/**
+ * Returns a reference to the front of this queue. Throws
+ * QueueBase<T>::Underflow if this queue is empty.
+ *
+ * @return
+ */
+template <typename T>
+T& VariantQueue<T>::front() {
+    switch (mKind) {
+        case ARRAY:
+            return mArray.front();
+        default:
+            return mLinked.front();
+    }
+}
+
+/**
+ * Destroys the active member of the union.
+ */
+template <typename T>
+void VariantQueue<T>::destroy() {
+    switch (mKind) {
+        case ARRAY:
+            mArray.~StaticQueue<ArrayList<T> >();
+            break;
+        case LINKED:
+            mLinked.~StaticQueue<LinkedList<T> >();
+            break;
+    }
+}
+
+#endif
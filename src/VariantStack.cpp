@@ -0,0 +1,241 @@
+#ifndef _VARIANT_STACK_CPP_
+#define _VARIANT_STACK_CPP_
+
+#include "../include/VariantStack.h"
+#include <cstdlib>          // For size_t
+#include <new>              // For placement new
+
+
+/**
+ * Initializes an empty stack backed by the container selected by kind.
+ * This operation provides strong exception safety.
+ *
+ * @param kind backing container to use
+ */
+template <typename T>
+VariantStack<T>::VariantStack(Kind kind) : mKind(kind) {
+    switch (mKind) {
+        case ARRAY:
+            new (&mArray) StaticStack<ArrayList<T> >();
+            break;
+        case LINKED:
+            new (&mLinked) StaticStack<LinkedList<T> >();
+            break;
+    }
+}
+
+/**
+ * Initializes the VariantStack to be a copy of src, using the same kind of
+ * container.
+ * This operation provides strong exception safety.
+ *
+ * @param src VariantStack to copy
+ */
+template <typename T>
+VariantStack<T>::VariantStack(const VariantStack<T>& src) : mKind(src.mKind) {
+    switch (mKind) {
+        case ARRAY:
+            new (&mArray) StaticStack<ArrayList<T> >(src.mArray);
+            break;
+        case LINKED:
+            new (&mLinked) StaticStack<LinkedList<T> >(src.mLinked);
+            break;
+    }
+}
+
+/**
+ * Destroys the active container.
+ */
+template <typename T>
+VariantStack<T>::~VariantStack() {
+    destroy();
+}
+
+/**
+ * Returns true if this stack is empty.
+ *
+ * @return
+ */
+template <typename T>
+bool VariantStack<T>::isEmpty() const {
+    return size() == 0;
+}
+
+/**
+ * Returns the kind of container backing this stack.
+ * This operation is a no-throw.
+ *
+ * @return
+ */
+template <typename T>
+typename VariantStack<T>::Kind VariantStack<T>::kind() const throw () {
+    return mKind;
+}
+
+/**
+ * Removes the top element from the stack. Throws StackBase<T>::Underflow
+ * if this stack is empty.
+ */
+template <typename T>
+void VariantStack<T>::pop() {
+    switch (mKind) {
+        case ARRAY:
+            mArray.pop();
+            break;
+        case LINKED:
+            mLinked.pop();
+            break;
+    }
+}
+
+/**
+ * Removes the top element and returns it, moved out rather than copied.
+ * Throws StackBase<T>::Underflow if this stack is empty.
+ *
+ * @return
+ */
+template <typename T>
+T VariantStack<T>::popValue() {
+    switch (mKind) {
+        case ARRAY:
+            return mArray.popValue();
+        default:
+            return mLinked.popValue();
+    }
+}
+
+/**
+ * Adds value to the top of the stack.
+ *
+ * @param
+ */
+template <typename T>
+void VariantStack<T>::push(const T& value) {
+    switch (mKind) {
+        case ARRAY:
+            mArray.push(value);
+            break;
+        case LINKED:
+            mLinked.push(value);
+            break;
+    }
+}
+
+/**
+ * Returns the size of this stack.
+ *
+ * @return
+ */
+template <typename T>
+size_t VariantStack<T>::size() const {
+    switch (mKind) {
+        case ARRAY:
+            return mArray.size();
+        default:
+            return mLinked.size();
+    }
+}
+
+/**
+ * Moves the top element into out, removes it and returns true, or
+ * returns false if this stack is empty.
+ *
+ * @param out receives the top element
+ * @return
+ */
+template <typename T>
+bool VariantStack<T>::tryPop(T& out) {
+    switch (mKind) {
+        case ARRAY:
+            return mArray.tryPop(out);
+        default:
+            return mLinked.tryPop(out);
+    }
+}
+
+/**
+ * Adds the count elements of values to the top of the stack, so that
+ * values[count - 1] ends up on top.
+ *
+ * @param values elements to push
+ * @param count number of elements to push
+ */
+template <typename T>
+void VariantStack<T>::pushBulk(const T* values, size_t count) {
+    switch (mKind) {
+        case ARRAY:
+            mArray.pushBulk(values, count);
+            break;
+        case LINKED:
+            mLinked.pushBulk(values, count);
+            break;
+    }
+}
+
+/**
+ * Moves up to count elements from the top of the stack into out, the top
+ * first, and removes them. Returns the number of elements moved, which is
+ * less than count only if the stack ran empty.
+ *
+ * @param out receives the popped elements
+ * @param count maximum number of elements to pop
+ * @return
+ */
+template <typename T>
+size_t VariantStack<T>::popBulk(T* out, size_t count) {
+    switch (mKind) {
+        case ARRAY:
+            return mArray.popBulk(out, count);
+        default:
+            return mLinked.popBulk(out, count);
+    }
+}
+
+/**
+ * Returns a reference to the top of the stack. Throws
+ * StackBase<T>::Underflow if this stack is empty.
+ *
+ * @return
+ */
+template <typename T>
+const T& VariantStack<T>::top() const {
+    switch (mKind) {
+        case ARRAY:
+            return mArray.top();
+        default:
+            return mLinked.top();
+    }
+}
+
+/**
+ * Returns a reference to the top of the stack. Throws
+ * StackBase<T>::Underflow if this stack is empty.
+ *
+ * @return
+ */
+template <typename T>
+T& VariantStack<T>::top() {
+    switch (mKind) {
+        case ARRAY:
+            return mArray.top();
+        default:
+            return mLinked.top();
+    }
+}
+
+/**
+ * Destroys the active member of the union.
+ */
+template <typename T>
+void VariantStack<T>::destroy() {
+    switch (mKind) {
+        case ARRAY:
+            mArray.~StaticStack<ArrayList<T> >();
+            break;
+        case LINKED:
+            mLinked.~StaticStack<LinkedList<T> >();
+            break;
+    }
+}
+
+#endif
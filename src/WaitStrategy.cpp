@@ -0,0 +1,91 @@
+#ifndef _WAIT_STRATEGY_CPP_
+#define _WAIT_STRATEGY_CPP_
+
+#include "../include/WaitStrategy.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>                  // For size_t
+#include <mutex>
+#include <thread>                   // For std::this_thread::yield
+
+
+/**
+ * Spins until ready() returns true.
+ *
+ * @param ready
+ */
+template <typename Predicate>
+void BusySpinWait::waitUntil(Predicate ready) {
+    while (!ready())
+        ;
+}
+
+/**
+ * Does nothing, since nobody sleeps.
+ * This operation is a no-throw.
+ */
+inline void BusySpinWait::signal() throw () {
+}
+
+/**
+ * Spins for a while, then yields the processor between calls to ready()
+ * until it returns true.
+ *
+ * @param ready
+ */
+template <typename Predicate>
+void YieldWait::waitUntil(Predicate ready) {
+    for (unsigned spins = 0; !ready(); ++spins) {
+        if (spins >= kSpinCount)
+            std::this_thread::yield();
+    }
+}
+
+/**
+ * Does nothing, since nobody sleeps.
+ * This operation is a no-throw.
+ */
+inline void YieldWait::signal() throw () {
+}
+
+/**
+ * Initializes the strategy with nobody waiting.
+ */
+inline BlockingWait::BlockingWait() : mWaiters(0) {
+}
+
+/**
+ * Spins for a while, then parks until ready() returns true.
+ *
+ * @param ready
+ */
+template <typename Predicate>
+void BlockingWait::waitUntil(Predicate ready) {
+    for (unsigned spins = 0; spins < kSpinCount; ++spins) {
+        if (ready())
+            return;
+    }
+
+    std::unique_lock<std::mutex> lock(mMutex);
+    mWaiters.fetch_add(1, std::memory_order_seq_cst);
+    // Pairs with the fence in signal(): either the signaller sees us counted
+    // or we see the change it signals
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    while (!ready())
+        mWake.wait(lock);
+    mWaiters.fetch_sub(1, std::memory_order_relaxed);
+}
+
+/**
+ * Wakes parked waiters, if there are any, so that they recheck their
+ * conditions.
+ */
+inline void BlockingWait::signal() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (mWaiters.load(std::memory_order_relaxed) == 0)
+        return;
+    std::lock_guard<std::mutex> lock(mMutex);
+    mWake.notify_all();
+}
+
+#endif
@@ -0,0 +1,162 @@
+#ifndef _WORK_STEALING_DEQUE_CPP_
+#define _WORK_STEALING_DEQUE_CPP_
+
+#include "../include/WorkStealingDeque.h"
+#include <atomic>
+#include <cstdlib>                  // For size_t
+#include <stdint.h>                 // For int64_t
+#include <type_traits>              // For std::is_trivially_copyable
+
+
+/**
+ * Initializes an empty deque with room for capacity elements before it
+ * first grows. The capacity is rounded up to a power of two.
+ *
+ * @param capacity initial number of slots
+ */
+template <typename T>
+WorkStealingDeque<T>::WorkStealingDeque(size_t capacity) : mTop(0), mBottom(0), mArray(0) {
+    static_assert(std::is_trivially_copyable<T>::value, "WorkStealingDeque elements must be trivially copyable");
+    size_t rounded = 2;
+    while (rounded < capacity)
+        rounded <<= 1;
+    mArray.store(new Array(rounded), std::memory_order_relaxed);
+}
+
+/**
+ * Destroys the deque and all of its arrays. No thread may use the deque
+ * any more.
+ * This operation is a no-throw.
+ */
+template <typename T>
+WorkStealingDeque<T>::~WorkStealingDeque() throw () {
+    Array* array = mArray.load(std::memory_order_relaxed);
+    while (array) {
+        Array* previous = array->mPrevious;
+        delete array;
+        array = previous;
+    }
+}
+
+/**
+ * Adds value at the bottom, growing the array if it is full. Owner only.
+ * This operation provides strong exception safety.
+ *
+ * @param value value to push
+ */
+template <typename T>
+void WorkStealingDeque<T>::push(value_type value) {
+    int64_t bottom = mBottom.load(std::memory_order_relaxed);
+    int64_t top = mTop.load(std::memory_order_acquire);
+    Array* array = mArray.load(std::memory_order_relaxed);
+    if (bottom - top > array->capacity() - 1)
+        array = grow(array, top, bottom);
+    array->put(bottom, value);
+    std::atomic_thread_fence(std::memory_order_release);
+    mBottom.store(bottom + 1, std::memory_order_relaxed);
+}
+
+/**
+ * Removes the bottom element into out and returns true, or returns false
+ * if the deque is empty or a thief took the last element. Owner only.
+ * This operation is a no-throw.
+ *
+ * @param out receives the bottom element
+ * @return
+ */
+template <typename T>
+bool WorkStealingDeque<T>::pop(value_type& out) throw () {
+    int64_t bottom = mBottom.load(std::memory_order_relaxed) - 1;
+    Array* array = mArray.load(std::memory_order_relaxed);
+    // Claim the bottom slot before looking at the top, so that a thief
+    // either sees the claim or is seen by us
+    mBottom.store(bottom, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t top = mTop.load(std::memory_order_relaxed);
+
+    if (top > bottom) {
+        mBottom.store(bottom + 1, std::memory_order_relaxed);
+        return false;
+    }
+
+    out = array->get(bottom);
+    if (top == bottom) {
+        // The last element: race the thieves for it
+        bool won = mTop.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                                std::memory_order_relaxed);
+        mBottom.store(bottom + 1, std::memory_order_relaxed);
+        return won;
+    }
+    return true;
+}
+
+/**
+ * Removes the top element into out and returns true, or returns false if
+ * the deque is empty or another thread won the race for the element. Any
+ * thread.
+ * This operation is a no-throw.
+ *
+ * @param out receives the top element
+ * @return
+ */
+template <typename T>
+bool WorkStealingDeque<T>::steal(value_type& out) throw () {
+    int64_t top = mTop.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t bottom = mBottom.load(std::memory_order_acquire);
+    if (top >= bottom)
+        return false;
+
+    Array* array = mArray.load(std::memory_order_acquire);
+    value_type value = array->get(top);
+    if (!mTop.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+        return false;
+    out = value;
+    return true;
+}
+
+/**
+ * Returns true if the deque looked empty.
+ * This operation is a no-throw.
+ *
+ * @return
+ */
+template <typename T>
+bool WorkStealingDeque<T>::isEmpty() const throw () {
+    return size() == 0;
+}
+
+/**
+ * Returns the number of elements the deque held a moment ago.
+ * This operation is a no-throw.
+ *
+ * @return
+ */
+template <typename T>
+size_t WorkStealingDeque<T>::size() const throw () {
+    int64_t bottom = mBottom.load(std::memory_order_relaxed);
+    int64_t top = mTop.load(std::memory_order_relaxed);
+    return bottom > top ? static_cast<size_t>(bottom - top) : 0;
+}
+
+/**
+ * Replaces array, which holds the elements [top, bottom), with one twice
+ * as large and returns the new array. Owner only.
+ * This operation provides strong exception safety.
+ *
+ * @param array
+ * @param top
+ * @param bottom
+ * @return
+ */
+template <typename T>
+typename WorkStealingDeque<T>::Array* WorkStealingDeque<T>::grow(Array* array, int64_t top, int64_t bottom) {
+    Array* bigger = new Array(static_cast<size_t>(array->capacity()) * 2);
+    for (int64_t i = top; i < bottom; ++i)
+        bigger->put(i, array->get(i));
+    bigger->mPrevious = array;
+    mArray.store(bigger, std::memory_order_release);
+    return bigger;
+}
+
+#endif
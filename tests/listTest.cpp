@@ -0,0 +1,692 @@
+#include "tests.h"
+#include "../include/ArrayList.h"
+#include "../include/ArrayListSubList.h"
+#include "../include/ArrayListView.h"
+#include "../include/CompressedIntList.h"
+#include "../include/CowArrayList.h"
+#include "../include/LinkedList.h"
+#include "../include/LinkedListSubList.h"
+#include "../include/ListSerialization.h"
+#include "../include/MappedArrayList.h"
+#include "../include/PersistentList.h"
+#include "../include/RleList.h"
+#include "../include/SparseList.h"
+#include <vector>
+#include <thread>
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>          // For std::declval
+#include <cstdlib>          // For mkstemp
+#include <cstring>          // For memcpy
+#include <unistd.h>         // For close, unlink, lseek
+#include <sys/mman.h>       // For mmap, munmap
+
+
+TEST(BoolListTest, PackedAddGetRemove) {
+    EXPECT_NO_THROW({
+        ArrayList<bool> list;
+        std::vector<bool> model;
+        for (size_t i = 0; i < 500; ++i) {
+            bool value = (i * 7) % 3 == 0;
+            list.add(value);
+            model.push_back(value);
+        }
+        for (size_t i = 0; i < 300; i += 5) {
+            list.add(i, true);
+            model.insert(model.begin() + i, true);
+        }
+        for (size_t i = 0; i < 200; i += 3) {
+            EXPECT_EQ(list.remove(i), model[i]);
+            model.erase(model.begin() + i);
+        }
+
+        ASSERT_EQ(list.size(), model.size());
+        size_t count = 0;
+        for (size_t i = 0; i < model.size(); ++i) {
+            EXPECT_EQ(list.get(i), model[i]);
+            count += model[i];
+        }
+        EXPECT_EQ(list.count(), count);
+    });
+}
+
+TEST(BoolListTest, Proxy) {
+    ArrayList<bool> list(70);
+    list[65] = true;
+    list.get(3) = list[65];
+    list[4].flip();
+    EXPECT_TRUE(list[3]);
+    EXPECT_TRUE(list[4]);
+    EXPECT_EQ(list.count(), 3UL);
+    EXPECT_THROW(list.get(70), std::out_of_range);
+
+    size_t seen = 0;
+    for (ArrayList<bool>::iterator iter = list.begin(); iter != list.end(); ++iter) {
+        if (*iter) {
+            *iter = false;
+            ++seen;
+        }
+    }
+    EXPECT_EQ(seen, 3UL);
+    EXPECT_EQ(list.count(), 0UL);
+}
+
+TEST(BoolListTest, FindAndCompare) {
+    ArrayList<bool> list(200);
+    EXPECT_EQ(list.findFirst(), list.size());
+    list.set(3, true);
+    list.set(64, true);
+    list.set(199, true);
+    EXPECT_EQ(list.findFirst(), 3UL);
+    EXPECT_EQ(list.findNext(3), 64UL);
+    EXPECT_EQ(list.findNext(64), 199UL);
+    EXPECT_EQ(list.findNext(199), list.size());
+
+    ArrayList<bool> copy(list);
+    EXPECT_TRUE(copy == list);
+    copy.remove(199);
+    copy.add(false);
+    EXPECT_TRUE(copy != list);
+
+    ArrayList<bool> ones(130, true);
+    EXPECT_EQ(ones.count(), 130UL);
+    ones.add(200, true);
+    EXPECT_EQ(ones.size(), 201UL);
+    EXPECT_EQ(ones.count(), 131UL);
+}
+
+TEST(CompressedIntListTest, RoundTrip) {
+    CompressedIntList list;
+    std::vector<uint64_t> model;
+    uint64_t id = 1000000000000ULL;
+    for (size_t i = 0; i < 10000; ++i) {
+        id += (i * 37) % 11;                    // Monotone, small deltas
+        if (i % 1000 == 999)
+            id -= 5;                            // Occasional step back
+        uint64_t value = i % 3000 < 2000 ? id : (i * 2654435761ULL) % 4096;
+        list.add(value);
+        model.push_back(value);
+    }
+    list.add(~0ULL);
+    model.push_back(~0ULL);
+
+    ASSERT_EQ(list.size(), model.size());
+    for (size_t i = 0; i < model.size(); i += 7)
+        EXPECT_EQ(list.get(i), model[i]);
+    EXPECT_TRUE(std::equal(model.begin(), model.end(), list.begin()));
+    EXPECT_THROW(list.get(model.size()), std::out_of_range);
+    EXPECT_LT(list.compressedBytes(), model.size() * sizeof(uint64_t) / 4);
+
+    CompressedIntList copy(list);
+    EXPECT_TRUE(copy == list);
+    list.clear();
+    EXPECT_TRUE(list.isEmpty());
+    EXPECT_TRUE(list.begin() == list.end());
+}
+
+TEST(RleListTest, RunsSplitAndMerge) {
+    RleList<int> list(1000000, 7);
+    EXPECT_EQ(list.runCount(), 1UL);
+    list.set(500, 3);
+    EXPECT_EQ(list.runCount(), 3UL);
+    EXPECT_EQ(list.get(499), 7);
+    EXPECT_EQ(list.get(500), 3);
+    EXPECT_EQ(list.get(501), 7);
+    list.set(500, 7);
+    EXPECT_EQ(list.runCount(), 1UL);
+
+    list.add(2000000, 1);
+    EXPECT_EQ(list.size(), 2000001UL);
+    EXPECT_EQ(list.runCount(), 3UL);
+    EXPECT_EQ(list.get(1500000), 0);
+    EXPECT_EQ(list.remove(2000000), 1);
+    EXPECT_EQ(list.runCount(), 2UL);
+    EXPECT_THROW(list.get(2000000), std::out_of_range);
+}
+
+TEST(RleListTest, MatchesModel) {
+    RleList<int> list;
+    std::vector<int> model;
+    for (int i = 0; i < 400; ++i) {
+        int value = (i / 13) % 4;
+        size_t index = (i * 31) % (model.size() + 1);
+        list.add(index, value);
+        model.insert(model.begin() + index, value);
+        if (i % 5 == 0) {
+            size_t victim = (i * 17) % model.size();
+            EXPECT_EQ(list.remove(victim), model[victim]);
+            model.erase(model.begin() + victim);
+        }
+        if (i % 7 == 0 && !model.empty()) {
+            size_t target = (i * 11) % model.size();
+            list.set(target, 9);
+            model[target] = 9;
+        }
+    }
+    ASSERT_EQ(list.size(), model.size());
+    EXPECT_TRUE(std::equal(model.begin(), model.end(), list.begin()));
+    for (size_t i = 0; i < model.size(); ++i)
+        EXPECT_EQ(list[i], model[i]);
+
+    RleList<int> rebuilt;
+    for (size_t i = 0; i < model.size(); ++i)
+        rebuilt.add(model[i]);
+    EXPECT_TRUE(rebuilt == list);
+    EXPECT_EQ(rebuilt.runCount(), list.runCount());
+}
+
+// Copying one of these throws once sCopiesLeft runs out
+struct FragileValue {
+    FragileValue(int value = 0) : mValue(value) {}
+    FragileValue(const FragileValue& other) : mValue(other.mValue) {
+        if (sCopiesLeft-- == 0)
+            throw std::runtime_error("copy failed");
+    }
+    FragileValue& operator=(const FragileValue& other) {
+        mValue = other.mValue;
+        return *this;
+    }
+    bool operator==(const FragileValue& rhs) const { return mValue == rhs.mValue; }
+
+    int mValue;
+    static int sCopiesLeft;
+};
+
+int FragileValue::sCopiesLeft = -1;
+
+TEST(RleListTest, FailedSpliceLeavesListUnchanged) {
+    RleList<FragileValue> list;
+    for (int i = 0; i < 40; ++i)
+        list.add(FragileValue(i / 4));
+    RleList<FragileValue> before(list);
+
+    for (int copies = 0; copies < 20; ++copies) {
+        FragileValue::sCopiesLeft = copies;
+        try {
+            list.set(17, FragileValue(99));
+            FragileValue::sCopiesLeft = -1;
+            list.set(17, FragileValue(17 / 4));
+            break;
+        } catch (const std::runtime_error&) {
+            FragileValue::sCopiesLeft = -1;
+            ASSERT_TRUE(list == before);
+            ASSERT_EQ(list.size(), 40UL);
+            EXPECT_EQ(list.get(39).mValue, 9);
+        }
+    }
+    FragileValue::sCopiesLeft = -1;
+    EXPECT_TRUE(list == before);
+}
+
+TEST(SparseListTest, GapsAreNotMaterialized) {
+    SparseList<int> list;
+    list.add(10000000, 42);
+    EXPECT_EQ(list.size(), 10000001UL);
+    EXPECT_EQ(list.entryCount(), 1UL);
+    EXPECT_EQ(list.get(9999999), 0);
+    EXPECT_EQ(list.get(10000000), 42);
+    EXPECT_FALSE(list.contains(5));
+    EXPECT_THROW(list.get(10000001), std::out_of_range);
+
+    list.add(5, 7);
+    EXPECT_EQ(list.get(5), 7);
+    EXPECT_EQ(list.get(10000001), 42);
+    EXPECT_EQ(list.remove(0), 0);
+    EXPECT_EQ(list.get(4), 7);
+    EXPECT_EQ(list.get(10000000), 42);
+    EXPECT_EQ(list.entryCount(), 2UL);
+
+    SparseList<int>::const_iterator iter = list.begin();
+    EXPECT_EQ(iter.index(), 4UL);
+    EXPECT_EQ(*iter, 7);
+    ++iter;
+    EXPECT_EQ(iter.index(), 10000000UL);
+    EXPECT_TRUE(++iter == list.end());
+}
+
+TEST(SparseListTest, MatchesModel) {
+    SparseList<int> list;
+    std::vector<int> model;
+    for (int i = 1; i < 300; ++i) {
+        size_t index = (i * 29) % (model.size() + 3);
+        list.add(index, i);
+        if (index >= model.size())
+            model.resize(index);
+        model.insert(model.begin() + index, i);
+        if (i % 4 == 0) {
+            size_t victim = (i * 13) % model.size();
+            EXPECT_EQ(list.remove(victim), model[victim]);
+            model.erase(model.begin() + victim);
+        }
+        if (i % 6 == 0) {
+            size_t target = (i * 7) % model.size();
+            list.set(target, -i);
+            model[target] = -i;
+        }
+    }
+    ASSERT_EQ(list.size(), model.size());
+    for (size_t i = 0; i < model.size(); ++i)
+        EXPECT_EQ(list.get(i), model[i]);
+
+    SparseList<int> dense;
+    for (size_t i = 0; i < model.size(); ++i)
+        dense.add(model[i]);
+    EXPECT_TRUE(dense == list);
+    dense.set(0, dense.get(0) + 1);
+    EXPECT_TRUE(dense != list);
+}
+
+TEST(ZeroFillTest, LazyZeroedStorage) {
+    EXPECT_NO_THROW({
+        ArrayList<long> huge(1 << 24);
+        EXPECT_EQ(huge.size(), 1UL << 24);
+        EXPECT_EQ(huge.get(0), 0L);
+        EXPECT_EQ(huge.get((1 << 24) - 1), 0L);
+        huge[12345] = 7;
+        huge.add(9);
+        EXPECT_EQ(huge.get(12345), 7L);
+        EXPECT_EQ(huge.get(1 << 24), 9L);
+        EXPECT_EQ(huge.remove(12345), 7L);
+        EXPECT_EQ(huge.get(12345), 0L);
+
+        ArrayList<int> small(10);
+        ArrayList<int> filled(10, 0);
+        EXPECT_TRUE(small == filled);
+        ArrayList<int> copy(small);
+        copy.clear();
+        EXPECT_TRUE(copy.isEmpty());
+
+        ArrayList<int> empty;
+        empty.add(3, 4);
+        EXPECT_EQ(empty.get(3), 4);
+        EXPECT_EQ(empty.get(0), 0);
+    });
+}
+
+TEST(StorageTest, MappedAndAlignedGrowth) {
+    const ArrayStorage storages[] = {
+        ArrayStorage::mapped(),
+        ArrayStorage::mapped(ArrayStorage::HUGE_PAGES | ArrayStorage::POPULATE),
+        ArrayStorage::mapped(0),
+        ArrayStorage::aligned(64)
+    };
+
+    for (size_t s = 0; s < sizeof(storages) / sizeof(storages[0]); ++s) {
+        ArrayList<long> list(0, 0, storages[s]);
+        for (long i = 0; i < (1 << 20); ++i)
+            list.add(i);
+        if (storages[s].backing() == ArrayStorage::ALIGNED) {
+            EXPECT_EQ(reinterpret_cast<size_t>(&list[0]) % 64, 0UL);
+        }
+
+        ArrayList<long> copy(list);
+        list.add(5, -1);
+        EXPECT_EQ(list.remove(5), -1L);
+        ASSERT_EQ(list.size(), 1UL << 20);
+        for (long i = 0; i < (1 << 20); i += 4099)
+            ASSERT_EQ(list.get(i), i);
+        EXPECT_TRUE(list == copy);
+
+        list.clear();
+        list.add(3);
+        EXPECT_EQ(list.get(0), 3L);
+    }
+
+    ArrayList<std::vector<int> > objects(3, std::vector<int>(2, 7), ArrayStorage::mapped());
+    objects.add(std::vector<int>(1, 1));
+    EXPECT_EQ(objects.get(2).size(), 2UL);
+    EXPECT_EQ(objects.get(3)[0], 1);
+}
+
+TEST(MappedArrayListTest, ReattachAfterGrowth) {
+    char path[] = "/tmp/mappedArrayListTestXXXXXX";
+    int fd = mkstemp(path);
+    ASSERT_GE(fd, 0);
+    close(fd);
+
+    {
+        MappedArrayList<long> list(path);
+        EXPECT_TRUE(list.isEmpty());
+        for (long i = 0; i < 100000; ++i)
+            list.add(i);
+        list.add(0, -1);
+        list.add(list.size() + 2, 5);
+        EXPECT_EQ(list.remove(0), -1L);
+        EXPECT_EQ(list.get(100000), 0L);
+        EXPECT_GE(list.capacity(), list.size());
+        list.sync();
+    }
+
+    {
+        MappedArrayList<long> list(path);
+        ASSERT_EQ(list.size(), 100003UL);
+        for (long i = 0; i < 100000; ++i)
+            ASSERT_EQ(list[i], i);
+        EXPECT_EQ(list.get(100002), 5L);
+        EXPECT_THROW(list.get(100003), std::out_of_range);
+        list.add(list[0]);
+        EXPECT_EQ(list.get(100003), 0L);
+
+        MappedArrayList<long> other(path);
+        EXPECT_TRUE(list == other);
+    }
+
+    EXPECT_THROW(MappedArrayList<char> wrongType(path), std::runtime_error);
+    unlink(path);
+}
+
+TEST(SerializationTest, RoundTripAndView) {
+    char path[] = "/tmp/serializationTestXXXXXX";
+    int fd = mkstemp(path);
+    ASSERT_GE(fd, 0);
+
+    ArrayList<int> numbers;
+    for (int i = 0; i < 50000; ++i)
+        numbers.add(i * 3);
+    numbers.writeTo(fd);
+    ArrayList<int>().writeTo(fd);
+
+    ASSERT_EQ(lseek(fd, 0, SEEK_SET), 0);
+    ArrayList<int> copy;
+    copy.readFrom(fd);
+    EXPECT_TRUE(copy == numbers);
+    LinkedList<int> linked;
+    linked.add(1);
+    linked.readFrom(fd);
+    EXPECT_TRUE(linked.isEmpty());
+    EXPECT_THROW(copy.readFrom(fd), std::runtime_error);
+    EXPECT_TRUE(copy == numbers);
+
+    size_t length = lseek(fd, 0, SEEK_END);
+    void* buffer = mmap(0, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    ASSERT_NE(buffer, MAP_FAILED);
+    ArrayListView<int> view(buffer, length);
+    ASSERT_EQ(view.size(), numbers.size());
+    EXPECT_TRUE(std::equal(view.begin(), view.end(), numbers.begin()));
+    EXPECT_EQ(view.get(49999), 149997);
+    EXPECT_THROW(view.get(50000), std::out_of_range);
+    EXPECT_THROW(ArrayListView<long> wrongType(buffer, length), std::runtime_error);
+    EXPECT_THROW(ArrayListView<int> truncated(buffer, 1000), std::runtime_error);
+    munmap(buffer, length);
+    close(fd);
+    unlink(path);
+
+    std::stringstream stream;
+    LinkedList<std::string> words;
+    words.add("zero");
+    words.add("");
+    words.add(std::string(100000, 'x'));
+    words.writeTo(stream);
+    numbers.writeTo(stream);
+
+    ArrayList<std::string> wordArray;
+    wordArray.readFrom(stream);
+    ASSERT_EQ(wordArray.size(), 3UL);
+    EXPECT_EQ(wordArray.get(0), "zero");
+    EXPECT_EQ(wordArray.get(2).size(), 100000UL);
+    LinkedList<int> linkedNumbers;
+    linkedNumbers.readFrom(stream);
+    EXPECT_EQ(linkedNumbers.size(), 50000UL);
+    EXPECT_EQ(linkedNumbers.get(7), 21);
+}
+
+TEST(SerializationTest, RejectsOversizedHeader) {
+    ArrayList<int> numbers;
+    numbers.add(1);
+    numbers.add(2);
+    std::stringstream stream;
+    numbers.writeTo(stream);
+
+    // A size that wraps around once multiplied by the element size
+    std::string data = stream.str();
+    ListFileHeader header;
+    std::memcpy(&header, data.data(), sizeof(header));
+    header.mSize = (static_cast<uint64_t>(1) << 63) + 1;
+    header.mCapacity = ~static_cast<uint64_t>(0);
+    data.replace(0, sizeof(header), reinterpret_cast<const char*>(&header), sizeof(header));
+
+    std::stringstream patched(data);
+    ArrayList<int> copy;
+    copy.add(7);
+    EXPECT_THROW(copy.readFrom(patched), std::runtime_error);
+    ASSERT_EQ(copy.size(), 1UL);
+    EXPECT_EQ(copy.get(0), 7);
+
+    // Large enough to overflow an allocation, but not the byte count
+    header.mSize = static_cast<uint64_t>(1) << 61;
+    header.mCapacity = header.mSize;
+    data.replace(0, sizeof(header), reinterpret_cast<const char*>(&header), sizeof(header));
+    std::stringstream huge(data);
+    EXPECT_THROW(copy.readFrom(huge), std::runtime_error);
+    EXPECT_EQ(copy.size(), 1UL);
+
+    // Plausible, but far more than the data holds
+    header.mSize = static_cast<uint64_t>(1) << 40;
+    header.mCapacity = header.mSize;
+    data.replace(0, sizeof(header), reinterpret_cast<const char*>(&header), sizeof(header));
+    std::stringstream truncated(data);
+    EXPECT_THROW(copy.readFrom(truncated), std::runtime_error);
+    ASSERT_EQ(copy.size(), 1UL);
+    EXPECT_EQ(copy.get(0), 7);
+
+    std::stringstream words;
+    ArrayList<std::string>(3, "word").writeTo(words);
+    data = words.str();
+    std::memcpy(&header, data.data(), sizeof(header));
+    header.mSize = static_cast<uint64_t>(1) << 40;
+    header.mCapacity = header.mSize;
+    data.replace(0, sizeof(header), reinterpret_cast<const char*>(&header), sizeof(header));
+    std::stringstream truncatedWords(data);
+    ArrayList<std::string> wordCopy(1, "kept");
+    EXPECT_THROW(wordCopy.readFrom(truncatedWords), std::runtime_error);
+    ASSERT_EQ(wordCopy.size(), 1UL);
+    EXPECT_EQ(wordCopy.get(0), "kept");
+}
+
+TEST(BulkTest, AddAllAndRemoveRange) {
+    std::vector<std::string> words;
+    for (int i = 0; i < 100; ++i)
+        words.push_back(std::string(i % 7 + 1, static_cast<char>('a' + i % 26)));
+
+    ArrayList<std::string> array;
+    array.add("first");
+    array.addAll(words.begin(), words.end());
+    EXPECT_EQ(array.size(), 101UL);
+    EXPECT_EQ(array.get(100), words[99]);
+    array.removeRange(1, 51);
+    EXPECT_EQ(array.size(), 51UL);
+    EXPECT_EQ(array.get(1), words[50]);
+    EXPECT_THROW(array.removeRange(10, 52), std::out_of_range);
+    EXPECT_THROW(array.removeRange(10, 9), std::out_of_range);
+
+    ArrayList<int> ints;
+    int values[] = {1, 2, 3, 4, 5};
+    ints.addAll(values, values + 5);
+    ints.removeRange(0, 2);
+    ints.removeRange(3, 3);
+    EXPECT_EQ(ints.size(), 3UL);
+    EXPECT_EQ(ints.get(0), 3);
+
+    LinkedList<std::string> linked;
+    linked.addAll(words.begin(), words.end());
+    linked.addAll(words.begin(), words.begin());
+    EXPECT_EQ(linked.size(), 100UL);
+    EXPECT_EQ(linked.back(), words[99]);
+    linked.removeFirst();
+    linked.removeLast();
+    EXPECT_EQ(linked.front(), words[1]);
+    EXPECT_EQ(linked.back(), words[98]);
+}
+
+template <typename View>
+class HasSet {
+    template <typename V>
+    static auto check(int) -> decltype(std::declval<V&>().set(0, std::declval<typename V::const_reference>()),
+                                       std::true_type());
+    template <typename V>
+    static std::false_type check(...);
+public:
+    typedef decltype(check<View>(0)) type;
+};
+
+// A view of a constant list must not write into it
+static_assert(HasSet<LinkedListSubList<int> >::type::value, "LinkedListSubList<int> must have set()");
+static_assert(!HasSet<LinkedListSubList<const int> >::type::value, "LinkedListSubList<const int> must not have set()");
+
+TEST(SubListTest, ViewsShareElements) {
+    ArrayList<int> list;
+    for (int i = 0; i < 20; ++i)
+        list.add(100 - i);
+
+    ArrayListSubList<int> middle = list.subList(5, 15);
+    ASSERT_EQ(middle.size(), 10UL);
+    std::sort(middle.begin(), middle.end());
+    EXPECT_EQ(list.get(4), 96);
+    EXPECT_EQ(list.get(5), 86);
+    EXPECT_EQ(list.get(14), 95);
+    EXPECT_EQ(list.get(15), 85);
+    EXPECT_TRUE(std::binary_search(middle.begin(), middle.end(), 90));
+    EXPECT_EQ(*std::lower_bound(middle.begin(), middle.end(), 90), 90);
+
+    ArrayListSubList<int> inner = middle.subList(2, 4);
+    inner.set(0, -1);
+    inner[1] = -2;
+    EXPECT_EQ(list.get(7), -1);
+    EXPECT_EQ(middle.get(3), -2);
+    EXPECT_THROW(inner.get(2), std::out_of_range);
+    EXPECT_THROW(middle.subList(3, 11), std::out_of_range);
+    EXPECT_THROW(list.subList(6, 5), std::out_of_range);
+    EXPECT_TRUE(list.subList(20, 20).isEmpty());
+
+    const ArrayList<int>& constList = list;
+    ArrayListSubList<const int> readOnly = constList.subList(7, 9);
+    EXPECT_EQ(readOnly.get(0), -1);
+    EXPECT_EQ(readOnly.end() - readOnly.begin(), 2);
+    EXPECT_TRUE(readOnly.subList(0, 2) == readOnly);
+
+    LinkedList<int> linked;
+    for (int i = 0; i < 10; ++i)
+        linked.add(i);
+    LinkedListSubList<int> tail = linked.subList(6, 10);
+    ASSERT_EQ(tail.size(), 4UL);
+    EXPECT_EQ(tail.get(0), 6);
+    tail.set(3, 42);
+    EXPECT_EQ(linked.get(9), 42);
+    EXPECT_EQ(std::count(tail.begin(), tail.end(), 42), 1);
+    LinkedListSubList<int> pair = tail.subList(1, 3);
+    EXPECT_EQ(pair.get(1), 8);
+    EXPECT_THROW(pair.get(2), std::out_of_range);
+    EXPECT_THROW(linked.subList(0, 11), std::out_of_range);
+
+    const LinkedList<int>& constLinked = linked;
+    LinkedListSubList<const int> head = constLinked.subList(0, 3);
+    int sum = 0;
+    for (LinkedListSubList<const int>::const_iterator iter = head.begin(); iter != head.end(); ++iter)
+        sum += *iter;
+    EXPECT_EQ(sum, 3);
+}
+
+TEST(CowArrayListTest, CopiesShareUntilWritten) {
+    CowArrayList<int> original(1000, 7);
+    EXPECT_TRUE(original.unique());
+
+    CowArrayList<int> copy(original);
+    EXPECT_FALSE(original.unique());
+    EXPECT_EQ(&copy[0], &original[0]);
+    EXPECT_TRUE(copy == original);
+
+    copy.set(0, 1);
+    EXPECT_TRUE(copy.unique());
+    EXPECT_TRUE(original.unique());
+    EXPECT_EQ(original.get(0), 7);
+    EXPECT_EQ(copy.get(0), 1);
+    EXPECT_THROW(copy.set(1000, 1), std::out_of_range);
+
+    CowArrayList<int> assigned;
+    assigned = original;
+    assigned = assigned;
+    EXPECT_FALSE(original.unique());
+    assigned.clear();
+    EXPECT_TRUE(assigned.isEmpty());
+    EXPECT_EQ(original.size(), 1000UL);
+    EXPECT_TRUE(original.unique());
+
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; ++t) {
+        readers.push_back(std::thread([original, t]() {
+            for (int i = 0; i < 1000; ++i) {
+                CowArrayList<int> snapshot(original);
+                if (i % 100 == 0)
+                    snapshot.add(t);
+            }
+        }));
+    }
+    for (size_t t = 0; t < readers.size(); ++t)
+        readers[t].join();
+    EXPECT_TRUE(original.unique());
+    EXPECT_EQ(original.size(), 1000UL);
+}
+
+TEST(PersistentListTest, VersionsShareStructure) {
+    std::vector<PersistentList<int> > versions(1, PersistentList<int>());
+    for (int i = 0; i < 33000; ++i)
+        versions.push_back(versions.back().add(i));
+    for (size_t n = 0; n < versions.size(); n += 997) {
+        ASSERT_EQ(versions[n].size(), n);
+        for (size_t i = 0; i < n; ++i)
+            ASSERT_EQ(versions[n][i], static_cast<int>(i));
+    }
+
+    const size_t boundaries[] = {2, 32, 33, 1024, 1056, 1057, 32768, 32800, 32801, 33000};
+    for (size_t b = 0; b < sizeof(boundaries) / sizeof(boundaries[0]); ++b) {
+        const PersistentList<int>& list = versions[boundaries[b]];
+        PersistentList<int> popped = list.removeLast();
+        EXPECT_TRUE(popped == versions[boundaries[b] - 1]);
+        PersistentList<int> changed = list.set(0, -1).set(list.size() - 1, -2);
+        EXPECT_EQ(changed.get(0), -1);
+        EXPECT_EQ(changed.get(list.size() - 1), -2);
+        EXPECT_EQ(list.get(list.size() - 1), static_cast<int>(list.size() - 1));
+        EXPECT_TRUE(changed != list);
+    }
+
+    PersistentList<int> shrinking = versions.back();
+    long long sum = 0;
+    while (!shrinking.isEmpty()) {
+        sum += shrinking.get(shrinking.size() - 1);
+        shrinking = shrinking.removeLast();
+    }
+    EXPECT_EQ(sum, 33000LL * 32999 / 2);
+    EXPECT_THROW(shrinking.removeLast(), std::out_of_range);
+    EXPECT_THROW(versions[5].get(5), std::out_of_range);
+    EXPECT_THROW(versions[5].set(5, 0), std::out_of_range);
+}
+
+TEST(PersistentListTest, TransientBuildsInPlace) {
+    PersistentList<int> base = PersistentList<int>().add(1).add(2);
+    PersistentList<int>::Transient transient(base);
+    for (int i = 0; i < 40000; ++i)
+        transient.add(i);
+    transient.set(0, 10).set(39000, -1);
+    EXPECT_EQ(transient.size(), 40002UL);
+    EXPECT_EQ(transient.get(39000), -1);
+
+    PersistentList<int> built = transient.persistent();
+    EXPECT_THROW(transient.add(0), std::logic_error);
+    EXPECT_EQ(base.size(), 2UL);
+    EXPECT_EQ(base.get(0), 1);
+    EXPECT_EQ(built.get(0), 10);
+    EXPECT_EQ(built.get(39000), -1);
+
+    PersistentList<int>::Transient again(built);
+    again.set(39000, 5);
+    EXPECT_EQ(built.get(39000), -1);
+    EXPECT_EQ(again.persistent().get(39000), 5);
+
+    long long sum = 0;
+    for (PersistentList<int>::const_iterator it = built.begin(); it != built.end(); ++it)
+        sum += *it;
+    EXPECT_EQ(sum, 10LL + 2 + 39999LL * 40000 / 2 - 38998 - 1);
+}
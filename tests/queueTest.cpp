@@ -5,8 +5,32 @@
 #include "tests.h"
 #include "../include/QueueBase.h"
 #include "../include/QueueAdapter.h"
+#include "../include/ContainerTraits.h"
+#include "../include/StaticQueue.h"
+#include "../include/VariantQueue.h"
 #include "../include/ArrayList.h"
 #include "../include/LinkedList.h"
+#include "../include/BlockingQueue.h"
+#include "../include/FlatCombining.h"
+#include "../include/MpmcBoundedQueue.h"
+#include "../include/MpscQueue.h"
+#include "../include/MulticastRing.h"
+#include "../include/ShmRingQueue.h"
+#include "../include/SpscRingQueue.h"
+#include "../include/TaskPool.h"
+#include "../include/WorkStealingDeque.h"
+#include <thread>
+#include <chrono>
+#include <vector>
+#include <atomic>
+#include <stdexcept>
+#include <algorithm>
+#include <sstream>
+#include <fcntl.h>          // For O_RDWR
+#include <sys/mman.h>       // For mmap, munmap, shm_open
+#include <sys/stat.h>       // For fstat
+#include <sys/wait.h>       // For waitpid
+#include <unistd.h>         // For fork, getpid, _exit
 
 
 QueueBase<int>* makeIntQueue(const int &testMode) {
@@ -125,8 +149,894 @@ TEST_P(QueueTest, Adapter) {
     });
 }
 
+TEST_P(QueueTest, TryDequeueAndDequeueValue) {
+    QueueBase<int>* q = makeIntQueue(GetParam());
+    int value = -1;
+    EXPECT_FALSE(q->tryDequeue(value));
+    EXPECT_EQ(value, -1);
+    EXPECT_THROW(q->dequeueValue(), QueueBase<int>::Underflow);
+
+    for (int i = 1; i < 999; ++i)
+        q->enqueue(i);
+    EXPECT_EQ(q->dequeueValue(), 1);
+    for (int i = 2; i < 999; ++i) {
+        EXPECT_TRUE(q->tryDequeue(value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_FALSE(q->tryDequeue(value));
+    EXPECT_TRUE(q->isEmpty());
+    delete q;
+}
+
+TEST_P(QueueTest, Bulk) {
+    QueueBase<int>* q = makeIntQueue(GetParam());
+    int values[300];
+    for (int i = 0; i < 300; ++i)
+        values[i] = i;
+    q->enqueueBulk(values, 300);
+    q->enqueueBulk(values, 0);
+    EXPECT_EQ(q->size(), 300UL);
+    EXPECT_EQ(q->front(), 0);
+
+    int out[400];
+    EXPECT_EQ(q->dequeueBulk(out, 100), 100UL);
+    EXPECT_EQ(out[0], 0);
+    EXPECT_EQ(out[99], 99);
+    EXPECT_EQ(q->front(), 100);
+    EXPECT_EQ(q->dequeueBulk(out, 400), 200UL);
+    EXPECT_EQ(out[199], 299);
+    EXPECT_TRUE(q->isEmpty());
+    EXPECT_EQ(q->dequeueBulk(out, 1), 0UL);
+    delete q;
+
+    QueueAdapter<EnforcedIntAdaptee> minimal;
+    minimal.enqueueBulk(values, 10);
+    EXPECT_EQ(minimal.dequeueBulk(out, 3), 3UL);
+    EXPECT_EQ(out[2], 2);
+    EXPECT_EQ(minimal.front(), 3);
+}
+
 INSTANTIATE_TEST_CASE_P(Default,
     QueueTest,
     ::testing::Values(CREATE_LINKED_STACK, CREATE_ARRAY_STACK),
     ::testing::PrintToStringParamName()
 );
+
+TEST(QueueCapabilityTest, DetectsCheapOperations) {
+    EXPECT_TRUE(HasRemoveFirst<LinkedList<int> >::type::value);
+    EXPECT_TRUE(HasFront<LinkedList<int> >::type::value);
+    EXPECT_FALSE(HasRemoveFirst<ArrayList<int> >::type::value);
+    EXPECT_FALSE(HasRemoveFirst<EnforcedIntAdaptee>::type::value);
+    EXPECT_FALSE(HasFront<EnforcedIntAdaptee>::type::value);
+
+    QueueAdapter<LinkedList<int> > queue;
+    for (int i = 0; i < 100; ++i)
+        queue.emplace(i);
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(queue.front(), i);
+        queue.dequeue();
+    }
+    EXPECT_TRUE(queue.isEmpty());
+}
+
+TEST(StaticQueueTest, MatchesAdapter) {
+    StaticQueue<ArrayList<int> > queue;
+    VariantQueue<int> array(VariantQueue<int>::ARRAY);
+    VariantQueue<int> linked(VariantQueue<int>::LINKED);
+    EXPECT_THROW(queue.dequeue(), QueueBase<int>::Underflow);
+    EXPECT_THROW(array.front(), QueueBase<int>::Underflow);
+    EXPECT_THROW(linked.dequeue(), QueueBase<int>::Underflow);
+
+    for (int i = 1; i < 999; ++i) {
+        queue.enqueue(i);
+        array.enqueue(i);
+        linked.enqueue(i);
+    }
+    VariantQueue<int> copy(array);
+    copy.front() = 0;
+    EXPECT_EQ(array.front(), 1);
+
+    for (int i = 1; i < 999; ++i) {
+        EXPECT_EQ(queue.front(), i);
+        EXPECT_EQ(array.front(), i);
+        EXPECT_EQ(linked.front(), i);
+        queue.dequeue();
+        array.dequeue();
+        linked.dequeue();
+    }
+    EXPECT_TRUE(queue.isEmpty());
+    EXPECT_TRUE(array.isEmpty());
+    EXPECT_TRUE(linked.isEmpty());
+}
+
+TEST(SpscRingQueueTest, SingleThread) {
+    SpscRingQueue<int> ring(5);
+    QueueBase<int>& q = ring;
+    EXPECT_EQ(ring.capacity(), 8UL);
+    EXPECT_TRUE(q.isEmpty());
+    EXPECT_THROW(q.front(), QueueBase<int>::Underflow);
+    EXPECT_THROW(q.dequeue(), QueueBase<int>::Underflow);
+
+    for (int i = 0; i < 8; ++i)
+        EXPECT_TRUE(ring.tryEnqueue(i));
+    EXPECT_FALSE(ring.tryEnqueue(8));
+    EXPECT_EQ(q.size(), 8UL);
+    EXPECT_EQ(q.front(), 0);
+    q.dequeue();
+    EXPECT_EQ(q.dequeueValue(), 1);
+
+    int values[] = {8, 9, 10};
+    EXPECT_EQ(ring.tryEnqueueBulk(values, 3), 2UL);
+    int out[8];
+    EXPECT_EQ(q.dequeueBulk(out, 8), 8UL);
+    EXPECT_EQ(out[0], 2);
+    EXPECT_EQ(out[7], 9);
+    EXPECT_FALSE(q.tryDequeue(out[0]));
+}
+
+TEST(SpscRingQueueTest, ProducerConsumer) {
+    const int kCount = 100000;
+    SpscRingQueue<int> ring(64);
+
+    std::thread producer([&ring, kCount]() {
+        int batch[16];
+        for (int i = 0; i < kCount; i += 16) {
+            for (int j = 0; j < 16; ++j)
+                batch[j] = i + j;
+            if (i % 32 == 0) {
+                ring.enqueueBulk(batch, 16);
+            } else {
+                for (int j = 0; j < 16; ++j)
+                    ring.enqueue(batch[j]);
+            }
+        }
+    });
+
+    int expected = 0;
+    int out[10];
+    while (expected < kCount) {
+        size_t got = ring.dequeueBulk(out, 10);
+        for (size_t i = 0; i < got; ++i)
+            ASSERT_EQ(out[i], expected++);
+        int value;
+        if (ring.tryDequeue(value)) {
+            ASSERT_EQ(value, expected++);
+        }
+    }
+    producer.join();
+    EXPECT_TRUE(ring.isEmpty());
+}
+
+TEST(MpmcBoundedQueueTest, SingleThread) {
+    MpmcBoundedQueue<int> bounded(3);
+    QueueBase<int>& q = bounded;
+    EXPECT_EQ(bounded.capacity(), 4UL);
+    EXPECT_THROW(q.front(), QueueBase<int>::Underflow);
+    EXPECT_THROW(q.dequeueValue(), QueueBase<int>::Underflow);
+
+    for (int lap = 0; lap < 3; ++lap) {
+        for (int i = 0; i < 4; ++i)
+            EXPECT_TRUE(bounded.tryEnqueue(i));
+        EXPECT_FALSE(bounded.tryEnqueue(4));
+        EXPECT_EQ(q.size(), 4UL);
+        EXPECT_EQ(q.front(), 0);
+        q.dequeue();
+        int value;
+        EXPECT_TRUE(q.tryDequeue(value));
+        EXPECT_EQ(value, 1);
+        EXPECT_EQ(q.dequeueValue(), 2);
+        EXPECT_EQ(q.dequeueValue(), 3);
+        EXPECT_FALSE(q.tryDequeue(value));
+    }
+}
+
+// Copies of kNoCopy and moves of kNoMove throw
+struct Picky {
+    enum { kNoCopy = -1, kNoMove = -2 };
+
+    Picky(int value = 0) : mValue(value) {}
+    Picky(const Picky& other) : mValue(other.mValue) { check(other, kNoCopy); }
+    Picky(Picky&& other) : mValue(other.mValue) { check(other, kNoMove); }
+    Picky& operator=(const Picky& other) {
+        check(other, kNoCopy);
+        mValue = other.mValue;
+        return *this;
+    }
+    Picky& operator=(Picky&& other) {
+        check(other, kNoMove);
+        mValue = other.mValue;
+        return *this;
+    }
+    static void check(const Picky& other, int refused) {
+        if (other.mValue == refused)
+            throw std::runtime_error("refused");
+    }
+
+    int mValue;
+};
+
+TEST(MpmcBoundedQueueTest, ThrowingCopiesKeepTheRingMoving) {
+    MpmcBoundedQueue<Picky> q(4);
+    for (int lap = 0; lap < 3; ++lap) {
+        EXPECT_TRUE(q.tryEnqueue(Picky(1)));
+        EXPECT_THROW(q.tryEnqueue(Picky(Picky::kNoCopy)), std::runtime_error);
+        EXPECT_TRUE(q.tryEnqueue(Picky(Picky::kNoMove)));
+        EXPECT_TRUE(q.tryEnqueue(Picky(2)));
+
+        Picky value;
+        EXPECT_TRUE(q.tryDequeue(value));
+        EXPECT_EQ(value.mValue, 1);
+        EXPECT_EQ(q.front().mValue, Picky::kNoMove);
+        EXPECT_THROW(q.tryDequeue(value), std::runtime_error);
+        EXPECT_EQ(q.front().mValue, 2);
+        EXPECT_EQ(q.dequeueValue().mValue, 2);
+
+        EXPECT_TRUE(q.tryEnqueue(Picky(Picky::kNoMove)));
+        EXPECT_THROW(q.dequeueValue(), std::runtime_error);
+        EXPECT_TRUE(q.isEmpty());
+
+        // Every slot went back to producers
+        for (int i = 0; i < 4; ++i)
+            EXPECT_TRUE(q.tryEnqueue(Picky(i)));
+        EXPECT_FALSE(q.tryEnqueue(Picky(4)));
+        for (int i = 0; i < 4; ++i)
+            q.dequeue();
+        EXPECT_THROW(q.front(), QueueBase<Picky>::Underflow);
+    }
+}
+
+TEST(MpmcBoundedQueueTest, ManyProducersAndConsumers) {
+    const int kThreads = 4;
+    const int kPerThread = 20000;
+    MpmcBoundedQueue<int> q(128);
+    std::atomic<long long> sum(0);
+    std::atomic<int> consumed(0);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.push_back(std::thread([&q, t, kPerThread]() {
+            for (int i = 1; i <= kPerThread; ++i)
+                q.enqueue(t * kPerThread + i);
+        }));
+        threads.push_back(std::thread([&q, &sum, &consumed, kThreads, kPerThread]() {
+            int value;
+            while (consumed.load() < kThreads * kPerThread) {
+                if (q.tryDequeue(value)) {
+                    sum += value;
+                    ++consumed;
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        }));
+    }
+    for (size_t t = 0; t < threads.size(); ++t)
+        threads[t].join();
+
+    long long n = kThreads * kPerThread;
+    EXPECT_EQ(consumed.load(), n);
+    EXPECT_EQ(sum.load(), n * (n + 1) / 2);
+    EXPECT_TRUE(q.isEmpty());
+}
+
+TEST(MpscQueueTest, SingleThread) {
+    MpscQueue<int> mailbox(4);
+    QueueBase<int>& q = mailbox;
+    EXPECT_THROW(q.front(), QueueBase<int>::Underflow);
+    EXPECT_THROW(q.dequeue(), QueueBase<int>::Underflow);
+
+    for (int lap = 0; lap < 3; ++lap) {
+        for (int i = 0; i < 10; ++i)
+            q.enqueue(i);
+        EXPECT_EQ(q.size(), 10UL);
+        EXPECT_EQ(q.front(), 0);
+        q.dequeue();
+        EXPECT_EQ(q.dequeueValue(), 1);
+
+        int values[4];
+        EXPECT_EQ(q.dequeueBulk(values, 4), 4UL);
+        EXPECT_EQ(values[3], 5);
+
+        int sum = 0;
+        auto add = [&sum](int value) { sum += value; };
+        EXPECT_EQ(mailbox.drain(add, 2), 2UL);
+        EXPECT_EQ(sum, 6 + 7);
+        EXPECT_EQ(mailbox.drain(add), 2UL);
+        EXPECT_EQ(sum, 6 + 7 + 8 + 9);
+        EXPECT_TRUE(q.isEmpty());
+    }
+}
+
+TEST(MpscQueueTest, ManyProducers) {
+    const int kProducers = 4;
+    const int kPerThread = 20000;
+    const int kBatch = 8;
+    MpscQueue<int> q;
+
+    std::vector<std::thread> producers;
+    for (int t = 0; t < kProducers; ++t) {
+        producers.push_back(std::thread([&q, t, kPerThread, kBatch]() {
+            // Odd producers post in batches, whose elements must stay adjacent
+            int batch[kBatch];
+            for (int i = 0; i < kPerThread; i += kBatch) {
+                for (int j = 0; j < kBatch; ++j)
+                    batch[j] = t * kPerThread + i + j;
+                if (t % 2) {
+                    q.enqueueBulk(batch, kBatch);
+                } else {
+                    for (int j = 0; j < kBatch; ++j)
+                        q.enqueue(batch[j]);
+                }
+            }
+        }));
+    }
+
+    std::vector<int> last(kProducers, -1);
+    int consumed = 0;
+    bool ordered = true;
+    int previous = -1;
+    while (consumed < kProducers * kPerThread) {
+        consumed += q.drain([&](int value) {
+            int producer = value / kPerThread;
+            ordered = ordered && value > last[producer];
+            if (producer % 2 && value % kBatch)
+                ordered = ordered && value == previous + 1;
+            last[producer] = value;
+            previous = value;
+        });
+    }
+    for (size_t t = 0; t < producers.size(); ++t)
+        producers[t].join();
+
+    EXPECT_TRUE(ordered);
+    EXPECT_TRUE(q.isEmpty());
+    for (int t = 0; t < kProducers; ++t)
+        EXPECT_EQ(last[t], (t + 1) * kPerThread - 1);
+}
+
+TEST(BlockingQueueTest, TimeoutsAndClose) {
+    BlockingQueue<LinkedList<int> > bounded(2);
+    QueueBase<int>& q = bounded;
+    int value = 0;
+    EXPECT_FALSE(bounded.dequeueFor(value, std::chrono::milliseconds(1)));
+    EXPECT_FALSE(q.tryDequeue(value));
+
+    q.enqueue(1);
+    EXPECT_TRUE(bounded.tryEnqueue(2));
+    EXPECT_FALSE(bounded.tryEnqueue(3));
+    EXPECT_EQ(q.size(), 2UL);
+    EXPECT_EQ(q.front(), 1);
+
+    int values[4];
+    EXPECT_EQ(bounded.dequeueBatch(values, 4, std::chrono::milliseconds(1)), 2UL);
+    EXPECT_EQ(values[1], 2);
+    EXPECT_EQ(bounded.dequeueBatch(values, 4, std::chrono::milliseconds(1)), 0UL);
+
+    q.enqueue(3);
+    bounded.close();
+    EXPECT_TRUE(bounded.isClosed());
+    EXPECT_THROW(q.enqueue(4), BlockingQueue<LinkedList<int> >::Closed);
+    EXPECT_EQ(q.dequeueValue(), 3);
+    EXPECT_THROW(q.dequeue(), QueueBase<int>::Underflow);
+    EXPECT_FALSE(bounded.dequeueFor(value, std::chrono::seconds(10)));
+}
+
+TEST(BlockingQueueTest, CloseWakesWaiters) {
+    BlockingQueue<ArrayList<int> > q;
+    std::atomic<int> woken(0);
+    std::vector<std::thread> consumers;
+    for (int t = 0; t < 3; ++t) {
+        consumers.push_back(std::thread([&q, &woken]() {
+            EXPECT_THROW(q.dequeue(), QueueBase<int>::Underflow);
+            ++woken;
+        }));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    q.close();
+    for (size_t t = 0; t < consumers.size(); ++t)
+        consumers[t].join();
+    EXPECT_EQ(woken.load(), 3);
+}
+
+TEST(BlockingQueueTest, BoundedProducersAndConsumers) {
+    const int kThreads = 3;
+    const int kPerThread = 20000;
+    BlockingQueue<ArrayList<int> > q(16);
+    std::atomic<long long> sum(0);
+    std::atomic<int> consumed(0);
+
+    std::vector<std::thread> producers, consumers;
+    for (int t = 0; t < kThreads; ++t) {
+        producers.push_back(std::thread([&q, t, kPerThread]() {
+            int batch[5];
+            for (int i = 1; i <= kPerThread; i += 5) {
+                for (int j = 0; j < 5; ++j)
+                    batch[j] = t * kPerThread + i + j;
+                q.enqueueBulk(batch, 5);
+            }
+        }));
+        consumers.push_back(std::thread([&q, &sum, &consumed]() {
+            int values[8];
+            try {
+                for (;;) {
+                    sum += q.dequeueValue();
+                    ++consumed;
+                    size_t n = q.dequeueBatch(values, 8, std::chrono::milliseconds(1));
+                    for (size_t i = 0; i < n; ++i)
+                        sum += values[i];
+                    consumed += static_cast<int>(n);
+                }
+            } catch (QueueBase<int>::Underflow&) {
+            }
+        }));
+    }
+    for (size_t t = 0; t < producers.size(); ++t)
+        producers[t].join();
+    q.close();
+    for (size_t t = 0; t < consumers.size(); ++t)
+        consumers[t].join();
+
+    long long n = kThreads * kPerThread;
+    EXPECT_EQ(consumed.load(), n);
+    EXPECT_EQ(sum.load(), n * (n + 1) / 2);
+}
+
+TEST(WorkStealingDequeTest, OwnerAndThieves) {
+    const int kThieves = 3;
+    const int kCount = 50000;
+    WorkStealingDeque<int> deque(2);
+    std::atomic<long long> sum(0);
+    std::atomic<int> taken(0);
+    std::atomic<bool> done(false);
+
+    std::vector<std::thread> thieves;
+    for (int t = 0; t < kThieves; ++t) {
+        thieves.push_back(std::thread([&]() {
+            int value;
+            while (!done.load()) {
+                if (deque.steal(value)) {
+                    sum += value;
+                    ++taken;
+                }
+            }
+        }));
+    }
+
+    // The owner pushes in bursts, so the array grows while thieves read it
+    int value;
+    for (int i = 1; i <= kCount; ++i) {
+        deque.push(i);
+        if (i % 3 == 0 && deque.pop(value)) {
+            sum += value;
+            ++taken;
+        }
+    }
+    while (deque.pop(value)) {
+        sum += value;
+        ++taken;
+    }
+    while (taken.load() < kCount)
+        std::this_thread::yield();
+    done = true;
+    for (size_t t = 0; t < thieves.size(); ++t)
+        thieves[t].join();
+
+    EXPECT_EQ(taken.load(), kCount);
+    EXPECT_EQ(sum.load(), static_cast<long long>(kCount) * (kCount + 1) / 2);
+    EXPECT_TRUE(deque.isEmpty());
+    EXPECT_FALSE(deque.steal(value));
+}
+
+TEST(TaskPoolTest, SubmitAndWait) {
+    TaskPool pool(3);
+    EXPECT_EQ(pool.workerCount(), 3UL);
+    std::atomic<int> count(0);
+    for (int i = 0; i < 1000; ++i) {
+        pool.submit([&pool, &count]() {
+            // Tasks submitted from workers go to their own deques
+            pool.submit([&count]() { ++count; });
+            ++count;
+        });
+    }
+    pool.wait();
+    EXPECT_EQ(count.load(), 2000);
+}
+
+TEST(TaskPoolTest, NestedParallelFor) {
+    TaskPool pool(4);
+    std::vector<int> hits(100 * 100, 0);
+    pool.parallelFor(0, 100, [&pool, &hits](size_t i) {
+        pool.parallelFor(0, 100, [&hits, i](size_t j) { ++hits[i * 100 + j]; }, 8);
+    });
+    EXPECT_EQ(std::count(hits.begin(), hits.end(), 1), 100 * 100);
+
+    auto failAt500 = [](size_t i) {
+        if (i == 500)
+            throw std::runtime_error("500");
+    };
+    EXPECT_THROW(pool.parallelFor(0, 1000, failAt500, 16), std::runtime_error);
+}
+
+TEST(FlatCombiningTest, QueueAdapterKeepsPerThreadOrder) {
+    const int kThreads = 4;
+    const int kPerThread = 10000;
+    FlatCombining<QueueAdapter<LinkedList<int> > > queue;
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.push_back(std::thread([&queue, t, kPerThread]() {
+            for (int i = 0; i < kPerThread; ++i)
+                queue.add(t * kPerThread + i);
+        }));
+    }
+    for (size_t t = 0; t < threads.size(); ++t)
+        threads[t].join();
+
+    EXPECT_EQ(queue.size(), static_cast<size_t>(kThreads * kPerThread));
+    std::vector<int> last(kThreads, -1);
+    int value;
+    bool ordered = true;
+    while (queue.tryRemove(value)) {
+        ordered = ordered && value > last[value / kPerThread];
+        last[value / kPerThread] = value;
+    }
+    EXPECT_TRUE(ordered);
+    for (int t = 0; t < kThreads; ++t)
+        EXPECT_EQ(last[t], (t + 1) * kPerThread - 1);
+}
+
+template <typename Wait>
+void runMulticastPipeline() {
+    const int kEvents = 20000;
+    MulticastRing<long long, Wait> ring(64);
+    size_t persist = ring.addConsumer();
+    size_t metrics = ring.addConsumer();
+    // Indexing only sees an event once persisting it is done
+    size_t index = ring.addConsumer(std::vector<size_t>(1, persist));
+
+    std::atomic<long long> persisted(0);
+    long long persistSum = 0, metricsSum = 0, indexSum = 0;
+    bool indexAfterPersist = true;
+
+    std::thread persistThread([&]() {
+        while (ring.cursor(persist) < static_cast<uint64_t>(kEvents)) {
+            ring.waitFor(persist);
+            ring.drain(persist, [&](const long long& event, uint64_t) {
+                persistSum += event;
+                ++persisted;
+            });
+        }
+    });
+    std::thread metricsThread([&]() {
+        while (ring.cursor(metrics) < static_cast<uint64_t>(kEvents)) {
+            ring.waitFor(metrics);
+            ring.drain(metrics, [&](const long long& event, uint64_t) { metricsSum += event; });
+        }
+    });
+    std::thread indexThread([&]() {
+        while (ring.cursor(index) < static_cast<uint64_t>(kEvents)) {
+            ring.waitFor(index);
+            ring.drain(index, [&](const long long& event, uint64_t sequence) {
+                indexAfterPersist = indexAfterPersist && persisted.load() > static_cast<long long>(sequence);
+                indexSum += event;
+            });
+        }
+    });
+
+    // Publish in batches of up to 8 events
+    for (int i = 1; i <= kEvents; ) {
+        size_t batch = std::min(8, kEvents - i + 1);
+        uint64_t first = ring.claim(batch);
+        for (size_t j = 0; j < batch; ++j)
+            ring[first + j] = i++;
+        ring.publish();
+    }
+    persistThread.join();
+    metricsThread.join();
+    indexThread.join();
+
+    long long expected = static_cast<long long>(kEvents) * (kEvents + 1) / 2;
+    EXPECT_EQ(persistSum, expected);
+    EXPECT_EQ(metricsSum, expected);
+    EXPECT_EQ(indexSum, expected);
+    EXPECT_TRUE(indexAfterPersist);
+}
+
+TEST(MulticastRingTest, YieldWait) {
+    runMulticastPipeline<YieldWait>();
+}
+
+TEST(MulticastRingTest, BlockingWait) {
+    runMulticastPipeline<BlockingWait>();
+}
+
+TEST(MulticastRingTest, HaltReleasesWaiters) {
+    MulticastRing<int, BlockingWait> ring(4);
+    size_t consumer = ring.addConsumer();
+    EXPECT_THROW(ring.addConsumer(std::vector<size_t>(1, 5)), std::out_of_range);
+    EXPECT_THROW(ring.claim(5), std::out_of_range);
+    EXPECT_EQ(ring.available(consumer), 0UL);
+
+    std::thread waiter([&ring, consumer]() { EXPECT_EQ(ring.waitFor(consumer), 0UL); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    ring.halt();
+    waiter.join();
+
+    // The consumer never releases, so the producer waits for room
+    typedef MulticastRing<int, BlockingWait> Ring;
+    Ring full(4);
+    full.addConsumer();
+    EXPECT_EQ(full.claim(4), 0UL);
+    full.publish();
+    std::thread producer([&full]() {
+        EXPECT_THROW(full.claim(1), Ring::Halted);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    full.halt();
+    producer.join();
+    EXPECT_THROW(full.claim(1), Ring::Halted);
+    EXPECT_EQ(full.claim(0), 4UL);
+}
+
+std::string shmName(const char* test) {
+    std::ostringstream os;
+    os << "/shm-ring-" << test << "-" << getpid();
+    return os.str();
+}
+
+TEST(ShmRingQueueTest, SingleProcess) {
+    std::string name = shmName("single");
+    ShmRingQueue<int> queue(name, 5);
+    EXPECT_EQ(queue.capacity(), 8UL);
+    EXPECT_EQ(queue.mode(), ShmRingQueue<int>::MPMC);
+    EXPECT_TRUE(queue.isEmpty());
+    EXPECT_THROW(queue.dequeue(), QueueBase<int>::Underflow);
+    EXPECT_THROW(queue.front(), QueueBase<int>::Underflow);
+
+    for (int i = 0; i < 8; ++i)
+        EXPECT_TRUE(queue.tryEnqueue(i));
+    EXPECT_FALSE(queue.tryEnqueue(8));
+    EXPECT_EQ(queue.size(), 8UL);
+
+    // A second peer sees the same ring, possibly at another address
+    ShmRingQueue<int> other(name, 8);
+    EXPECT_EQ(other.front(), 0);
+    EXPECT_EQ(other.dequeueValue(), 0);
+    other.dequeue();
+    int value = -1;
+    EXPECT_TRUE(queue.tryDequeue(value));
+    EXPECT_EQ(value, 2);
+    EXPECT_EQ(queue.size(), 5UL);
+
+    // Segments created for another layout are rejected
+    EXPECT_THROW(ShmRingQueue<int>(name, 16), std::runtime_error);
+    EXPECT_THROW(ShmRingQueue<int>(name, 8, ShmRingQueue<int>::SPSC), std::runtime_error);
+    EXPECT_THROW(ShmRingQueue<long long>(name, 8), std::runtime_error);
+    EXPECT_EQ(queue.deadPeers(), 0UL);
+    ShmRingQueue<int>::remove(name);
+}
+
+TEST(ShmRingQueueTest, SpscAcrossProcesses) {
+    const long long kCount = 100000;
+    std::string name = shmName("spsc");
+    ShmRingQueue<long long> consumer(name, 256, ShmRingQueue<long long>::SPSC);
+
+    pid_t child = fork();
+    ASSERT_GE(child, 0);
+    if (child == 0) {
+        int status = 0;
+        try {
+            ShmRingQueue<long long> producer(name, 256, ShmRingQueue<long long>::SPSC);
+            for (long long i = 0; i < kCount; ++i)
+                producer.enqueue(i);
+        } catch (...) {
+            status = 1;
+        }
+        _exit(status);
+    }
+
+    bool ordered = true;
+    for (long long expected = 0; expected < kCount; ) {
+        long long value;
+        if (consumer.tryDequeue(value))
+            ordered = ordered && value == expected++;
+        else
+            std::this_thread::yield();
+    }
+    int status = -1;
+    waitpid(child, &status, 0);
+    EXPECT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    EXPECT_TRUE(ordered);
+    EXPECT_TRUE(consumer.isEmpty());
+    ShmRingQueue<long long>::remove(name);
+}
+
+TEST(ShmRingQueueTest, MpmcThreads) {
+    const int kThreads = 4;
+    const int kPerThread = 5000;
+    std::string name = shmName("mpmc");
+    ShmRingQueue<int> owner(name, 64);
+    std::atomic<long long> sum(0);
+    std::atomic<int> consumed(0);
+
+    // Every thread is a peer of its own
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.push_back(std::thread([&name, t, kPerThread]() {
+            ShmRingQueue<int> producer(name, 64);
+            for (int i = 1; i <= kPerThread; ++i)
+                producer.enqueue(t * kPerThread + i);
+        }));
+        threads.push_back(std::thread([&name, &sum, &consumed, kThreads, kPerThread]() {
+            ShmRingQueue<int> consumer(name, 64);
+            int value;
+            while (consumed.load() < kThreads * kPerThread) {
+                if (consumer.tryDequeue(value)) {
+                    sum += value;
+                    ++consumed;
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        }));
+    }
+    for (size_t i = 0; i < threads.size(); ++i)
+        threads[i].join();
+
+    long long total = static_cast<long long>(kThreads) * kPerThread;
+    EXPECT_EQ(consumed.load(), total);
+    EXPECT_EQ(sum.load(), total * (total + 1) / 2);
+    EXPECT_TRUE(owner.isEmpty());
+    ShmRingQueue<int>::remove(name);
+}
+
+TEST(ShmRingQueueTest, CrashedPeerIsRecovered) {
+    std::string name = shmName("crash");
+    ShmRingQueue<int> queue(name, 16);
+
+    pid_t child = fork();
+    ASSERT_GE(child, 0);
+    if (child == 0) {
+        // Dies without detaching, as if it had crashed
+        ShmRingQueue<int>* producer = new ShmRingQueue<int>(name, 16);
+        for (int i = 0; i < 10; ++i)
+            producer->enqueue(i);
+        _exit(0);
+    }
+    int status = -1;
+    waitpid(child, &status, 0);
+
+    EXPECT_EQ(queue.deadPeers(), 1UL);
+    EXPECT_EQ(queue.recover(), 1UL);
+    EXPECT_EQ(queue.deadPeers(), 0UL);
+    EXPECT_EQ(queue.recover(), 0UL);
+    for (int i = 0; i < 10; ++i)
+        EXPECT_EQ(queue.dequeueValue(), i);
+    EXPECT_TRUE(queue.isEmpty());
+    ShmRingQueue<int>::remove(name);
+}
+
+// Maps the segment of a ShmRingQueue to fake what a crashed peer leaves
+// behind. This mirrors the private layout: the positions at offsets 64 and
+// 128, the offset of the peer table at 24, and 64-byte peers holding the
+// pid followed by the claim at offset 8.
+class ShmRingSegment {
+public:
+    explicit ShmRingSegment(const std::string& name) : mBase(0), mLength(0) {
+        int fd = shm_open(name.c_str(), O_RDWR, 0600);
+        struct stat info;
+        if (fd >= 0 && fstat(fd, &info) == 0) {
+            mLength = info.st_size;
+            mBase = static_cast<char*>(mmap(0, mLength, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0));
+        }
+        if (fd >= 0)
+            close(fd);
+    }
+
+    ~ShmRingSegment() {
+        munmap(mBase, mLength);
+    }
+
+    std::atomic<uint64_t>& enqueuePos() {
+        return *reinterpret_cast<std::atomic<uint64_t>*>(mBase + 64);
+    }
+
+    std::atomic<uint64_t>& dequeuePos() {
+        return *reinterpret_cast<std::atomic<uint64_t>*>(mBase + 128);
+    }
+
+    // Sets the claim of every peer registered by pid: the position shifted
+    // left by three, plus 1 to enqueue or 2 to dequeue, plus 4 once won
+    void setClaim(int pid, uint64_t claim) {
+        char* peers = mBase + *reinterpret_cast<const uint64_t*>(mBase + 24);
+        for (int i = 0; i < 64; ++i) {
+            if (reinterpret_cast<std::atomic<int>*>(peers + 64 * i)->load() == pid)
+                reinterpret_cast<std::atomic<uint64_t>*>(peers + 64 * i + 8)->store(claim);
+        }
+    }
+
+private:
+    char* mBase;
+    size_t mLength;
+};
+
+// Registers a peer in a child process that exits without detaching
+pid_t crashedPeer(const std::string& name, size_t capacity) {
+    pid_t child = fork();
+    if (child == 0) {
+        new ShmRingQueue<int>(name, capacity);
+        _exit(0);
+    }
+    int status = -1;
+    waitpid(child, &status, 0);
+    return child;
+}
+
+TEST(ShmRingQueueTest, DeadProducerSlotIsSkipped) {
+    std::string name = shmName("producer");
+    ShmRingQueue<int> queue(name, 8);
+    ShmRingQueue<int> live(name, 8);
+    queue.enqueue(1);
+    pid_t child = crashedPeer(name, 8);
+    ASSERT_GT(child, 0);
+
+    // The child claimed position 1 and died before writing it, and another
+    // producer filled position 2
+    ShmRingSegment segment(name);
+    segment.enqueuePos().store(2);
+    segment.setClaim(child, 1 << 3 | 1);
+    queue.enqueue(3);
+    EXPECT_EQ(queue.dequeueValue(), 1);
+    int value;
+    EXPECT_FALSE(queue.tryDequeue(value));
+
+    // While a live peer may still be racing for position 1, nobody can tell
+    // who got it, so the dead peer is kept
+    segment.setClaim(getpid(), 1 << 3 | 1);
+    EXPECT_EQ(queue.recover(), 0UL);
+    EXPECT_EQ(queue.deadPeers(), 1UL);
+    segment.setClaim(getpid(), 0);
+    EXPECT_EQ(queue.recover(), 1UL);
+    EXPECT_EQ(queue.deadPeers(), 0UL);
+
+    // Consumers pass over the abandoned slot and the ring keeps flowing
+    EXPECT_EQ(live.front(), 3);
+    EXPECT_EQ(queue.dequeueValue(), 3);
+    for (int lap = 0; lap < 3; ++lap) {
+        for (int i = 0; i < 8; ++i)
+            EXPECT_TRUE(live.tryEnqueue(i));
+        EXPECT_FALSE(live.tryEnqueue(8));
+        for (int i = 0; i < 8; ++i)
+            EXPECT_EQ(queue.dequeueValue(), i);
+    }
+    EXPECT_TRUE(queue.isEmpty());
+    ShmRingQueue<int>::remove(name);
+}
+
+TEST(ShmRingQueueTest, DeadConsumerSlotIsReturned) {
+    std::string name = shmName("consumer");
+    ShmRingQueue<int> queue(name, 4);
+    for (int i = 10; i < 14; ++i)
+        queue.enqueue(i);
+    pid_t child = crashedPeer(name, 4);
+    ASSERT_GT(child, 0);
+
+    // The child won position 0 and died before handing the slot back
+    ShmRingSegment segment(name);
+    segment.dequeuePos().store(1);
+    segment.setClaim(child, 0 << 3 | 4 | 2);
+    for (int i = 11; i < 14; ++i)
+        EXPECT_EQ(queue.dequeueValue(), i);
+    EXPECT_TRUE(queue.isEmpty());
+    EXPECT_FALSE(queue.tryEnqueue(14));
+
+    // Recovery hands the slot back to producers; its element is lost
+    EXPECT_EQ(queue.recover(), 1UL);
+    for (int i = 14; i < 18; ++i)
+        EXPECT_TRUE(queue.tryEnqueue(i));
+    EXPECT_FALSE(queue.tryEnqueue(18));
+    for (int i = 14; i < 18; ++i)
+        EXPECT_EQ(queue.dequeueValue(), i);
+    EXPECT_TRUE(queue.isEmpty());
+    ShmRingQueue<int>::remove(name);
+}
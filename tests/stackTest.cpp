@@ -4,8 +4,17 @@
 #include "tests.h"
 #include "../include/StackBase.h"
 #include "../include/StackAdapter.h"
+#include "../include/ConcurrentStack.h"
+#include "../include/ContainerTraits.h"
+#include "../include/EliminationStack.h"
+#include "../include/FlatCombining.h"
+#include "../include/StaticStack.h"
+#include "../include/VariantStack.h"
 #include "../include/ArrayList.h"
 #include "../include/LinkedList.h"
+#include <atomic>
+#include <thread>
+#include <vector>
 
 
 StackBase<int>* makeIntStack(const int &testMode) {
@@ -138,8 +147,280 @@ TEST_P(StackTest, Adapter) {
     });
 }
 
+TEST_P(StackTest, TryPopAndPopValue) {
+    StackBase<int>* stack = makeIntStack(GetParam());
+    int value = -1;
+    EXPECT_FALSE(stack->tryPop(value));
+    EXPECT_EQ(value, -1);
+    EXPECT_THROW(stack->popValue(), StackBase<int>::Underflow);
+
+    for (int i = 1; i < 999; ++i)
+        stack->push(i);
+    EXPECT_EQ(stack->popValue(), 998);
+    for (int i = 997; i >= 1; --i) {
+        EXPECT_TRUE(stack->tryPop(value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_FALSE(stack->tryPop(value));
+    EXPECT_TRUE(stack->isEmpty());
+    delete stack;
+}
+
+TEST_P(StackTest, Bulk) {
+    StackBase<int>* stack = makeIntStack(GetParam());
+    int values[300];
+    for (int i = 0; i < 300; ++i)
+        values[i] = i;
+    stack->pushBulk(values, 300);
+    stack->pushBulk(values, 0);
+    EXPECT_EQ(stack->size(), 300UL);
+    EXPECT_EQ(stack->top(), 299);
+
+    int out[400];
+    EXPECT_EQ(stack->popBulk(out, 100), 100UL);
+    EXPECT_EQ(out[0], 299);
+    EXPECT_EQ(out[99], 200);
+    EXPECT_EQ(stack->popBulk(out, 400), 200UL);
+    EXPECT_EQ(out[199], 0);
+    EXPECT_TRUE(stack->isEmpty());
+    EXPECT_EQ(stack->popBulk(out, 1), 0UL);
+    delete stack;
+
+    StackAdapter<EnforcedIntAdaptee> minimal;
+    minimal.pushBulk(values, 10);
+    EXPECT_EQ(minimal.popBulk(out, 3), 3UL);
+    EXPECT_EQ(out[2], 7);
+}
+
 INSTANTIATE_TEST_CASE_P(Default,
     StackTest,
     ::testing::Values(CREATE_LINKED_STACK, CREATE_ARRAY_STACK),
     ::testing::PrintToStringParamName()
 );
+
+TEST(StackCapabilityTest, DetectsCheapOperations) {
+    EXPECT_TRUE(HasRemoveLast<LinkedList<int> >::type::value);
+    EXPECT_TRUE(HasBack<ArrayList<int> >::type::value);
+    EXPECT_TRUE(HasReserve<ArrayList<int> >::type::value);
+    EXPECT_FALSE(HasReserve<LinkedList<int> >::type::value);
+    EXPECT_FALSE(HasRemoveLast<EnforcedIntAdaptee>::type::value);
+    EXPECT_FALSE(HasBack<EnforcedIntAdaptee>::type::value);
+
+    StackAdapter<ArrayList<int> > stack;
+    stack.reserve(100);
+    for (int i = 0; i < 100; ++i)
+        stack.emplace(i);
+    EXPECT_EQ(stack.size(), 100UL);
+    EXPECT_EQ(stack.top(), 99);
+
+    StackAdapter<EnforcedIntAdaptee> minimal;
+    minimal.reserve(10);
+    minimal.emplace(7);
+    EXPECT_EQ(minimal.top(), 7);
+}
+
+TEST(StaticStackTest, MatchesAdapter) {
+    StaticStack<LinkedList<int> > stack;
+    VariantStack<int> array(VariantStack<int>::ARRAY);
+    VariantStack<int> linked(VariantStack<int>::LINKED);
+    EXPECT_THROW(stack.pop(), StackBase<int>::Underflow);
+    EXPECT_THROW(array.top(), StackBase<int>::Underflow);
+    EXPECT_THROW(linked.pop(), StackBase<int>::Underflow);
+
+    for (int i = 1; i < 999; ++i) {
+        stack.push(i);
+        array.push(i);
+        linked.push(i);
+    }
+    stack.top() = 0;
+    linked.top() = 0;
+    VariantStack<int> copy(linked);
+    EXPECT_EQ(copy.kind(), VariantStack<int>::LINKED);
+    EXPECT_EQ(copy.top(), 0);
+    copy.pop();
+    EXPECT_EQ(linked.size(), 998UL);
+
+    for (int i = 998; i >= 2; --i) {
+        stack.pop();
+        array.pop();
+        linked.pop();
+        EXPECT_EQ(stack.top(), i - 1);
+        EXPECT_EQ(array.top(), i - 1);
+        EXPECT_EQ(linked.top(), i - 1);
+    }
+    stack.pop();
+    array.pop();
+    linked.pop();
+    EXPECT_TRUE(stack.isEmpty());
+    EXPECT_TRUE(array.isEmpty());
+    EXPECT_TRUE(linked.isEmpty());
+}
+
+TEST(ConcurrentStackTest, SingleThread) {
+    ConcurrentStack<int> concurrent;
+    StackBase<int>& stack = concurrent;
+    EXPECT_THROW(stack.top(), StackBase<int>::Underflow);
+    EXPECT_THROW(stack.pop(), StackBase<int>::Underflow);
+
+    // Enough elements to need several chunks, pushed and popped twice so that
+    // the second round runs on recycled nodes
+    for (int round = 0; round < 2; ++round) {
+        for (int i = 0; i < 1000; ++i)
+            stack.push(i);
+        EXPECT_EQ(stack.size(), 1000UL);
+        EXPECT_EQ(stack.top(), 999);
+        stack.pop();
+        EXPECT_EQ(stack.popValue(), 998);
+        int value;
+        for (int i = 997; i >= 0; --i) {
+            EXPECT_TRUE(stack.tryPop(value));
+            EXPECT_EQ(value, i);
+        }
+        EXPECT_FALSE(stack.tryPop(value));
+        EXPECT_TRUE(stack.isEmpty());
+    }
+
+    int values[] = {1, 2, 3};
+    stack.pushBulk(values, 3);
+    int out[3];
+    EXPECT_EQ(stack.popBulk(out, 3), 3UL);
+    EXPECT_EQ(out[0], 3);
+    EXPECT_EQ(out[2], 1);
+}
+
+TEST(ConcurrentStackTest, ManyThreads) {
+    const int kThreads = 4;
+    const int kPerThread = 20000;
+    ConcurrentStack<int> stack;
+    std::atomic<long long> sum(0);
+    std::atomic<int> popped(0);
+
+    // Every thread pushes its own values and pops whatever it finds, so
+    // nodes are recycled between threads all the time
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.push_back(std::thread([&stack, &sum, &popped, t, kPerThread]() {
+            int value;
+            for (int i = 1; i <= kPerThread; ++i) {
+                value = t * kPerThread + i;
+                if (i % 2)
+                    stack.push(value);
+                else
+                    stack.pushBulk(&value, 1);
+                if (stack.tryPop(value)) {
+                    sum += value;
+                    ++popped;
+                }
+            }
+        }));
+    }
+    for (size_t t = 0; t < threads.size(); ++t)
+        threads[t].join();
+
+    int value;
+    while (stack.tryPop(value)) {
+        sum += value;
+        ++popped;
+    }
+    long long n = kThreads * kPerThread;
+    EXPECT_EQ(popped.load(), n);
+    EXPECT_EQ(sum.load(), n * (n + 1) / 2);
+}
+
+TEST(EliminationStackTest, SingleThread) {
+    EliminationStack<int> elimination(4);
+    StackBase<int>& stack = elimination;
+    EXPECT_THROW(stack.top(), StackBase<int>::Underflow);
+    EXPECT_THROW(stack.popValue(), StackBase<int>::Underflow);
+
+    for (int i = 0; i < 100; ++i)
+        stack.push(i);
+    int values[] = {100, 101};
+    stack.pushBulk(values, 2);
+    EXPECT_EQ(stack.size(), 102UL);
+    EXPECT_EQ(stack.top(), 101);
+    stack.pop();
+    int value;
+    for (int i = 100; i >= 0; --i) {
+        EXPECT_TRUE(stack.tryPop(value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_FALSE(stack.tryPop(value));
+}
+
+TEST(EliminationStackTest, ManyThreads) {
+    const int kThreads = 8;
+    const int kPerThread = 20000;
+    EliminationStack<int> stack(2);
+    std::atomic<long long> sum(0);
+    std::atomic<int> popped(0);
+
+    // Pushers and poppers run side by side, so colliding pairs exchange
+    // their elements in the elimination array
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.push_back(std::thread([&stack, &sum, &popped, t, kPerThread]() {
+            int value;
+            for (int i = 1; i <= kPerThread; ++i) {
+                stack.push(t * kPerThread + i);
+                if (stack.tryPop(value)) {
+                    sum += value;
+                    ++popped;
+                }
+            }
+        }));
+    }
+    for (size_t t = 0; t < threads.size(); ++t)
+        threads[t].join();
+
+    int value;
+    while (stack.tryPop(value)) {
+        sum += value;
+        ++popped;
+    }
+    long long n = kThreads * kPerThread;
+    EXPECT_EQ(popped.load(), n);
+    EXPECT_EQ(sum.load(), n * (n + 1) / 2);
+    EXPECT_TRUE(stack.isEmpty());
+}
+
+TEST(FlatCombiningTest, StackAdapter) {
+    const int kThreads = 4;
+    const int kPerThread = 10000;
+    FlatCombining<StackAdapter<ArrayList<int> > > stack(2);
+    std::atomic<long long> sum(0);
+    std::atomic<int> removed(0);
+
+    // Fewer slots than threads, so threads also wait for a free slot
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.push_back(std::thread([&stack, &sum, &removed, t, kPerThread]() {
+            int value;
+            for (int i = 1; i <= kPerThread; ++i) {
+                stack.add(t * kPerThread + i);
+                if (i % 2 == 0 && stack.tryRemove(value)) {
+                    sum += value;
+                    ++removed;
+                }
+            }
+        }));
+    }
+    for (size_t t = 0; t < threads.size(); ++t)
+        threads[t].join();
+
+    size_t left = stack.size();
+    EXPECT_EQ(left + removed.load(), static_cast<size_t>(kThreads * kPerThread));
+    int top = 0;
+    stack.apply([&top](StackAdapter<ArrayList<int> >& adapter) { top = adapter.top(); });
+    int value;
+    EXPECT_TRUE(stack.tryRemove(value));
+    EXPECT_EQ(value, top);
+    sum += value;
+    while (stack.tryRemove(value))
+        sum += value;
+    long long n = kThreads * kPerThread;
+    EXPECT_EQ(sum.load(), n * (n + 1) / 2);
+
+    auto popEmpty = [](StackAdapter<ArrayList<int> >& adapter) { adapter.pop(); };
+    EXPECT_THROW(stack.apply(popEmpty), StackBase<int>::Underflow);
+}